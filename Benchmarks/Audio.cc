@@ -0,0 +1,135 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Audio/AudioThread.h"
+#include "Audio/WavWriter.h"
+#include "Bench.h"
+#include "Foundation/Math/Random.h"
+
+static constexpr uint32_t RATE = 48000;
+static constexpr uint32_t VOICES = 512;
+static constexpr uint32_t BLOCKS = 200;
+static constexpr uint32_t REPEAT = 5;
+
+/* 원본 표본율이 섞인 2 초짜리 모노 소리들: 감쇠하는 화음, 잡음 폭발, 스윕 */
+static void make_sounds (std::vector <std::vector <float>> &storage, std::vector <AudioSound> &sounds)
+{
+  Xoshiro256 random (5);
+  const uint32_t rates[3] = { 48000, 44100, 22050 };
+  for (uint32_t n = 0; n < 6; ++n)
+  {
+    const uint32_t rate = rates[n % 3], frames = rate * 2;
+    std::vector <float> samples (frames);
+    for (uint32_t i = 0; i < frames; ++i)
+    {
+      const float t = float (i) / float (rate), decay = expf (-t * 2.0f);
+      switch (n % 3)
+      {
+        case 0: samples[i] = decay * 0.3f * (sinf (6.2831853f * 220.0f * t) + sinf (6.2831853f * 277.2f * t)); break;
+        case 1: samples[i] = expf (-t * 8.0f) * (random.next_float () * 2.0f - 1.0f) * 0.5f; break;
+        default: samples[i] = 0.4f * sinf (6.2831853f * (100.0f + 400.0f * t) * t); break;
+      }
+    }
+    storage.push_back (std::move (samples));
+  }
+  for (uint32_t n = 0; n < 6; ++n) sounds.push_back ({ storage[n].data (), uint32_t (storage[n].size ()), rates[n % 3] });
+}
+
+int main ()
+{
+  std::vector <std::vector <float>> storage;
+  std::vector <AudioSound> sounds;
+  make_sounds (storage, sounds);
+
+  const double block_ns = 1e9 * AudioMixer::BLOCK_FRAMES / RATE;
+  printf ("%u voices, %u Hz, %u-frame blocks (%.2f ms), best of %u\n", VOICES, RATE, AudioMixer::BLOCK_FRAMES, block_ns * 1e-6, REPEAT);
+
+  struct Case
+  {
+    const char *name;
+    bool native;    /* 48 kHz 소리를 음높이 1 로만 (복사 경로) */
+    bool effects;   /* 저역 통과 + 메아리 보내기 */
+  };
+  const Case cases[] = { { "mix native rate", true, false }, { "mix resampled", false, false }, { "mix resampled + filter + echo", false, true } };
+
+  std::vector <float> out (size_t (AudioMixer::BLOCK_FRAMES) * 2);
+  for (const Case &c : cases)
+  {
+    AudioMixer *mixer = new AudioMixer (RATE);
+    Xoshiro256 random (9);
+    for (uint32_t v = 0; v < VOICES; ++v)
+    {
+      const AudioSound &sound = sounds[c.native ? 0 : v % sounds.size ()];
+      const float pitch = c.native ? 1.0f : 0.5f + random.next_float () * 1.5f;
+      const AudioVoice voice = mixer->play (sound, 0.02f, random.next_float () * 2.0f - 1.0f, pitch, true);
+      if (c.effects)
+      {
+        mixer->set_filter (voice, 500.0f + random.next_float () * 8000.0f);
+        mixer->set_send (voice, 0.3f);
+      }
+    }
+    if (c.effects) mixer->set_echo (0.25f, 0.4f, 0.5f);
+
+    const double ns = Bench::run (c.name, size_t (BLOCKS) * VOICES, REPEAT, [&]
+    {
+      for (uint32_t b = 0; b < BLOCKS; ++b) mixer->mix (out.data (), AudioMixer::BLOCK_FRAMES);
+      Bench::keep (out[0]);
+    });
+    printf ("  %u voices active, %.0f voices per core in real time\n", mixer->active_voices (), block_ns / ns);
+    delete mixer;
+  }
+
+  /* 오프라인 렌더: 한 번만 울리는 목소리 몇 개와 도중에 멈추는 고리 하나를 WAV 버퍼로 */
+  {
+    AudioMixer *mixer = new AudioMixer (RATE);
+    const size_t frames = RATE * 3;
+    std::vector <float> render (frames * 2);
+    mixer->set_echo (0.3f, 0.35f, 0.4f);
+    const AudioVoice chord = mixer->play (sounds[0], 0.8f, -0.5f);
+    mixer->set_send (chord, 0.5f);
+    mixer->play (sounds[1], 0.6f, 0.5f, 1.5f);
+    const AudioVoice sweep = mixer->play (sounds[2], 0.5f, 0.0f, 1.0f, true);
+    mixer->set_filter (sweep, 2000.0f);
+
+    mixer->mix (render.data (), frames / 2);
+    mixer->stop (sweep);
+    mixer->mix (render.data () + frames, frames / 2);
+    mixer->update ();
+
+    float peak = 0.0f;
+    for (float x : render) peak = fabsf (x) > peak ? fabsf (x) : peak;
+    std::vector <uint8_t> wav (wav_size (frames));
+    const size_t bytes = encode_wav (render.data (), frames, RATE, wav.data ());
+    FILE *file = fopen ("audio.wav", "wb");
+    if (file)
+    {
+      fwrite (wav.data (), 1, bytes, file);
+      fclose (file);
+    }
+    printf ("offline render: %zu frames, peak %.3f, %u voices left, %zu-byte WAV\n", frames, peak, mixer->voice_count (), bytes);
+    delete mixer;
+  }
+
+  /* 실시간 스레드: 장치 콜백 대신 이 스레드가 블록 주기마다 링에서 읽음 */
+  {
+    AudioMixer *mixer = new AudioMixer (RATE);
+    for (uint32_t v = 0; v < 64; ++v) mixer->play (sounds[v % sounds.size ()], 0.05f, 0.0f, 1.0f, true);
+    AudioOutput output (4096);
+    AudioThread thread (*mixer, output);
+    thread.start ();
+
+    std::vector <float> device (size_t (AudioMixer::BLOCK_FRAMES) * 2);
+    const uint64_t start = Clock::now ();
+    for (uint32_t b = 0; b < 100; ++b)
+    {
+      while (Clock::now () - start < uint64_t (block_ns * (b + 1))) Atomics::pause ();
+      output.read (device.data (), AudioMixer::BLOCK_FRAMES);
+    }
+    thread.stop ();
+    printf ("audio thread: %llu blocks, %llu underruns, realtime priority %s\n", (unsigned long long) thread.blocks (),
+            (unsigned long long) output.underruns (), thread.realtime () ? "granted" : "denied");
+    delete mixer;
+  }
+  return 0;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "Foundation/Time/Clock.h"
+
+namespace Bench
+{
+  /* 결과가 최적화로 사라지지 않도록 */
+  template <typename T>
+  inline void keep (const T &value)
+  {
+#if _MSC_VER
+    static volatile const T *sink;
+    sink = &value;
+#else
+    asm volatile ("" : : "r,m" (value) : "memory");
+#endif
+  }
+
+  /* func 를 repeat 번 실행해 가장 빠른 회차 기준으로 항목당 시간과 처리량 출력 */
+  template <typename F>
+  double run (const char *name, const size_t items, const uint32_t repeat, F &&func)
+  {
+    uint64_t best = ~uint64_t (0);
+    for (uint32_t r = 0; r < repeat; ++r)
+    {
+      const uint64_t start = Clock::now ();
+      func ();
+      const uint64_t elapsed = Clock::now () - start;
+      if (elapsed < best) best = elapsed;
+    }
+
+    const double per_item = double (best) / double (items);
+    printf ("%-32s %10.3f ns/item %12.1f M items/s\n", name, per_item, 1e3 / per_item);
+    return per_item;
+  }
+} /* namespace Bench */
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+#include "Bench.h"
+#include "Foundation/Math/Random.h"
+#include "Render/CommandBucket.h"
+
+static constexpr size_t COUNT = 1 << 20;
+static constexpr uint32_t REPEAT = 10;
+static constexpr size_t CHUNK = 4096;
+
+/* 비교 기준: 공유 벡터에 잠금을 잡고 넣은 뒤 std::sort */
+struct LockedList
+{
+  struct Packet
+  {
+    uint64_t key;
+    RenderDraw draw;
+  };
+
+  std::mutex lock;
+  std::vector <Packet> packets;
+
+  void add (const uint64_t key, const RenderMesh &mesh, const float *world, const uint32_t color)
+  {
+    Packet packet;
+    packet.key = key;
+    packet.draw.mesh = &mesh;
+    std::copy (world, world + 16, packet.draw.world);
+    packet.draw.color = color;
+    packet.draw.cull_back = true;
+    std::lock_guard <std::mutex> guard (lock);
+    packets.push_back (packet);
+  }
+};
+
+int main ()
+{
+  ThreadLocal::attach ();
+  ThreadPool pool;
+  const uint32_t cores = pool.worker_count () + 1;
+
+  /* 장면 쪽 데이터: 객체마다 재질과 깊이 */
+  std::vector <uint64_t> keys (COUNT);
+  Xoshiro256 random (7);
+  for (size_t i = 0; i < COUNT; ++i)
+  {
+    const uint32_t material = uint32_t (random.next () % 512);
+    const bool translucent = random.next () % 8 == 0;
+    keys[i] = render_sort_key (uint32_t (random.next () % 3), translucent, random.next_float (), material);
+  }
+  const RenderMesh mesh = {};
+  const float world[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+  printf ("%zu packets, %u cores, best of %u\n", COUNT, cores, REPEAT);
+
+  LockedList baseline;
+  baseline.packets.reserve (COUNT);
+  const double slow = Bench::run ("locked vector + std::sort", COUNT, REPEAT, [&]
+  {
+    baseline.packets.clear ();
+    parallel_for (pool, COUNT, CHUNK, [&] (const size_t begin, const size_t end)
+    {
+      for (size_t i = begin; i < end; ++i) baseline.add (keys[i], mesh, world, uint32_t (i));
+    });
+    std::sort (baseline.packets.begin (), baseline.packets.end (), [] (const LockedList::Packet &a, const LockedList::Packet &b) { return a.key < b.key; });
+    Bench::keep (baseline.packets[0].key);
+  });
+
+  CommandBucket bucket (COUNT, 128 << 20);
+  const double fast = Bench::run ("command bucket + radix sort", COUNT, REPEAT, [&]
+  {
+    bucket.reset ();
+    parallel_for (pool, COUNT, CHUNK, [&] (const size_t begin, const size_t end)
+    {
+      for (size_t i = begin; i < end; ++i) bucket.add (keys[i], mesh, world, uint32_t (i));
+    });
+    bucket.sort (pool);
+    Bench::keep (bucket.key (0));
+  });
+
+  bool ordered = bucket.size () == COUNT;
+  for (size_t i = 1; i < bucket.size () && ordered; ++i) ordered = bucket.key (i - 1) <= bucket.key (i);
+  printf ("  sorted %s, speedup %.2fx\n", ordered ? "ok" : "FAILED", slow / fast);
+
+  RenderCommandStream stream (COUNT);
+  Bench::run ("submit to command stream", COUNT, REPEAT, [&] { stream.reset (); bucket.submit (stream); Bench::keep (stream.size ()); });
+  return ordered ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "Bench.h"
+#include "Net/NetEndpoint.h"
+
+static constexpr uint32_t RAW_PACKETS = 256 * 1024;
+static constexpr uint32_t CLIENTS = 64;
+static constexpr uint32_t ROUNDS = 2000;
+static constexpr uint32_t RELIABLE_MESSAGES = 20000;
+static constexpr uint32_t REPEAT = 3;
+
+/* 소켓 두 개 사이에서 묶음 보내기 / 받기만: 시스템 호출 한 번에 MAX_BATCH 개 */
+static void bench_raw ()
+{
+  UdpSocket sender, receiver;
+  if (!sender.open (0, true) || !receiver.open (0, true))
+  {
+    printf ("raw: socket open failed\n");
+    return;
+  }
+
+  std::vector <uint8_t> storage (size_t (UdpSocket::MAX_BATCH) * 1536);
+  NetDatagram out[UdpSocket::MAX_BATCH], in[UdpSocket::MAX_BATCH];
+  for (uint32_t i = 0; i < UdpSocket::MAX_BATCH; ++i)
+  {
+    out[i] = { NetAddress::loopback (receiver.port ()), storage.data (), 64 };
+    in[i].data = storage.data () + size_t (i) * 1536;
+  }
+
+  size_t received = 0, sent = 0;
+  Bench::run ("udp loopback batch 64B", RAW_PACKETS, REPEAT, [&]
+  {
+    received = sent = 0;
+    for (uint32_t p = 0; p < RAW_PACKETS; p += UdpSocket::MAX_BATCH)
+    {
+      sent += sender.send (out, UdpSocket::MAX_BATCH);
+      received += receiver.receive (in, UdpSocket::MAX_BATCH, 1536);
+    }
+    while (size_t n = receiver.receive (in, UdpSocket::MAX_BATCH, 1536)) received += n;
+  });
+  printf ("  %zu sent, %zu received\n", sent, received);
+}
+
+/* 서버 하나에 클라이언트 여럿. 라운드마다 클라이언트가 비신뢰 상태 하나씩 보내고 서버가 모두 받아 답함.
+   서버 쪽 poll / flush 시간만 재서 한 스레드의 패킷 처리량으로 봄 */
+static void bench_endpoint ()
+{
+  NetEndpoint server (CLIENTS * 2);
+  if (!server.open (0, true)) return;
+  std::vector <NetEndpoint *> clients;
+  std::vector <uint32_t> links;
+  for (uint32_t c = 0; c < CLIENTS; ++c)
+  {
+    clients.push_back (new NetEndpoint (1, 1024));
+    clients[c]->open (0, true);
+    links.push_back (clients[c]->connect (NetAddress::loopback (server.port ()), Clock::now ()));
+  }
+
+  uint8_t state[64] = {};
+  uint64_t server_ns = 0, handled = 0, replies = 0, messages = 0;
+  for (uint32_t round = 0; round < ROUNDS; ++round)
+  {
+    const uint64_t now = Clock::now ();
+    for (uint32_t c = 0; c < CLIENTS; ++c)
+    {
+      memcpy (state, &round, sizeof (round));
+      clients[c]->send (links[c], state, sizeof (state), false);
+      clients[c]->flush (now);
+    }
+
+    const uint64_t start = Clock::now ();
+    handled += server.poll (start, [&] (uint32_t id, const uint8_t *data, uint32_t size, bool)
+    {
+      ++messages;
+      server.send (id, data, size, false);
+    });
+    replies += server.flush (start);
+    server_ns += Clock::now () - start;
+
+    for (uint32_t c = 0; c < CLIENTS; ++c) clients[c]->poll (now, [] (uint32_t, const uint8_t *, uint32_t, bool) {});
+  }
+
+  const double packets = double (handled + replies);
+  printf ("%-32s %10.3f ns/item %12.1f M items/s\n", "endpoint server recv+send", double (server_ns) / packets, packets * 1e3 / double (server_ns));
+  printf ("  %u clients, %llu received, %llu messages, %llu replies, %zu pool blocks in use\n", server.connection_count (),
+          (unsigned long long) handled, (unsigned long long) messages, (unsigned long long) replies, server.packets_in_use ());
+  for (NetEndpoint *client : clients) delete client;
+}
+
+/* 양쪽 모두 10% 손실에서 신뢰 메시지가 빠짐없이 순서대로 도착하는지. 시간은 가상으로 1 ms 씩 흐름 */
+static void check_reliable ()
+{
+  NetEndpoint server (4), client (4);
+  if (!server.open (0, true) || !client.open (0, true)) return;
+  server.set_simulated_loss (0.1f, 3);
+  client.set_simulated_loss (0.1f, 4);
+  uint64_t now = 1000000;
+  const uint32_t link = client.connect (NetAddress::loopback (server.port ()), now);
+
+  uint32_t queued = 0, delivered = 0, out_of_order = 0, ticks = 0;
+  while (delivered < RELIABLE_MESSAGES && ticks < 100000)
+  {
+    while (queued < RELIABLE_MESSAGES && client.send (link, &queued, sizeof (queued), true)) ++queued;
+    client.flush (now);
+    server.poll (now, [&] (uint32_t, const uint8_t *data, uint32_t size, bool reliable)
+    {
+      uint32_t value;
+      if (!reliable || size != sizeof (value)) return;
+      memcpy (&value, data, sizeof (value));
+      out_of_order += value != delivered;
+      ++delivered;
+    });
+    server.flush (now);
+    client.poll (now, [] (uint32_t, const uint8_t *, uint32_t, bool) {});
+    now += 1000000;
+    ++ticks;
+  }
+
+  const NetConnectionStats &stats = client.connection (link).stats ();
+  printf ("reliable under 10%% loss: %u / %u delivered, %u out of order, %u ticks\n", delivered, RELIABLE_MESSAGES, out_of_order, ticks);
+  printf ("  %llu packets sent, %llu acked, %llu lost, %llu resends, rtt %.2f ms\n", (unsigned long long) stats.packets_sent,
+          (unsigned long long) stats.packets_acked, (unsigned long long) stats.packets_lost, (unsigned long long) stats.messages_resent,
+          stats.rtt_ms);
+}
+
+int main ()
+{
+  bench_raw ();
+  bench_endpoint ();
+  check_reliable ();
+  return 0;
+}
@@ -0,0 +1,51 @@
+#include <cstdio>
+
+#include "Bench.h"
+#include "Particle/ParticleSystem.h"
+
+static constexpr size_t COUNT = 1 << 22;
+static constexpr uint32_t REPEAT = 20;
+static constexpr float DT = 1.0f / 60.0f;
+
+static const ParticleEmitter EMITTER = {
+  { 0.0f, 0.0f, 0.0f }, { 10.0f, 10.0f, 10.0f },
+  { -1.0f, 2.0f, -1.0f }, { 1.0f, 6.0f, 1.0f },
+  1000.0f, 2000.0f,
+};
+
+static const ParticleAttractor ATTRACTORS[] = {
+  { { 5.0f, 0.0f, 0.0f }, 20.0f },
+  { { -5.0f, 3.0f, 2.0f }, 15.0f },
+};
+
+static void report (const double ns_per_particle, const uint32_t cores)
+{
+  printf ("%-32s %10.0f particles/ms/core (%u cores)\n", "", 1e6 / ns_per_particle / cores, cores);
+}
+
+int main ()
+{
+  XoshiroWide random (1);
+  ParticleForces forces;
+  forces.drag = 0.1f;
+  forces.attractors = ATTRACTORS;
+  forces.attractor_count = 2;
+
+  ParticleSystem serial (COUNT);
+  serial.emit (EMITTER, COUNT, random);
+  printf ("%zu particles, best of %u\n", COUNT, REPEAT);
+  report (Bench::run ("update", COUNT, REPEAT, [&] { serial.update (DT, forces); Bench::keep (serial.position (0)[0]); }), 1);
+
+  ThreadPool pool;
+  ParticleSystem parallel (COUNT);
+  parallel.emit (EMITTER, COUNT, random);
+  const uint32_t cores = pool.worker_count () + 1;
+  report (Bench::run ("update parallel", COUNT, REPEAT, [&] { parallel.update (pool, DT, forces); Bench::keep (parallel.position (0)[0]); }), cores);
+
+  /* 매 프레임 1/8 이 죽는 경우의 압축 비용 */
+  ParticleSystem churn (COUNT);
+  churn.emit ({ { 0.0f, 0.0f, 0.0f }, { 10.0f, 10.0f, 10.0f }, { -1.0f, 2.0f, -1.0f }, { 1.0f, 6.0f, 1.0f }, 0.0f, 8 * DT }, COUNT, random);
+  Bench::run ("compact 1/8 dead", COUNT, 1, [&] { churn.update (DT, forces); });
+  printf ("%zu particles alive after one step\n", churn.size ());
+  return 0;
+}
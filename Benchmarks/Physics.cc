@@ -0,0 +1,71 @@
+#include <cstdio>
+
+#include "Bench.h"
+#include "Foundation/Math/Random.h"
+#include "Physics/PhysicsWorld.h"
+
+static constexpr uint32_t SIDE = 16;
+static constexpr uint32_t LAYERS = 16;
+static constexpr uint32_t BODIES = SIDE * SIDE * LAYERS;
+static constexpr uint32_t SETTLE_STEPS = 300;
+static constexpr float RADIUS = 0.5f;
+static constexpr float HALF_WIDTH = SIDE * RADIUS * 1.25f;
+static constexpr float DT = 1.0f / 60.0f;
+
+/* 바닥과 네 벽으로 된 상자 안에 구를 흩어 떨어뜨려 쌓음 */
+static void build (PhysicsWorld &world, Xoshiro256 &random)
+{
+  const float floor[3] = { 0.0f, 1.0f, 0.0f };
+  world.add_plane (floor, 0.0f);
+  const float walls[4][3] = { { 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f } };
+  for (const float *wall : walls) world.add_plane (wall, -HALF_WIDTH);
+
+  const float spacing = 2.0f * HALF_WIDTH / SIDE;
+  for (uint32_t y = 0; y < LAYERS; ++y)
+    for (uint32_t z = 0; z < SIDE; ++z)
+      for (uint32_t x = 0; x < SIDE; ++x)
+      {
+        const float jitter = (random.next_float () - 0.5f) * 0.1f;
+        const float position[3] = { -HALF_WIDTH + (float (x) + 0.5f) * spacing + jitter, RADIUS + float (y) * spacing * 1.1f,
+                                    -HALF_WIDTH + (float (z) + 0.5f) * spacing - jitter };
+        world.add_sphere (position, RADIUS, 1.0f);
+      }
+}
+
+int main ()
+{
+  ThreadPool pool;
+  Xoshiro256 random (3);
+  PhysicsWorld world (BODIES);
+  build (world, random);
+  printf ("%u spheres against 5 planes, %u workers + caller\n", world.body_count (), pool.worker_count ());
+
+  uint64_t settle_ns = 0;
+  for (uint32_t s = 0; s < SETTLE_STEPS; ++s)
+  {
+    const uint64_t start = Clock::now ();
+    world.step (pool, DT);
+    settle_ns += Clock::now () - start;
+  }
+
+  uint32_t sleeping = 0, escaped = 0;
+  float lowest = 1e30f;
+  for (uint32_t b = 0; b < world.body_count (); ++b)
+  {
+    sleeping += world.sleeping (b);
+    const float x = world.position (0)[b], y = world.position (1)[b], z = world.position (2)[b];
+    lowest = y < lowest ? y : lowest;
+    escaped += y < 0.0f || x < -HALF_WIDTH || x > HALF_WIDTH || z < -HALF_WIDTH || z > HALF_WIDTH;
+  }
+  printf ("  settle %.3f ms per step over %u steps\n", double (settle_ns) / SETTLE_STEPS * 1e-6, SETTLE_STEPS);
+  printf ("  %u contacts, %u islands, %u batches, %u sleeping, lowest centre %.3f, %u outside the box\n", world.contact_count (),
+          world.island_count (), world.batch_count (), sleeping, lowest, escaped);
+
+  /* 쌓인 더미를 깨워 놓고 한 스텝 비용을 잼 */
+  Bench::run ("step awake pile", BODIES, 10, [&]
+  {
+    for (uint32_t b = 0; b < world.body_count (); ++b) world.wake (b);
+    world.step (pool, DT);
+  });
+  return 0;
+}
@@ -0,0 +1,38 @@
+#include <cstdio>
+#include <random>
+
+#include "Bench.h"
+#include "Foundation/Math/Random.h"
+
+static constexpr size_t COUNT = 1 << 22;
+static constexpr uint32_t REPEAT = 10;
+
+alignas (64) static uint32_t ints[COUNT];
+alignas (64) static float floats[COUNT];
+
+int main ()
+{
+  printf ("%zu values, best of %u\n", COUNT, REPEAT);
+
+  std::mt19937 mt (1);
+  Bench::run ("mt19937 u32", COUNT, REPEAT, [&] { for (size_t i = 0; i < COUNT; ++i) ints[i] = uint32_t (mt ()); Bench::keep (ints[COUNT - 1]); });
+
+  std::uniform_real_distribution <float> distribution (0.0f, 1.0f);
+  Bench::run ("mt19937 float", COUNT, REPEAT, [&] { for (size_t i = 0; i < COUNT; ++i) floats[i] = distribution (mt); Bench::keep (floats[COUNT - 1]); });
+
+  Pcg32 pcg (1);
+  Bench::run ("pcg32 u32", COUNT, REPEAT, [&] { pcg.fill (ints, COUNT); Bench::keep (ints[COUNT - 1]); });
+  Bench::run ("pcg32 float", COUNT, REPEAT, [&] { pcg.fill (floats, COUNT); Bench::keep (floats[COUNT - 1]); });
+
+  Xoshiro256 xoshiro (1);
+  Bench::run ("xoshiro256** u32", COUNT, REPEAT, [&] { xoshiro.fill (ints, COUNT); Bench::keep (ints[COUNT - 1]); });
+  Bench::run ("xoshiro256** float", COUNT, REPEAT, [&] { xoshiro.fill (floats, COUNT); Bench::keep (floats[COUNT - 1]); });
+
+  XoshiroWide wide (1);
+  char name[64];
+  snprintf (name, sizeof (name), "xoshiro256** x%zu u32", XoshiroWide::LANES);
+  Bench::run (name, COUNT, REPEAT, [&] { wide.fill (ints, COUNT); Bench::keep (ints[COUNT - 1]); });
+  snprintf (name, sizeof (name), "xoshiro256** x%zu float", XoshiroWide::LANES);
+  Bench::run (name, COUNT, REPEAT, [&] { wide.fill (floats, COUNT); Bench::keep (floats[COUNT - 1]); });
+  return 0;
+}
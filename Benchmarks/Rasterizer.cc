@@ -0,0 +1,117 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Bench.h"
+#include "Render/SoftwareRasterizer.h"
+
+static constexpr uint32_t WIDTH = 1280;
+static constexpr uint32_t HEIGHT = 720;
+static constexpr uint32_t REPEAT = 10;
+
+/* 경도 x 위도 격자 구. 바깥쪽이 앞면 */
+static void make_sphere (const uint32_t slices, const uint32_t stacks, std::vector <float> &positions, std::vector <uint32_t> &indices)
+{
+  for (uint32_t j = 0; j <= stacks; ++j)
+    for (uint32_t i = 0; i <= slices; ++i)
+    {
+      const float theta = 3.14159265f * float (j) / float (stacks), phi = 6.2831853f * float (i) / float (slices);
+      positions.insert (positions.end (), { sinf (theta) * cosf (phi), cosf (theta), sinf (theta) * sinf (phi) });
+    }
+  for (uint32_t j = 0; j < stacks; ++j)
+    for (uint32_t i = 0; i < slices; ++i)
+    {
+      const uint32_t a = j * (slices + 1) + i, b = a + 1, c = a + slices + 1, d = c + 1;
+      indices.insert (indices.end (), { a, b, d, a, d, c });
+    }
+}
+
+static void perspective (float *out, const float fov, const float aspect, const float near, const float far)
+{
+  const float t = 1.0f / tanf (fov * 0.5f);
+  const float m[16] = { t / aspect, 0, 0, 0, 0, t, 0, 0, 0, 0, far / (near - far), -1, 0, 0, near * far / (near - far), 0 };
+  for (int i = 0; i < 16; ++i) out[i] = m[i];
+}
+
+/* 구를 grid x grid 로 늘어놓은 장면. 앞줄이 뒷줄을 가려 계층 Z 가 일함 */
+static void build_scene (RenderCommandStream &stream, const RenderMesh &mesh, const uint32_t grid, const float *view_projection)
+{
+  const float light[3] = { 0.3f, 0.8f, 0.5f };
+  stream.reset ();
+  stream.clear (0xff302010);
+  stream.set_camera (view_projection);
+  stream.set_light (light, 0.2f);
+  for (uint32_t y = 0; y < grid; ++y)
+    for (uint32_t x = 0; x < grid; ++x)
+      for (uint32_t z = 0; z < 4; ++z)
+      {
+        const float world[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0,
+                                  (float (x) - float (grid - 1) * 0.5f) * 2.2f, (float (y) - float (grid - 1) * 0.5f) * 2.2f, -8.0f - float (z) * 3.0f, 1 };
+        stream.draw (mesh, world, 0xff000000 | (x * 40 + 60) | (y * 40 + 60) << 8 | (z * 50 + 80) << 16);
+      }
+}
+
+int main ()
+{
+  ThreadPool pool;
+  Framebuffer target (WIDTH, HEIGHT);
+  RenderCommandStream stream (4096);
+  float view_projection[16];
+  perspective (view_projection, 1.2f, float (WIDTH) / float (HEIGHT), 0.1f, 100.0f);
+
+  struct Case
+  {
+    const char *name;
+    uint32_t slices, stacks, grid;
+  };
+  /* 큰 삼각형 (채우기 위주) 과 픽셀 몇 개짜리 작은 삼각형 (준비와 분류 위주) */
+  const Case cases[] = { { "large triangles", 16, 8, 4 }, { "medium triangles", 64, 32, 6 }, { "small triangles", 256, 128, 6 } };
+
+  printf ("%ux%u, %u cores, best of %u\n", WIDTH, HEIGHT, pool.worker_count () + 1, REPEAT);
+  for (const Case &c : cases)
+  {
+    std::vector <float> positions;
+    std::vector <uint32_t> indices;
+    make_sphere (c.slices, c.stacks, positions, indices);
+    const RenderMesh mesh = { positions.data (), indices.data (), uint32_t (positions.size () / 3), uint32_t (indices.size () / 3) };
+    build_scene (stream, mesh, c.grid, view_projection);
+
+    const size_t triangle_count = size_t (mesh.triangle_count) * c.grid * c.grid * 4;
+    SoftwareRasterizer rasterizer (triangle_count);
+    const double ns = Bench::run (c.name, triangle_count, REPEAT, [&] { rasterizer.execute (pool, stream, target); });
+    const RasterStats &stats = rasterizer.stats ();
+    printf ("  %zu triangles, %llu visible, %.2f bins/triangle, %.1f M triangles/s\n", triangle_count, (unsigned long long) stats.visible,
+            double (stats.bin_entries) / double (stats.visible ? stats.visible : 1), 1e3 / ns);
+  }
+
+  /* 1920x1080 화면 전체를 덮는 사각형을 앞에서부터 겹쳐 그림. 타일 목록이 bins 보다 커져 나눠 그리는 경로 */
+  static constexpr uint32_t OVERDRAW_QUADS = 12000;
+  static constexpr float IDENTITY[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+  static const uint32_t quad_indices[6] = { 0, 1, 2, 0, 2, 3 };
+  std::vector <float> quad_positions;
+  std::vector <RenderMesh> quads;
+  for (uint32_t i = 0; i < OVERDRAW_QUADS; ++i)
+  {
+    const float z = 0.01f + 0.9f * float (i) / float (OVERDRAW_QUADS);
+    quad_positions.insert (quad_positions.end (), { -1, -1, z, 1, -1, z, 1, 1, z, -1, 1, z });
+  }
+  for (uint32_t i = 0; i < OVERDRAW_QUADS; ++i) quads.push_back ({ quad_positions.data () + i * 12, quad_indices, 4, 2 });
+
+  const float light[3] = { 0.0f, 0.0f, 1.0f };
+  RenderCommandStream overdraw (OVERDRAW_QUADS + 4);
+  overdraw.clear (0xff000000);
+  overdraw.set_camera (IDENTITY);
+  overdraw.set_light (light, 1.0f);
+  for (uint32_t i = 0; i < OVERDRAW_QUADS; ++i) overdraw.draw (quads[i], IDENTITY, 0xff000000 | (i * 2654435761u >> 8), false);
+
+  const size_t overdraw_triangles = size_t (OVERDRAW_QUADS) * 2;
+  Framebuffer overdraw_target (1920, 1080);
+  SoftwareRasterizer rasterizer (overdraw_triangles);
+  const double ns = Bench::run ("full-screen overdraw", overdraw_triangles, 1, [&] { rasterizer.execute (pool, overdraw, overdraw_target); });
+  const RasterStats &stats = rasterizer.stats ();
+  printf ("  %zu triangles, %.0f bins/triangle in %llu passes, %.1f K triangles/s\n", overdraw_triangles,
+          double (stats.bin_entries) / double (overdraw_triangles), (unsigned long long) stats.bin_passes, 1e6 / ns);
+
+  target.write_ppm ("rasterizer.ppm");
+  return 0;
+}
@@ -0,0 +1,149 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Bench.h"
+#include "Foundation/Math/Random.h"
+#include "Net/ReplicationClient.h"
+#include "Net/ReplicationServer.h"
+
+static constexpr uint32_t ENTITIES = 4096;
+static constexpr uint32_t CLIENTS = 64;
+static constexpr uint32_t TICKS = 300;
+static constexpr uint32_t PACKET_BYTES = 1200;
+static constexpr float WORLD = 512.0f;
+static constexpr float LOSS = 0.05f;
+
+struct Entity
+{
+  float x, y, z, yaw;
+  uint32_t health, anim;
+};
+
+/* 한 틱: 개체의 1/4 이 걷고 가끔 죽었다 살아남 */
+static void simulate (std::vector <Entity> &entities, ReplicationServer &server, Xoshiro256 &random, bool move)
+{
+  for (uint32_t e = 0; e < ENTITIES; ++e)
+  {
+    Entity &entity = entities[e];
+    if (move && random.next_below (4) == 0)
+    {
+      entity.x = fminf (fmaxf (entity.x + random.next_float () * 2.0f - 1.0f, -WORLD), WORLD);
+      entity.z = fminf (fmaxf (entity.z + random.next_float () * 2.0f - 1.0f, -WORLD), WORLD);
+      entity.yaw = fmodf (entity.yaw + random.next_float () * 0.2f, 6.2831853f);
+      entity.anim = random.next_below (8) == 0 ? random.next_below (64) : entity.anim;
+    }
+    if (move && random.next_below (2000) == 0)
+    {
+      if (server.is_alive (e)) server.despawn (e);
+      else server.spawn (e, 1.0f + float (e % 4));
+    }
+    server.set_float (e, 0, entity.x);
+    server.set_float (e, 1, entity.y);
+    server.set_float (e, 2, entity.z);
+    server.set_float (e, 3, entity.yaw);
+    server.set_integer (e, 4, entity.health);
+    server.set_integer (e, 5, entity.anim);
+    server.set_position (e, entity.x, entity.y, entity.z);
+  }
+}
+
+int main ()
+{
+  ReplicationSchema schema;
+  schema.add_float (-WORLD, WORLD, 18);
+  schema.add_float (-64.0f, 64.0f, 14);
+  schema.add_float (-WORLD, WORLD, 18);
+  schema.add_float (0.0f, 6.2831853f, 10);
+  schema.add_integer (8);
+  schema.add_integer (6);
+
+  ThreadPool pool;
+  ReplicationServer server (schema, ENTITIES, CLIENTS, PACKET_BYTES);
+  std::vector <ReplicationClient *> clients;
+  Xoshiro256 random (11);
+  for (uint32_t c = 0; c < CLIENTS; ++c)
+  {
+    server.add_client (c);
+    server.set_view (c, random.next_float () * 2.0f * WORLD - WORLD, 0.0f, random.next_float () * 2.0f * WORLD - WORLD, 64.0f);
+    clients.push_back (new ReplicationClient (schema, ENTITIES));
+  }
+
+  std::vector <Entity> entities (ENTITIES);
+  for (uint32_t e = 0; e < ENTITIES; ++e)
+  {
+    entities[e] = { random.next_float () * 2.0f * WORLD - WORLD, 0.0f, random.next_float () * 2.0f * WORLD - WORLD, 0.0f, 100, 0 };
+    server.spawn (e, 1.0f + float (e % 4));
+  }
+
+  /* 서버 → 클라이언트 스냅숏과 클라이언트 → 서버 확인을 각각 LOSS 확률로 잃음. 확인은 다음 틱에 도착 */
+  std::vector <std::vector <uint16_t>> acks (CLIENTS);
+  uint64_t update_ns = 0, bytes = 0, records = 0, rejected = 0, packets = 0;
+  auto tick = [&] (bool move, float loss)
+  {
+    for (uint32_t c = 0; c < CLIENTS; ++c)
+    {
+      for (uint16_t sequence : acks[c]) server.acknowledge (c, sequence);
+      acks[c].clear ();
+    }
+    simulate (entities, server, random, move);
+
+    const uint64_t start = Clock::now ();
+    server.update (pool);
+    update_ns += Clock::now () - start;
+
+    for (uint32_t c = 0; c < CLIENTS; ++c)
+    {
+      bytes += server.packet_size (c);
+      records += server.records_sent (c);
+      ++packets;
+      if (random.next_float () < loss) continue;
+      uint16_t sequence;
+      if (!clients[c]->read (server.packet (c), server.packet_size (c), &sequence))
+      {
+        ++rejected;
+        continue;
+      }
+      if (random.next_float () >= loss) acks[c].push_back (sequence);
+    }
+  };
+
+  for (uint32_t t = 0; t < TICKS; ++t) tick (true, LOSS);
+  const double full_bytes = double (ENTITIES) * (schema.state_bits () + 14) / 8.0;
+  printf ("%u entities, %u clients, %u ticks, %.0f%% loss each way\n", ENTITIES, CLIENTS, TICKS, LOSS * 100.0f);
+  printf ("  server update %.3f ms per tick (%u workers + caller), %.1f us per client\n", double (update_ns) / TICKS * 1e-6,
+          pool.worker_count (), double (update_ns) / TICKS / CLIENTS * 1e-3);
+  printf ("  %.0f bytes and %.1f records per snapshot (full world %.0f bytes), %llu rejected\n", double (bytes) / double (packets),
+          double (records) / double (packets), full_bytes, (unsigned long long) rejected);
+
+  Bench::run ("update one client serial", CLIENTS, 5, [&]
+  {
+    for (uint32_t c = 0; c < CLIENTS; ++c) server.update_client (c);
+  });
+  Bench::run ("update clients parallel", CLIENTS, 5, [&] { server.update (pool); });
+
+  /* 멈춘 뒤 손실 없이 보낼 것이 없어질 때까지 돌리고 모든 클라이언트가 서버와 같은지 확인 */
+  uint32_t settle = 0;
+  for (; settle < 200; ++settle)
+  {
+    records = 0;
+    tick (false, 0.0f);
+    if (!records) break;
+  }
+  uint32_t mismatches = 0;
+  for (uint32_t c = 0; c < CLIENTS; ++c)
+    for (uint32_t e = 0; e < ENTITIES; ++e)
+    {
+      if (clients[c]->is_alive (e) != server.is_alive (e))
+      {
+        ++mismatches;
+        continue;
+      }
+      if (!server.is_alive (e)) continue;
+      for (uint32_t f = 0; f < schema.field_count; ++f) mismatches += clients[c]->value (e, f) != server.value (e, f);
+    }
+  printf ("settled after %u ticks, %u mismatched entity fields across clients\n", settle, mismatches);
+
+  for (ReplicationClient *client : clients) delete client;
+  return 0;
+}
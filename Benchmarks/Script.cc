@@ -0,0 +1,276 @@
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+
+#include "Bench.h"
+#include "Script/ScriptAssembler.h"
+
+/* 비교 기준: 흔한 임베디드 인터프리터 구조. 태그 + 공용체 값, 스택 기반 switch 디스패치, 객체 필드는 해시 조회 */
+namespace Baseline
+{
+  struct Object;
+
+  struct BoxedValue
+  {
+    enum Type : uint8_t { Nil, Number, Boolean, Reference } type = Nil;
+    union
+    {
+      double number;
+      bool boolean;
+      Object *object;
+    };
+    BoxedValue () : number (0) {}
+  };
+
+  struct Object
+  {
+    std::unordered_map <uint32_t, BoxedValue> fields;
+  };
+
+  enum Op : uint8_t { Push, Load, Store, Add, Sub, Mul, Less, JumpIfFalse, Jump, Call, Return, GetField, SetField, NewObject };
+
+  struct Instruction
+  {
+    Op op;
+    int32_t arg;
+    double number;
+  };
+
+  struct Function
+  {
+    std::vector <Instruction> code;
+    int32_t params;
+    int32_t locals;
+  };
+
+  struct Interpreter
+  {
+    std::vector <Function> functions;
+    std::vector <BoxedValue> stack;
+    std::vector <Object *> objects;
+
+    ~Interpreter () { for (Object *object : objects) delete object; }
+
+    BoxedValue run (int32_t index, const BoxedValue *args)
+    {
+      struct Frame { const Function *function; size_t pc; size_t base; };
+      std::vector <Frame> frames;
+      stack.clear ();
+      const Function *function = &functions[index];
+      for (int32_t i = 0; i < function->locals; ++i) stack.push_back (i < function->params ? args[i] : BoxedValue ());
+      frames.push_back ({ function, 0, 0 });
+
+      auto number = [] (double value) { BoxedValue v; v.type = BoxedValue::Number; v.number = value; return v; };
+      auto pop = [&] { BoxedValue v = stack.back (); stack.pop_back (); return v; };
+
+      for (;;)
+      {
+        Frame &frame = frames.back ();
+        const Instruction &in = frame.function->code[frame.pc++];
+        switch (in.op)
+        {
+          case Push: stack.push_back (number (in.number)); break;
+          case Load: stack.push_back (stack[frame.base + in.arg]); break;
+          case Store: stack[frame.base + in.arg] = pop (); break;
+          case Add: { BoxedValue b = pop (), a = pop (); if (a.type != BoxedValue::Number || b.type != BoxedValue::Number) return {}; stack.push_back (number (a.number + b.number)); break; }
+          case Sub: { BoxedValue b = pop (), a = pop (); if (a.type != BoxedValue::Number || b.type != BoxedValue::Number) return {}; stack.push_back (number (a.number - b.number)); break; }
+          case Mul: { BoxedValue b = pop (), a = pop (); if (a.type != BoxedValue::Number || b.type != BoxedValue::Number) return {}; stack.push_back (number (a.number * b.number)); break; }
+          case Less:
+          {
+            BoxedValue b = pop (), a = pop ();
+            BoxedValue v;
+            v.type = BoxedValue::Boolean;
+            v.boolean = a.number < b.number;
+            stack.push_back (v);
+            break;
+          }
+          case JumpIfFalse: { BoxedValue v = pop (); if (v.type == BoxedValue::Nil || (v.type == BoxedValue::Boolean && !v.boolean)) frame.pc = size_t (in.arg); break; }
+          case Jump: frame.pc = size_t (in.arg); break;
+          case Call:
+          {
+            const Function *callee = &functions[in.arg];
+            const size_t base = stack.size () - size_t (callee->params);
+            for (int32_t i = callee->params; i < callee->locals; ++i) stack.push_back (BoxedValue ());
+            frames.push_back ({ callee, 0, base });
+            break;
+          }
+          case Return:
+          {
+            BoxedValue v = pop ();
+            const size_t base = frame.base;
+            frames.pop_back ();
+            if (frames.empty ()) return v;
+            stack.resize (base);
+            stack.push_back (v);
+            break;
+          }
+          case GetField: { BoxedValue o = pop (); stack.push_back (o.object->fields[uint32_t (in.arg)]); break; }
+          case SetField: { BoxedValue v = pop (), o = pop (); o.object->fields[uint32_t (in.arg)] = v; break; }
+          case NewObject:
+          {
+            BoxedValue v;
+            v.type = BoxedValue::Reference;
+            v.object = new Object;
+            objects.push_back (v.object);
+            stack.push_back (v);
+            break;
+          }
+        }
+      }
+    }
+  };
+} /* namespace Baseline */
+
+enum { FIELD_X, FIELD_VX };
+
+static constexpr double FIB_N = 25;
+static constexpr double LOOP_COUNT = 2000000;
+static constexpr uint32_t REPEAT = 5;
+static constexpr double FIB_CALLS = 242785;   /* fib (25) 의 호출 수 */
+
+int main ()
+{
+  using namespace Baseline;
+  using S = ScriptOp;
+
+  ScriptVM vm;
+
+  /* fib (n) = n < 2 ? n : fib (n - 1) + fib (n - 2) */
+  ScriptAssembler fib (1);
+  fib.load_constant (1, Value::number (2));
+  fib.binary (S::Less, 1, 0, 1);
+  const uint32_t recurse = fib.jump (S::JumpIfFalse, 1);
+  fib.ret (0);
+  fib.patch (recurse);
+  fib.add_constant (2, 0, Value::number (-1));
+  fib.call (1, 0, 1);
+  fib.add_constant (3, 0, Value::number (-2));
+  fib.call (2, 0, 1);
+  fib.binary (S::Add, 1, 1, 2);
+  fib.ret (1);
+  const uint32_t fib_index = fib.finish (vm);
+
+  /* s = 0; for (i = 0; i < n; ++i) s = s + i * 0.5 */
+  ScriptAssembler loop (1);
+  loop.load_constant (1, Value::number (0));
+  loop.load_constant (2, Value::number (0));
+  loop.load_constant (3, Value::number (0.5));
+  const uint32_t loop_top = loop.here ();
+  loop.binary (S::Less, 4, 2, 0);
+  const uint32_t loop_exit = loop.jump (S::JumpIfFalse, 4);
+  loop.binary (S::Mul, 4, 2, 3);
+  loop.binary (S::Add, 1, 1, 4);
+  loop.add_constant (2, 2, Value::number (1));
+  loop.jump_to (S::Jump, loop_top);
+  loop.patch (loop_exit);
+  loop.ret (1);
+  const uint32_t loop_index = loop.finish (vm);
+
+  /* o = { x = 0, vx = 1 }; for (i = 0; i < n; ++i) o.x = o.x + o.vx */
+  ScriptAssembler fields (1);
+  fields.new_object (1);
+  fields.load_constant (2, Value::number (0));
+  fields.set_field (1, FIELD_X, 2);
+  fields.load_constant (3, Value::number (1));
+  fields.set_field (1, FIELD_VX, 3);
+  const uint32_t fields_top = fields.here ();
+  fields.binary (S::Less, 4, 2, 0);
+  const uint32_t fields_exit = fields.jump (S::JumpIfFalse, 4);
+  fields.get_field (4, 1, FIELD_X);
+  fields.get_field (5, 1, FIELD_VX);
+  fields.binary (S::Add, 4, 4, 5);
+  fields.set_field (1, FIELD_X, 4);
+  fields.add_constant (2, 2, Value::number (1));
+  fields.jump_to (S::Jump, fields_top);
+  fields.patch (fields_exit);
+  fields.get_field (4, 1, FIELD_X);
+  fields.ret (4);
+  const uint32_t fields_index = fields.finish (vm);
+
+  if (fib_index == ~0u || loop_index == ~0u || fields_index == ~0u)
+  {
+    printf ("script verification failed\n");
+    return 1;
+  }
+
+  Interpreter baseline;
+  baseline.functions.push_back ({ { { Load, 0, 0 }, { Push, 0, 2 }, { Less, 0, 0 }, { JumpIfFalse, 6, 0 }, { Load, 0, 0 }, { Return, 0, 0 },
+                                    { Load, 0, 0 }, { Push, 0, 1 }, { Sub, 0, 0 }, { Call, 0, 0 },
+                                    { Load, 0, 0 }, { Push, 0, 2 }, { Sub, 0, 0 }, { Call, 0, 0 }, { Add, 0, 0 }, { Return, 0, 0 } }, 1, 1 });
+  /* locals: 0 n, 1 s, 2 i */
+  baseline.functions.push_back ({ { { Push, 0, 0 }, { Store, 1, 0 }, { Push, 0, 0 }, { Store, 2, 0 },
+                                    { Load, 2, 0 }, { Load, 0, 0 }, { Less, 0, 0 }, { JumpIfFalse, 19, 0 },
+                                    { Load, 1, 0 }, { Load, 2, 0 }, { Push, 0, 0.5 }, { Mul, 0, 0 }, { Add, 0, 0 }, { Store, 1, 0 },
+                                    { Load, 2, 0 }, { Push, 0, 1 }, { Add, 0, 0 }, { Store, 2, 0 }, { Jump, 4, 0 },
+                                    { Load, 1, 0 }, { Return, 0, 0 } }, 1, 3 });
+  /* locals: 0 n, 1 o, 2 i */
+  baseline.functions.push_back ({ { { NewObject, 0, 0 }, { Store, 1, 0 }, { Load, 1, 0 }, { Push, 0, 0 }, { SetField, FIELD_X, 0 },
+                                    { Load, 1, 0 }, { Push, 0, 1 }, { SetField, FIELD_VX, 0 }, { Push, 0, 0 }, { Store, 2, 0 },
+                                    { Load, 2, 0 }, { Load, 0, 0 }, { Less, 0, 0 }, { JumpIfFalse, 26, 0 },
+                                    { Load, 1, 0 }, { Load, 1, 0 }, { GetField, FIELD_X, 0 }, { Load, 1, 0 }, { GetField, FIELD_VX, 0 },
+                                    { Add, 0, 0 }, { SetField, FIELD_X, 0 },
+                                    { Load, 2, 0 }, { Push, 0, 1 }, { Add, 0, 0 }, { Store, 2, 0 }, { Jump, 10, 0 },
+                                    { Load, 1, 0 }, { GetField, FIELD_X, 0 }, { Return, 0, 0 } }, 1, 3 });
+
+  struct Case
+  {
+    const char *name;
+    uint32_t vm_index;
+    int32_t baseline_index;
+    double argument;
+    double items;
+  };
+  const Case cases[] = { { "fib", fib_index, 0, FIB_N, FIB_CALLS }, { "loop", loop_index, 1, LOOP_COUNT, LOOP_COUNT },
+                         { "fields", fields_index, 2, LOOP_COUNT, LOOP_COUNT } };
+  const char *dispatch = IKYO_SCRIPT_COMPUTED_GOTO ? "computed goto" : "switch";
+
+  /* 1. 흔한 임베디드 인터프리터 구조와 비교: 값 표현, 레지스터 창, 인라인 캐시, 디스패치를 모두 합친 차이 */
+  printf ("conventional stack interpreter vs register vm (%s dispatch), best of %u\n", dispatch, REPEAT);
+  for (const Case &c : cases)
+  {
+    char name[64];
+    Value vm_result;
+    BoxedValue baseline_result;
+    const Value vm_argument = Value::number (c.argument);
+    BoxedValue baseline_argument;
+    baseline_argument.type = BoxedValue::Number;
+    baseline_argument.number = c.argument;
+
+    snprintf (name, sizeof (name), "%s baseline", c.name);
+    const double slow = Bench::run (name, size_t (c.items), REPEAT, [&] { baseline_result = baseline.run (c.baseline_index, &baseline_argument); });
+    snprintf (name, sizeof (name), "%s register vm", c.name);
+    const double fast = Bench::run (name, size_t (c.items), REPEAT, [&]
+    {
+      vm.reset_heap ();
+      if (vm.call (c.vm_index, &vm_argument, 1, &vm_result) != ScriptStatus::Ok) vm_result = Value::nil ();
+    });
+
+    printf ("  result %.1f / %.1f, speedup %.2fx\n", vm_result.is_number () ? vm_result.as_number () : -1.0, baseline_result.number, slow / fast);
+  }
+
+  /* 2. 같은 VM, 같은 바이트코드를 switch 디스패치로 돌린 것과 비교: 차이는 디스패치 방식뿐 */
+  printf ("same bytecode, switch vs %s dispatch, best of %u\n", dispatch, REPEAT);
+  for (const Case &c : cases)
+  {
+    char name[64];
+    Value switch_result, result;
+    const Value argument = Value::number (c.argument);
+
+    snprintf (name, sizeof (name), "%s switch", c.name);
+    const double slow = Bench::run (name, size_t (c.items), REPEAT, [&]
+    {
+      vm.reset_heap ();
+      if (vm.call <false> (c.vm_index, &argument, 1, &switch_result) != ScriptStatus::Ok) switch_result = Value::nil ();
+    });
+    snprintf (name, sizeof (name), "%s %s", c.name, dispatch);
+    const double fast = Bench::run (name, size_t (c.items), REPEAT, [&]
+    {
+      vm.reset_heap ();
+      if (vm.call (c.vm_index, &argument, 1, &result) != ScriptStatus::Ok) result = Value::nil ();
+    });
+
+    printf ("  result %.1f / %.1f, speedup %.2fx\n", switch_result.is_number () ? switch_result.as_number () : -1.0,
+            result.is_number () ? result.as_number () : -1.0, slow / fast);
+  }
+  return 0;
+}
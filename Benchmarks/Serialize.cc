@@ -0,0 +1,95 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "Bench.h"
+#include "Foundation/Math/Random.h"
+#include "Foundation/Reflection/Serialize.h"
+
+static constexpr size_t COUNT = 1 << 16;
+static constexpr uint32_t REPEAT = 10;
+
+enum class Team : uint8_t { Red, Blue, Neutral };
+
+struct Transform
+{
+  float position[3];
+  float rotation[4];
+  float scale;
+};
+IKYO_REFLECT (Transform, IKYO_FIELD (position, 0), IKYO_FIELD (rotation, 0), IKYO_FIELD (scale, 0));
+
+struct Unit
+{
+  uint64_t id;
+  Transform transform;
+  int16_t health;
+  Team team;
+  bool alive;
+  bool flags[4];
+  double spawn_time;
+  uint32_t cache;                     /* 직렬화하지 않음 */
+};
+IKYO_REFLECT (Unit, IKYO_FIELD (id, 0), IKYO_FIELD (transform, 0), IKYO_FIELD (health, 0), IKYO_FIELD (team, 0), IKYO_FIELD (alive, 0),
+              IKYO_FIELD (flags, 0), IKYO_FIELD (spawn_time, 0), IKYO_FIELD (cache, Reflection::FIELD_TRANSIENT));
+
+static bool same (const Unit &a, const Unit &b)
+{
+  return a.id == b.id && !memcmp (&a.transform, &b.transform, sizeof (Transform)) && a.health == b.health && a.team == b.team &&
+         a.alive == b.alive && !memcmp (a.flags, b.flags, sizeof (a.flags)) && a.spawn_time == b.spawn_time;
+}
+
+int main ()
+{
+  constexpr size_t UNIT_BYTES = Reflection::serialized_size <Unit> ();
+  printf ("%zu units, %zu bytes each serialized (%zu in memory), best of %u\n", COUNT, UNIT_BYTES, sizeof (Unit), REPEAT);
+
+  std::vector <Unit> units (COUNT), loaded (COUNT);
+  Xoshiro256 random (5);
+  for (size_t i = 0; i < COUNT; ++i)
+  {
+    Unit &unit = units[i];
+    unit.id = random.next ();
+    for (float &p : unit.transform.position) p = random.next_float () * 1000.0f;
+    for (float &r : unit.transform.rotation) r = random.next_float ();
+    unit.transform.scale = 1.0f;
+    unit.health = int16_t (random.next_below (200)) - 50;
+    unit.team = Team (random.next_below (3));
+    unit.alive = random.next_below (2);
+    for (bool &flag : unit.flags) flag = random.next_below (2);
+    unit.spawn_time = double (random.next_float ()) * 3600.0;
+    unit.cache = uint32_t (random.next ());
+  }
+
+  std::vector <uint8_t> buffer (COUNT * UNIT_BYTES);
+  size_t written = 0;
+  Bench::run ("serialize", COUNT, REPEAT, [&]
+  {
+    Reflection::ByteWriter writer { buffer.data (), buffer.size () };
+    for (const Unit &unit : units) Reflection::serialize (unit, writer);
+    written = writer.size;
+    Bench::keep (written);
+  });
+
+  bool ok = written == buffer.size ();
+  Bench::run ("deserialize", COUNT, REPEAT, [&]
+  {
+    Reflection::ByteReader reader { buffer.data (), written };
+    for (Unit &unit : loaded) ok &= Reflection::deserialize (unit, reader);
+    Bench::keep (loaded[COUNT - 1]);
+  });
+
+  /* 읽은 값이 모두 같고, 어긋난 bool 바이트는 true 로 읽히며, 버퍼가 모자라면 실패해야 함 */
+  size_t mismatches = 0;
+  for (size_t i = 0; i < COUNT; ++i) mismatches += !same (units[i], loaded[i]);
+
+  constexpr size_t ALIVE_BYTE = sizeof (uint64_t) + Reflection::serialized_size <Transform> () + sizeof (int16_t) + sizeof (Team);
+  buffer[ALIVE_BYTE] = 0x7f;
+  Reflection::ByteReader reader { buffer.data (), UNIT_BYTES };
+  Unit first, second;
+  const bool read_first = Reflection::deserialize (first, reader);
+  const bool truncated = !Reflection::deserialize (second, reader);
+  printf ("round trip %s, %zu mismatches, odd bool byte read as %s, truncated read %s\n", ok ? "ok" : "FAILED", mismatches,
+          read_first && first.alive ? "true" : "false", truncated ? "rejected" : "ACCEPTED");
+  return 0;
+}
@@ -0,0 +1,157 @@
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "Bench.h"
+#include "Foundation/Math/Random.h"
+#include "Texture/TextureCodec.h"
+
+static constexpr uint32_t WIDTH = 2048;
+static constexpr uint32_t HEIGHT = 2048;
+static constexpr uint32_t REPEAT = 5;
+static constexpr uint32_t STRIP_ROWS = 16;
+static constexpr uint32_t ASTC_POOL = 4096;
+
+/* 부드러운 기울기, 날카로운 경계, 잡음이 섞인 RGBA 이미지 */
+static void make_image (std::vector <uint32_t> &pixels)
+{
+  Xoshiro256 random (11);
+  for (uint32_t y = 0; y < HEIGHT; ++y)
+    for (uint32_t x = 0; x < WIDTH; ++x)
+    {
+      const float u = float (x) / WIDTH, v = float (y) / HEIGHT;
+      const bool stripe = ((x / 37) + (y / 53)) & 1;
+      const uint32_t noise = random.next_u32 () & 15;
+      const uint32_t r = uint32_t (127.0f + 120.0f * sinf (u * 9.0f + v * 3.0f)) + noise / 2;
+      const uint32_t g = stripe ? uint32_t (200.0f * v) : uint32_t (60.0f + 150.0f * u * v);
+      const uint32_t b = uint32_t (255.0f * (1.0f - u)) ^ (noise & 7);
+      const uint32_t a = uint32_t (255.0f - 80.0f * fabsf (sinf (v * 6.0f)));
+      pixels[size_t (y) * WIDTH + x] = (r > 255 ? 255 : r) | (g > 255 ? 255 : g) << 8 | b << 16 | a << 24;
+    }
+}
+
+static double psnr (const std::vector <uint32_t> &a, const std::vector <uint32_t> &b, const uint32_t channels)
+{
+  double error = 0.0;
+  for (size_t i = 0; i < a.size (); ++i)
+    for (uint32_t c = 0; c < channels; ++c)
+    {
+      const double d = double ((a[i] >> (8 * c)) & 0xff) - double ((b[i] >> (8 * c)) & 0xff);
+      error += d * d;
+    }
+  error /= double (a.size ()) * channels;
+  return error > 0.0 ? 10.0 * log10 (255.0 * 255.0 / error) : 99.0;
+}
+
+int main ()
+{
+  ThreadPool pool;
+  const size_t pixel_count = size_t (WIDTH) * HEIGHT;
+  std::vector <uint32_t> image (pixel_count), decoded (pixel_count);
+  make_image (image);
+
+  printf ("%ux%u, %u cores, best of %u\n", WIDTH, HEIGHT, pool.worker_count () + 1, REPEAT);
+
+  struct Encoded
+  {
+    BlockFormat format;
+    const char *name;
+    uint32_t channels;
+  };
+  const Encoded encoders[] = { { BlockFormat::BC1, "BC1", 3 }, { BlockFormat::BC7, "BC7 (mode 6)", 4 } };
+  std::vector <uint8_t> blocks[2];
+  for (uint32_t n = 0; n < 2; ++n)
+  {
+    const Encoded &e = encoders[n];
+    blocks[n].resize (texture_compressed_size (e.format, WIDTH, HEIGHT));
+    char label[64];
+    snprintf (label, sizeof (label), "encode %s", e.name);
+    const double ns = Bench::run (label, pixel_count, REPEAT, [&] { encode_texture (pool, image.data (), WIDTH, WIDTH, HEIGHT, e.format, blocks[n].data ()); });
+    decode_texture (pool, blocks[n].data (), e.format, WIDTH, HEIGHT, decoded.data (), WIDTH);
+    printf ("  %.1f MP/s, round trip %.2f dB\n", 1e3 / ns, psnr (image, decoded, e.channels));
+  }
+
+  /* BC2~BC5 는 압축기가 없으므로 임의 블록을 풂. 해제 비용은 내용과 거의 무관 */
+  std::vector <uint8_t> noise (texture_compressed_size (BlockFormat::BC7, WIDTH, HEIGHT));
+  Xoshiro256 random (3);
+  for (uint8_t &byte : noise) byte = uint8_t (random.next_u32 ());
+
+  struct Decoded
+  {
+    BlockFormat format;
+    const char *name;
+    const uint8_t *data;
+  };
+  const Decoded decoders[] = { { BlockFormat::BC1, "BC1", blocks[0].data () }, { BlockFormat::BC2, "BC2", noise.data () },
+                               { BlockFormat::BC3, "BC3", noise.data () },     { BlockFormat::BC4, "BC4", noise.data () },
+                               { BlockFormat::BC5, "BC5", noise.data () },     { BlockFormat::BC7, "BC7 (mode 6)", blocks[1].data () },
+                               { BlockFormat::BC7, "BC7 (all modes)", noise.data () } };
+  for (const Decoded &d : decoders)
+  {
+    char label[64];
+    snprintf (label, sizeof (label), "decode %s", d.name);
+    const double ns = Bench::run (label, pixel_count, REPEAT, [&]
+    {
+      decode_texture (pool, d.data, d.format, WIDTH, HEIGHT, decoded.data (), WIDTH);
+      Bench::keep (decoded[0]);
+    });
+    printf ("  %.1f MP/s\n", 1e3 / ns);
+  }
+
+  /* HDR: BC6H 도 임의 블록 (예약된 모드는 검정) */
+  std::vector <uint64_t> hdr (pixel_count);
+  const Decoded hdr_decoders[] = { { BlockFormat::BC6H_UF16, "BC6H UF16", noise.data () }, { BlockFormat::BC6H_SF16, "BC6H SF16", noise.data () } };
+  for (const Decoded &d : hdr_decoders)
+  {
+    char label[64];
+    snprintf (label, sizeof (label), "decode %s", d.name);
+    const double ns = Bench::run (label, pixel_count, REPEAT, [&]
+    {
+      decode_texture_hdr (pool, d.data, d.format, WIDTH, HEIGHT, hdr.data (), WIDTH);
+      Bench::keep (hdr[0]);
+    });
+    printf ("  %.1f MP/s\n", 1e3 / ns);
+  }
+
+  /* ASTC 도 압축기가 없으나 임의 비트는 대부분 잘못된 블록이라, 오류 색이 아닌 블록만 골라 ASTC_POOL 개를 깔아 씀 */
+  const BlockFormat astc_formats[] = { BlockFormat::ASTC_4x4, BlockFormat::ASTC_6x6, BlockFormat::ASTC_8x8, BlockFormat::ASTC_12x12 };
+  for (const BlockFormat format : astc_formats)
+  {
+    std::vector <uint8_t> pool_blocks (ASTC_POOL * 16), astc (texture_compressed_size (format, WIDTH, HEIGHT));
+    uint32_t texels[144];
+    const uint32_t texel_count = block_width (format) * block_height (format);
+    for (uint32_t n = 0; n < ASTC_POOL;)
+    {
+      uint8_t *block = &pool_blocks[n * 16];
+      for (uint32_t i = 0; i < 16; ++i) block[i] = uint8_t (random.next_u32 ());
+      decode_block (format, block, texels, block_width (format));
+      bool valid = false;
+      for (uint32_t i = 0; i < texel_count; ++i) valid |= texels[i] != ASTC_ERROR_COLOR;
+      n += valid;
+    }
+    for (size_t i = 0; i < astc.size (); i += 16) memcpy (&astc[i], &pool_blocks[(i / 16) % ASTC_POOL * 16], 16);
+
+    char label[64];
+    snprintf (label, sizeof (label), "decode ASTC %ux%u", block_width (format), block_height (format));
+    const double ns = Bench::run (label, pixel_count, REPEAT, [&]
+    {
+      decode_texture (pool, astc.data (), format, WIDTH, HEIGHT, decoded.data (), WIDTH);
+      Bench::keep (decoded[0]);
+    });
+    printf ("  %.1f MP/s, %.2f bits per pixel\n", 1e3 / ns, 128.0 / texel_count);
+  }
+
+  /* 스트리밍: 블록 STRIP_ROWS 행짜리 버퍼 하나를 되풀이해 쓰며 위에서부터 조각조각 풂 */
+  std::vector <uint32_t> strip (size_t (WIDTH) * STRIP_ROWS * 4);
+  const double ns = Bench::run ("decode BC7 into streaming strip", pixel_count, REPEAT, [&]
+  {
+    for (uint32_t row = 0; row < texture_block_rows (BlockFormat::BC7, HEIGHT); row += STRIP_ROWS)
+    {
+      decode_texture (pool, blocks[1].data (), BlockFormat::BC7, WIDTH, HEIGHT, strip.data (), WIDTH, row, STRIP_ROWS);
+      Bench::keep (strip[0]);
+    }
+  });
+  printf ("  %.1f MP/s\n", 1e3 / ns);
+  return 0;
+}
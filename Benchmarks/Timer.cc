@@ -0,0 +1,85 @@
+#include <cstdio>
+#include <vector>
+
+#include "Bench.h"
+#include "Foundation/Math/Random.h"
+#include "Foundation/Time/TimerWheel.h"
+
+static constexpr uint32_t TIMERS = 1 << 18;
+static constexpr uint64_t SPAN = 1 << 16;
+static constexpr uint32_t REPEAT = 5;
+
+static uint64_t fired_count = 0;
+
+static void count_fire (void *) { ++fired_count; }
+
+/* 같은 슬롯의 이웃을 취소한 뒤 자기 자신도 취소하는 콜백 */
+struct Sibling
+{
+  TimerWheel *wheel;
+  TimerHandle self;
+  TimerHandle sibling;
+  uint32_t fired;
+};
+
+static void cancel_sibling_then_self (void *arg)
+{
+  auto *timer = static_cast <Sibling *> (arg);
+  ++timer->fired;
+  timer->wheel->cancel (timer->sibling);
+  timer->wheel->cancel (timer->self);
+}
+
+/* 주기 타이머가 세 번째 만료에서 자기 자신을 취소 */
+static void cancel_self_on_third (void *arg)
+{
+  auto *timer = static_cast <Sibling *> (arg);
+  if (++timer->fired == 3) timer->wheel->cancel (timer->self);
+}
+
+int main ()
+{
+  TimerWheel wheel (TIMERS * 2);
+  Xoshiro256 random (3);
+  std::vector <uint64_t> delays (TIMERS);
+  std::vector <TimerHandle> handles (TIMERS);
+  for (uint64_t &delay : delays) delay = 1 + random.next_below (SPAN);
+
+  printf ("%u timers, delays up to %llu ticks, best of %u\n", TIMERS, (unsigned long long) SPAN, REPEAT);
+
+  Bench::run ("schedule + cancel", TIMERS, REPEAT, [&]
+  {
+    for (uint32_t i = 0; i < TIMERS; ++i) handles[i] = wheel.schedule (delays[i], count_fire, nullptr);
+    for (uint32_t i = 0; i < TIMERS; ++i) wheel.cancel (handles[i]);
+  });
+  Bench::run ("schedule + advance to expiry", TIMERS, REPEAT, [&]
+  {
+    for (uint32_t i = 0; i < TIMERS; ++i) wheel.schedule (delays[i], count_fire, nullptr);
+    wheel.advance (SPAN + 1);
+  });
+  Bench::keep (fired_count);
+
+  /* 콜백 안에서 이웃과 자기 자신을 취소해도 목록이 깨지거나 해제된 노드를 건드리지 않아야 함 */
+  std::vector <Sibling> pairs (TIMERS);
+  for (uint32_t i = 0; i < TIMERS; i += 2)
+  {
+    const uint64_t delay = delays[i];
+    pairs[i] = { &wheel, wheel.schedule (delay, cancel_sibling_then_self, &pairs[i]), {}, 0 };
+    pairs[i + 1] = { &wheel, wheel.schedule (delay, cancel_sibling_then_self, &pairs[i + 1]), {}, 0 };
+    pairs[i].sibling = pairs[i + 1].self;
+    pairs[i + 1].sibling = pairs[i].self;
+  }
+  Sibling periodic = { &wheel, {}, {}, 0 };
+  periodic.self = wheel.schedule (5, cancel_self_on_third, &periodic, 7);
+
+  wheel.advance (SPAN + 64);
+  uint32_t first_fired = 0, both_fired = 0;
+  for (uint32_t i = 0; i < TIMERS; i += 2)
+  {
+    first_fired += pairs[i].fired + pairs[i + 1].fired == 1;
+    both_fired += pairs[i].fired && pairs[i + 1].fired;
+  }
+  printf ("self-cancel: %u of %u pairs fired once, %u fired twice, periodic fired %u (3), %zu timers left (0)\n",
+          first_fired, TIMERS / 2, both_fired, periodic.fired, wheel.size ());
+  return 0;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include "AI/BehaviorTree.h"
+#include "AI/Blackboard.h"
+#include "Foundation/Thread/ParallelFor.h"
+#include "Foundation/Thread/ThreadLocal.h"
+#include "Foundation/Thread/ThreadPool.h"
+
+/* 트리 하나를 공유하는 에이전트들의 시분할 평가. 프레임마다 budget 명만 라운드 로빈으로 골라 청크 단위로 워커에 나눔.
+   에이전트마다 마지막 평가 시각을 기억해 두고 elapsed_key 열에 그동안 흐른 시간을 넣어 줌 */
+class BehaviorScheduler
+{
+public:
+  static constexpr uint32_t MAX_CHUNK = 1024;
+  static constexpr uint32_t NO_KEY = ~0u;
+
+  BehaviorScheduler (uint32_t max_agents, uint32_t chunk_size = 256, uint32_t elapsed_key = NO_KEY);
+  ~BehaviorScheduler ();
+
+  BehaviorScheduler (const BehaviorScheduler &) = delete;
+  BehaviorScheduler &operator= (const BehaviorScheduler &) = delete;
+
+  /* 에이전트 [0, agent_count) 중 최대 budget 명을 평가하고 평가한 수를 반환.
+     부르는 스레드도 청크를 맡아 스레드별 스크래치를 씀 */
+  uint32_t tick (ThreadPool &pool, const BehaviorTree &tree, Blackboard &blackboard, uint32_t agent_count, uint32_t budget, float now);
+
+  /* 마지막 평가 결과. 한 번도 평가되지 않았으면 Running */
+  BehaviorStatus status (uint32_t agent) const { return results[agent]; }
+
+private:
+  BehaviorScratch &local ();
+
+  uint32_t max_agents;
+  uint32_t chunk_size;
+  uint32_t elapsed_key;
+  uint32_t cursor = 0;
+  float *last_time;
+  BehaviorStatus *results;
+  BehaviorScratch *scratches[ThreadLocal::MAX_THREADS] = {};
+};
+
+/* ============ 구현 ============ */
+inline BehaviorScheduler::BehaviorScheduler (const uint32_t max_agents, const uint32_t chunk_size, const uint32_t elapsed_key)
+  : max_agents (max_agents), chunk_size (chunk_size < 1 ? 1 : chunk_size > MAX_CHUNK ? MAX_CHUNK : chunk_size), elapsed_key (elapsed_key)
+{
+  last_time = static_cast <float *> (malloc (sizeof (float) * max_agents + 1));
+  results = static_cast <BehaviorStatus *> (malloc (sizeof (BehaviorStatus) * max_agents + 1));
+  if (!last_time || !results) abort ();
+
+  for (uint32_t i = 0; i < max_agents; ++i)
+  {
+    last_time[i] = -1.0f;
+    results[i] = BehaviorStatus::Running;
+  }
+}
+
+inline BehaviorScheduler::~BehaviorScheduler ()
+{
+  for (BehaviorScratch *scratch : scratches) delete scratch;
+  free (last_time);
+  free (results);
+}
+
+inline BehaviorScratch &BehaviorScheduler::local ()
+{
+  BehaviorScratch *&scratch = scratches[ThreadLocal::index ()];
+  if (!scratch) scratch = new BehaviorScratch (chunk_size);
+  return *scratch;
+}
+
+inline uint32_t BehaviorScheduler::tick (ThreadPool &pool, const BehaviorTree &tree, Blackboard &blackboard, const uint32_t agent_count,
+                                         const uint32_t budget, const float now)
+{
+  if (agent_count > max_agents || agent_count > blackboard.capacity ()) abort ();
+  if (!agent_count) return 0;
+
+  const uint32_t count = budget < agent_count ? budget : agent_count;
+  const uint32_t start = cursor % agent_count;
+
+  parallel_for (pool, count, chunk_size, [&] (const size_t begin, const size_t end)
+  {
+    uint32_t agents[MAX_CHUNK];
+    BehaviorStatus status[MAX_CHUNK];
+    const uint32_t n = uint32_t (end - begin);
+
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      const uint32_t agent = (start + uint32_t (begin) + i) % agent_count;
+      agents[i] = agent;
+      if (elapsed_key != NO_KEY) blackboard.floats (elapsed_key)[agent] = last_time[agent] < 0.0f ? 0.0f : now - last_time[agent];
+      last_time[agent] = now;
+    }
+
+    tree.evaluate (blackboard, local (), agents, n, status);
+    for (uint32_t i = 0; i < n; ++i) results[agents[i]] = status[i];
+  });
+
+  cursor = (start + count) % agent_count;
+  return count;
+}
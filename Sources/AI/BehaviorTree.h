@@ -0,0 +1,291 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include "AI/Blackboard.h"
+#include "Foundation/Heap/VirtualArray.h"
+
+enum class BehaviorStatus : uint8_t
+{
+  Success,
+  Failure,
+  Running,
+};
+
+enum class BehaviorOp : uint8_t
+{
+  Sequence,         /* 자식을 차례로. 하나라도 성공이 아니면 그 결과로 멈춤 */
+  Selector,         /* 자식을 차례로. 하나라도 실패가 아니면 그 결과로 멈춤 */
+  Utility,          /* 자식 (Consider) 점수가 가장 높은 하나만 실행 */
+  Consider,         /* 점수 = clamp (a * floats(key) + b, 0, 1). 자식 하나를 그대로 실행 */
+  Inverter,
+  Condition,        /* floats(key) 와 a 비교 */
+  Action,
+};
+
+enum class BehaviorCompare : uint8_t
+{
+  Less,
+  LessEqual,
+  Greater,
+  GreaterEqual,
+};
+
+/* 평탄화된 트리 노드. 자식은 바로 뒤에 이어지고 size 만큼 건너뛰면 다음 형제 */
+struct BehaviorNode
+{
+  BehaviorOp op;
+  BehaviorCompare compare;
+  uint16_t key;      /* Action 이면 동작 번호 */
+  uint32_t size;     /* 자기 자신을 포함한 서브트리 노드 수 */
+  float a;
+  float b;
+};
+
+/* 동작은 같은 노드에 도달한 에이전트 묶음 단위로 호출됨. status[i] 는 agents[i] 의 결과 */
+using BehaviorAction = void (*) (void *context, Blackboard &blackboard, const uint32_t *agents, uint32_t count, BehaviorStatus *status);
+
+/* 평가 중 composite 노드가 쓰는 임시 목록. 스택처럼 쓰고 돌려놓음. 스레드마다 하나 */
+class BehaviorScratch
+{
+public:
+  static constexpr uint32_t MAX_DEPTH = 32;
+
+  explicit BehaviorScratch (uint32_t max_batch)
+    : words (size_t (max_batch) * 3 * MAX_DEPTH + 64), statuses (size_t (max_batch) * MAX_DEPTH + 64)
+  {
+  }
+
+  VirtualArray <uint32_t> words;
+  VirtualArray <BehaviorStatus> statuses;
+};
+
+class BehaviorTree
+{
+public:
+  static constexpr uint32_t MAX_ACTIONS = 256;
+
+  BehaviorTree () : nodes (65536) {}
+
+  BehaviorTree (const BehaviorTree &) = delete;
+  BehaviorTree &operator= (const BehaviorTree &) = delete;
+
+  /* 빌더. composite 는 begin_* 와 end 로 감쌈. 깊이는 BehaviorScratch::MAX_DEPTH 까지 */
+  void begin_sequence () { open (BehaviorOp::Sequence, 0, 0, 0); }
+  void begin_selector () { open (BehaviorOp::Selector, 0, 0, 0); }
+  void begin_utility () { open (BehaviorOp::Utility, 0, 0, 0); }
+  void begin_consider (uint16_t key, float scale, float bias) { open (BehaviorOp::Consider, key, scale, bias); }
+  void begin_inverter () { open (BehaviorOp::Inverter, 0, 0, 0); }
+  void end ();
+
+  void condition (uint16_t key, BehaviorCompare compare, float value);
+  void action (BehaviorAction func, void *context);
+
+  /* agents 전부를 루트부터 평가. 반응형 트리라 매번 루트에서 시작하며 Running 은 결과로만 전달됨 */
+  void evaluate (Blackboard &blackboard, BehaviorScratch &scratch, const uint32_t *agents, uint32_t count, BehaviorStatus *status) const;
+
+  const BehaviorNode *data () const { return nodes.data (); }
+  uint32_t node_count () const { return uint32_t (nodes.size ()); }
+
+private:
+  void open (BehaviorOp op, uint16_t key, float a, float b);
+  void run (uint32_t node, Blackboard &blackboard, BehaviorScratch &scratch, const uint32_t *agents, uint32_t count, BehaviorStatus *status) const;
+
+  struct ActionSlot
+  {
+    BehaviorAction func;
+    void *context;
+  };
+
+  VirtualArray <BehaviorNode> nodes;
+  ActionSlot actions[MAX_ACTIONS];
+  uint32_t action_count = 0;
+  uint32_t stack[BehaviorScratch::MAX_DEPTH];
+  uint32_t depth = 0;
+};
+
+/* ============ 구현 ============ */
+inline void BehaviorTree::open (const BehaviorOp op, const uint16_t key, const float a, const float b)
+{
+  if (depth == BehaviorScratch::MAX_DEPTH) abort ();
+  stack[depth++] = uint32_t (nodes.size ());
+  nodes.push_back ({ op, BehaviorCompare::Less, key, 1, a, b });
+}
+
+inline void BehaviorTree::end ()
+{
+  if (!depth) abort ();
+  const uint32_t index = stack[--depth];
+  BehaviorNode &node = nodes[index];
+  node.size = uint32_t (nodes.size ()) - index;
+  /* 장식 노드는 자식이 정확히 하나 */
+  if ((node.op == BehaviorOp::Consider || node.op == BehaviorOp::Inverter) && node.size != 1 + nodes[index + 1].size) abort ();
+}
+
+inline void BehaviorTree::condition (const uint16_t key, const BehaviorCompare compare, const float value)
+{
+  nodes.push_back ({ BehaviorOp::Condition, compare, key, 1, value, 0 });
+}
+
+inline void BehaviorTree::action (const BehaviorAction func, void *context)
+{
+  if (action_count == MAX_ACTIONS) abort ();
+  actions[action_count] = { func, context };
+  nodes.push_back ({ BehaviorOp::Action, BehaviorCompare::Less, uint16_t (action_count++), 1, 0, 0 });
+}
+
+inline void BehaviorTree::evaluate (Blackboard &blackboard, BehaviorScratch &scratch, const uint32_t *agents, const uint32_t count,
+                                    BehaviorStatus *status) const
+{
+  if (depth) abort ();
+  if (!count) return;
+  if (!nodes.size ())
+  {
+    for (uint32_t i = 0; i < count; ++i) status[i] = BehaviorStatus::Failure;
+    return;
+  }
+  run (0, blackboard, scratch, agents, count, status);
+}
+
+/* 노드 하나를 에이전트 묶음에 대해 실행. composite 는 결과가 아직 안 정해진 에이전트만 모아 다음 자식으로 넘기므로
+   각 노드는 자기에게 도달한 에이전트 목록만 훑음 */
+inline void BehaviorTree::run (const uint32_t index, Blackboard &blackboard, BehaviorScratch &scratch, const uint32_t *agents, const uint32_t count,
+                               BehaviorStatus *status) const
+{
+  const BehaviorNode &node = nodes[index];
+  switch (node.op)
+  {
+    case BehaviorOp::Condition:
+    {
+      const float *column = blackboard.floats (node.key);
+      const float value = node.a;
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        const float x = column[agents[i]];
+        bool pass;
+        switch (node.compare)
+        {
+          case BehaviorCompare::Less: pass = x < value; break;
+          case BehaviorCompare::LessEqual: pass = x <= value; break;
+          case BehaviorCompare::Greater: pass = x > value; break;
+          default: pass = x >= value; break;
+        }
+        status[i] = pass ? BehaviorStatus::Success : BehaviorStatus::Failure;
+      }
+      return;
+    }
+
+    case BehaviorOp::Action:
+    {
+      const ActionSlot &slot = actions[node.key];
+      slot.func (slot.context, blackboard, agents, count, status);
+      return;
+    }
+
+    case BehaviorOp::Consider:
+      run (index + 1, blackboard, scratch, agents, count, status);
+      return;
+
+    case BehaviorOp::Inverter:
+      run (index + 1, blackboard, scratch, agents, count, status);
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        if (status[i] == BehaviorStatus::Success) status[i] = BehaviorStatus::Failure;
+        else if (status[i] == BehaviorStatus::Failure) status[i] = BehaviorStatus::Success;
+      }
+      return;
+
+    default:
+      break;
+  }
+
+  /* composite 용 임시 목록: 남은 에이전트, 그 에이전트의 출력 위치, 자식 결과 */
+  const size_t word_mark = scratch.words.size ();
+  const size_t status_mark = scratch.statuses.size ();
+  scratch.words.resize (word_mark + size_t (count) * 3);
+  scratch.statuses.resize (status_mark + count);
+  uint32_t *pending = scratch.words.data () + word_mark;
+  uint32_t *slots = pending + count;
+  uint32_t *choice = slots + count;
+  BehaviorStatus *child_status = scratch.statuses.data () + status_mark;
+  const uint32_t end = index + node.size;
+
+  if (node.op == BehaviorOp::Utility)
+  {
+    /* 에이전트마다 점수가 가장 높은 자식을 고른 뒤 같은 자식을 고른 에이전트끼리 묶어 실행.
+       점수는 [0, 1] 이라 비트 패턴을 정수로 비교해도 순서가 같음 */
+    uint32_t *best = slots;
+    for (uint32_t i = 0; i < count; ++i) choice[i] = 0;
+    for (uint32_t child = index + 1; child < end; child += nodes[child].size)
+    {
+      const BehaviorNode &consider = nodes[child];
+      if (consider.op != BehaviorOp::Consider) continue;
+      const float *column = blackboard.floats (consider.key);
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        float score = consider.a * column[agents[i]] + consider.b;
+        score = score < 0.0f ? 0.0f : score > 1.0f ? 1.0f : score;
+        const uint32_t bits = std::bit_cast <uint32_t> (score);
+        if (!choice[i] || bits > best[i])
+        {
+          best[i] = bits;
+          choice[i] = child;
+        }
+      }
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+      if (!choice[i]) status[i] = BehaviorStatus::Failure;
+
+    for (uint32_t child = index + 1; child < end; child += nodes[child].size)
+    {
+      uint32_t group = 0;
+      for (uint32_t i = 0; i < count; ++i)
+        if (choice[i] == child)
+        {
+          pending[group] = agents[i];
+          slots[group++] = i;
+        }
+      if (!group) continue;
+      run (child, blackboard, scratch, pending, group, child_status);
+      for (uint32_t i = 0; i < group; ++i) status[slots[i]] = child_status[i];
+    }
+  }
+  else
+  {
+    const BehaviorStatus proceed = node.op == BehaviorOp::Sequence ? BehaviorStatus::Success : BehaviorStatus::Failure;
+    uint32_t remaining = count;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      pending[i] = agents[i];
+      slots[i] = i;
+    }
+
+    for (uint32_t child = index + 1; child < end && remaining; child += nodes[child].size)
+    {
+      run (child, blackboard, scratch, pending, remaining, child_status);
+      const bool last = child + nodes[child].size == end;
+
+      uint32_t kept = 0;
+      for (uint32_t i = 0; i < remaining; ++i)
+      {
+        if (child_status[i] == proceed && !last)
+        {
+          pending[kept] = pending[i];
+          slots[kept++] = slots[i];
+        }
+        else status[slots[i]] = child_status[i];
+      }
+      remaining = kept;
+    }
+
+    /* 자식이 없는 composite */
+    for (uint32_t i = 0; i < remaining; ++i) status[slots[i]] = proceed;
+  }
+
+  scratch.words.resize (word_mark);
+  scratch.statuses.resize (status_mark);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+/* 에이전트별 AI 상태를 키마다 열 하나로 저장 (SoA). 같은 조건을 여러 에이전트에 대해 검사할 때 한 열만 훑음.
+   키는 0 부터 시작하는 정수로, 이름과의 대응은 호출자가 관리 */
+class Blackboard
+{
+public:
+  Blackboard (uint32_t capacity, uint32_t float_keys, uint32_t int_keys);
+  ~Blackboard ();
+
+  Blackboard (const Blackboard &) = delete;
+  Blackboard &operator= (const Blackboard &) = delete;
+
+  float *floats (uint32_t key) const { return float_data + size_t (key) * stride; }
+  int32_t *ints (uint32_t key) const { return int_data + size_t (key) * stride; }
+
+  uint32_t capacity () const { return agent_capacity; }
+  uint32_t float_key_count () const { return float_keys; }
+  uint32_t int_key_count () const { return int_keys; }
+
+private:
+  uint32_t agent_capacity;
+  uint32_t float_keys;
+  uint32_t int_keys;
+  size_t stride;    /* 열 사이 간격. 16 개 단위로 올려 열마다 캐시 라인에서 시작 */
+  float *float_data;
+  int32_t *int_data;
+};
+
+/* ============ 구현 ============ */
+inline Blackboard::Blackboard (const uint32_t capacity, const uint32_t float_keys, const uint32_t int_keys)
+  : agent_capacity (capacity), float_keys (float_keys), int_keys (int_keys), stride ((size_t (capacity) + 15) & ~size_t (15))
+{
+  float_data = static_cast <float *> (aligned_alloc (64, sizeof (float) * stride * float_keys + 64));
+  int_data = static_cast <int32_t *> (aligned_alloc (64, sizeof (int32_t) * stride * int_keys + 64));
+  if (!float_data || !int_data) abort ();
+
+  memset (float_data, 0, sizeof (float) * stride * float_keys);
+  memset (int_data, 0, sizeof (int32_t) * stride * int_keys);
+}
+
+inline Blackboard::~Blackboard ()
+{
+  free (float_data);
+  free (int_data);
+}
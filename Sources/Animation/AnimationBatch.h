@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Animation/AnimationClip.h"
+#include "Animation/Pose.h"
+#include "Animation/Skeleton.h"
+#include "Foundation/Thread/ParallelFor.h"
+#include "Foundation/Thread/ThreadLocal.h"
+#include "Foundation/Thread/ThreadPool.h"
+
+inline constexpr uint32_t MAX_ANIMATION_LAYERS = 4;
+
+struct AnimationLayer
+{
+  const AnimationClip *clip;
+  float time;
+  float weight;
+};
+
+/* 캐릭터 하나의 입력과 출력. local 과 model 은 호출자가 스켈레톤 관절 수만큼 준비 */
+struct AnimationInstance
+{
+  AnimationLayer layers[MAX_ANIMATION_LAYERS];
+  uint32_t layer_count;
+  Pose *local;
+  Matrix34 *model;
+};
+
+/* 레이어 샘플링 -> 블렌딩 -> 모델 공간 변환을 캐릭터마다 수행. 캐릭터끼리는 독립이므로 풀에서는 캐릭터 단위로 나눔.
+   레이어 임시 포즈는 스레드별 슬롯에 두므로 부르는 스레드는 ThreadLocal 에 붙어 있어야 함 */
+void animate (const Skeleton &skeleton, AnimationInstance *instances, size_t count);
+void animate (ThreadPool &pool, const Skeleton &skeleton, AnimationInstance *instances, size_t count, size_t chunk_size = 4);
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  /* 스레드마다 레이어 임시 포즈를 두고 프레임을 넘어 재사용. sample 이 포즈 전체를 상수 트랙으로 덮어쓴 뒤
+     채우므로 프레임마다 따로 지울 필요 없음. 관절 수가 다른 스켈레톤을 만났을 때만 다시 만듦 */
+  struct AnimationScratch
+  {
+    Pose *poses[MAX_ANIMATION_LAYERS] = {};
+
+    AnimationScratch () = default;
+    ~AnimationScratch ()
+    {
+      for (Pose *pose : poses) delete pose;
+    }
+
+    AnimationScratch (const AnimationScratch &) = delete;
+    AnimationScratch &operator= (const AnimationScratch &) = delete;
+
+    Pose &get (const uint32_t index, const uint32_t joint_count)
+    {
+      Pose *&pose = poses[index];
+      if (!pose || pose->joint_count () != joint_count)
+      {
+        delete pose;
+        pose = new Pose (joint_count);
+      }
+      return *pose;
+    }
+  };
+
+  inline const ThreadLocal::Slot animation_scratch_slot = ThreadLocal::register_slot <AnimationScratch> ();
+
+  inline void animate_range (const Skeleton &skeleton, AnimationInstance *instances, const size_t begin, const size_t end)
+  {
+    AnimationScratch &scratch = *ThreadLocal::get <AnimationScratch> (animation_scratch_slot);
+    const uint32_t joint_count = skeleton.joint_count ();
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      AnimationInstance &instance = instances[i];
+      if (!instance.layer_count) continue;
+
+      if (instance.layer_count == 1) instance.layers[0].clip->sample (instance.layers[0].time, *instance.local);
+      else
+      {
+        const Pose *poses[MAX_ANIMATION_LAYERS];
+        float weights[MAX_ANIMATION_LAYERS];
+        float total = 0.0f;
+        for (uint32_t l = 0; l < instance.layer_count; ++l) total += instance.layers[l].weight;
+        for (uint32_t l = 0; l < instance.layer_count; ++l)
+        {
+          Pose &pose = scratch.get (l, joint_count);
+          instance.layers[l].clip->sample (instance.layers[l].time, pose);
+          poses[l] = &pose;
+          weights[l] = total > 0.0f ? instance.layers[l].weight / total : 1.0f / float (instance.layer_count);
+        }
+        blend_poses (poses, weights, instance.layer_count, *instance.local);
+      }
+
+      local_to_model (skeleton, *instance.local, instance.model);
+    }
+  }
+}
+
+inline void animate (const Skeleton &skeleton, AnimationInstance *instances, const size_t count)
+{
+  Detail::animate_range (skeleton, instances, 0, count);
+}
+
+inline void animate (ThreadPool &pool, const Skeleton &skeleton, AnimationInstance *instances, const size_t count, const size_t chunk_size)
+{
+  parallel_for (pool, count, chunk_size, [&] (const size_t begin, const size_t end)
+  {
+    Detail::animate_range (skeleton, instances, begin, end);
+  });
+}
@@ -0,0 +1,394 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "Animation/Pose.h"
+#include "Animation/Skeleton.h"
+#include "Foundation/Math/Simd.h"
+
+/* 트랙별 허용 오차. 모든 프레임이 첫 프레임과 허용 오차 이내면 상수 트랙으로 저장 */
+struct AnimationClipSettings
+{
+  float rotation_tolerance = 0.0005f;     /* 쿼터니언 성분 차이 */
+  float translation_tolerance = 0.0001f;
+  float scale_tolerance = 0.0001f;
+  const float *joint_tolerance = nullptr; /* 관절별 배율. 말단 관절일수록 크게 줄 수 있음 */
+};
+
+/* 균일 샘플링된 키프레임 클립.
+   회전은 가장 큰 성분을 뺀 세 성분을 16비트로 양자화 (smallest three), 이동/스케일은 트랙별 범위로 16비트 양자화.
+   움직이는 트랙만 프레임마다 저장하고 상수 트랙은 기본 포즈에 한 번만 저장 */
+class AnimationClip
+{
+public:
+  /* keys[frame * joint_count + joint]. 프레임이 하나도 없거나 frame_rate 가 양수가 아니면 중단 */
+  AnimationClip (const Transform *keys, uint32_t frame_count, uint32_t joint_count, float frame_rate,
+                 const AnimationClipSettings &settings = {});
+  ~AnimationClip ();
+
+  AnimationClip (const AnimationClip &) = delete;
+  AnimationClip &operator= (const AnimationClip &) = delete;
+
+  /* time 은 [0, duration] 으로 잘림 */
+  void sample (float time, Pose &out) const;
+
+  float duration () const { return float (frames - 1) / rate; }
+  uint32_t joint_count () const { return joints; }
+  uint32_t frame_count () const { return frames; }
+
+  /* 원본 대비 측정된 최대 오차 */
+  float rotation_error (uint32_t joint) const { return errors[joint * 3]; }
+  float translation_error (uint32_t joint) const { return errors[joint * 3 + 1]; }
+  float scale_error (uint32_t joint) const { return errors[joint * 3 + 2]; }
+
+  uint32_t animated_track_count () const { return rotations.count + translations.count + scales.count; }
+  size_t compressed_size () const;
+
+private:
+  struct RotationTracks
+  {
+    uint32_t count = 0;
+    uint32_t padded = 0;
+    uint16_t *joints = nullptr;
+    uint16_t *values[3] = {};  /* [frame * padded + track] */
+    uint8_t *largest = nullptr;
+  };
+
+  struct VectorTracks
+  {
+    uint32_t count = 0;
+    uint32_t padded = 0;
+    uint16_t *joints = nullptr;
+    float *minimum[3] = {};
+    float *extent[3] = {};
+    uint16_t *values[3] = {};
+  };
+
+  void build_rotations (const Transform *keys, const AnimationClipSettings &settings);
+  void build_vectors (const Transform *keys, const AnimationClipSettings &settings, bool scale);
+  void sample_rotations (uint32_t f0, uint32_t f1, float alpha, Pose &out) const;
+  void sample_vectors (const VectorTracks &tracks, uint32_t f0, uint32_t f1, float alpha, float *const *out) const;
+
+  uint32_t frames;
+  uint32_t joints;
+  float rate;
+  Pose constant;
+  float *errors;
+  RotationTracks rotations;
+  VectorTracks translations;
+  VectorTracks scales;
+};
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  inline constexpr float QUATERNION_RANGE = 0.70710678f;
+
+  inline uint16_t quantize_unit (const float value)
+  {
+    const float clamped = value < 0.0f ? 0.0f : value > 1.0f ? 1.0f : value;
+    return uint16_t (clamped * 65535.0f + 0.5f);
+  }
+
+  /* 가장 큰 성분이 양수가 되도록 부호를 맞춘 뒤 나머지 세 성분을 양자화 */
+  inline void encode_quaternion (const float *q, uint16_t *values, uint8_t *largest)
+  {
+    uint8_t index = 0;
+    for (uint8_t c = 1; c < 4; ++c)
+      if (fabsf (q[c]) > fabsf (q[index])) index = c;
+
+    const float sign = q[index] < 0.0f ? -1.0f : 1.0f;
+    for (int c = 0, o = 0; c < 4; ++c)
+      if (c != index) values[o++] = quantize_unit ((q[c] * sign / QUATERNION_RANGE) * 0.5f + 0.5f);
+    *largest = index;
+  }
+
+  inline void decode_quaternion (const uint16_t *values, const uint8_t largest, float *q)
+  {
+    float sum = 0.0f;
+    for (int c = 0, o = 0; c < 4; ++c)
+    {
+      if (c == largest) continue;
+      q[c] = (float (values[o++]) / 65535.0f * 2.0f - 1.0f) * QUATERNION_RANGE;
+      sum += q[c] * q[c];
+    }
+    q[largest] = sqrtf (fmaxf (1.0f - sum, 0.0f));
+  }
+
+  inline float quaternion_distance (const float *a, const float *b)
+  {
+    const float sign = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3] < 0.0f ? -1.0f : 1.0f;
+    float error = 0.0f;
+    for (int c = 0; c < 4; ++c) error = fmaxf (error, fabsf (a[c] - b[c] * sign));
+    return error;
+  }
+
+  inline SimdFloat load_u16 (const uint16_t *values, const float scale)
+  {
+    float lanes[SIMD_WIDTH];
+    for (size_t l = 0; l < SIMD_WIDTH; ++l) lanes[l] = float (values[l]) * scale;
+    return Simd::load (lanes);
+  }
+
+  inline uint32_t padded_tracks (const uint32_t count)
+  {
+    return uint32_t ((count + SIMD_WIDTH - 1) & ~(SIMD_WIDTH - 1));
+  }
+
+  template <typename T>
+  inline T *allocate_array (const size_t count)
+  {
+    T *array = static_cast <T *> (calloc (count ? count : 1, sizeof (T)));
+    if (!array) abort ();
+    return array;
+  }
+}
+
+inline AnimationClip::AnimationClip (const Transform *keys, const uint32_t frame_count, const uint32_t joint_count, const float frame_rate,
+                                     const AnimationClipSettings &settings)
+  : frames (frame_count), joints (joint_count), rate (frame_rate), constant (joint_count)
+{
+  if (!frame_count || !(frame_rate > 0.0f)) abort ();
+
+  errors = Detail::allocate_array <float> (size_t (joint_count) * 3);
+  for (uint32_t j = 0; j < joint_count; ++j) constant.set (j, keys[j]);
+
+  build_rotations (keys, settings);
+  build_vectors (keys, settings, false);
+  build_vectors (keys, settings, true);
+}
+
+inline AnimationClip::~AnimationClip ()
+{
+  free (errors);
+  free (rotations.joints);
+  free (rotations.largest);
+  for (uint16_t *values : rotations.values) free (values);
+  VectorTracks *vector_tracks[2] = { &translations, &scales };
+  for (VectorTracks *tracks : vector_tracks)
+  {
+    free (tracks->joints);
+    for (int c = 0; c < 3; ++c)
+    {
+      free (tracks->minimum[c]);
+      free (tracks->extent[c]);
+      free (tracks->values[c]);
+    }
+  }
+}
+
+inline void AnimationClip::build_rotations (const Transform *keys, const AnimationClipSettings &settings)
+{
+  uint16_t *animated = Detail::allocate_array <uint16_t> (joints);
+  uint32_t count = 0;
+
+  for (uint32_t j = 0; j < joints; ++j)
+  {
+    const float tolerance = settings.rotation_tolerance * (settings.joint_tolerance ? settings.joint_tolerance[j] : 1.0f);
+    float deviation = 0.0f;
+    for (uint32_t f = 1; f < frames; ++f)
+      deviation = fmaxf (deviation, Detail::quaternion_distance (keys[j].rotation, keys[f * joints + j].rotation));
+
+    if (deviation <= tolerance) errors[j * 3] = deviation;
+    else animated[count++] = uint16_t (j);
+  }
+
+  rotations.count = count;
+  rotations.padded = Detail::padded_tracks (count);
+  rotations.joints = animated;
+  const size_t total = size_t (frames) * rotations.padded;
+  for (uint16_t *&values : rotations.values) values = Detail::allocate_array <uint16_t> (total);
+  rotations.largest = Detail::allocate_array <uint8_t> (total);
+
+  for (uint32_t f = 0; f < frames; ++f)
+    for (uint32_t t = 0; t < rotations.padded; ++t)
+    {
+      const size_t slot = size_t (f) * rotations.padded + t;
+      /* 패딩 레인은 단위 쿼터니언으로 채워 디코딩 중 NaN 이 생기지 않게 함 */
+      static const float identity[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+      const float *q = t < count ? keys[f * joints + animated[t]].rotation : identity;
+
+      uint16_t values[3];
+      Detail::encode_quaternion (q, values, &rotations.largest[slot]);
+      for (int c = 0; c < 3; ++c) rotations.values[c][slot] = values[c];
+
+      if (t < count)
+      {
+        float decoded[4];
+        Detail::decode_quaternion (values, rotations.largest[slot], decoded);
+        float &error = errors[animated[t] * 3];
+        error = fmaxf (error, Detail::quaternion_distance (q, decoded));
+      }
+    }
+}
+
+inline void AnimationClip::build_vectors (const Transform *keys, const AnimationClipSettings &settings, const bool scale)
+{
+  VectorTracks &tracks = scale ? scales : translations;
+  const int error_slot = scale ? 2 : 1;
+  const float base_tolerance = scale ? settings.scale_tolerance : settings.translation_tolerance;
+  auto component = [&] (const uint32_t f, const uint32_t j) { return scale ? keys[f * joints + j].scale : keys[f * joints + j].translation; };
+
+  uint16_t *animated = Detail::allocate_array <uint16_t> (joints);
+  uint32_t count = 0;
+
+  for (uint32_t j = 0; j < joints; ++j)
+  {
+    const float tolerance = base_tolerance * (settings.joint_tolerance ? settings.joint_tolerance[j] : 1.0f);
+    float deviation = 0.0f;
+    for (uint32_t f = 1; f < frames; ++f)
+      for (int c = 0; c < 3; ++c) deviation = fmaxf (deviation, fabsf (component (f, j)[c] - component (0, j)[c]));
+
+    if (deviation <= tolerance) errors[j * 3 + error_slot] = deviation;
+    else animated[count++] = uint16_t (j);
+  }
+
+  tracks.count = count;
+  tracks.padded = Detail::padded_tracks (count);
+  tracks.joints = animated;
+  const size_t total = size_t (frames) * tracks.padded;
+  for (int c = 0; c < 3; ++c)
+  {
+    tracks.minimum[c] = Detail::allocate_array <float> (tracks.padded);
+    tracks.extent[c] = Detail::allocate_array <float> (tracks.padded);
+    tracks.values[c] = Detail::allocate_array <uint16_t> (total);
+  }
+
+  for (uint32_t t = 0; t < count; ++t)
+  {
+    const uint32_t j = animated[t];
+    for (int c = 0; c < 3; ++c)
+    {
+      float low = component (0, j)[c], high = low;
+      for (uint32_t f = 1; f < frames; ++f)
+      {
+        low = fminf (low, component (f, j)[c]);
+        high = fmaxf (high, component (f, j)[c]);
+      }
+      tracks.minimum[c][t] = low;
+      tracks.extent[c][t] = high - low;
+
+      const float inverse = high > low ? 1.0f / (high - low) : 0.0f;
+      for (uint32_t f = 0; f < frames; ++f)
+      {
+        const float value = component (f, j)[c];
+        const uint16_t quantized = Detail::quantize_unit ((value - low) * inverse);
+        tracks.values[c][size_t (f) * tracks.padded + t] = quantized;
+
+        const float decoded = low + float (quantized) / 65535.0f * (high - low);
+        float &error = errors[j * 3 + error_slot];
+        error = fmaxf (error, fabsf (decoded - value));
+      }
+    }
+  }
+}
+
+inline size_t AnimationClip::compressed_size () const
+{
+  const size_t rotation_bytes = size_t (frames) * rotations.padded * (3 * sizeof (uint16_t) + 1) + rotations.count * sizeof (uint16_t);
+  const size_t translation_bytes = size_t (frames) * translations.padded * 3 * sizeof (uint16_t) + translations.padded * (6 * sizeof (float) + sizeof (uint16_t));
+  const size_t scale_bytes = size_t (frames) * scales.padded * 3 * sizeof (uint16_t) + scales.padded * (6 * sizeof (float) + sizeof (uint16_t));
+  return rotation_bytes + translation_bytes + scale_bytes + sizeof (float) * 10 * constant.padded_count ();
+}
+
+inline void AnimationClip::sample_rotations (const uint32_t f0, const uint32_t f1, const float alpha, Pose &out) const
+{
+  const SimdFloat t = Simd::splat (alpha);
+  const SimdFloat zero = Simd::zero ();
+  const SimdFloat one = Simd::splat (1.0f);
+  const SimdFloat half = Simd::splat (0.5f), one_half = Simd::splat (1.5f), two_half = Simd::splat (2.5f);
+  const SimdFloat offset = Simd::splat (-Detail::QUATERNION_RANGE);
+  const float scale = 2.0f * Detail::QUATERNION_RANGE / 65535.0f;
+
+  for (uint32_t k = 0; k < rotations.count; k += SIMD_WIDTH)
+  {
+    SimdFloat q[2][4];
+    const uint32_t frame[2] = { f0, f1 };
+    for (int i = 0; i < 2; ++i)
+    {
+      const size_t slot = size_t (frame[i]) * rotations.padded + k;
+      const SimdFloat a = Detail::load_u16 (rotations.values[0] + slot, scale) + offset;
+      const SimdFloat b = Detail::load_u16 (rotations.values[1] + slot, scale) + offset;
+      const SimdFloat c = Detail::load_u16 (rotations.values[2] + slot, scale) + offset;
+      const SimdFloat d = Simd::sqrt (Simd::max (one - Simd::mul_add (a, a, Simd::mul_add (b, b, c * c)), zero));
+
+      float indices[SIMD_WIDTH];
+      for (size_t l = 0; l < SIMD_WIDTH; ++l) indices[l] = float (rotations.largest[slot + l]);
+      const SimdFloat largest = Simd::load (indices);
+      const SimdMask is0 = Simd::less (largest, half);
+      const SimdMask up_to1 = Simd::less (largest, one_half);
+      const SimdMask up_to2 = Simd::less (largest, two_half);
+
+      q[i][0] = Simd::select (is0, d, a);
+      q[i][1] = Simd::select (is0, a, Simd::select (up_to1, d, b));
+      q[i][2] = Simd::select (up_to1, b, Simd::select (up_to2, d, c));
+      q[i][3] = Simd::select (up_to2, c, d);
+    }
+
+    const SimdFloat dot = Simd::mul_add (q[0][0], q[1][0], Simd::mul_add (q[0][1], q[1][1], Simd::mul_add (q[0][2], q[1][2], q[0][3] * q[1][3])));
+    const SimdMask flip = Simd::less (dot, zero);
+
+    SimdFloat r[4];
+    for (int c = 0; c < 4; ++c)
+    {
+      const SimdFloat target = Simd::select (flip, zero - q[1][c], q[1][c]);
+      r[c] = Simd::mul_add (target - q[0][c], t, q[0][c]);
+    }
+    const SimdFloat length2 = Simd::mul_add (r[0], r[0], Simd::mul_add (r[1], r[1], Simd::mul_add (r[2], r[2], r[3] * r[3])));
+    const SimdFloat inverse = one / Simd::sqrt (length2);
+
+    float lanes[4][SIMD_WIDTH];
+    for (int c = 0; c < 4; ++c) Simd::store (lanes[c], r[c] * inverse);
+
+    const uint32_t n = rotations.count - k < SIMD_WIDTH ? rotations.count - k : uint32_t (SIMD_WIDTH);
+    for (uint32_t l = 0; l < n; ++l)
+    {
+      const uint16_t joint = rotations.joints[k + l];
+      for (int c = 0; c < 4; ++c) out.rotation[c][joint] = lanes[c][l];
+    }
+  }
+}
+
+inline void AnimationClip::sample_vectors (const VectorTracks &tracks, const uint32_t f0, const uint32_t f1, const float alpha, float *const *out) const
+{
+  const SimdFloat t = Simd::splat (alpha);
+  const float unit = 1.0f / 65535.0f;
+
+  for (uint32_t k = 0; k < tracks.count; k += SIMD_WIDTH)
+  {
+    const uint32_t n = tracks.count - k < SIMD_WIDTH ? tracks.count - k : uint32_t (SIMD_WIDTH);
+    for (int c = 0; c < 3; ++c)
+    {
+      const SimdFloat low = Simd::load (tracks.minimum[c] + k);
+      const SimdFloat extent = Simd::load (tracks.extent[c] + k);
+      const SimdFloat v0 = Detail::load_u16 (tracks.values[c] + size_t (f0) * tracks.padded + k, unit);
+      const SimdFloat v1 = Detail::load_u16 (tracks.values[c] + size_t (f1) * tracks.padded + k, unit);
+      const SimdFloat v = Simd::mul_add (Simd::mul_add (v1 - v0, t, v0), extent, low);
+
+      float lanes[SIMD_WIDTH];
+      Simd::store (lanes, v);
+      for (uint32_t l = 0; l < n; ++l) out[c][tracks.joints[k + l]] = lanes[l];
+    }
+  }
+}
+
+inline void AnimationClip::sample (const float time, Pose &out) const
+{
+  out.copy_from (constant);
+
+  const float last = float (frames - 1);
+  float position = time * rate;
+  position = position < 0.0f ? 0.0f : position > last ? last : position;
+
+  const uint32_t f0 = uint32_t (position);
+  const uint32_t f1 = f0 + 1 < frames ? f0 + 1 : f0;
+  const float alpha = position - float (f0);
+
+  sample_rotations (f0, f1, alpha, out);
+  sample_vectors (translations, f0, f1, alpha, out.translation);
+  sample_vectors (scales, f0, f1, alpha, out.scale);
+}
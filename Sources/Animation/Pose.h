@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "Animation/Skeleton.h"
+#include "Foundation/Math/Simd.h"
+
+/* 관절 로컬 변환을 성분별 배열로 저장한 포즈. 배열 길이는 SIMD_WIDTH 배수로 패딩됨 */
+class Pose
+{
+public:
+  explicit Pose (uint32_t joint_count);
+  ~Pose ();
+
+  Pose (const Pose &) = delete;
+  Pose &operator= (const Pose &) = delete;
+
+  void set (uint32_t joint, const Transform &transform);
+  Transform get (uint32_t joint) const;
+  void copy_from (const Pose &other);
+
+  uint32_t joint_count () const { return count; }
+  uint32_t padded_count () const { return padded; }
+
+  float *rotation[4];
+  float *translation[3];
+  float *scale[3];
+
+private:
+  uint32_t count;
+  uint32_t padded;
+  float *storage;
+};
+
+/* 가중치 합으로 포즈 섞기. 회전은 첫 포즈와 같은 반구로 맞춘 뒤 더하고 정규화 (nlerp) */
+void blend_poses (const Pose *const *poses, const float *weights, uint32_t pose_count, Pose &out);
+void blend_poses (const Pose &a, const Pose &b, float alpha, Pose &out);
+
+/* 로컬 포즈를 모델 공간 행렬로 변환. 로컬 행렬은 관절 단위 SIMD 로 만들고 계층 곱은 부모 순서대로 진행 */
+void local_to_model (const Skeleton &skeleton, const Pose &pose, Matrix34 *model);
+
+/* ============ 구현 ============ */
+inline Pose::Pose (const uint32_t joint_count)
+  : count (joint_count),
+    padded (uint32_t ((joint_count + SIMD_WIDTH - 1) & ~(SIMD_WIDTH - 1)))
+{
+  storage = static_cast <float *> (malloc (sizeof (float) * 10 * (padded ? padded : 1)));
+  if (!storage) abort ();
+
+  for (int c = 0; c < 4; ++c) rotation[c] = storage + c * padded;
+  for (int c = 0; c < 3; ++c) translation[c] = storage + (4 + c) * padded;
+  for (int c = 0; c < 3; ++c) scale[c] = storage + (7 + c) * padded;
+
+  const Transform identity;
+  for (uint32_t j = 0; j < padded; ++j) set (j, identity);
+}
+
+inline Pose::~Pose ()
+{
+  free (storage);
+}
+
+inline void Pose::set (const uint32_t joint, const Transform &transform)
+{
+  for (int c = 0; c < 4; ++c) rotation[c][joint] = transform.rotation[c];
+  for (int c = 0; c < 3; ++c) translation[c][joint] = transform.translation[c];
+  for (int c = 0; c < 3; ++c) scale[c][joint] = transform.scale[c];
+}
+
+inline Transform Pose::get (const uint32_t joint) const
+{
+  Transform transform;
+  for (int c = 0; c < 4; ++c) transform.rotation[c] = rotation[c][joint];
+  for (int c = 0; c < 3; ++c) transform.translation[c] = translation[c][joint];
+  for (int c = 0; c < 3; ++c) transform.scale[c] = scale[c][joint];
+  return transform;
+}
+
+inline void Pose::copy_from (const Pose &other)
+{
+  if (other.padded != padded) abort ();
+  memcpy (storage, other.storage, sizeof (float) * 10 * padded);
+}
+
+inline void blend_poses (const Pose *const *poses, const float *weights, const uint32_t pose_count, Pose &out)
+{
+  const uint32_t padded = out.padded_count ();
+  const Pose &reference = *poses[0];
+
+  for (uint32_t j = 0; j < padded; j += SIMD_WIDTH)
+  {
+    const SimdFloat rx = Simd::load (reference.rotation[0] + j), ry = Simd::load (reference.rotation[1] + j);
+    const SimdFloat rz = Simd::load (reference.rotation[2] + j), rw = Simd::load (reference.rotation[3] + j);
+
+    SimdFloat qx = Simd::zero (), qy = Simd::zero (), qz = Simd::zero (), qw = Simd::zero ();
+    SimdFloat tx = Simd::zero (), ty = Simd::zero (), tz = Simd::zero ();
+    SimdFloat sx = Simd::zero (), sy = Simd::zero (), sz = Simd::zero ();
+
+    for (uint32_t p = 0; p < pose_count; ++p)
+    {
+      const Pose &pose = *poses[p];
+      const SimdFloat weight = Simd::splat (weights[p]);
+
+      const SimdFloat x = Simd::load (pose.rotation[0] + j), y = Simd::load (pose.rotation[1] + j);
+      const SimdFloat z = Simd::load (pose.rotation[2] + j), w = Simd::load (pose.rotation[3] + j);
+      const SimdFloat dot = Simd::mul_add (x, rx, Simd::mul_add (y, ry, Simd::mul_add (z, rz, w * rw)));
+      const SimdFloat signed_weight = Simd::select (Simd::less (dot, Simd::zero ()), Simd::zero () - weight, weight);
+
+      qx = Simd::mul_add (x, signed_weight, qx);
+      qy = Simd::mul_add (y, signed_weight, qy);
+      qz = Simd::mul_add (z, signed_weight, qz);
+      qw = Simd::mul_add (w, signed_weight, qw);
+
+      tx = Simd::mul_add (Simd::load (pose.translation[0] + j), weight, tx);
+      ty = Simd::mul_add (Simd::load (pose.translation[1] + j), weight, ty);
+      tz = Simd::mul_add (Simd::load (pose.translation[2] + j), weight, tz);
+      sx = Simd::mul_add (Simd::load (pose.scale[0] + j), weight, sx);
+      sy = Simd::mul_add (Simd::load (pose.scale[1] + j), weight, sy);
+      sz = Simd::mul_add (Simd::load (pose.scale[2] + j), weight, sz);
+    }
+
+    const SimdFloat length2 = Simd::mul_add (qx, qx, Simd::mul_add (qy, qy, Simd::mul_add (qz, qz, qw * qw)));
+    const SimdFloat inverse = Simd::splat (1.0f) / Simd::sqrt (Simd::max (length2, Simd::splat (1e-12f)));
+
+    Simd::store (out.rotation[0] + j, qx * inverse);
+    Simd::store (out.rotation[1] + j, qy * inverse);
+    Simd::store (out.rotation[2] + j, qz * inverse);
+    Simd::store (out.rotation[3] + j, qw * inverse);
+    Simd::store (out.translation[0] + j, tx);
+    Simd::store (out.translation[1] + j, ty);
+    Simd::store (out.translation[2] + j, tz);
+    Simd::store (out.scale[0] + j, sx);
+    Simd::store (out.scale[1] + j, sy);
+    Simd::store (out.scale[2] + j, sz);
+  }
+}
+
+inline void blend_poses (const Pose &a, const Pose &b, const float alpha, Pose &out)
+{
+  const Pose *poses[2] = { &a, &b };
+  const float weights[2] = { 1.0f - alpha, alpha };
+  blend_poses (poses, weights, 2, out);
+}
+
+inline void local_to_model (const Skeleton &skeleton, const Pose &pose, Matrix34 *model)
+{
+  const uint32_t count = skeleton.joint_count ();
+  const int16_t *parents = skeleton.parents ();
+  const SimdFloat one = Simd::splat (1.0f);
+  const SimdFloat two = Simd::splat (2.0f);
+
+  /* 1단계: 관절 SIMD_WIDTH 개씩 로컬 행렬 계산 */
+  for (uint32_t j = 0; j < count; j += SIMD_WIDTH)
+  {
+    const SimdFloat x = Simd::load (pose.rotation[0] + j), y = Simd::load (pose.rotation[1] + j);
+    const SimdFloat z = Simd::load (pose.rotation[2] + j), w = Simd::load (pose.rotation[3] + j);
+    const SimdFloat sx = Simd::load (pose.scale[0] + j), sy = Simd::load (pose.scale[1] + j), sz = Simd::load (pose.scale[2] + j);
+
+    const SimdFloat xx = x * x * two, yy = y * y * two, zz = z * z * two;
+    const SimdFloat xy = x * y * two, xz = x * z * two, yz = y * z * two;
+    const SimdFloat wx = w * x * two, wy = w * y * two, wz = w * z * two;
+
+    SimdFloat rows[12] = {
+      (one - yy - zz) * sx, (xy - wz) * sy, (xz + wy) * sz, Simd::load (pose.translation[0] + j),
+      (xy + wz) * sx, (one - xx - zz) * sy, (yz - wx) * sz, Simd::load (pose.translation[1] + j),
+      (xz - wy) * sx, (yz + wx) * sy, (one - xx - yy) * sz, Simd::load (pose.translation[2] + j),
+    };
+
+    float lanes[12][SIMD_WIDTH];
+    for (int e = 0; e < 12; ++e) Simd::store (lanes[e], rows[e]);
+
+    const uint32_t n = count - j < SIMD_WIDTH ? count - j : uint32_t (SIMD_WIDTH);
+    for (uint32_t l = 0; l < n; ++l)
+      for (int e = 0; e < 12; ++e) model[j + l].m[e] = lanes[e][l];
+  }
+
+  /* 2단계: 부모 행렬을 앞에서부터 곱함. 부모 인덱스가 항상 작으므로 부모는 이미 모델 공간 */
+  for (uint32_t j = 0; j < count; ++j)
+  {
+    if (parents[j] < 0) continue;
+    const float *p = model[parents[j]].m;
+    const float local[12] = { model[j].m[0], model[j].m[1], model[j].m[2], model[j].m[3],
+                              model[j].m[4], model[j].m[5], model[j].m[6], model[j].m[7],
+                              model[j].m[8], model[j].m[9], model[j].m[10], model[j].m[11] };
+    float *m = model[j].m;
+    for (int r = 0; r < 3; ++r)
+    {
+      const float a = p[r * 4], b = p[r * 4 + 1], c = p[r * 4 + 2];
+      m[r * 4 + 0] = a * local[0] + b * local[4] + c * local[8];
+      m[r * 4 + 1] = a * local[1] + b * local[5] + c * local[9];
+      m[r * 4 + 2] = a * local[2] + b * local[6] + c * local[10];
+      m[r * 4 + 3] = a * local[3] + b * local[7] + c * local[11] + p[r * 4 + 3];
+    }
+  }
+}
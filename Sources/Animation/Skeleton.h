@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+/* 관절 로컬 변환. 회전은 (x, y, z, w) 단위 쿼터니언 */
+struct Transform
+{
+  float rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+  float translation[3] = { 0.0f, 0.0f, 0.0f };
+  float scale[3] = { 1.0f, 1.0f, 1.0f };
+};
+
+/* 3x4 행 우선 아핀 행렬. 마지막 열이 이동 */
+struct Matrix34
+{
+  float m[12];
+};
+
+/* 관절 계층. 부모 인덱스는 항상 자식보다 작아야 하므로 앞에서부터 한 번 순회하면 모델 공간 변환이 나옴 */
+class Skeleton
+{
+public:
+  Skeleton (uint32_t joint_count, const int16_t *parents, const Transform *bind_pose);
+  ~Skeleton ();
+
+  Skeleton (const Skeleton &) = delete;
+  Skeleton &operator= (const Skeleton &) = delete;
+
+  uint32_t joint_count () const { return count; }
+  const int16_t *parents () const { return parent_indices; }
+  const Transform *bind_pose () const { return bind; }
+
+private:
+  uint32_t count;
+  int16_t *parent_indices;
+  Transform *bind;
+};
+
+/* ============ 구현 ============ */
+inline Skeleton::Skeleton (const uint32_t joint_count, const int16_t *parents, const Transform *bind_pose) : count (joint_count)
+{
+  parent_indices = static_cast <int16_t *> (malloc (sizeof (int16_t) * joint_count));
+  bind = static_cast <Transform *> (malloc (sizeof (Transform) * joint_count));
+  if (!parent_indices || !bind) abort ();
+
+  for (uint32_t i = 0; i < joint_count; ++i)
+    if (parents[i] >= int32_t (i)) abort ();
+
+  memcpy (parent_indices, parents, sizeof (int16_t) * joint_count);
+  memcpy (static_cast <void *> (bind), bind_pose, sizeof (Transform) * joint_count);
+}
+
+inline Skeleton::~Skeleton ()
+{
+  free (parent_indices);
+  free (bind);
+}
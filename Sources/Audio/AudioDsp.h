@@ -0,0 +1,227 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "Foundation/Math/Simd.h"
+
+/* 믹서가 쓰는 작은 DSP 조각들. 버퍼 길이는 SIMD_WIDTH 의 배수라고 가정하는 것이 있음 */
+
+/* 8 탭 창 씌운 sinc 를 256 위상으로 미리 구운 다위상 (polyphase) 보간기. 출력 하나는 입력 8 개의 내적 */
+class PolyphaseTable
+{
+public:
+  static constexpr uint32_t TAPS = 8;
+  static constexpr uint32_t PHASE_BITS = 8;
+  static constexpr uint32_t PHASES = 1u << PHASE_BITS;
+
+  PolyphaseTable ();
+
+  /* 위치는 32.32 고정소수점 프레임. input[k] 는 원본의 (floor (처음 위치) - TAPS / 2 + 1 + k) 번째 프레임.
+     frames 개를 쓰고 끝난 위치를 돌려줌 */
+  uint64_t resample (const float *input, uint64_t position, uint64_t step, float *out, size_t frames) const;
+
+  static const PolyphaseTable &instance ();
+
+private:
+  alignas (32) float coefficients[PHASES][TAPS];
+};
+
+/* 2 차 IIR (전치 직접형 II). 계수는 RBJ 오디오 EQ 요리책 */
+struct Biquad
+{
+  float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+  float z1 = 0.0f, z2 = 0.0f;
+
+  void set_lowpass (float cutoff, float sample_rate, float q = 0.7071f);
+  void set_highpass (float cutoff, float sample_rate, float q = 0.7071f);
+  void reset () { z1 = z2 = 0.0f; }
+  void process (float *samples, size_t count);
+};
+
+/* 스테레오 되먹임 지연 (메아리). 입력은 보내기 버스, 결과는 출력에 더함 */
+class Echo
+{
+public:
+  explicit Echo (size_t max_delay_frames);
+  ~Echo ();
+
+  Echo (const Echo &) = delete;
+  Echo &operator= (const Echo &) = delete;
+
+  void set (size_t delay_frames, float feedback, float wet);
+  void process (const float *send_left, const float *send_right, float *left, float *right, size_t frames);
+
+private:
+  float *buffer;      /* 프레임마다 L, R */
+  size_t capacity;
+  size_t delay = 1;
+  size_t cursor = 0;
+  float feedback = 0.0f;
+  float wet = 0.0f;
+};
+
+/* 즉시 공격, 지수 감쇠 해제의 피크 리미터. threshold 를 넘는 봉우리만 누름 */
+struct Limiter
+{
+  float threshold = 0.95f;
+  float release = 0.9995f;   /* 샘플마다 봉우리 추정에 곱하는 값 */
+  float envelope = 0.0f;
+
+  void process (float *left, float *right, size_t frames);
+};
+
+/* mono 에 L/R 이득을 블록 동안 선형으로 바꿔 가며 곱해 더함: left[i] += mono[i] * (l0 + l_step * i) */
+void audio_accumulate (float *left, float *right, const float *mono, size_t frames, float l0, float l_step, float r0, float r_step);
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  alignas (32) inline constexpr float AUDIO_LANES[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+}
+
+inline PolyphaseTable::PolyphaseTable ()
+{
+  /* 차단 주파수 0.45 (나이퀴스트 0.5) 의 sinc 에 블랙먼 창. 위상마다 합이 1 이 되게 정규화 */
+  const double cutoff = 0.45, pi = 3.14159265358979323846;
+  for (uint32_t phase = 0; phase < PHASES; ++phase)
+  {
+    const double fraction = double (phase) / PHASES;
+    double sum = 0.0, taps[TAPS];
+    for (uint32_t t = 0; t < TAPS; ++t)
+    {
+      const double x = double (t) - double (TAPS / 2 - 1) - fraction;
+      const double sinc = fabs (x) < 1e-9 ? 2.0 * cutoff : sin (2.0 * pi * cutoff * x) / (pi * x);
+      const double w = (x + TAPS / 2.0) / TAPS;
+      const double window = 0.42 - 0.5 * cos (2.0 * pi * w) + 0.08 * cos (4.0 * pi * w);
+      taps[t] = sinc * window;
+      sum += taps[t];
+    }
+    for (uint32_t t = 0; t < TAPS; ++t) coefficients[phase][t] = float (taps[t] / sum);
+  }
+}
+
+inline const PolyphaseTable &PolyphaseTable::instance ()
+{
+  static const PolyphaseTable table;
+  return table;
+}
+
+inline uint64_t PolyphaseTable::resample (const float *input, uint64_t position, const uint64_t step, float *out, const size_t frames) const
+{
+  const uint64_t base = position >> 32;
+  for (size_t i = 0; i < frames; ++i)
+  {
+    const float *window = input + ((position >> 32) - base);
+    const float *taps = coefficients[uint32_t (position >> (32 - PHASE_BITS)) & (PHASES - 1)];
+    float sum = 0.0f;
+    for (uint32_t t = 0; t < TAPS; ++t) sum += window[t] * taps[t];
+    out[i] = sum;
+    position += step;
+  }
+  return position;
+}
+
+inline void Biquad::set_lowpass (const float cutoff, const float sample_rate, const float q)
+{
+  const float w = 6.2831853f * cutoff / sample_rate, cosw = cosf (w), alpha = sinf (w) / (2.0f * q);
+  const float a0 = 1.0f / (1.0f + alpha);
+  b0 = (1.0f - cosw) * 0.5f * a0;
+  b1 = (1.0f - cosw) * a0;
+  b2 = b0;
+  a1 = -2.0f * cosw * a0;
+  a2 = (1.0f - alpha) * a0;
+}
+
+inline void Biquad::set_highpass (const float cutoff, const float sample_rate, const float q)
+{
+  const float w = 6.2831853f * cutoff / sample_rate, cosw = cosf (w), alpha = sinf (w) / (2.0f * q);
+  const float a0 = 1.0f / (1.0f + alpha);
+  b0 = (1.0f + cosw) * 0.5f * a0;
+  b1 = -(1.0f + cosw) * a0;
+  b2 = b0;
+  a1 = -2.0f * cosw * a0;
+  a2 = (1.0f - alpha) * a0;
+}
+
+inline void Biquad::process (float *samples, const size_t count)
+{
+  float s1 = z1, s2 = z2;
+  for (size_t i = 0; i < count; ++i)
+  {
+    const float x = samples[i], y = b0 * x + s1;
+    s1 = b1 * x - a1 * y + s2;
+    s2 = b2 * x - a2 * y;
+    samples[i] = y;
+  }
+  /* 무음이 이어질 때 비정규 수로 느려지지 않게 */
+  z1 = fabsf (s1) < 1e-15f ? 0.0f : s1;
+  z2 = fabsf (s2) < 1e-15f ? 0.0f : s2;
+}
+
+inline Echo::Echo (const size_t max_delay_frames) : capacity (max_delay_frames + 1)
+{
+  buffer = static_cast <float *> (calloc (capacity * 2, sizeof (float)));
+  if (!buffer) abort ();
+}
+
+inline Echo::~Echo () { free (buffer); }
+
+inline void Echo::set (const size_t delay_frames, const float feedback, const float wet)
+{
+  delay = delay_frames < 1 ? 1 : delay_frames >= capacity ? capacity - 1 : delay_frames;
+  this->feedback = feedback;
+  this->wet = wet;
+}
+
+inline void Echo::process (const float *send_left, const float *send_right, float *left, float *right, const size_t frames)
+{
+  if (wet <= 0.0f && feedback <= 0.0f) return;
+  for (size_t i = 0; i < frames; ++i)
+  {
+    const size_t read = cursor >= delay ? cursor - delay : cursor + capacity - delay;
+    const float delayed_left = buffer[read * 2], delayed_right = buffer[read * 2 + 1];
+    buffer[cursor * 2] = send_left[i] + delayed_left * feedback;
+    buffer[cursor * 2 + 1] = send_right[i] + delayed_right * feedback;
+    left[i] += delayed_left * wet;
+    right[i] += delayed_right * wet;
+    if (++cursor == capacity) cursor = 0;
+  }
+}
+
+inline void Limiter::process (float *left, float *right, const size_t frames)
+{
+  float env = envelope;
+  for (size_t i = 0; i < frames; ++i)
+  {
+    const float l = fabsf (left[i]), r = fabsf (right[i]);
+    const float peak = l > r ? l : r;
+    env = peak > env ? peak : env * release;
+    if (env > threshold)
+    {
+      const float gain = threshold / env;
+      left[i] *= gain;
+      right[i] *= gain;
+    }
+  }
+  envelope = env < 1e-15f ? 0.0f : env;
+}
+
+inline void audio_accumulate (float *left, float *right, const float *mono, const size_t frames, const float l0, const float l_step,
+                              const float r0, const float r_step)
+{
+  const SimdFloat lanes = Simd::load (Detail::AUDIO_LANES);
+  const SimdFloat left_step = Simd::splat (l_step), right_step = Simd::splat (r_step);
+  for (size_t i = 0; i < frames; i += SIMD_WIDTH)
+  {
+    const SimdFloat index = Simd::splat (float (i)) + lanes;
+    const SimdFloat gain_left = Simd::mul_add (index, left_step, Simd::splat (l0));
+    const SimdFloat gain_right = Simd::mul_add (index, right_step, Simd::splat (r0));
+    const SimdFloat sample = Simd::load (mono + i);
+    Simd::store (left + i, Simd::mul_add (sample, gain_left, Simd::load (left + i)));
+    Simd::store (right + i, Simd::mul_add (sample, gain_right, Simd::load (right + i)));
+  }
+}
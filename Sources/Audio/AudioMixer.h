@@ -0,0 +1,452 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Audio/AudioDsp.h"
+#include "Foundation/Thread/SPSCQueue.h"
+
+/* 모노 PCM. 호출한 쪽이 소유하며 재생이 끝날 때까지 살아 있어야 함 */
+struct AudioSound
+{
+  const float *samples;
+  uint32_t frame_count;
+  uint32_t sample_rate;
+};
+
+/* 목소리 핸들. (세대 << 16) | 슬롯 이라 슬롯이 재사용돼도 옛 핸들로 보낸 명령은 무시됨 */
+using AudioVoice = uint32_t;
+inline constexpr AudioVoice INVALID_VOICE = 0;
+
+enum class AudioCommandType : uint8_t
+{
+  Play,
+  Stop,
+  SetVoice,
+  SetSend,
+  SetFilter,
+  SetEcho,
+  SetMasterGain,
+};
+
+struct AudioPlay
+{
+  const AudioSound *sound;
+  float gain;
+  float pan;
+  float pitch;
+  bool loop;
+};
+
+struct AudioVoiceParams
+{
+  float gain;
+  float pan;      /* -1 (왼쪽) ~ 1 (오른쪽) */
+  float pitch;    /* 재생 속도 배율 */
+};
+
+struct AudioEchoParams
+{
+  float delay_seconds;
+  float feedback;
+  float wet;
+};
+
+struct AudioCommand
+{
+  AudioCommandType type;
+  AudioVoice voice;
+  union
+  {
+    AudioPlay play;
+    AudioVoiceParams params;
+    float value;    /* SetSend, SetFilter (차단 주파수 Hz), SetMasterGain */
+    AudioEchoParams echo;
+  };
+};
+
+/* 목소리 수백 개를 블록 (BLOCK_FRAMES) 단위로 섞는 믹서. 게임 스레드는 명령을 SPSC 큐로 보내고 오디오 스레드는
+   블록마다 큐를 비운 뒤 섞으므로 두 스레드 사이에 잠금이 없음. 끝난 목소리는 반대 방향 SPSC 큐로 돌아오고
+   게임 스레드가 update 에서 슬롯을 회수함.
+   목소리마다 다위상 재표본화 -> 선택적 저역 통과 -> 블록 동안 선형으로 바뀌는 등전력 팬 이득으로 SIMD 누적.
+   보내기 버스는 메아리를 거쳐 합쳐지고 마스터 이득과 리미터 뒤 인터리브된 스테레오로 나감 */
+class AudioMixer
+{
+public:
+  static constexpr uint32_t MAX_VOICES = 1024;
+  static constexpr uint32_t BLOCK_FRAMES = 256;
+  static constexpr uint32_t COMMAND_CAPACITY = 4096;
+  static constexpr float MAX_RATIO = 4.0f;    /* 음높이 x 원본/출력 표본율의 상한 */
+
+  explicit AudioMixer (uint32_t sample_rate, float max_echo_seconds = 2.0f);
+
+  AudioMixer (const AudioMixer &) = delete;
+  AudioMixer &operator= (const AudioMixer &) = delete;
+
+  /* 게임 스레드. 슬롯이나 명령 큐가 차면 INVALID_VOICE / false */
+  AudioVoice play (const AudioSound &sound, float gain = 1.0f, float pan = 0.0f, float pitch = 1.0f, bool loop = false);
+  bool stop (AudioVoice voice);
+  bool set_voice (AudioVoice voice, float gain, float pan, float pitch);
+  bool set_send (AudioVoice voice, float level);
+  /* 0 이면 필터를 끔 */
+  bool set_filter (AudioVoice voice, float cutoff);
+  bool set_echo (float delay_seconds, float feedback, float wet);
+  bool set_master_gain (float gain);
+  /* 끝난 목소리의 슬롯을 회수 */
+  void update ();
+  bool playing (AudioVoice voice) const { return voice != INVALID_VOICE && slot_handles[voice & 0xffff] == voice; }
+  uint32_t voice_count () const { return MAX_VOICES - free_count; }
+
+  /* 오디오 스레드 (또는 오프라인). out 은 frames 개의 L, R 쌍 */
+  void mix (float *out, size_t frames);
+  uint32_t sample_rate () const { return rate; }
+  uint32_t active_voices () const { return active_count; }
+
+private:
+  struct Voice
+  {
+    AudioVoice handle;
+    const AudioSound *sound;
+    uint64_t position;          /* 32.32 고정소수점 원본 프레임 */
+    float gain, pan, pitch, send;
+    float current_left, current_right;
+    Biquad filter;
+    bool filtered;
+    bool loop;
+    bool stopping;              /* 이번 블록에 0 으로 줄인 뒤 끝냄 */
+  };
+
+  bool send (const AudioCommand &command);
+  void apply (const AudioCommand &command);
+  void render_block ();
+  /* 목소리 하나를 mono 에 씀. 끝났으면 false */
+  bool render_voice (Voice &voice, float *mono);
+  void fetch (const AudioSound &sound, int64_t first, size_t count, bool loop, float *out) const;
+
+  uint32_t rate;
+
+  /* 게임 스레드 쪽 */
+  AudioVoice slot_handles[MAX_VOICES];
+  uint16_t generations[MAX_VOICES];
+  uint32_t free_slots[MAX_VOICES];
+  uint32_t free_count = MAX_VOICES;
+
+  SPSCQueue <AudioCommand, COMMAND_CAPACITY> commands;
+  SPSCQueue <AudioVoice, MAX_VOICES> finished;    /* 슬롯 수와 같으니 넘치지 않음 */
+
+  /* 오디오 스레드 쪽 */
+  Voice voices[MAX_VOICES];
+  uint32_t active[MAX_VOICES];
+  uint32_t active_count = 0;
+  Echo echo;
+  Limiter limiter;
+  float master_gain = 1.0f;
+
+  alignas (32) float left[BLOCK_FRAMES];
+  alignas (32) float right[BLOCK_FRAMES];
+  alignas (32) float send_left[BLOCK_FRAMES];
+  alignas (32) float send_right[BLOCK_FRAMES];
+  alignas (32) float mono[BLOCK_FRAMES];
+  alignas (32) float input[size_t (BLOCK_FRAMES * MAX_RATIO) + PolyphaseTable::TAPS + 1];
+  uint32_t block_cursor = BLOCK_FRAMES;
+};
+
+/* ============ 구현 ============ */
+inline AudioMixer::AudioMixer (const uint32_t sample_rate, const float max_echo_seconds)
+  : rate (sample_rate), echo (size_t (max_echo_seconds * float (sample_rate)))
+{
+  for (uint32_t i = 0; i < MAX_VOICES; ++i)
+  {
+    slot_handles[i] = INVALID_VOICE;
+    generations[i] = 0;
+    free_slots[i] = MAX_VOICES - 1 - i;
+  }
+  memset (static_cast <void *> (voices), 0, sizeof (voices));
+  PolyphaseTable::instance ();
+}
+
+inline bool AudioMixer::send (const AudioCommand &command)
+{
+  return commands.push (command);
+}
+
+inline AudioVoice AudioMixer::play (const AudioSound &sound, const float gain, const float pan, const float pitch, const bool loop)
+{
+  if (!free_count || !sound.frame_count) return INVALID_VOICE;
+
+  const uint32_t slot = free_slots[free_count - 1];
+  if (!++generations[slot]) generations[slot] = 1;
+  const AudioVoice voice = AudioVoice (generations[slot]) << 16 | slot;
+
+  AudioCommand command;
+  command.type = AudioCommandType::Play;
+  command.voice = voice;
+  command.play = { &sound, gain, pan, pitch, loop };
+  if (!send (command)) return INVALID_VOICE;
+
+  --free_count;
+  slot_handles[slot] = voice;
+  return voice;
+}
+
+inline bool AudioMixer::stop (const AudioVoice voice)
+{
+  if (!playing (voice)) return false;
+  AudioCommand command;
+  command.type = AudioCommandType::Stop;
+  command.voice = voice;
+  return send (command);
+}
+
+inline bool AudioMixer::set_voice (const AudioVoice voice, const float gain, const float pan, const float pitch)
+{
+  if (!playing (voice)) return false;
+  AudioCommand command;
+  command.type = AudioCommandType::SetVoice;
+  command.voice = voice;
+  command.params = { gain, pan, pitch };
+  return send (command);
+}
+
+inline bool AudioMixer::set_send (const AudioVoice voice, const float level)
+{
+  if (!playing (voice)) return false;
+  AudioCommand command;
+  command.type = AudioCommandType::SetSend;
+  command.voice = voice;
+  command.value = level;
+  return send (command);
+}
+
+inline bool AudioMixer::set_filter (const AudioVoice voice, const float cutoff)
+{
+  if (!playing (voice)) return false;
+  AudioCommand command;
+  command.type = AudioCommandType::SetFilter;
+  command.voice = voice;
+  command.value = cutoff;
+  return send (command);
+}
+
+inline bool AudioMixer::set_echo (const float delay_seconds, const float feedback, const float wet)
+{
+  AudioCommand command;
+  command.type = AudioCommandType::SetEcho;
+  command.voice = INVALID_VOICE;
+  command.echo = { delay_seconds, feedback, wet };
+  return send (command);
+}
+
+inline bool AudioMixer::set_master_gain (const float gain)
+{
+  AudioCommand command;
+  command.type = AudioCommandType::SetMasterGain;
+  command.voice = INVALID_VOICE;
+  command.value = gain;
+  return send (command);
+}
+
+inline void AudioMixer::update ()
+{
+  AudioVoice voice;
+  while (finished.pop (&voice))
+  {
+    const uint32_t slot = voice & 0xffff;
+    if (slot_handles[slot] != voice) continue;
+    slot_handles[slot] = INVALID_VOICE;
+    free_slots[free_count++] = slot;
+  }
+}
+
+inline void AudioMixer::apply (const AudioCommand &command)
+{
+  switch (command.type)
+  {
+    case AudioCommandType::SetEcho:
+      echo.set (size_t (command.echo.delay_seconds * float (rate)), command.echo.feedback, command.echo.wet);
+      return;
+    case AudioCommandType::SetMasterGain:
+      master_gain = command.value;
+      return;
+    default:
+      break;
+  }
+
+  Voice &voice = voices[command.voice & 0xffff];
+  if (command.type == AudioCommandType::Play)
+  {
+    memset (static_cast <void *> (&voice), 0, sizeof (Voice));
+    voice.handle = command.voice;
+    voice.sound = command.play.sound;
+    voice.gain = command.play.gain;
+    voice.pan = command.play.pan;
+    voice.pitch = command.play.pitch;
+    voice.loop = command.play.loop;
+    voice.filter = Biquad ();
+
+    /* 첫 블록은 이득을 바로 목표값에서 시작 */
+    const float angle = (voice.pan < -1.0f ? -1.0f : voice.pan > 1.0f ? 1.0f : voice.pan) * 0.78539816f + 0.78539816f;
+    voice.current_left = cosf (angle) * voice.gain;
+    voice.current_right = sinf (angle) * voice.gain;
+    active[active_count++] = command.voice & 0xffff;
+    return;
+  }
+
+  if (voice.handle != command.voice) return;
+  switch (command.type)
+  {
+    case AudioCommandType::Stop: voice.stopping = true; break;
+    case AudioCommandType::SetVoice:
+      voice.gain = command.params.gain;
+      voice.pan = command.params.pan;
+      voice.pitch = command.params.pitch;
+      break;
+    case AudioCommandType::SetSend: voice.send = command.value; break;
+    case AudioCommandType::SetFilter:
+      voice.filtered = command.value > 0.0f && command.value < float (rate) * 0.45f;
+      if (voice.filtered) voice.filter.set_lowpass (command.value, float (rate));
+      else voice.filter.reset ();
+      break;
+    default: break;
+  }
+}
+
+inline void AudioMixer::fetch (const AudioSound &sound, int64_t first, size_t count, const bool loop, float *out) const
+{
+  const int64_t length = sound.frame_count;
+  if (loop)
+  {
+    first %= length;
+    if (first < 0) first += length;
+  }
+  while (count)
+  {
+    size_t run;
+    if (first < 0)
+    {
+      run = size_t (-first) < count ? size_t (-first) : count;
+      memset (out, 0, sizeof (float) * run);
+    }
+    else if (first >= length)
+    {
+      run = count;
+      memset (out, 0, sizeof (float) * run);
+    }
+    else
+    {
+      run = size_t (length - first) < count ? size_t (length - first) : count;
+      memcpy (out, sound.samples + first, sizeof (float) * run);
+    }
+    out += run;
+    count -= run;
+    first += int64_t (run);
+    if (loop && first >= length) first = 0;
+  }
+}
+
+inline bool AudioMixer::render_voice (Voice &voice, float *out)
+{
+  const AudioSound &sound = *voice.sound;
+  float ratio = voice.pitch * float (sound.sample_rate) / float (rate);
+  ratio = ratio < 1.0f / 1024.0f ? 1.0f / 1024.0f : ratio > MAX_RATIO ? MAX_RATIO : ratio;
+  const uint64_t step = uint64_t (double (ratio) * 4294967296.0);
+  const int64_t whole = int64_t (voice.position >> 32);
+
+  /* 음높이가 정확히 1 이고 위상이 맞으면 보간 없이 복사 */
+  if (step == uint64_t (1) << 32 && !(voice.position & 0xffffffffu)) fetch (sound, whole, BLOCK_FRAMES, voice.loop, out);
+  else
+  {
+    const uint64_t last = (voice.position + step * (BLOCK_FRAMES - 1)) >> 32;
+    const size_t needed = size_t (last - uint64_t (whole)) + PolyphaseTable::TAPS;
+    fetch (sound, whole - int64_t (PolyphaseTable::TAPS / 2 - 1), needed, voice.loop, input);
+    PolyphaseTable::instance ().resample (input, voice.position, step, out, BLOCK_FRAMES);
+  }
+  voice.position += step * BLOCK_FRAMES;
+
+  if (voice.loop)
+  {
+    const uint64_t length = uint64_t (sound.frame_count) << 32;
+    while (voice.position >= length) voice.position -= length;
+    return true;
+  }
+  /* 보간기 꼬리까지 다 내보낸 뒤 끝남 */
+  return (voice.position >> 32) < uint64_t (sound.frame_count) + PolyphaseTable::TAPS / 2;
+}
+
+inline void AudioMixer::render_block ()
+{
+  for (AudioCommand *command = commands.front (); command; command = commands.front ())
+  {
+    apply (*command);
+    commands.pop ();
+  }
+
+  memset (left, 0, sizeof (left));
+  memset (right, 0, sizeof (right));
+  memset (send_left, 0, sizeof (send_left));
+  memset (send_right, 0, sizeof (send_right));
+
+  const float step = 1.0f / float (BLOCK_FRAMES);
+  for (uint32_t i = 0; i < active_count;)
+  {
+    Voice &voice = voices[active[i]];
+    const bool alive = render_voice (voice, mono) && !voice.stopping;
+    if (voice.filtered) voice.filter.process (mono, BLOCK_FRAMES);
+
+    float target_left = 0.0f, target_right = 0.0f;
+    if (!voice.stopping)
+    {
+      const float angle = (voice.pan < -1.0f ? -1.0f : voice.pan > 1.0f ? 1.0f : voice.pan) * 0.78539816f + 0.78539816f;
+      target_left = cosf (angle) * voice.gain;
+      target_right = sinf (angle) * voice.gain;
+    }
+    const float left_step = (target_left - voice.current_left) * step, right_step = (target_right - voice.current_right) * step;
+    audio_accumulate (left, right, mono, BLOCK_FRAMES, voice.current_left, left_step, voice.current_right, right_step);
+    if (voice.send > 0.0f)
+      audio_accumulate (send_left, send_right, mono, BLOCK_FRAMES, voice.current_left * voice.send, left_step * voice.send,
+                        voice.current_right * voice.send, right_step * voice.send);
+    voice.current_left = target_left;
+    voice.current_right = target_right;
+
+    if (alive)
+    {
+      ++i;
+      continue;
+    }
+    finished.push (voice.handle);
+    voice.handle = INVALID_VOICE;
+    active[i] = active[--active_count];
+  }
+
+  echo.process (send_left, send_right, left, right, BLOCK_FRAMES);
+  if (master_gain != 1.0f)
+    for (uint32_t i = 0; i < BLOCK_FRAMES; ++i)
+    {
+      left[i] *= master_gain;
+      right[i] *= master_gain;
+    }
+  limiter.process (left, right, BLOCK_FRAMES);
+}
+
+inline void AudioMixer::mix (float *out, size_t frames)
+{
+  while (frames)
+  {
+    if (block_cursor == BLOCK_FRAMES)
+    {
+      render_block ();
+      block_cursor = 0;
+    }
+    const size_t count = BLOCK_FRAMES - block_cursor < frames ? BLOCK_FRAMES - block_cursor : frames;
+    for (size_t i = 0; i < count; ++i)
+    {
+      out[i * 2] = left[block_cursor + i];
+      out[i * 2 + 1] = right[block_cursor + i];
+    }
+    out += count * 2;
+    frames -= count;
+    block_cursor += uint32_t (count);
+  }
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "Audio/AudioMixer.h"
+#include "Foundation/Thread/Atomics.h"
+#include "Foundation/Thread/Futex.h"
+#include "Foundation/Thread/Thread.h"
+
+/* 장치로 나갈 인터리브 스테레오 프레임 링. 오디오 스레드가 쓰고 장치 콜백 (플랫폼 백엔드) 이 읽음.
+   읽을 때마다 reads 를 올리고 깨우므로 쓰는 쪽은 자리가 날 때까지 futex 에서 잠듦 */
+class AudioOutput
+{
+public:
+  /* capacity_frames 는 2 의 거듭제곱 */
+  explicit AudioOutput (size_t capacity_frames);
+  ~AudioOutput ();
+
+  AudioOutput (const AudioOutput &) = delete;
+  AudioOutput &operator= (const AudioOutput &) = delete;
+
+  /* 생산자 */
+  size_t space () const { return capacity - (Atomics::load_acquire (&tail) - Atomics::load_acquire (&head)); }
+  size_t write (const float *frames, size_t count);
+
+  /* 소비자. 모자라면 있는 만큼만 읽고 나머지는 무음으로 채움 (언더런) */
+  size_t read (float *frames, size_t count);
+  size_t available () const { return Atomics::load_acquire (&tail) - Atomics::load_acquire (&head); }
+  uint64_t underruns () const { return Atomics::load_relaxed (&underrun_count); }
+
+  volatile uint32_t reads = 0;
+
+private:
+  float *buffer;
+  size_t capacity;
+  alignas (CACHE_LINE_SIZE) size_t head = 0;
+  alignas (CACHE_LINE_SIZE) size_t tail = 0;
+  uint64_t underrun_count = 0;
+};
+
+/* 믹서를 돌리는 전용 스레드. 시작하면서 실시간 우선순위를 요청하고 (권한이 없으면 보통 우선순위로 계속)
+   출력 링에 블록 하나가 들어갈 자리가 있는 동안 섞고, 없으면 소비자가 읽을 때까지 잠듦 */
+class AudioThread
+{
+public:
+  AudioThread (AudioMixer &mixer, AudioOutput &output) : mixer (mixer), output (output) {}
+  ~AudioThread () { stop (); }
+
+  AudioThread (const AudioThread &) = delete;
+  AudioThread &operator= (const AudioThread &) = delete;
+
+  void start ();
+  void stop ();
+
+  bool realtime () const { return Atomics::load (&realtime_granted) != 0; }
+  uint64_t blocks () const { return Atomics::load_relaxed (&block_count); }
+
+private:
+  static void *entry (void *arg);
+  void run ();
+
+  AudioMixer &mixer;
+  AudioOutput &output;
+  Thread thread;
+  volatile uint32_t running = 0;
+  volatile uint32_t realtime_granted = 0;
+  uint64_t block_count = 0;
+  bool started = false;
+};
+
+/* ============ 구현 ============ */
+inline AudioOutput::AudioOutput (const size_t capacity_frames) : capacity (capacity_frames)
+{
+  if (!capacity || (capacity & (capacity - 1))) abort ();
+  buffer = static_cast <float *> (calloc (capacity * 2, sizeof (float)));
+  if (!buffer) abort ();
+}
+
+inline AudioOutput::~AudioOutput () { free (buffer); }
+
+inline size_t AudioOutput::write (const float *frames, size_t count)
+{
+  const size_t start = Atomics::load_relaxed (&tail);
+  const size_t room = capacity - (start - Atomics::load_acquire (&head));
+  count = count < room ? count : room;
+  for (size_t i = 0; i < count; ++i)
+  {
+    const size_t slot = (start + i) & (capacity - 1);
+    buffer[slot * 2] = frames[i * 2];
+    buffer[slot * 2 + 1] = frames[i * 2 + 1];
+  }
+  Atomics::store_release (&tail, start + count);
+  return count;
+}
+
+inline size_t AudioOutput::read (float *frames, const size_t count)
+{
+  const size_t start = Atomics::load_relaxed (&head);
+  const size_t ready = Atomics::load_acquire (&tail) - start;
+  const size_t n = count < ready ? count : ready;
+  for (size_t i = 0; i < n; ++i)
+  {
+    const size_t slot = (start + i) & (capacity - 1);
+    frames[i * 2] = buffer[slot * 2];
+    frames[i * 2 + 1] = buffer[slot * 2 + 1];
+  }
+  if (n < count)
+  {
+    memset (frames + n * 2, 0, sizeof (float) * 2 * (count - n));
+    Atomics::store_relaxed (&underrun_count, underrun_count + 1);
+  }
+  Atomics::store_release (&head, start + n);
+
+  Atomics::fetch_add (&reads, 1u);
+  Futex::wake_one (&reads);
+  return n;
+}
+
+inline void AudioThread::start ()
+{
+  if (started) return;
+  Atomics::store (&running, 1u);
+  thread.create (entry, this);
+  started = true;
+}
+
+inline void AudioThread::stop ()
+{
+  if (!started) return;
+  Atomics::store (&running, 0u);
+  Atomics::fetch_add (&output.reads, 1u);
+  Futex::wake_all (&output.reads);
+  thread.join ();
+  started = false;
+}
+
+inline void *AudioThread::entry (void *arg)
+{
+  static_cast <AudioThread *> (arg)->run ();
+  return nullptr;
+}
+
+inline void AudioThread::run ()
+{
+  Atomics::store (&realtime_granted, uint32_t (Thread::set_realtime_priority ()));
+
+  alignas (32) float block[AudioMixer::BLOCK_FRAMES * 2];
+  while (Atomics::load (&running))
+  {
+    /* 깨어난 뒤 자리를 다시 보기 전에 reads 를 읽어 두어야 그 사이의 읽기를 놓치지 않음 */
+    const uint32_t seen = Atomics::load (&output.reads);
+    if (output.space () < AudioMixer::BLOCK_FRAMES)
+    {
+      Futex::wait (&output.reads, seen);
+      continue;
+    }
+    mixer.mix (block, AudioMixer::BLOCK_FRAMES);
+    output.write (block, AudioMixer::BLOCK_FRAMES);
+    Atomics::store_relaxed (&block_count, block_count + 1);
+  }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/* 인터리브 스테레오 float 를 16 비트 PCM WAV 로. 오프라인 렌더 결과를 메모리에 담아 비교하거나 파일로 쓸 때 */
+inline constexpr size_t wav_size (size_t frames) { return 44 + frames * 4; }
+
+/* out 에는 wav_size (frames) 바이트가 있어야 함. 쓴 바이트 수를 돌려줌 */
+size_t encode_wav (const float *stereo, size_t frames, uint32_t sample_rate, uint8_t *out);
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  inline uint8_t *wav_put32 (uint8_t *p, const uint32_t value)
+  {
+    for (int i = 0; i < 4; ++i) p[i] = uint8_t (value >> (8 * i));
+    return p + 4;
+  }
+
+  inline uint8_t *wav_put16 (uint8_t *p, const uint16_t value)
+  {
+    p[0] = uint8_t (value);
+    p[1] = uint8_t (value >> 8);
+    return p + 2;
+  }
+}
+
+inline size_t encode_wav (const float *stereo, const size_t frames, const uint32_t sample_rate, uint8_t *out)
+{
+  using namespace Detail;
+
+  const uint32_t data_bytes = uint32_t (frames * 4);
+  uint8_t *p = out;
+  memcpy (p, "RIFF", 4);
+  p = wav_put32 (p + 4, 36 + data_bytes);
+  memcpy (p, "WAVEfmt ", 8);
+  p = wav_put32 (p + 8, 16);
+  p = wav_put16 (p, 1);                   /* PCM */
+  p = wav_put16 (p, 2);                   /* 채널 */
+  p = wav_put32 (p, sample_rate);
+  p = wav_put32 (p, sample_rate * 4);     /* 초당 바이트 */
+  p = wav_put16 (p, 4);                   /* 프레임 바이트 */
+  p = wav_put16 (p, 16);
+  memcpy (p, "data", 4);
+  p = wav_put32 (p + 4, data_bytes);
+
+  for (size_t i = 0; i < frames * 2; ++i)
+  {
+    const float x = stereo[i] < -1.0f ? -1.0f : stereo[i] > 1.0f ? 1.0f : stereo[i];
+    p = wav_put16 (p, uint16_t (int16_t (x * 32767.0f + (x < 0.0f ? -0.5f : 0.5f))));
+  }
+  return size_t (p - out);
+}
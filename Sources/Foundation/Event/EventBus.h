@@ -0,0 +1,267 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+#include "Foundation/Heap/FrameArena.h"
+#include "Foundation/Thread/Atomics.h"
+#include "Foundation/Thread/ThreadLocal.h"
+
+inline constexpr uint32_t MAX_EVENT_TYPES = 256;
+inline constexpr uint32_t MAX_EVENT_HANDLERS = 8;
+
+template <typename E>
+concept EventType = std::is_trivially_copyable_v <E> && alignof (E) <= 16;
+
+/* 생산자는 스레드별 버퍼에 이벤트를 기록하고, dispatch 가 한 페이즈 동안 쌓인 이벤트를
+   타입별 연속 배열로 모아 핸들러에 한 번씩 넘김. 핸들러 안에서 발행한 이벤트는 다음 페이즈로 넘어감.
+   dispatch 는 페이즈를 뒤집은 뒤 이전 페이즈에 기록 중인 생산자가 끝나기를 기다리므로
+   생산자가 dispatch 와 동시에 publish 해도 됨 (그 이벤트는 어느 한 페이즈에 온전히 들어감) */
+class EventBus
+{
+public:
+  template <EventType E>
+  using Handler = void (*) (const E *events, size_t count, void *user);
+
+  explicit EventBus (size_t arena_size = 64 << 20);
+
+  EventBus (const EventBus &) = delete;
+  EventBus &operator= (const EventBus &) = delete;
+
+  /* 스레드별 버퍼에 쓰므로 ThreadLocal 에 붙은 스레드에서 부름 */
+  template <EventType E>
+  void publish (const E &event);
+
+  template <EventType E>
+  void subscribe (Handler <E> handler, void *user = nullptr);
+
+  /* 한 번에 한 스레드만 부름 */
+  size_t dispatch ();
+
+private:
+  static constexpr size_t CHUNK_SIZE = 16 << 10;
+
+  struct Record
+  {
+    uint32_t type;
+    uint32_t size;
+  };
+
+  struct Chunk
+  {
+    Chunk *next;
+    size_t used;
+  };
+
+  struct alignas (CACHE_LINE_SIZE) Writer
+  {
+    Chunk *first;
+    Chunk *last;
+    char *cursor;
+    char *end;
+  };
+
+  /* 기록 중이면 홀수. dispatch 가 뒤집기 전 페이즈에 쓰는 생산자를 기다릴 때 씀 */
+  struct alignas (CACHE_LINE_SIZE) Publisher
+  {
+    uint32_t sequence;
+  };
+
+  struct Subscriber
+  {
+    void (*invoke) (const Subscriber &subscriber, const void *events, size_t count);
+    void (*handler) ();
+    void *user;
+  };
+
+  template <EventType E>
+  static void invoke (const Subscriber &subscriber, const void *events, size_t count);
+
+  static constexpr size_t payload_offset () { return (sizeof (Record) + 15) & ~size_t (15); }
+  static constexpr size_t record_size (size_t size) { return payload_offset () + ((size + 15) & ~size_t (15)); }
+
+  char *reserve (uint32_t current, uint32_t thread, size_t size);
+
+  FrameArena arenas[2];
+  Writer writers[2][ThreadLocal::MAX_THREADS];
+  Publisher publishers[ThreadLocal::MAX_THREADS];
+  uint32_t phase = 0;
+
+  Subscriber subscribers[MAX_EVENT_TYPES][MAX_EVENT_HANDLERS];
+  uint32_t subscriber_counts[MAX_EVENT_TYPES];
+};
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  constinit inline uint32_t event_type_count = 0;
+  constinit inline uint32_t event_type_sizes[MAX_EVENT_TYPES] = {};
+
+  /* 타입 번호 + 1. 0 이면 아직 번호가 없어 처음 publish / subscribe 할 때 매김.
+     상수 초기화라 정적 초기화 순서와 상관없이 쓸 수 있음 */
+  template <EventType E>
+  constinit inline uint32_t event_type_ids = 0;
+
+  template <EventType E>
+  [[gnu::noinline]] uint32_t register_event_type ()
+  {
+    const uint32_t id = Atomics::fetch_add (&event_type_count, 1u);
+    if (id >= MAX_EVENT_TYPES) abort ();
+    event_type_sizes[id] = sizeof (E);
+
+    /* 두 스레드가 동시에 매기면 먼저 넣은 번호를 쓰고 진 쪽 번호는 빈 채로 남음 */
+    uint32_t expected = 0;
+    if (Atomics::compare_exchange (&event_type_ids <E>, &expected, id + 1)) return id;
+    return expected - 1;
+  }
+
+  template <EventType E>
+  inline uint32_t event_type_id ()
+  {
+    const uint32_t id = Atomics::load_acquire (&event_type_ids <E>);
+    if (id) [[likely]] return id - 1;
+    return register_event_type <E> ();
+  }
+}
+
+inline EventBus::EventBus (const size_t arena_size) : arenas { FrameArena (arena_size), FrameArena (arena_size) }
+{
+  memset (writers, 0, sizeof (writers));
+  memset (publishers, 0, sizeof (publishers));
+  memset (subscriber_counts, 0, sizeof (subscriber_counts));
+}
+
+inline char *EventBus::reserve (const uint32_t current, const uint32_t thread, const size_t size)
+{
+  Writer &writer = writers[current][thread];
+
+  if (writer.cursor + size > writer.end)
+  {
+    const size_t chunk_size = size + sizeof (Chunk) > CHUNK_SIZE ? size + sizeof (Chunk) : CHUNK_SIZE;
+    auto *chunk = static_cast <Chunk *> (arenas[current].allocate (chunk_size, 16));
+    if (!chunk) abort ();
+    chunk->next = nullptr;
+    chunk->used = 0;
+
+    if (writer.last) writer.last->next = chunk;
+    else writer.first = chunk;
+    writer.last = chunk;
+    writer.cursor = reinterpret_cast <char *> (chunk) + ((sizeof (Chunk) + 15) & ~size_t (15));
+    writer.end = reinterpret_cast <char *> (chunk) + chunk_size;
+  }
+
+  char *record = writer.cursor;
+  writer.cursor += size;
+  writer.last->used += size;
+  return record;
+}
+
+template <EventType E>
+void EventBus::publish (const E &event)
+{
+  constexpr size_t size = record_size (sizeof (E));
+  const uint32_t type = Detail::event_type_id <E> ();
+  const uint32_t thread = ThreadLocal::index ();
+
+  /* 기록 시작을 알린 뒤 페이즈를 읽음. dispatch 는 페이즈를 바꾼 뒤 이 표시를 읽으므로
+     둘 중 하나는 반드시 상대를 봄 */
+  Publisher &publisher = publishers[thread];
+  const uint32_t sequence = Atomics::fetch_add (&publisher.sequence, 1u);
+  const uint32_t current = Atomics::load (&phase);
+
+  char *record = reserve (current, thread, size);
+  *reinterpret_cast <Record *> (record) = { type, uint32_t (size) };
+  memcpy (record + payload_offset (), &event, sizeof (E));
+
+  Atomics::store_release (&publisher.sequence, sequence + 2);
+}
+
+template <EventType E>
+void EventBus::subscribe (Handler <E> handler, void *user)
+{
+  const uint32_t type = Detail::event_type_id <E> ();
+  if (subscriber_counts[type] == MAX_EVENT_HANDLERS) abort ();
+  subscribers[type][subscriber_counts[type]++] = { invoke <E>, reinterpret_cast <void (*) ()> (handler), user };
+}
+
+template <EventType E>
+void EventBus::invoke (const Subscriber &subscriber, const void *events, const size_t count)
+{
+  reinterpret_cast <Handler <E>> (subscriber.handler) (static_cast <const E *> (events), count, subscriber.user);
+}
+
+inline size_t EventBus::dispatch ()
+{
+  const uint32_t previous = phase;
+  Atomics::store (&phase, previous ^ 1);
+
+  /* 뒤집기 전 페이즈를 읽었을 수 있는 생산자가 기록을 마칠 때까지 기다림. 끝난 뒤 다시 시작한 기록은 새 페이즈로 감 */
+  for (uint32_t t = 0; t < ThreadLocal::MAX_THREADS; ++t)
+  {
+    const uint32_t sequence = Atomics::load (&publishers[t].sequence);
+    if (sequence & 1)
+      while (Atomics::load_acquire (&publishers[t].sequence) == sequence) Atomics::pause ();
+  }
+
+  FrameArena &arena = arenas[previous];
+  Writer *phase_writers = writers[previous];
+  const uint32_t type_count = Atomics::load (&Detail::event_type_count);
+
+  uint32_t counts[MAX_EVENT_TYPES] = {};
+  for (uint32_t t = 0; t < ThreadLocal::MAX_THREADS; ++t)
+    for (const Chunk *chunk = phase_writers[t].first; chunk; chunk = chunk->next)
+    {
+      const char *cursor = reinterpret_cast <const char *> (chunk) + ((sizeof (Chunk) + 15) & ~size_t (15));
+      const char *end = cursor + chunk->used;
+      while (cursor < end)
+      {
+        const Record *record = reinterpret_cast <const Record *> (cursor);
+        ++counts[record->type];
+        cursor += record->size;
+      }
+    }
+
+  char *spans[MAX_EVENT_TYPES] = {};
+  char *fill[MAX_EVENT_TYPES] = {};
+  size_t total = 0;
+  for (uint32_t type = 0; type < type_count; ++type)
+  {
+    total += counts[type];
+    if (!counts[type] || !subscriber_counts[type]) continue;
+    spans[type] = static_cast <char *> (arena.allocate (size_t (counts[type]) * Detail::event_type_sizes[type], 16));
+    if (!spans[type]) abort ();
+    fill[type] = spans[type];
+  }
+
+  for (uint32_t t = 0; t < ThreadLocal::MAX_THREADS; ++t)
+    for (const Chunk *chunk = phase_writers[t].first; chunk; chunk = chunk->next)
+    {
+      const char *cursor = reinterpret_cast <const char *> (chunk) + ((sizeof (Chunk) + 15) & ~size_t (15));
+      const char *end = cursor + chunk->used;
+      while (cursor < end)
+      {
+        const Record *record = reinterpret_cast <const Record *> (cursor);
+        if (fill[record->type])
+        {
+          const uint32_t size = Detail::event_type_sizes[record->type];
+          memcpy (fill[record->type], cursor + payload_offset (), size);
+          fill[record->type] += size;
+        }
+        cursor += record->size;
+      }
+    }
+
+  for (uint32_t type = 0; type < type_count; ++type)
+  {
+    if (!spans[type]) continue;
+    for (uint32_t i = 0; i < subscriber_counts[type]; ++i)
+      subscribers[type][i].invoke (subscribers[type][i], spans[type], counts[type]);
+  }
+
+  memset (phase_writers, 0, sizeof (writers[previous]));
+  arena.reset ();
+  return total;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Foundation/Heap/OSAllocator.h"
+#include "Foundation/Thread/Atomics.h"
+#include "Foundation/Thread/SpinLock.h"
+
+/* 프레임 단위 선형 할당기. allocate 는 여러 스레드에서 호출 가능하고 reset 은 모든 할당이 끝난 뒤 한 스레드에서 호출 */
+class FrameArena
+{
+  static constexpr size_t COMMIT_GRANULARITY = 1 << 20;
+
+  OSAllocator memory;
+  size_t capacity;
+  alignas (CACHE_LINE_SIZE) size_t offset = 0;
+  alignas (CACHE_LINE_SIZE) size_t committed = 0;
+  SpinLock commit_lock;
+
+public:
+  explicit FrameArena (size_t reserve_size);
+
+  FrameArena (const FrameArena &) = delete;
+  FrameArena &operator= (const FrameArena &) = delete;
+
+  void *allocate (size_t size, size_t align = alignof (max_align_t));
+  template <typename T>
+  T *allocate (size_t count) { return static_cast <T *> (allocate (sizeof (T) * count, alignof (T))); }
+
+  void reset () { Atomics::store (&offset, size_t (0)); }
+  size_t used () const { return Atomics::load_relaxed (&offset); }
+};
+
+/* ============ 구현 ============ */
+inline FrameArena::FrameArena (const size_t reserve_size)
+  : memory (reserve_size), capacity (Detail::align_to (reserve_size, SYSTEM_PAGE_SIZE))
+{
+}
+
+inline void *FrameArena::allocate (const size_t size, const size_t align)
+{
+  const uintptr_t base = reinterpret_cast <uintptr_t> (memory.data ());
+  size_t current = Atomics::load_relaxed (&offset);
+  size_t begin;
+
+  for (;;)
+  {
+    begin = Detail::align_to (base + current, align) - base;
+    if (begin + size > capacity) return nullptr;
+    if (Atomics::compare_exchange (&offset, &current, begin + size)) break;
+  }
+
+  const size_t end = begin + size;
+  if (end > Atomics::load_acquire (&committed))
+  {
+    commit_lock.lock ();
+    if (end > committed)
+    {
+      size_t target = Detail::align_to (end, COMMIT_GRANULARITY);
+      if (target > capacity) target = capacity;
+      memory.map (target);
+      Atomics::store_release (&committed, target);
+    }
+    commit_lock.unlock ();
+  }
+
+  return reinterpret_cast <void *> (base + begin);
+}
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cassert>
 
+#include "Foundation/Thread/Atomics.h"
+
 #if __APPLE__ || __aarch64__
 #define SYSTEM_PAGE_SIZE (16 << 10)
 #else
@@ -16,12 +19,36 @@ class OSAllocator
   size_t reserved_size;
   size_t page_size;
   size_t alignment;
+  uint64_t *dirty_bits = nullptr;
+  size_t tracked_size = 0;
+  uint64_t *committed_bits = nullptr;  /* 예약 범위의 페이지별 커밋 여부 */
+  int shared_fd = -1;
+  char *shared_name = nullptr;
 
 public:
+  enum class Shared { Create, Open };
+
   explicit OSAllocator (size_t reserve_size, size_t page_size = SYSTEM_PAGE_SIZE, size_t alignment = 0);
+  /* 이름 있는 공유 메모리 예약. 프로세스마다 주소가 다르므로 내부 포인터는 OffsetPtr 사용 */
+  OSAllocator (const char *name, Shared mode, size_t reserve_size, size_t page_size = SYSTEM_PAGE_SIZE);
   ~OSAllocator();
   void map (size_t size);
   void unmap (size_t size);
+
+  /* 쓰기 보호 기반 dirty 페이지 추적. 열거/리셋은 쓰기가 없는 동기화 지점에서 호출.
+     보호는 커밋된 페이지에만 걸리고 커밋되지 않은 페이지의 폴트는 처리하지 않고 넘김 */
+  void track_dirty (size_t size);
+  void untrack_dirty ();
+  void reset_dirty ();
+  template <typename F>
+  void for_each_dirty (F &&func) const;
+  size_t dirty_page_count () const;
+
+  void *data () const { return base; }
+
+private:
+  /* 추적 범위 안의 커밋된 페이지 보호를 바꿈 */
+  void protect_tracked (int protection);
 };
 
 /* ============ 구현 ============ */
@@ -34,12 +61,181 @@ namespace Detail
     size_t size = (static_cast <size_t> (data) + (align - 1)) & ~(align - 1);
     return T (size);
   }
+
+  struct DirtyRegion
+  {
+    uintptr_t begin;
+    uintptr_t end;
+    size_t page_size;
+    const uint64_t *committed;
+    uint64_t *bits;
+  };
+
+  inline constexpr size_t MAX_DIRTY_REGIONS = 64;
+  inline DirtyRegion dirty_regions[MAX_DIRTY_REGIONS];
+
+  inline bool test_page (const uint64_t *bits, const size_t page)
+  {
+    return (Atomics::load (&bits[page >> 6]) >> (page & 63)) & 1;
+  }
+
+  inline void set_pages (uint64_t *bits, const size_t first, const size_t last, const bool set)
+  {
+    for (size_t page = first; page < last; ++page)
+    {
+      const uint64_t bit = uint64_t (1) << (page & 63);
+      if (set) Atomics::fetch_or (&bits[page >> 6], bit);
+      else Atomics::fetch_and (&bits[page >> 6], ~bit);
+    }
+  }
+
+  /* [page, end) 에서 비트가 set 과 같은 첫 페이지. 없으면 end */
+  inline size_t find_page (const uint64_t *bits, size_t page, const size_t end, const bool set)
+  {
+    while (page < end)
+    {
+      uint64_t word = Atomics::load (&bits[page >> 6]);
+      if (!set) word = ~word;
+      word &= ~uint64_t (0) << (page & 63);
+      if (word)
+      {
+        const size_t found = (page & ~size_t (63)) + size_t (__builtin_ctzll (word));
+        return found < end ? found : end;
+      }
+      page = (page | 63) + 1;
+    }
+    return end;
+  }
+
+  /* [begin, end) 에서 비트가 set 과 같은 연속 구간마다 func (first, last) */
+  template <typename F>
+  void for_each_page_run (const uint64_t *bits, const size_t begin, const size_t end, const bool set, F &&func)
+  {
+    for (size_t page = find_page (bits, begin, end, set); page < end;)
+    {
+      const size_t last = find_page (bits, page, end, !set);
+      func (page, last);
+      page = find_page (bits, last, end, set);
+    }
+  }
+
+  inline uint64_t *allocate_page_bits (const size_t size, const size_t page_size)
+  {
+    const size_t pages = align_to (size, page_size) / page_size;
+    auto *bits = static_cast <uint64_t *> (calloc ((pages + 63) / 64, sizeof (uint64_t)));
+    if (!bits) abort ();
+    return bits;
+  }
+}
+
+template <typename F>
+void OSAllocator::for_each_dirty (F &&func) const
+{
+  if (!dirty_bits) return;
+
+  const size_t page_count = Detail::align_to (tracked_size, page_size) / page_size;
+  size_t run_begin = 0;
+  size_t run_length = 0;
+
+  for (size_t i = 0; i < page_count; ++i)
+  {
+    if (Atomics::load (&dirty_bits[i >> 6]) & (uint64_t (1) << (i & 63)))
+    {
+      if (!run_length) run_begin = i;
+      ++run_length;
+      continue;
+    }
+    if (run_length) func (static_cast <char *> (base) + run_begin * page_size, run_length * page_size);
+    run_length = 0;
+  }
+  if (run_length) func (static_cast <char *> (base) + run_begin * page_size, run_length * page_size);
+}
+
+inline size_t OSAllocator::dirty_page_count () const
+{
+  if (!dirty_bits) return 0;
+
+  const size_t page_count = Detail::align_to (tracked_size, page_size) / page_size;
+  size_t count = 0;
+  for (size_t i = 0; i < (page_count + 63) / 64; ++i)
+    count += __builtin_popcountll (Atomics::load (&dirty_bits[i]));
+  return count;
 }
 
 #if _WIN32
 #elif __APPLE__ || __linux__
 
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <string.h>
+
+namespace Detail
+{
+  inline struct sigaction previous_segv_action;
+  inline struct sigaction previous_bus_action;
+  inline bool dirty_handler_installed = false;
+
+  inline bool mark_dirty (const uintptr_t addr)
+  {
+    for (size_t i = 0; i < MAX_DIRTY_REGIONS; ++i)
+    {
+      DirtyRegion &region = dirty_regions[i];
+      uint64_t *bits = Atomics::load (&region.bits);
+      if (!bits) continue;
+      const uintptr_t end = Atomics::load (&region.end);
+      const uintptr_t begin = Atomics::load (&region.begin);
+      if (addr < begin || addr >= end) continue;
+
+      /* 디커밋된 페이지에 쓰면 그대로 죽어야 함 */
+      const size_t page = (addr - begin) / region.page_size;
+      if (!test_page (region.committed, page)) return false;
+      const uintptr_t page_addr = begin + page * region.page_size;
+      Atomics::fetch_or (&bits[page >> 6], uint64_t (1) << (page & 63));
+      return mprotect (reinterpret_cast <void *> (page_addr), region.page_size, PROT_READ | PROT_WRITE) == 0;
+    }
+    return false;
+  }
+
+  inline void forward_fault (const struct sigaction &previous, int sig, siginfo_t *info, void *context)
+  {
+    if (previous.sa_flags & SA_SIGINFO)
+    {
+      previous.sa_sigaction (sig, info, context);
+      return;
+    }
+    if (previous.sa_handler == SIG_IGN) return;
+    if (previous.sa_handler == SIG_DFL)
+    {
+      signal (sig, SIG_DFL);
+      return;
+    }
+    previous.sa_handler (sig);
+  }
+
+  inline void dirty_fault_handler (int sig, siginfo_t *info, void *context)
+  {
+    if (mark_dirty (reinterpret_cast <uintptr_t> (info->si_addr))) return;
+    forward_fault (sig == SIGBUS ? previous_bus_action : previous_segv_action, sig, info, context);
+  }
+
+  inline void install_dirty_handler ()
+  {
+    bool expected = false;
+    if (!Atomics::compare_exchange (&dirty_handler_installed, &expected, true)) return;
+
+    struct sigaction action;
+    memset (&action, 0, sizeof (action));
+    action.sa_sigaction = dirty_fault_handler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset (&action.sa_mask);
+
+    if (sigaction (SIGSEGV, &action, &previous_segv_action)) abort ();
+    if (sigaction (SIGBUS, &action, &previous_bus_action)) abort ();
+  }
+}
 
 inline OSAllocator::OSAllocator (const size_t reserve_size, const size_t page_size, const size_t alignment)
 {
@@ -53,6 +249,7 @@ inline OSAllocator::OSAllocator (const size_t reserve_size, const size_t page_si
     this->reserved_size = reserve_size;
     this->page_size = page_size;
     this->alignment = alignment;
+    this->committed_bits = Detail::allocate_page_bits (reserve_size, page_size);
     return;
   }
 
@@ -75,12 +272,63 @@ inline OSAllocator::OSAllocator (const size_t reserve_size, const size_t page_si
   this->reserved_size = reserve_size;
   this->page_size = page_size;
   this->alignment = alignment;
+  this->committed_bits = Detail::allocate_page_bits (reserve_size, page_size);
+}
+
+inline OSAllocator::OSAllocator (const char *name, const Shared mode, const size_t reserve_size, const size_t page_size)
+{
+  const size_t aligned_reserve_size = Detail::align_to (reserve_size, page_size);
+
+  const int flags = mode == Shared::Create ? O_RDWR | O_CREAT | O_EXCL : O_RDWR;
+  const int fd = shm_open (name, flags, S_IRUSR | S_IWUSR);
+  if (fd < 0) abort ();
+
+  if (mode == Shared::Create)
+  {
+    if (ftruncate (fd, static_cast <off_t> (aligned_reserve_size))) abort ();
+    this->shared_name = strdup (name);
+    if (!this->shared_name) abort ();
+  }
+  else
+  {
+    /* 만든 쪽이 shm_open 과 ftruncate 사이에 있을 수 있으므로 크기가 잡힐 때까지 잠시 기다림 (최대 약 1 초) */
+    struct stat info;
+    for (int attempt = 0;; ++attempt)
+    {
+      if (fstat (fd, &info)) abort ();
+      if (static_cast <size_t> (info.st_size) >= aligned_reserve_size) break;
+      if (attempt == 1000) abort ();
+      usleep (1000);
+    }
+  }
+
+  void *ptr = mmap (nullptr, aligned_reserve_size, PROT_NONE, MAP_SHARED | MAP_NORESERVE, fd, 0);
+  if (ptr == MAP_FAILED) abort ();
+
+  this->base = ptr;
+  this->reserved_size = reserve_size;
+  this->page_size = page_size;
+  this->alignment = 0;
+  this->shared_fd = fd;
+  this->committed_bits = Detail::allocate_page_bits (reserve_size, page_size);
 }
 
 inline OSAllocator::~OSAllocator()
 {
+  if (dirty_bits) untrack_dirty ();
+  free (committed_bits);
+
   const size_t aligned_reserved_size = Detail::align_to (reserved_size, page_size);
-  if (alignment <= page_size)
+  if (shared_fd >= 0)
+  {
+    if (munmap (base, aligned_reserved_size) || close (shared_fd)) abort ();
+    if (shared_name)
+    {
+      shm_unlink (shared_name);
+      free (shared_name);
+    }
+  }
+  else if (alignment <= page_size)
   {
     if (munmap (base, aligned_reserved_size)) abort ();
   }
@@ -93,18 +341,114 @@ inline OSAllocator::~OSAllocator()
   }
 }
 
+namespace Detail
+{
+  inline void protect_pages (void *base, const size_t begin, const size_t end, const int protection)
+  {
+    if (begin < end && mprotect (static_cast <char *> (base) + begin, end - begin, protection)) abort ();
+  }
+}
+
+/* 이미 커밋된 페이지는 건드리지 않으므로 내용과 보호 (dirty 로 풀린 쓰기 권한 포함) 가 그대로 남음 */
 inline void OSAllocator::map(const size_t size)
 {
-  const uintptr_t base_addr = reinterpret_cast <uintptr_t> (base) & ~(page_size - 1);
-  const uintptr_t end_addr = Detail::align_to (reinterpret_cast <uintptr_t> (base) + size, page_size);
-  if (mprotect (reinterpret_cast <void *> (base_addr), end_addr - base_addr, PROT_READ | PROT_WRITE)) abort ();
+  const size_t pages = Detail::align_to (size, page_size) / page_size;
+  const size_t tracked_pages = tracked_size / page_size;
+  Detail::for_each_page_run (committed_bits, 0, pages, false, [&] (const size_t first, const size_t last)
+  {
+    /* 추적 범위 안은 읽기 전용으로 커밋해 첫 쓰기를 잡고, 밖은 바로 쓰기 가능 */
+    const size_t split = tracked_pages < first ? first : tracked_pages < last ? tracked_pages : last;
+    Detail::protect_pages (base, first * page_size, split * page_size, PROT_READ);
+    Detail::protect_pages (base, split * page_size, last * page_size, PROT_READ | PROT_WRITE);
+    Detail::set_pages (committed_bits, first, last, true);
+  });
 }
 
 inline void OSAllocator::unmap(const size_t size)
 {
-  const uintptr_t base_addr = reinterpret_cast <uintptr_t> (base) & ~(page_size - 1);
-  const uintptr_t end_addr = Detail::align_to (reinterpret_cast <uintptr_t> (base) + size, page_size);
-  if (mprotect (reinterpret_cast <void *> (base_addr), end_addr - base_addr, PROT_NONE)) abort ();
+  const size_t pages = Detail::align_to (size, page_size) / page_size;
+  const size_t tracked_pages = tracked_size / page_size;
+  Detail::for_each_page_run (committed_bits, 0, pages, true, [&] (const size_t first, const size_t last)
+  {
+    Detail::protect_pages (base, first * page_size, last * page_size, PROT_NONE);
+    Detail::set_pages (committed_bits, first, last, false);
+
+    /* 디커밋된 페이지는 더 이상 dirty 로 열거하지 않음 */
+    if (dirty_bits && first < tracked_pages) Detail::set_pages (dirty_bits, first, last < tracked_pages ? last : tracked_pages, false);
+  });
+}
+
+inline void OSAllocator::protect_tracked (const int protection)
+{
+  Detail::for_each_page_run (committed_bits, 0, tracked_size / page_size, true, [&] (const size_t first, const size_t last)
+  {
+    Detail::protect_pages (base, first * page_size, last * page_size, protection);
+  });
+}
+
+inline void OSAllocator::track_dirty (const size_t size)
+{
+  if (dirty_bits || size > Detail::align_to (reserved_size, page_size)) abort ();
+
+  const size_t page_count = Detail::align_to (size, page_size) / page_size;
+  dirty_bits = static_cast <uint64_t *> (calloc ((page_count + 63) / 64, sizeof (uint64_t)));
+  if (!dirty_bits) abort ();
+  tracked_size = page_count * page_size;
+
+  Detail::install_dirty_handler ();
+
+  Detail::DirtyRegion *region = nullptr;
+  for (Detail::DirtyRegion &candidate : Detail::dirty_regions)
+  {
+    uint64_t *expected = nullptr;
+    if (!Atomics::compare_exchange (&candidate.bits, &expected, dirty_bits)) continue;
+    region = &candidate;
+    break;
+  }
+  if (!region) abort ();
+
+  region->page_size = page_size;
+  region->committed = committed_bits;
+  Atomics::store (&region->begin, reinterpret_cast <uintptr_t> (base));
+  Atomics::store (&region->end, reinterpret_cast <uintptr_t> (base) + tracked_size);
+
+  /* 커밋된 페이지만 읽기 전용으로. 예약만 된 페이지는 PROT_NONE 그대로 */
+  protect_tracked (PROT_READ);
+}
+
+inline void OSAllocator::untrack_dirty ()
+{
+  if (!dirty_bits) return;
+
+  protect_tracked (PROT_READ | PROT_WRITE);
+
+  for (Detail::DirtyRegion &region : Detail::dirty_regions)
+  {
+    if (Atomics::load (&region.bits) != dirty_bits) continue;
+    Atomics::store (&region.end, uintptr_t (0));
+    Atomics::store (&region.begin, uintptr_t (0));
+    Atomics::store (&region.bits, static_cast <uint64_t *> (nullptr));
+    break;
+  }
+
+  free (dirty_bits);
+  dirty_bits = nullptr;
+  tracked_size = 0;
+}
+
+inline void OSAllocator::reset_dirty ()
+{
+  if (!dirty_bits) return;
+
+  /* dirty 비트는 커밋된 페이지에만 남아 있음 (unmap 이 지움) */
+  for_each_dirty ([] (void *ptr, size_t length)
+  {
+    if (mprotect (ptr, length, PROT_READ)) abort ();
+  });
+
+  const size_t page_count = tracked_size / page_size;
+  for (size_t i = 0; i < (page_count + 63) / 64; ++i)
+    Atomics::store (&dirty_bits[i], uint64_t (0));
 }
 
 #endif
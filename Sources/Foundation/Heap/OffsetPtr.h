@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/* 자기 자신으로부터의 상대 주소를 저장하는 포인터. 프로세스마다 다른 주소에 매핑된 공유 메모리 안에서 사용 */
+template <typename T>
+class OffsetPtr
+{
+  /* 0 은 "자기 자신을 가리킴" 이라 쓸 수 없음 (구조체 첫 멤버가 자기를 담은 객체를 가리키는 경우 등).
+     1 은 OffsetPtr 자신이 intptr_t 정렬이므로 T 가 1 바이트 넘게 정렬되면 나올 수 없는 상대 주소.
+     char 같은 1 바이트 정렬 T 에서는 포인터 바로 다음 바이트를 가리킬 수 없음 */
+  static constexpr intptr_t NULL_OFFSET = 1;
+  intptr_t offset;
+
+  intptr_t offset_to (const T *ptr) const
+  {
+    if (!ptr) return NULL_OFFSET;
+    return reinterpret_cast <intptr_t> (ptr) - reinterpret_cast <intptr_t> (this);
+  }
+
+public:
+  OffsetPtr () : offset (NULL_OFFSET) {}
+  OffsetPtr (T *ptr) : offset (offset_to (ptr)) {}
+  OffsetPtr (const OffsetPtr &other) : offset (offset_to (other.get ())) {}
+
+  OffsetPtr &operator= (const OffsetPtr &other) { offset = offset_to (other.get ()); return *this; }
+  OffsetPtr &operator= (T *ptr) { offset = offset_to (ptr); return *this; }
+
+  T *get () const
+  {
+    if (offset == NULL_OFFSET) return nullptr;
+    return reinterpret_cast <T *> (reinterpret_cast <intptr_t> (this) + offset);
+  }
+
+  T *operator-> () const { return get (); }
+  T &operator* () const { return *get (); }
+  T &operator[] (size_t index) const { return get ()[index]; }
+  explicit operator bool () const { return offset != NULL_OFFSET; }
+};
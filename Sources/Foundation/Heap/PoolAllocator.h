@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include "Foundation/Heap/OSAllocator.h"
+
+/* 고정 크기 블록 풀. 최대 블록 수만큼 주소 공간을 예약하고 필요한 만큼만 커밋.
+   블록 주소가 움직이지 않으므로 인덱스와 포인터를 자유롭게 변환 가능. 단일 스레드 전용 */
+class PoolAllocator
+{
+  OSAllocator memory;
+  size_t block_size;
+  size_t max_blocks;
+  size_t committed_blocks = 0;
+  size_t used_blocks = 0;
+  size_t live_blocks = 0;
+  void *free_list = nullptr;
+
+public:
+  PoolAllocator (size_t block_size, size_t max_blocks);
+
+  PoolAllocator (const PoolAllocator &) = delete;
+  PoolAllocator &operator= (const PoolAllocator &) = delete;
+
+  void *allocate ();
+  void free (void *ptr);
+
+  size_t index_of (const void *ptr) const;
+  void *at (size_t index) const;
+
+  size_t size () const { return live_blocks; }
+  size_t used () const { return used_blocks; }    /* 한 번이라도 내준 블록 수. at 으로 읽어도 되는 범위 */
+  size_t capacity () const { return max_blocks; }
+};
+
+/* ============ 구현 ============ */
+inline PoolAllocator::PoolAllocator (const size_t block_size, const size_t max_blocks)
+  : memory (Detail::align_to (block_size, alignof (max_align_t)) * max_blocks),
+    block_size (Detail::align_to (block_size, alignof (max_align_t))),
+    max_blocks (max_blocks)
+{
+}
+
+inline void *PoolAllocator::allocate ()
+{
+  if (free_list)
+  {
+    void *block = free_list;
+    free_list = *static_cast <void **> (block);
+    ++live_blocks;
+    return block;
+  }
+
+  if (used_blocks == max_blocks) return nullptr;
+
+  if (used_blocks == committed_blocks)
+  {
+    const size_t grow_bytes = Detail::align_to (block_size * (committed_blocks / 2 + 1), SYSTEM_PAGE_SIZE);
+    size_t target = committed_blocks + grow_bytes / block_size;
+    if (target > max_blocks) target = max_blocks;
+    memory.map (target * block_size);
+    committed_blocks = target;
+  }
+
+  ++live_blocks;
+  return static_cast <char *> (memory.data ()) + block_size * used_blocks++;
+}
+
+inline void PoolAllocator::free (void *ptr)
+{
+  if (!ptr) return;
+  *static_cast <void **> (ptr) = free_list;
+  free_list = ptr;
+  --live_blocks;
+}
+
+inline size_t PoolAllocator::index_of (const void *ptr) const
+{
+  return size_t (static_cast <const char *> (ptr) - static_cast <const char *> (memory.data ())) / block_size;
+}
+
+inline void *PoolAllocator::at (const size_t index) const
+{
+  return static_cast <char *> (memory.data ()) + block_size * index;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+#include "Foundation/Heap/OSAllocator.h"
+
+/* 최대 크기만큼 주소 공간을 예약하고 커진 만큼만 커밋하는 배열. 재할당이 없어 포인터가 움직이지 않음.
+   새로 커밋된 원소는 0 으로 채워져 있음. 단일 스레드 전용 */
+template <typename T>
+class VirtualArray
+{
+  static_assert (std::is_trivially_copyable_v <T>);
+
+  OSAllocator memory;
+  size_t max_count;
+  size_t count = 0;
+  size_t committed = 0;
+
+public:
+  explicit VirtualArray (size_t max_count);
+
+  VirtualArray (const VirtualArray &) = delete;
+  VirtualArray &operator= (const VirtualArray &) = delete;
+
+  /* 원소 수를 바꾸지 않고 n 개까지 커밋 */
+  void reserve (size_t n);
+  void resize (size_t n);
+  T *push_back (const T &value);
+  void swap_remove (size_t index);
+  void clear () { count = 0; }
+
+  T *data () const { return static_cast <T *> (memory.data ()); }
+  T &operator[] (size_t index) const { return data ()[index]; }
+
+  size_t size () const { return count; }
+  size_t capacity () const { return max_count; }
+};
+
+/* ============ 구현 ============ */
+template <typename T>
+VirtualArray <T>::VirtualArray (const size_t max_count)
+  : memory (sizeof (T) * max_count),
+    max_count (max_count)
+{
+}
+
+template <typename T>
+void VirtualArray <T>::reserve (const size_t n)
+{
+  if (n <= committed) return;
+  if (n > max_count) abort ();
+
+  size_t target = committed + committed / 2;
+  if (target < n) target = n;
+  if (target > max_count) target = max_count;
+
+  memory.map (sizeof (T) * target);
+  committed = Detail::align_to (sizeof (T) * target, SYSTEM_PAGE_SIZE) / sizeof (T);
+  if (committed > max_count) committed = max_count;
+}
+
+template <typename T>
+void VirtualArray <T>::resize (const size_t n)
+{
+  reserve (n);
+  count = n;
+}
+
+template <typename T>
+T *VirtualArray <T>::push_back (const T &value)
+{
+  reserve (count + 1);
+  T *slot = data () + count++;
+  memcpy (static_cast <void *> (slot), &value, sizeof (T));
+  return slot;
+}
+
+template <typename T>
+void VirtualArray <T>::swap_remove (const size_t index)
+{
+  --count;
+  if (index != count) memcpy (static_cast <void *> (data () + index), data () + count, sizeof (T));
+}
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if __AVX2__
+#include <immintrin.h>
+#elif __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+/* Q 포맷 고정소수점. 모든 연산이 정수 연산이라 컴파일러/CPU 와 무관하게 비트 단위로 같은 결과.
+   곱셈은 -inf 방향 내림, 오버플로는 2의 보수로 감김 */
+template <typename Storage, typename Wide, int FractionBits>
+class Fixed
+{
+public:
+  static constexpr int FRACTION_BITS = FractionBits;
+  static constexpr Storage ONE = Storage (1) << FractionBits;
+
+  Storage raw;
+
+  constexpr Fixed () : raw (0) {}
+
+  static constexpr Fixed from_raw (Storage raw) { Fixed value; value.raw = raw; return value; }
+  static constexpr Fixed from_int (Storage value) { return from_raw (Storage (value * ONE)); }
+  static constexpr Fixed from_ratio (Storage numerator, Storage denominator) { return from_raw (Storage (Wide (numerator) * ONE / denominator)); }
+  /* 상수 초기화용. 실행 중 시뮬레이션 경로에서는 사용하지 않음 */
+  static constexpr Fixed from_double (double value) { return from_raw (Storage (value * double (ONE) + (value < 0 ? -0.5 : 0.5))); }
+
+  constexpr Storage to_int () const { return raw >> FractionBits; }
+  constexpr float to_float () const { return float (raw) / float (ONE); }
+  constexpr double to_double () const { return double (raw) / double (ONE); }
+
+  constexpr Fixed operator+ (Fixed other) const { return from_raw (Storage (raw + other.raw)); }
+  constexpr Fixed operator- (Fixed other) const { return from_raw (Storage (raw - other.raw)); }
+  constexpr Fixed operator- () const { return from_raw (Storage (-raw)); }
+  constexpr Fixed operator* (Fixed other) const { return from_raw (Storage ((Wide (raw) * other.raw) >> FractionBits)); }
+  constexpr Fixed operator/ (Fixed other) const { return from_raw (Storage ((Wide (raw) << FractionBits) / other.raw)); }
+
+  constexpr Fixed &operator+= (Fixed other) { return *this = *this + other; }
+  constexpr Fixed &operator-= (Fixed other) { return *this = *this - other; }
+  constexpr Fixed &operator*= (Fixed other) { return *this = *this * other; }
+  constexpr Fixed &operator/= (Fixed other) { return *this = *this / other; }
+
+  constexpr bool operator== (const Fixed &) const = default;
+  constexpr auto operator<=> (const Fixed &) const = default;
+};
+
+#if defined (__SIZEOF_INT128__)
+using Fixed64 = Fixed <int64_t, __int128, 32>;
+#endif
+using Fixed32 = Fixed <int32_t, int64_t, 16>;
+
+namespace FixedMath
+{
+  template <typename F>
+  constexpr F abs (F value) { return value.raw < 0 ? -value : value; }
+
+  template <typename F>
+  constexpr F min (F a, F b) { return a < b ? a : b; }
+
+  template <typename F>
+  constexpr F max (F a, F b) { return a < b ? b : a; }
+
+  template <typename F>
+  constexpr F sqrt (F value);
+
+  template <typename F>
+  constexpr F sin (F angle);
+
+  template <typename F>
+  constexpr F cos (F angle);
+
+  /* 배열 커널. SIMD 경로와 스칼라 경로의 결과가 비트 단위로 같음 */
+  void add (const Fixed32 *a, const Fixed32 *b, Fixed32 *out, size_t count);
+  void mul (const Fixed32 *a, const Fixed32 *b, Fixed32 *out, size_t count);
+  void mul_add (const Fixed32 *a, const Fixed32 *b, const Fixed32 *c, Fixed32 *out, size_t count);
+} /* namespace FixedMath */
+
+/* ============ 구현 ============ */
+namespace FixedMath
+{
+  template <typename F>
+  constexpr F sqrt (F value)
+  {
+    using Storage = decltype (value.raw);
+    using Unsigned = std::make_unsigned_t <Storage>;
+    if (value.raw <= 0) return F ();
+
+    /* 비트 단위 정수 제곱근: sqrt(raw << FRACTION_BITS) */
+#if defined (__SIZEOF_INT128__)
+    using WideUnsigned = std::conditional_t <sizeof (Storage) == 4, uint64_t, unsigned __int128>;
+#else
+    using WideUnsigned = uint64_t;
+#endif
+    WideUnsigned remainder = WideUnsigned (Unsigned (value.raw)) << F::FRACTION_BITS;
+    WideUnsigned root = 0;
+    WideUnsigned bit = WideUnsigned (1) << (sizeof (WideUnsigned) * 8 - 2);
+    while (bit > remainder) bit >>= 2;
+    while (bit)
+    {
+      if (remainder >= root + bit)
+      {
+        remainder -= root + bit;
+        root = (root >> 1) + bit;
+      }
+      else root >>= 1;
+      bit >>= 2;
+    }
+    return F::from_raw (Storage (root));
+  }
+
+  template <typename F>
+  constexpr F sin (F angle)
+  {
+    constexpr F PI = F::from_double (3.14159265358979323846);
+    constexpr F TWO_PI = F::from_double (6.28318530717958647692);
+    constexpr F HALF_PI = F::from_double (1.57079632679489661923);
+
+    F x = F::from_raw (angle.raw % TWO_PI.raw);
+    if (x > PI) x -= TWO_PI;
+    else if (x < -PI) x += TWO_PI;
+
+    if (x > HALF_PI) x = PI - x;
+    else if (x < -HALF_PI) x = -PI - x;
+
+    /* [-pi/2, pi/2] 에서 9차 테일러 다항식 */
+    constexpr F C3 = F::from_double (-1.0 / 6.0);
+    constexpr F C5 = F::from_double (1.0 / 120.0);
+    constexpr F C7 = F::from_double (-1.0 / 5040.0);
+    constexpr F C9 = F::from_double (1.0 / 362880.0);
+    const F x2 = x * x;
+    return x * (F::from_int (1) + x2 * (C3 + x2 * (C5 + x2 * (C7 + x2 * C9))));
+  }
+
+  template <typename F>
+  constexpr F cos (F angle)
+  {
+    return sin (angle + F::from_double (1.57079632679489661923));
+  }
+
+  inline void add (const Fixed32 *a, const Fixed32 *b, Fixed32 *out, const size_t count)
+  {
+    size_t i = 0;
+#if __AVX2__
+    for (; i + 8 <= count; i += 8)
+    {
+      const __m256i va = _mm256_loadu_si256 (reinterpret_cast <const __m256i *> (a + i));
+      const __m256i vb = _mm256_loadu_si256 (reinterpret_cast <const __m256i *> (b + i));
+      _mm256_storeu_si256 (reinterpret_cast <__m256i *> (out + i), _mm256_add_epi32 (va, vb));
+    }
+#elif __ARM_NEON
+    for (; i + 4 <= count; i += 4)
+    {
+      const int32x4_t va = vld1q_s32 (&a[i].raw);
+      const int32x4_t vb = vld1q_s32 (&b[i].raw);
+      vst1q_s32 (&out[i].raw, vaddq_s32 (va, vb));
+    }
+#endif
+    for (; i < count; ++i) out[i] = a[i] + b[i];
+  }
+
+#if __AVX2__
+  namespace Detail
+  {
+    inline __m256i mul_q16 (const __m256i a, const __m256i b)
+    {
+      const __m256i even = _mm256_srli_epi64 (_mm256_mul_epi32 (a, b), 16);
+      const __m256i odd = _mm256_slli_epi64 (_mm256_mul_epi32 (_mm256_srli_epi64 (a, 32), _mm256_srli_epi64 (b, 32)), 16);
+      return _mm256_blend_epi32 (even, odd, 0xAA);
+    }
+  }
+#elif __ARM_NEON
+  namespace Detail
+  {
+    inline int32x4_t mul_q16 (const int32x4_t a, const int32x4_t b)
+    {
+      const int64x2_t low = vmull_s32 (vget_low_s32 (a), vget_low_s32 (b));
+      const int64x2_t high = vmull_s32 (vget_high_s32 (a), vget_high_s32 (b));
+      return vcombine_s32 (vshrn_n_s64 (low, 16), vshrn_n_s64 (high, 16));
+    }
+  }
+#endif
+
+  inline void mul (const Fixed32 *a, const Fixed32 *b, Fixed32 *out, const size_t count)
+  {
+    size_t i = 0;
+#if __AVX2__
+    for (; i + 8 <= count; i += 8)
+    {
+      const __m256i va = _mm256_loadu_si256 (reinterpret_cast <const __m256i *> (a + i));
+      const __m256i vb = _mm256_loadu_si256 (reinterpret_cast <const __m256i *> (b + i));
+      _mm256_storeu_si256 (reinterpret_cast <__m256i *> (out + i), Detail::mul_q16 (va, vb));
+    }
+#elif __ARM_NEON
+    for (; i + 4 <= count; i += 4)
+      vst1q_s32 (&out[i].raw, Detail::mul_q16 (vld1q_s32 (&a[i].raw), vld1q_s32 (&b[i].raw)));
+#endif
+    for (; i < count; ++i) out[i] = a[i] * b[i];
+  }
+
+  inline void mul_add (const Fixed32 *a, const Fixed32 *b, const Fixed32 *c, Fixed32 *out, const size_t count)
+  {
+    size_t i = 0;
+#if __AVX2__
+    for (; i + 8 <= count; i += 8)
+    {
+      const __m256i va = _mm256_loadu_si256 (reinterpret_cast <const __m256i *> (a + i));
+      const __m256i vb = _mm256_loadu_si256 (reinterpret_cast <const __m256i *> (b + i));
+      const __m256i vc = _mm256_loadu_si256 (reinterpret_cast <const __m256i *> (c + i));
+      _mm256_storeu_si256 (reinterpret_cast <__m256i *> (out + i), _mm256_add_epi32 (Detail::mul_q16 (va, vb), vc));
+    }
+#elif __ARM_NEON
+    for (; i + 4 <= count; i += 4)
+    {
+      const int32x4_t product = Detail::mul_q16 (vld1q_s32 (&a[i].raw), vld1q_s32 (&b[i].raw));
+      vst1q_s32 (&out[i].raw, vaddq_s32 (product, vld1q_s32 (&c[i].raw)));
+    }
+#endif
+    for (; i < count; ++i) out[i] = a[i] * b[i] + c[i];
+  }
+} /* namespace FixedMath */
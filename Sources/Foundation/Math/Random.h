@@ -0,0 +1,549 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if __AVX2__
+#include <immintrin.h>
+#elif __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+/* 시드 확장용 */
+struct SplitMix64
+{
+  uint64_t state;
+
+  uint64_t next ()
+  {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+};
+
+/* xoshiro256**. jump 는 2^128, long_jump 는 2^192 만큼 건너뛰므로 워커마다 겹치지 않는 스트림을 만들 수 있음 */
+class Xoshiro256
+{
+public:
+  uint64_t s[4];
+
+  explicit Xoshiro256 (uint64_t seed = 0);
+  static Xoshiro256 stream (uint64_t seed, uint32_t index);
+
+  uint64_t next ();
+  uint32_t next_u32 () { return uint32_t (next () >> 32); }
+  uint32_t next_below (uint32_t bound);
+  float next_float () { return float (next () >> 40) * 0x1.0p-24f; }
+  double next_double () { return double (next () >> 11) * 0x1.0p-53; }
+
+  void jump ();
+  void long_jump ();
+
+  void fill (uint64_t *out, size_t count);
+  void fill (uint32_t *out, size_t count);
+  void fill (float *out, size_t count);
+
+private:
+  void jump_with (const uint64_t (&table)[4]);
+};
+
+/* PCG32 (XSH-RR). increment 로 스트림을 나누고 advance 로 O(log n) 건너뛰기 */
+class Pcg32
+{
+public:
+  uint64_t state;
+  uint64_t increment;
+
+  explicit Pcg32 (uint64_t seed = 0, uint64_t stream = 0);
+
+  uint32_t next ();
+  uint32_t next_below (uint32_t bound);
+  float next_float () { return float (next () >> 8) * 0x1.0p-24f; }
+
+  void advance (uint64_t delta);
+
+  void fill (uint32_t *out, size_t count);
+  void fill (float *out, size_t count);
+};
+
+/* 레인마다 독립된 xoshiro256** 상태. AVX2 는 8 레인, NEON 은 4 레인, 그 외에는 스칼라 8 레인 */
+class XoshiroWide
+{
+public:
+#if __ARM_NEON && !__AVX2__
+  static constexpr size_t LANES = 4;
+#else
+  static constexpr size_t LANES = 8;
+#endif
+
+  alignas (32) uint64_t s[4][LANES];
+
+  explicit XoshiroWide (uint64_t seed = 0);
+  static XoshiroWide stream (uint64_t seed, uint32_t index);
+
+  /* LANES 개의 64비트 값을 생성 */
+  void next (uint64_t *out);
+
+  void fill (uint64_t *out, size_t count);
+  void fill (uint32_t *out, size_t count);
+  void fill (float *out, size_t count);
+  void fill (float *out, size_t count, float low, float high);
+};
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  inline uint64_t rotl (const uint64_t x, const int k)
+  {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  inline constexpr uint64_t XOSHIRO_JUMP[4] = { 0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull };
+  inline constexpr uint64_t XOSHIRO_LONG_JUMP[4] = { 0x76e15d3efefdcbbfull, 0xc5004e441c522fb3ull, 0x77710069854ee241ull, 0x39109bb02acbe635ull };
+}
+
+inline Xoshiro256::Xoshiro256 (const uint64_t seed)
+{
+  SplitMix64 mix { seed };
+  for (uint64_t &word : s) word = mix.next ();
+}
+
+inline Xoshiro256 Xoshiro256::stream (const uint64_t seed, const uint32_t index)
+{
+  Xoshiro256 generator (seed);
+  for (uint32_t i = 0; i < index; ++i) generator.jump ();
+  return generator;
+}
+
+inline uint64_t Xoshiro256::next ()
+{
+  const uint64_t result = Detail::rotl (s[1] * 5, 7) * 9;
+  const uint64_t t = s[1] << 17;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = Detail::rotl (s[3], 45);
+
+  return result;
+}
+
+inline uint32_t Xoshiro256::next_below (const uint32_t bound)
+{
+  uint64_t product = uint64_t (next_u32 ()) * bound;
+  uint32_t low = uint32_t (product);
+  if (low < bound)
+  {
+    const uint32_t threshold = uint32_t (-bound) % bound;
+    while (low < threshold)
+    {
+      product = uint64_t (next_u32 ()) * bound;
+      low = uint32_t (product);
+    }
+  }
+  return uint32_t (product >> 32);
+}
+
+inline void Xoshiro256::jump_with (const uint64_t (&table)[4])
+{
+  uint64_t result[4] = {};
+  for (const uint64_t word : table)
+    for (int bit = 0; bit < 64; ++bit)
+    {
+      if (word & (uint64_t (1) << bit))
+        for (int i = 0; i < 4; ++i) result[i] ^= s[i];
+      next ();
+    }
+  memcpy (s, result, sizeof (s));
+}
+
+inline void Xoshiro256::jump () { jump_with (Detail::XOSHIRO_JUMP); }
+inline void Xoshiro256::long_jump () { jump_with (Detail::XOSHIRO_LONG_JUMP); }
+
+inline void Xoshiro256::fill (uint64_t *out, const size_t count)
+{
+  for (size_t i = 0; i < count; ++i) out[i] = next ();
+}
+
+inline void Xoshiro256::fill (uint32_t *out, const size_t count)
+{
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2)
+  {
+    const uint64_t value = next ();
+    out[i] = uint32_t (value);
+    out[i + 1] = uint32_t (value >> 32);
+  }
+  if (i < count) out[i] = next_u32 ();
+}
+
+inline void Xoshiro256::fill (float *out, const size_t count)
+{
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2)
+  {
+    const uint64_t value = next ();
+    out[i] = float (uint32_t (value) >> 8) * 0x1.0p-24f;
+    out[i + 1] = float (value >> 40) * 0x1.0p-24f;
+  }
+  if (i < count) out[i] = next_float ();
+}
+
+inline Pcg32::Pcg32 (const uint64_t seed, const uint64_t stream)
+{
+  state = 0;
+  increment = (stream << 1) | 1;
+  next ();
+  state += seed;
+  next ();
+}
+
+inline uint32_t Pcg32::next ()
+{
+  const uint64_t old = state;
+  state = old * 6364136223846793005ull + increment;
+  const uint32_t xorshifted = uint32_t (((old >> 18) ^ old) >> 27);
+  const uint32_t rotation = uint32_t (old >> 59);
+  return (xorshifted >> rotation) | (xorshifted << ((32 - rotation) & 31));
+}
+
+inline uint32_t Pcg32::next_below (const uint32_t bound)
+{
+  uint64_t product = uint64_t (next ()) * bound;
+  uint32_t low = uint32_t (product);
+  if (low < bound)
+  {
+    const uint32_t threshold = uint32_t (-bound) % bound;
+    while (low < threshold)
+    {
+      product = uint64_t (next ()) * bound;
+      low = uint32_t (product);
+    }
+  }
+  return uint32_t (product >> 32);
+}
+
+inline void Pcg32::advance (uint64_t delta)
+{
+  uint64_t multiplier = 6364136223846793005ull;
+  uint64_t addend = increment;
+  uint64_t total_multiplier = 1;
+  uint64_t total_addend = 0;
+
+  while (delta)
+  {
+    if (delta & 1)
+    {
+      total_multiplier *= multiplier;
+      total_addend = total_addend * multiplier + addend;
+    }
+    addend = (multiplier + 1) * addend;
+    multiplier *= multiplier;
+    delta >>= 1;
+  }
+  state = total_multiplier * state + total_addend;
+}
+
+inline void Pcg32::fill (uint32_t *out, const size_t count)
+{
+  for (size_t i = 0; i < count; ++i) out[i] = next ();
+}
+
+inline void Pcg32::fill (float *out, const size_t count)
+{
+  for (size_t i = 0; i < count; ++i) out[i] = next_float ();
+}
+
+inline XoshiroWide::XoshiroWide (const uint64_t seed)
+{
+  Xoshiro256 lane (seed);
+  for (size_t l = 0; l < LANES; ++l)
+  {
+    for (int w = 0; w < 4; ++w) s[w][l] = lane.s[w];
+    lane.jump ();
+  }
+}
+
+inline XoshiroWide XoshiroWide::stream (const uint64_t seed, const uint32_t index)
+{
+  XoshiroWide generator (seed);
+  for (size_t l = 0; l < LANES; ++l)
+  {
+    Xoshiro256 lane (0);
+    for (int w = 0; w < 4; ++w) lane.s[w] = generator.s[w][l];
+    for (uint32_t i = 0; i < index; ++i) lane.long_jump ();
+    for (int w = 0; w < 4; ++w) generator.s[w][l] = lane.s[w];
+  }
+  return generator;
+}
+
+#if __AVX2__
+
+namespace Detail
+{
+  inline __m256i rotl (const __m256i x, const int k)
+  {
+    return _mm256_or_si256 (_mm256_slli_epi64 (x, k), _mm256_srli_epi64 (x, 64 - k));
+  }
+
+  /* 4 레인 xoshiro256** 한 단계. 곱셈은 시프트와 덧셈으로 대체 (x*5, x*9) */
+  inline __m256i xoshiro_step (__m256i &s0, __m256i &s1, __m256i &s2, __m256i &s3)
+  {
+    const __m256i times5 = _mm256_add_epi64 (_mm256_slli_epi64 (s1, 2), s1);
+    const __m256i rotated = rotl (times5, 7);
+    const __m256i result = _mm256_add_epi64 (_mm256_slli_epi64 (rotated, 3), rotated);
+    const __m256i t = _mm256_slli_epi64 (s1, 17);
+
+    s2 = _mm256_xor_si256 (s2, s0);
+    s3 = _mm256_xor_si256 (s3, s1);
+    s1 = _mm256_xor_si256 (s1, s2);
+    s0 = _mm256_xor_si256 (s0, s3);
+    s2 = _mm256_xor_si256 (s2, t);
+    s3 = rotl (s3, 45);
+    return result;
+  }
+}
+
+inline void XoshiroWide::next (uint64_t *out)
+{
+  fill (out, LANES);
+}
+
+inline void XoshiroWide::fill (uint64_t *out, const size_t count)
+{
+  __m256i a0 = _mm256_load_si256 (reinterpret_cast <const __m256i *> (&s[0][0]));
+  __m256i a1 = _mm256_load_si256 (reinterpret_cast <const __m256i *> (&s[1][0]));
+  __m256i a2 = _mm256_load_si256 (reinterpret_cast <const __m256i *> (&s[2][0]));
+  __m256i a3 = _mm256_load_si256 (reinterpret_cast <const __m256i *> (&s[3][0]));
+  __m256i b0 = _mm256_load_si256 (reinterpret_cast <const __m256i *> (&s[0][4]));
+  __m256i b1 = _mm256_load_si256 (reinterpret_cast <const __m256i *> (&s[1][4]));
+  __m256i b2 = _mm256_load_si256 (reinterpret_cast <const __m256i *> (&s[2][4]));
+  __m256i b3 = _mm256_load_si256 (reinterpret_cast <const __m256i *> (&s[3][4]));
+
+  size_t i = 0;
+  for (; i + LANES <= count; i += LANES)
+  {
+    _mm256_storeu_si256 (reinterpret_cast <__m256i *> (out + i), Detail::xoshiro_step (a0, a1, a2, a3));
+    _mm256_storeu_si256 (reinterpret_cast <__m256i *> (out + i + 4), Detail::xoshiro_step (b0, b1, b2, b3));
+  }
+  if (i < count)
+  {
+    alignas (32) uint64_t tail[LANES];
+    _mm256_store_si256 (reinterpret_cast <__m256i *> (tail), Detail::xoshiro_step (a0, a1, a2, a3));
+    _mm256_store_si256 (reinterpret_cast <__m256i *> (tail + 4), Detail::xoshiro_step (b0, b1, b2, b3));
+    memcpy (out + i, tail, (count - i) * sizeof (uint64_t));
+  }
+
+  _mm256_store_si256 (reinterpret_cast <__m256i *> (&s[0][0]), a0);
+  _mm256_store_si256 (reinterpret_cast <__m256i *> (&s[1][0]), a1);
+  _mm256_store_si256 (reinterpret_cast <__m256i *> (&s[2][0]), a2);
+  _mm256_store_si256 (reinterpret_cast <__m256i *> (&s[3][0]), a3);
+  _mm256_store_si256 (reinterpret_cast <__m256i *> (&s[0][4]), b0);
+  _mm256_store_si256 (reinterpret_cast <__m256i *> (&s[1][4]), b1);
+  _mm256_store_si256 (reinterpret_cast <__m256i *> (&s[2][4]), b2);
+  _mm256_store_si256 (reinterpret_cast <__m256i *> (&s[3][4]), b3);
+}
+
+inline void XoshiroWide::fill (float *out, const size_t count, const float low, const float high)
+{
+  __m256i a0 = _mm256_load_si256 (reinterpret_cast <const __m256i *> (&s[0][0]));
+  __m256i a1 = _mm256_load_si256 (reinterpret_cast <const __m256i *> (&s[1][0]));
+  __m256i a2 = _mm256_load_si256 (reinterpret_cast <const __m256i *> (&s[2][0]));
+  __m256i a3 = _mm256_load_si256 (reinterpret_cast <const __m256i *> (&s[3][0]));
+  __m256i b0 = _mm256_load_si256 (reinterpret_cast <const __m256i *> (&s[0][4]));
+  __m256i b1 = _mm256_load_si256 (reinterpret_cast <const __m256i *> (&s[1][4]));
+  __m256i b2 = _mm256_load_si256 (reinterpret_cast <const __m256i *> (&s[2][4]));
+  __m256i b3 = _mm256_load_si256 (reinterpret_cast <const __m256i *> (&s[3][4]));
+
+  const __m256 scale = _mm256_set1_ps ((high - low) * 0x1.0p-24f);
+  const __m256 offset = _mm256_set1_ps (low);
+
+  /* 64비트 출력 하나를 32비트 두 개로 나눠 float 16개를 만듦 */
+  size_t i = 0;
+  for (; i + LANES * 2 <= count; i += LANES * 2)
+  {
+    const __m256i bits_a = _mm256_srli_epi32 (Detail::xoshiro_step (a0, a1, a2, a3), 8);
+    const __m256i bits_b = _mm256_srli_epi32 (Detail::xoshiro_step (b0, b1, b2, b3), 8);
+    _mm256_storeu_ps (out + i, _mm256_add_ps (_mm256_mul_ps (_mm256_cvtepi32_ps (bits_a), scale), offset));
+    _mm256_storeu_ps (out + i + 8, _mm256_add_ps (_mm256_mul_ps (_mm256_cvtepi32_ps (bits_b), scale), offset));
+  }
+  if (i < count)
+  {
+    alignas (32) float tail[LANES * 2];
+    const __m256i bits_a = _mm256_srli_epi32 (Detail::xoshiro_step (a0, a1, a2, a3), 8);
+    const __m256i bits_b = _mm256_srli_epi32 (Detail::xoshiro_step (b0, b1, b2, b3), 8);
+    _mm256_store_ps (tail, _mm256_add_ps (_mm256_mul_ps (_mm256_cvtepi32_ps (bits_a), scale), offset));
+    _mm256_store_ps (tail + 8, _mm256_add_ps (_mm256_mul_ps (_mm256_cvtepi32_ps (bits_b), scale), offset));
+    memcpy (out + i, tail, (count - i) * sizeof (float));
+  }
+
+  _mm256_store_si256 (reinterpret_cast <__m256i *> (&s[0][0]), a0);
+  _mm256_store_si256 (reinterpret_cast <__m256i *> (&s[1][0]), a1);
+  _mm256_store_si256 (reinterpret_cast <__m256i *> (&s[2][0]), a2);
+  _mm256_store_si256 (reinterpret_cast <__m256i *> (&s[3][0]), a3);
+  _mm256_store_si256 (reinterpret_cast <__m256i *> (&s[0][4]), b0);
+  _mm256_store_si256 (reinterpret_cast <__m256i *> (&s[1][4]), b1);
+  _mm256_store_si256 (reinterpret_cast <__m256i *> (&s[2][4]), b2);
+  _mm256_store_si256 (reinterpret_cast <__m256i *> (&s[3][4]), b3);
+}
+
+#elif __ARM_NEON
+
+namespace Detail
+{
+  template <int K>
+  inline uint64x2_t rotl (const uint64x2_t x)
+  {
+    return vorrq_u64 (vshlq_n_u64 (x, K), vshrq_n_u64 (x, 64 - K));
+  }
+
+  inline uint64x2_t xoshiro_step (uint64x2_t &s0, uint64x2_t &s1, uint64x2_t &s2, uint64x2_t &s3)
+  {
+    const uint64x2_t times5 = vaddq_u64 (vshlq_n_u64 (s1, 2), s1);
+    const uint64x2_t rotated = rotl <7> (times5);
+    const uint64x2_t result = vaddq_u64 (vshlq_n_u64 (rotated, 3), rotated);
+    const uint64x2_t t = vshlq_n_u64 (s1, 17);
+
+    s2 = veorq_u64 (s2, s0);
+    s3 = veorq_u64 (s3, s1);
+    s1 = veorq_u64 (s1, s2);
+    s0 = veorq_u64 (s0, s3);
+    s2 = veorq_u64 (s2, t);
+    s3 = rotl <45> (s3);
+    return result;
+  }
+}
+
+inline void XoshiroWide::next (uint64_t *out)
+{
+  fill (out, LANES);
+}
+
+inline void XoshiroWide::fill (uint64_t *out, const size_t count)
+{
+  uint64x2_t a0 = vld1q_u64 (&s[0][0]), a1 = vld1q_u64 (&s[1][0]), a2 = vld1q_u64 (&s[2][0]), a3 = vld1q_u64 (&s[3][0]);
+  uint64x2_t b0 = vld1q_u64 (&s[0][2]), b1 = vld1q_u64 (&s[1][2]), b2 = vld1q_u64 (&s[2][2]), b3 = vld1q_u64 (&s[3][2]);
+
+  size_t i = 0;
+  for (; i + LANES <= count; i += LANES)
+  {
+    vst1q_u64 (out + i, Detail::xoshiro_step (a0, a1, a2, a3));
+    vst1q_u64 (out + i + 2, Detail::xoshiro_step (b0, b1, b2, b3));
+  }
+  if (i < count)
+  {
+    uint64_t tail[LANES];
+    vst1q_u64 (tail, Detail::xoshiro_step (a0, a1, a2, a3));
+    vst1q_u64 (tail + 2, Detail::xoshiro_step (b0, b1, b2, b3));
+    memcpy (out + i, tail, (count - i) * sizeof (uint64_t));
+  }
+
+  vst1q_u64 (&s[0][0], a0); vst1q_u64 (&s[1][0], a1); vst1q_u64 (&s[2][0], a2); vst1q_u64 (&s[3][0], a3);
+  vst1q_u64 (&s[0][2], b0); vst1q_u64 (&s[1][2], b1); vst1q_u64 (&s[2][2], b2); vst1q_u64 (&s[3][2], b3);
+}
+
+inline void XoshiroWide::fill (float *out, const size_t count, const float low, const float high)
+{
+  uint64x2_t a0 = vld1q_u64 (&s[0][0]), a1 = vld1q_u64 (&s[1][0]), a2 = vld1q_u64 (&s[2][0]), a3 = vld1q_u64 (&s[3][0]);
+  uint64x2_t b0 = vld1q_u64 (&s[0][2]), b1 = vld1q_u64 (&s[1][2]), b2 = vld1q_u64 (&s[2][2]), b3 = vld1q_u64 (&s[3][2]);
+
+  const float32x4_t scale = vdupq_n_f32 ((high - low) * 0x1.0p-24f);
+  const float32x4_t offset = vdupq_n_f32 (low);
+
+  size_t i = 0;
+  for (; i + LANES * 2 <= count; i += LANES * 2)
+  {
+    const uint32x4_t bits_a = vshrq_n_u32 (vreinterpretq_u32_u64 (Detail::xoshiro_step (a0, a1, a2, a3)), 8);
+    const uint32x4_t bits_b = vshrq_n_u32 (vreinterpretq_u32_u64 (Detail::xoshiro_step (b0, b1, b2, b3)), 8);
+    vst1q_f32 (out + i, vmlaq_f32 (offset, vcvtq_f32_u32 (bits_a), scale));
+    vst1q_f32 (out + i + 4, vmlaq_f32 (offset, vcvtq_f32_u32 (bits_b), scale));
+  }
+  if (i < count)
+  {
+    float tail[LANES * 2];
+    const uint32x4_t bits_a = vshrq_n_u32 (vreinterpretq_u32_u64 (Detail::xoshiro_step (a0, a1, a2, a3)), 8);
+    const uint32x4_t bits_b = vshrq_n_u32 (vreinterpretq_u32_u64 (Detail::xoshiro_step (b0, b1, b2, b3)), 8);
+    vst1q_f32 (tail, vmlaq_f32 (offset, vcvtq_f32_u32 (bits_a), scale));
+    vst1q_f32 (tail + 4, vmlaq_f32 (offset, vcvtq_f32_u32 (bits_b), scale));
+    memcpy (out + i, tail, (count - i) * sizeof (float));
+  }
+
+  vst1q_u64 (&s[0][0], a0); vst1q_u64 (&s[1][0], a1); vst1q_u64 (&s[2][0], a2); vst1q_u64 (&s[3][0], a3);
+  vst1q_u64 (&s[0][2], b0); vst1q_u64 (&s[1][2], b1); vst1q_u64 (&s[2][2], b2); vst1q_u64 (&s[3][2], b3);
+}
+
+#else
+
+inline void XoshiroWide::next (uint64_t *out)
+{
+  for (size_t l = 0; l < LANES; ++l)
+  {
+    out[l] = Detail::rotl (s[1][l] * 5, 7) * 9;
+    const uint64_t t = s[1][l] << 17;
+    s[2][l] ^= s[0][l];
+    s[3][l] ^= s[1][l];
+    s[1][l] ^= s[2][l];
+    s[0][l] ^= s[3][l];
+    s[2][l] ^= t;
+    s[3][l] = Detail::rotl (s[3][l], 45);
+  }
+}
+
+inline void XoshiroWide::fill (uint64_t *out, const size_t count)
+{
+  size_t i = 0;
+  for (; i + LANES <= count; i += LANES) next (out + i);
+  if (i < count)
+  {
+    uint64_t tail[LANES];
+    next (tail);
+    memcpy (out + i, tail, (count - i) * sizeof (uint64_t));
+  }
+}
+
+inline void XoshiroWide::fill (float *out, const size_t count, const float low, const float high)
+{
+  const float scale = (high - low) * 0x1.0p-24f;
+  uint64_t values[LANES];
+  for (size_t i = 0; i < count; i += LANES * 2)
+  {
+    next (values);
+    const size_t n = count - i < LANES * 2 ? count - i : LANES * 2;
+    for (size_t j = 0; j < n; ++j)
+    {
+      const uint32_t bits = uint32_t (values[j / 2] >> (j & 1 ? 32 : 0)) >> 8;
+      out[i + j] = float (bits) * scale + low;
+    }
+  }
+}
+
+#endif
+
+inline void XoshiroWide::fill (uint32_t *out, const size_t count)
+{
+  /* uint32_t 배열에 uint64_t 로 쓰면 별칭 규칙 위반이므로 64 비트 값은 버퍼에 만들고 바이트째 복사 */
+  alignas (32) uint64_t block[LANES * 8];
+  for (size_t i = 0; i + 2 <= count;)
+  {
+    const size_t pairs = (count - i) / 2 < LANES * 8 ? (count - i) / 2 : LANES * 8;
+    fill (block, pairs);
+    memcpy (out + i, block, pairs * sizeof (uint64_t));
+    i += pairs * 2;
+  }
+  if (count & 1)
+  {
+    uint64_t tail[LANES];
+    next (tail);
+    out[count - 1] = uint32_t (tail[0] >> 32);
+  }
+}
+
+inline void XoshiroWide::fill (float *out, const size_t count)
+{
+  fill (out, count, 0.0f, 1.0f);
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if __AVX2__
+#include <immintrin.h>
+#elif __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+/* 플랫폼 네이티브 폭의 float 벡터. AVX2 는 8 레인, NEON 과 스칼라 대체 경로는 4 레인.
+   SoA 배열을 SIMD_WIDTH 단위로 순회하는 커널을 플랫폼별 분기 없이 작성하기 위한 얇은 래퍼 */
+#if __AVX2__
+inline constexpr size_t SIMD_WIDTH = 8;
+
+struct SimdFloat { __m256 v; };
+struct SimdMask { __m256 v; };
+#elif __ARM_NEON
+inline constexpr size_t SIMD_WIDTH = 4;
+
+struct SimdFloat { float32x4_t v; };
+struct SimdMask { uint32x4_t v; };
+#else
+inline constexpr size_t SIMD_WIDTH = 4;
+
+struct SimdFloat { float v[4]; };
+struct SimdMask { uint32_t v[4]; };
+#endif
+
+namespace Simd
+{
+  SimdFloat load (const float *ptr);
+  void store (float *ptr, SimdFloat value);
+  SimdFloat splat (float value);
+  SimdFloat zero ();
+
+  SimdFloat add (SimdFloat a, SimdFloat b);
+  SimdFloat sub (SimdFloat a, SimdFloat b);
+  SimdFloat mul (SimdFloat a, SimdFloat b);
+  SimdFloat div (SimdFloat a, SimdFloat b);
+  /* a * b + c */
+  SimdFloat mul_add (SimdFloat a, SimdFloat b, SimdFloat c);
+  SimdFloat min (SimdFloat a, SimdFloat b);
+  SimdFloat max (SimdFloat a, SimdFloat b);
+  SimdFloat sqrt (SimdFloat a);
+  SimdFloat floor (SimdFloat a);
+  SimdFloat abs (SimdFloat a);
+
+  SimdMask less (SimdFloat a, SimdFloat b);
+  SimdMask less_equal (SimdFloat a, SimdFloat b);
+  SimdFloat select (SimdMask mask, SimdFloat if_true, SimdFloat if_false);
+  /* 레인 i 의 마스크가 참이면 비트 i 가 1 */
+  uint32_t mask_bits (SimdMask mask);
+} /* namespace Simd */
+
+inline SimdFloat operator+ (SimdFloat a, SimdFloat b) { return Simd::add (a, b); }
+inline SimdFloat operator- (SimdFloat a, SimdFloat b) { return Simd::sub (a, b); }
+inline SimdFloat operator* (SimdFloat a, SimdFloat b) { return Simd::mul (a, b); }
+inline SimdFloat operator/ (SimdFloat a, SimdFloat b) { return Simd::div (a, b); }
+
+/* ============ 구현 ============ */
+namespace Simd
+{
+#if __AVX2__
+  inline SimdFloat load (const float *ptr) { return { _mm256_loadu_ps (ptr) }; }
+  inline void store (float *ptr, SimdFloat value) { _mm256_storeu_ps (ptr, value.v); }
+  inline SimdFloat splat (float value) { return { _mm256_set1_ps (value) }; }
+  inline SimdFloat zero () { return { _mm256_setzero_ps () }; }
+
+  inline SimdFloat add (SimdFloat a, SimdFloat b) { return { _mm256_add_ps (a.v, b.v) }; }
+  inline SimdFloat sub (SimdFloat a, SimdFloat b) { return { _mm256_sub_ps (a.v, b.v) }; }
+  inline SimdFloat mul (SimdFloat a, SimdFloat b) { return { _mm256_mul_ps (a.v, b.v) }; }
+  inline SimdFloat div (SimdFloat a, SimdFloat b) { return { _mm256_div_ps (a.v, b.v) }; }
+#if __FMA__
+  inline SimdFloat mul_add (SimdFloat a, SimdFloat b, SimdFloat c) { return { _mm256_fmadd_ps (a.v, b.v, c.v) }; }
+#else
+  inline SimdFloat mul_add (SimdFloat a, SimdFloat b, SimdFloat c) { return { _mm256_add_ps (_mm256_mul_ps (a.v, b.v), c.v) }; }
+#endif
+  inline SimdFloat min (SimdFloat a, SimdFloat b) { return { _mm256_min_ps (a.v, b.v) }; }
+  inline SimdFloat max (SimdFloat a, SimdFloat b) { return { _mm256_max_ps (a.v, b.v) }; }
+  inline SimdFloat sqrt (SimdFloat a) { return { _mm256_sqrt_ps (a.v) }; }
+  inline SimdFloat floor (SimdFloat a) { return { _mm256_floor_ps (a.v) }; }
+  inline SimdFloat abs (SimdFloat a) { return { _mm256_andnot_ps (_mm256_set1_ps (-0.0f), a.v) }; }
+
+  inline SimdMask less (SimdFloat a, SimdFloat b) { return { _mm256_cmp_ps (a.v, b.v, _CMP_LT_OQ) }; }
+  inline SimdMask less_equal (SimdFloat a, SimdFloat b) { return { _mm256_cmp_ps (a.v, b.v, _CMP_LE_OQ) }; }
+  inline SimdFloat select (SimdMask mask, SimdFloat if_true, SimdFloat if_false) { return { _mm256_blendv_ps (if_false.v, if_true.v, mask.v) }; }
+  inline uint32_t mask_bits (SimdMask mask) { return uint32_t (_mm256_movemask_ps (mask.v)); }
+#elif __ARM_NEON
+  inline SimdFloat load (const float *ptr) { return { vld1q_f32 (ptr) }; }
+  inline void store (float *ptr, SimdFloat value) { vst1q_f32 (ptr, value.v); }
+  inline SimdFloat splat (float value) { return { vdupq_n_f32 (value) }; }
+  inline SimdFloat zero () { return { vdupq_n_f32 (0.0f) }; }
+
+  inline SimdFloat add (SimdFloat a, SimdFloat b) { return { vaddq_f32 (a.v, b.v) }; }
+  inline SimdFloat sub (SimdFloat a, SimdFloat b) { return { vsubq_f32 (a.v, b.v) }; }
+  inline SimdFloat mul (SimdFloat a, SimdFloat b) { return { vmulq_f32 (a.v, b.v) }; }
+  inline SimdFloat div (SimdFloat a, SimdFloat b) { return { vdivq_f32 (a.v, b.v) }; }
+  inline SimdFloat mul_add (SimdFloat a, SimdFloat b, SimdFloat c) { return { vfmaq_f32 (c.v, a.v, b.v) }; }
+  inline SimdFloat min (SimdFloat a, SimdFloat b) { return { vminq_f32 (a.v, b.v) }; }
+  inline SimdFloat max (SimdFloat a, SimdFloat b) { return { vmaxq_f32 (a.v, b.v) }; }
+  inline SimdFloat sqrt (SimdFloat a) { return { vsqrtq_f32 (a.v) }; }
+  inline SimdFloat floor (SimdFloat a) { return { vrndmq_f32 (a.v) }; }
+  inline SimdFloat abs (SimdFloat a) { return { vabsq_f32 (a.v) }; }
+
+  inline SimdMask less (SimdFloat a, SimdFloat b) { return { vcltq_f32 (a.v, b.v) }; }
+  inline SimdMask less_equal (SimdFloat a, SimdFloat b) { return { vcleq_f32 (a.v, b.v) }; }
+  inline SimdFloat select (SimdMask mask, SimdFloat if_true, SimdFloat if_false) { return { vbslq_f32 (mask.v, if_true.v, if_false.v) }; }
+  inline uint32_t mask_bits (SimdMask mask)
+  {
+    static const uint32_t weights[4] = { 1, 2, 4, 8 };
+    return vaddvq_u32 (vandq_u32 (mask.v, vld1q_u32 (weights)));
+  }
+#else
+  inline SimdFloat load (const float *ptr) { return { { ptr[0], ptr[1], ptr[2], ptr[3] } }; }
+  inline void store (float *ptr, SimdFloat value) { for (int i = 0; i < 4; ++i) ptr[i] = value.v[i]; }
+  inline SimdFloat splat (float value) { return { { value, value, value, value } }; }
+  inline SimdFloat zero () { return splat (0.0f); }
+
+  template <typename F>
+  inline SimdFloat lanewise (SimdFloat a, SimdFloat b, F &&op)
+  {
+    SimdFloat result;
+    for (int i = 0; i < 4; ++i) result.v[i] = op (a.v[i], b.v[i]);
+    return result;
+  }
+
+  inline SimdFloat add (SimdFloat a, SimdFloat b) { return lanewise (a, b, [] (float x, float y) { return x + y; }); }
+  inline SimdFloat sub (SimdFloat a, SimdFloat b) { return lanewise (a, b, [] (float x, float y) { return x - y; }); }
+  inline SimdFloat mul (SimdFloat a, SimdFloat b) { return lanewise (a, b, [] (float x, float y) { return x * y; }); }
+  inline SimdFloat div (SimdFloat a, SimdFloat b) { return lanewise (a, b, [] (float x, float y) { return x / y; }); }
+  inline SimdFloat mul_add (SimdFloat a, SimdFloat b, SimdFloat c) { return add (mul (a, b), c); }
+  inline SimdFloat min (SimdFloat a, SimdFloat b) { return lanewise (a, b, [] (float x, float y) { return y < x ? y : x; }); }
+  inline SimdFloat max (SimdFloat a, SimdFloat b) { return lanewise (a, b, [] (float x, float y) { return x < y ? y : x; }); }
+  inline SimdFloat sqrt (SimdFloat a) { return lanewise (a, a, [] (float x, float) { return std::sqrt (x); }); }
+  inline SimdFloat floor (SimdFloat a) { return lanewise (a, a, [] (float x, float) { return std::floor (x); }); }
+  inline SimdFloat abs (SimdFloat a) { return lanewise (a, a, [] (float x, float) { return std::fabs (x); }); }
+
+  inline SimdMask less (SimdFloat a, SimdFloat b)
+  {
+    SimdMask mask;
+    for (int i = 0; i < 4; ++i) mask.v[i] = a.v[i] < b.v[i] ? ~0u : 0u;
+    return mask;
+  }
+
+  inline SimdMask less_equal (SimdFloat a, SimdFloat b)
+  {
+    SimdMask mask;
+    for (int i = 0; i < 4; ++i) mask.v[i] = a.v[i] <= b.v[i] ? ~0u : 0u;
+    return mask;
+  }
+
+  inline SimdFloat select (SimdMask mask, SimdFloat if_true, SimdFloat if_false)
+  {
+    SimdFloat result;
+    for (int i = 0; i < 4; ++i) result.v[i] = mask.v[i] ? if_true.v[i] : if_false.v[i];
+    return result;
+  }
+
+  inline uint32_t mask_bits (SimdMask mask)
+  {
+    uint32_t bits = 0;
+    for (int i = 0; i < 4; ++i) bits |= (mask.v[i] & 1u) << i;
+    return bits;
+  }
+#endif
+} /* namespace Simd */
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/* 매크로로 작성한 constexpr 필드 테이블. 핫 패스는 for_each_field 로 컴파일 타임에 전개하고
+   에디터/도구는 type_info 의 런타임 테이블을 사용 */
+namespace Reflection
+{
+  enum class FieldKind : uint8_t
+  {
+    Bool,
+    Int8, Int16, Int32, Int64,
+    UInt8, UInt16, UInt32, UInt64,
+    Float, Double,
+    Struct,
+    Array,
+    Opaque,
+  };
+
+  enum FieldFlags : uint32_t
+  {
+    FIELD_NONE       = 0,
+    FIELD_TRANSIENT  = 1 << 0, /* 직렬화 제외 */
+    FIELD_HIDDEN     = 1 << 1, /* 에디터에 노출하지 않음 */
+    FIELD_READONLY   = 1 << 2, /* 에디터에서 수정 불가 */
+    FIELD_REPLICATED = 1 << 3,
+  };
+
+  struct TypeInfo;
+
+  struct FieldInfo
+  {
+    const char *name;
+    size_t offset;
+    size_t size;
+    FieldKind kind;
+    FieldKind element;         /* 배열이면 원소 종류, 아니면 kind 와 같음 */
+    uint32_t flags;
+    uint32_t count;            /* 배열 원소 수, 배열이 아니면 1 */
+    const TypeInfo *type;      /* Struct 또는 Struct 배열일 때 원소 타입 */
+  };
+
+  struct TypeInfo
+  {
+    const char *name;
+    uint64_t id;
+    size_t size;
+    size_t align;
+    const FieldInfo *fields;
+    uint32_t field_count;
+    bool trivially_copyable;
+  };
+
+  template <typename Class, typename Member>
+  struct Field
+  {
+    using Type = Member;
+    const char *name;
+    Member Class::*pointer;
+    size_t offset;
+    uint32_t flags;
+  };
+
+  /* IKYO_REFLECT 가 특수화 */
+  template <typename T>
+  struct Describe;
+
+  template <typename T>
+  concept Reflected = requires { Describe <T>::fields; };
+
+  constexpr uint64_t hash (const char *text);
+
+  template <Reflected T>
+  constexpr const TypeInfo &type_info ();
+
+  template <Reflected T, typename F>
+  constexpr void for_each_field (T &object, F &&func);
+
+  template <Reflected T>
+  constexpr size_t field_count () { return std::tuple_size_v <std::remove_cvref_t <decltype (Describe <T>::fields)>>; }
+} /* namespace Reflection */
+
+#define IKYO_FIELD(member, flags) \
+  ::Reflection::Field <Self, decltype (Self::member)> { #member, &Self::member, offsetof (Self, member), (flags) }
+
+#define IKYO_REFLECT(type, ...)                                   \
+  template <>                                                     \
+  struct Reflection::Describe <type>                              \
+  {                                                               \
+    using Self = type;                                            \
+    static constexpr const char *name = #type;                    \
+    static constexpr auto fields = std::make_tuple (__VA_ARGS__); \
+  }
+
+/* ============ 구현 ============ */
+namespace Reflection
+{
+  constexpr uint64_t hash (const char *text)
+  {
+    uint64_t value = 0xcbf29ce484222325ull;
+    while (*text) value = (value ^ uint8_t (*text++)) * 0x100000001b3ull;
+    return value;
+  }
+
+  namespace Detail
+  {
+    template <typename T>
+    struct Element { using Type = T; static constexpr uint32_t count = 1; };
+
+    template <typename T, size_t N>
+    struct Element <T[N]> { using Type = T; static constexpr uint32_t count = N; };
+
+    template <typename T>
+    constexpr FieldKind scalar_kind ()
+    {
+      if constexpr (std::is_same_v <T, bool>) return FieldKind::Bool;
+      else if constexpr (std::is_enum_v <T>) return scalar_kind <std::underlying_type_t <T>> ();
+      else if constexpr (std::is_floating_point_v <T>) return sizeof (T) == 4 ? FieldKind::Float : FieldKind::Double;
+      else if constexpr (std::is_integral_v <T> && std::is_signed_v <T>)
+        return sizeof (T) == 1 ? FieldKind::Int8 : sizeof (T) == 2 ? FieldKind::Int16 : sizeof (T) == 4 ? FieldKind::Int32 : FieldKind::Int64;
+      else if constexpr (std::is_integral_v <T>)
+        return sizeof (T) == 1 ? FieldKind::UInt8 : sizeof (T) == 2 ? FieldKind::UInt16 : sizeof (T) == 4 ? FieldKind::UInt32 : FieldKind::UInt64;
+      else if constexpr (Reflected <T>) return FieldKind::Struct;
+      else return FieldKind::Opaque;
+    }
+
+    template <typename T>
+    constexpr FieldKind kind_of ()
+    {
+      if constexpr (std::is_array_v <T>) return FieldKind::Array;
+      else return scalar_kind <T> ();
+    }
+
+    template <typename T>
+    constexpr const TypeInfo *nested_type ()
+    {
+      using E = typename Element <T>::Type;
+      if constexpr (Reflected <E>) return &type_info <E> ();
+      else return nullptr;
+    }
+
+    template <typename T, size_t... I>
+    constexpr auto make_fields (std::index_sequence <I...>)
+    {
+      constexpr auto &fields = Describe <T>::fields;
+      using Fields = std::remove_cvref_t <decltype (fields)>;
+      return std::array <FieldInfo, sizeof... (I)> { FieldInfo {
+        std::get <I> (fields).name,
+        std::get <I> (fields).offset,
+        sizeof (typename std::tuple_element_t <I, Fields>::Type),
+        kind_of <typename std::tuple_element_t <I, Fields>::Type> (),
+        scalar_kind <typename Element <typename std::tuple_element_t <I, Fields>::Type>::Type> (),
+        std::get <I> (fields).flags,
+        Element <typename std::tuple_element_t <I, Fields>::Type>::count,
+        nested_type <typename std::tuple_element_t <I, Fields>::Type> () }... };
+    }
+
+    template <typename T>
+    struct Table
+    {
+      static constexpr auto fields = make_fields <T> (std::make_index_sequence <field_count <T> ()> ());
+      static constexpr TypeInfo info = {
+        Describe <T>::name, hash (Describe <T>::name), sizeof (T), alignof (T),
+        fields.data (), uint32_t (fields.size ()), std::is_trivially_copyable_v <T> };
+    };
+
+    template <typename T, typename F, size_t... I>
+    constexpr void for_each (T &object, F &func, std::index_sequence <I...>)
+    {
+      using Plain = std::remove_const_t <T>;
+      (func (std::get <I> (Describe <Plain>::fields), object.*(std::get <I> (Describe <Plain>::fields).pointer)), ...);
+    }
+  }
+
+  template <Reflected T>
+  constexpr const TypeInfo &type_info ()
+  {
+    return Detail::Table <T>::info;
+  }
+
+  template <Reflected T, typename F>
+  constexpr void for_each_field (T &object, F &&func)
+  {
+    Detail::for_each (object, func, std::make_index_sequence <field_count <T> ()> ());
+  }
+
+  template <Reflected T, typename F>
+  constexpr void for_each_field (const T &object, F &&func)
+  {
+    Detail::for_each (object, func, std::make_index_sequence <field_count <T> ()> ());
+  }
+} /* namespace Reflection */
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "Foundation/Reflection/Reflection.h"
+
+/* 리플렉션 테이블로 전개되는 이진 직렬화. FIELD_TRANSIENT 필드는 컴파일 타임에 제외되고
+   산술/열거형 필드는 리틀 엔디언으로 기록 (빅 엔디언 기계에서는 바이트를 뒤집음). bool 은 0 또는 1 한 바이트 */
+namespace Reflection
+{
+  struct ByteWriter
+  {
+    uint8_t *data;
+    size_t capacity;
+    size_t size = 0;
+    bool overflow = false;
+
+    void write (const void *bytes, size_t count);
+  };
+
+  struct ByteReader
+  {
+    const uint8_t *data;
+    size_t size;
+    size_t position = 0;
+    bool overflow = false;
+
+    void read (void *bytes, size_t count);
+  };
+
+  template <Reflected T>
+  bool serialize (const T &object, ByteWriter &writer);
+
+  template <Reflected T>
+  bool deserialize (T &object, ByteReader &reader);
+
+  template <Reflected T>
+  constexpr size_t serialized_size ();
+} /* namespace Reflection */
+
+/* ============ 구현 ============ */
+namespace Reflection
+{
+  inline void ByteWriter::write (const void *bytes, const size_t count)
+  {
+    if (overflow || count > capacity - size)
+    {
+      overflow = true;
+      return;
+    }
+    memcpy (data + size, bytes, count);
+    size += count;
+  }
+
+  inline void ByteReader::read (void *bytes, const size_t count)
+  {
+    if (overflow || count > size - position)
+    {
+      overflow = true;
+      memset (bytes, 0, count);
+      return;
+    }
+    memcpy (bytes, data + position, count);
+    position += count;
+  }
+
+  namespace Detail
+  {
+    template <typename T>
+    concept Scalar = std::is_arithmetic_v <T> || std::is_enum_v <T>;
+
+    /* 메모리 표현을 그대로 옮겨도 되는 스칼라 (리틀 엔디언 기계의 bool 이 아닌 스칼라) */
+    template <typename T>
+    concept RawScalar = Scalar <T> && !std::is_same_v <T, bool> && std::endian::native == std::endian::little;
+
+    template <size_t N>
+    using ScalarBits = std::conditional_t <N == 1, uint8_t, std::conditional_t <N == 2, uint16_t, std::conditional_t <N == 4, uint32_t, uint64_t>>>;
+
+    template <typename U>
+    U swap_bytes (const U bits)
+    {
+      if constexpr (sizeof (U) == 1) return bits;
+      else if constexpr (sizeof (U) == 2) return __builtin_bswap16 (bits);
+      else if constexpr (sizeof (U) == 4) return __builtin_bswap32 (bits);
+      else return __builtin_bswap64 (bits);
+    }
+
+    template <Scalar T>
+    void write_scalar (const T &value, ByteWriter &writer)
+    {
+      static_assert (sizeof (T) <= 8, "serialized scalars are at most 8 bytes");
+      if constexpr (std::is_same_v <T, bool>)
+      {
+        const uint8_t byte = value ? 1 : 0;
+        writer.write (&byte, 1);
+      }
+      else
+      {
+        ScalarBits <sizeof (T)> bits;
+        memcpy (&bits, &value, sizeof (T));
+        if constexpr (std::endian::native == std::endian::big) bits = swap_bytes (bits);
+        writer.write (&bits, sizeof (T));
+      }
+    }
+
+    template <Scalar T>
+    void read_scalar (T &value, ByteReader &reader)
+    {
+      static_assert (sizeof (T) <= 8, "serialized scalars are at most 8 bytes");
+      if constexpr (std::is_same_v <T, bool>)
+      {
+        uint8_t byte;
+        reader.read (&byte, 1);
+        value = byte != 0;
+      }
+      else
+      {
+        ScalarBits <sizeof (T)> bits;
+        reader.read (&bits, sizeof (T));
+        if constexpr (std::endian::native == std::endian::big) bits = swap_bytes (bits);
+        memcpy (&value, &bits, sizeof (T));
+      }
+    }
+
+    template <typename T>
+    void write_value (const T &value, ByteWriter &writer)
+    {
+      if constexpr (std::is_array_v <T>)
+      {
+        using E = std::remove_extent_t <T>;
+        if constexpr (RawScalar <E>) writer.write (value, sizeof (T));
+        else for (const E &element : value) write_value (element, writer);
+      }
+      else if constexpr (Scalar <T>) write_scalar (value, writer);
+      else
+      {
+        static_assert (Reflected <T>, "serialized fields must be scalars, arrays or reflected structs");
+        serialize (value, writer);
+      }
+    }
+
+    template <typename T>
+    void read_value (T &value, ByteReader &reader)
+    {
+      if constexpr (std::is_array_v <T>)
+      {
+        using E = std::remove_extent_t <T>;
+        if constexpr (RawScalar <E>) reader.read (value, sizeof (T));
+        else for (E &element : value) read_value (element, reader);
+      }
+      else if constexpr (Scalar <T>) read_scalar (value, reader);
+      else deserialize (value, reader);
+    }
+
+    template <typename T>
+    constexpr size_t value_size ()
+    {
+      if constexpr (std::is_array_v <T>) return std::extent_v <T> * value_size <std::remove_extent_t <T>> ();
+      else if constexpr (std::is_same_v <T, bool>) return 1;
+      else if constexpr (Scalar <T>) return sizeof (T);
+      else return serialized_size <T> ();
+    }
+
+    template <typename T, size_t I>
+    constexpr bool persistent ()
+    {
+      return !(std::get <I> (Describe <T>::fields).flags & FIELD_TRANSIENT);
+    }
+
+    template <typename T, size_t... I>
+    void serialize_fields (const T &object, ByteWriter &writer, std::index_sequence <I...>)
+    {
+      ([&]
+      {
+        if constexpr (persistent <T, I> ())
+          write_value (object.*(std::get <I> (Describe <T>::fields).pointer), writer);
+      } (), ...);
+    }
+
+    template <typename T, size_t... I>
+    void deserialize_fields (T &object, ByteReader &reader, std::index_sequence <I...>)
+    {
+      ([&]
+      {
+        if constexpr (persistent <T, I> ())
+          read_value (object.*(std::get <I> (Describe <T>::fields).pointer), reader);
+      } (), ...);
+    }
+
+    template <typename T, size_t... I>
+    constexpr size_t fields_size (std::index_sequence <I...>)
+    {
+      using Fields = std::remove_cvref_t <decltype (Describe <T>::fields)>;
+      return ((persistent <T, I> () ? value_size <typename std::tuple_element_t <I, Fields>::Type> () : 0) + ... + 0);
+    }
+  }
+
+  template <Reflected T>
+  bool serialize (const T &object, ByteWriter &writer)
+  {
+    Detail::serialize_fields (object, writer, std::make_index_sequence <field_count <T> ()> ());
+    return !writer.overflow;
+  }
+
+  template <Reflected T>
+  bool deserialize (T &object, ByteReader &reader)
+  {
+    Detail::deserialize_fields (object, reader, std::make_index_sequence <field_count <T> ()> ());
+    return !reader.overflow;
+  }
+
+  template <Reflected T>
+  constexpr size_t serialized_size ()
+  {
+    return Detail::fields_size <T> (std::make_index_sequence <field_count <T> ()> ());
+  }
+} /* namespace Reflection */
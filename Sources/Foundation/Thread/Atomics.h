@@ -2,6 +2,12 @@
 
 #include <type_traits>
 
+#if __APPLE__ && __aarch64__
+#define CACHE_LINE_SIZE 128
+#else
+#define CACHE_LINE_SIZE 64
+#endif
+
 namespace Atomics {
   template <typename T>
   concept AtomicsCompatible = 
@@ -13,12 +19,36 @@ namespace Atomics {
 
 namespace Atomics
 {
+  inline void pause ()
+  {
+#if __x86_64__ || __i386__
+    __builtin_ia32_pause ();
+#elif __aarch64__
+    __asm__ __volatile__ ("yield");
+#endif
+  }
+
+  /* 앞선 저장과 뒤따르는 읽기의 순서까지 보장하는 전체 장벽 (StoreLoad) */
+  inline void fence () { __atomic_thread_fence (__ATOMIC_SEQ_CST); }
+
   template <AtomicsCompatible T>
   T load (const volatile T *ptr) { return __atomic_load_n (ptr, __ATOMIC_SEQ_CST); }
 
   template <AtomicsCompatible T>
   void store (volatile T *ptr, T value) { __atomic_store_n (ptr, value, __ATOMIC_SEQ_CST); }
 
+  template <AtomicsCompatible T>
+  T load_relaxed (const volatile T *ptr) { return __atomic_load_n (ptr, __ATOMIC_RELAXED); }
+
+  template <AtomicsCompatible T>
+  void store_relaxed (volatile T *ptr, T value) { __atomic_store_n (ptr, value, __ATOMIC_RELAXED); }
+
+  template <AtomicsCompatible T>
+  T load_acquire (const volatile T *ptr) { return __atomic_load_n (ptr, __ATOMIC_ACQUIRE); }
+
+  template <AtomicsCompatible T>
+  void store_release (volatile T *ptr, T value) { __atomic_store_n (ptr, value, __ATOMIC_RELEASE); }
+
   template <AtomicsCompatible T>
   T exchange (volatile T *ptr, T value) { return __atomic_exchange_n (ptr, value, __ATOMIC_SEQ_CST); }
 
@@ -53,6 +83,9 @@ namespace Atomics
 
 namespace Atomics
 {
+  inline void pause () { YieldProcessor (); }
+  inline void fence () { MemoryBarrier (); }
+
   template <AtomicsCompatible T>
   T load (const volatile T *ptr)
   {
@@ -61,6 +94,27 @@ namespace Atomics
     return value;
   }
 
+  template <AtomicsCompatible T>
+  T load_relaxed (const volatile T *ptr) { return *ptr; }
+
+  template <AtomicsCompatible T>
+  void store_relaxed (volatile T *ptr, T value) { *ptr = value; }
+
+  template <AtomicsCompatible T>
+  T load_acquire (const volatile T *ptr)
+  {
+    T value = *ptr;
+    _ReadWriteBarrier ();
+    return value;
+  }
+
+  template <AtomicsCompatible T>
+  void store_release (volatile T *ptr, T value)
+  {
+    _ReadWriteBarrier ();
+    *ptr = value;
+  }
+
   template <AtomicsCompatible T>
   void store (volatile T *ptr, T value)
   {
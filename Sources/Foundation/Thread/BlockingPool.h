@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include "Foundation/Thread/Atomics.h"
+#include "Foundation/Thread/ThreadLocal.h"
+#include "Foundation/Thread/ThreadPool.h"
+
+/* 파일 I/O, 소켓, 압축처럼 블로킹되는 작업 전용 스레드 풀.
+   작업이 끝나면 이어지는 작업(continuation)을 연산 풀에 제출하므로 연산 워커는 블로킹되지 않음.
+   작업과 이어지는 작업의 쌍은 미리 잡아 둔 기록에 담아 호출마다 힙을 쓰지 않음.
+   offload 는 기다리지 않음. 큐나 기록이 바닥나면 부른 스레드에서 작업을 바로 실행하고 돌아옴 */
+class BlockingPool
+{
+public:
+  explicit BlockingPool (ThreadPool &compute, uint32_t thread_count = 4, uint32_t queue_capacity = 1024);
+
+  BlockingPool (const BlockingPool &) = delete;
+  BlockingPool &operator= (const BlockingPool &) = delete;
+
+  void offload (const Job &work);
+  void offload (const Job &work, const Job &continuation);
+
+  bool on_blocking_thread () const { return ThreadPool::current () == &blocking; }
+  void assert_may_block () const { assert (ThreadPool::current () != &compute); }
+
+  ThreadPoolMetrics metrics () const { return blocking.metrics (); }
+
+private:
+  struct Offload
+  {
+    Job work;
+    Job continuation;
+    BlockingPool *owner;
+    uint32_t next;                    /* 빈 목록에서 다음 기록의 인덱스 + 1 */
+  };
+
+  /* 동시에 쓰는 빈 기록 스택. 머리는 상위 32 비트 태그 (ABA 방지) 와 하위 32 비트 인덱스 + 1.
+     큐에 든 것 + 실행 중인 것 + 제출 직전인 스레드 수만큼 잡아 둠.
+     blocking 보다 먼저 선언해 일꾼이 모두 멈춘 뒤에 해제됨 */
+  struct OffloadPool
+  {
+    Offload *records;
+    uint64_t head = 0;
+
+    explicit OffloadPool (uint32_t count);
+    ~OffloadPool () { delete[] records; }
+
+    /* 비었으면 nullptr */
+    Offload *acquire ();
+    void release (Offload *offload);
+  };
+
+  static void run_offload (void *arg);
+  void complete (const Job &continuation);
+
+  ThreadPool &compute;
+  OffloadPool offloads;
+  ThreadPool blocking;
+};
+
+/* ============ 구현 ============ */
+inline BlockingPool::BlockingPool (ThreadPool &compute, const uint32_t thread_count, const uint32_t queue_capacity)
+  : compute (compute),
+    offloads (queue_capacity + thread_count + ThreadLocal::MAX_THREADS),
+    blocking ({ .worker_count = thread_count, .queue_capacity = queue_capacity, .spin_count = 0,
+                .burst_threshold = thread_count, .help_when_full = false })
+{
+}
+
+inline void BlockingPool::offload (const Job &work)
+{
+  if (!blocking.try_submit (work)) work.func (work.arg);
+}
+
+inline void BlockingPool::offload (const Job &work, const Job &continuation)
+{
+  if (continuation.counter) Atomics::fetch_add (&continuation.counter->pending, 1u);
+
+  if (Offload *offload = offloads.acquire ())
+  {
+    offload->work = { work.func, work.arg, nullptr };
+    offload->continuation = continuation;
+    offload->owner = this;
+    if (blocking.try_submit ({ run_offload, offload, work.counter })) return;
+    offloads.release (offload);
+  }
+
+  /* 블로킹 풀이 밀려 있으면 연산 워커가 자리를 기다리며 멈추지 않도록 여기서 바로 실행 */
+  work.func (work.arg);
+  complete (continuation);
+}
+
+inline void BlockingPool::run_offload (void *arg)
+{
+  Offload *offload = static_cast <Offload *> (arg);
+  offload->work.func (offload->work.arg);
+
+  BlockingPool *owner = offload->owner;
+  const Job continuation = offload->continuation;
+  owner->offloads.release (offload);
+  owner->complete (continuation);
+}
+
+inline void BlockingPool::complete (const Job &continuation)
+{
+  compute.submit (continuation);
+  if (continuation.counter && Atomics::fetch_sub (&continuation.counter->pending, 1u) == 1)
+    Futex::wake_all (&continuation.counter->pending);
+}
+
+inline BlockingPool::OffloadPool::OffloadPool (const uint32_t count)
+{
+  records = new Offload[count];
+  for (uint32_t i = 0; i < count; ++i) records[i].next = i + 1 < count ? i + 2 : 0;
+  head = count ? 1 : 0;
+}
+
+inline BlockingPool::Offload *BlockingPool::OffloadPool::acquire ()
+{
+  uint64_t current = Atomics::load (&head);
+  for (;;)
+  {
+    const uint32_t index = uint32_t (current);
+    if (!index) return nullptr;
+    const uint64_t next = ((current >> 32) + 1) << 32 | Atomics::load_relaxed (&records[index - 1].next);
+    if (Atomics::compare_exchange (&head, &current, next)) return &records[index - 1];
+  }
+}
+
+inline void BlockingPool::OffloadPool::release (Offload *offload)
+{
+  const uint32_t index = uint32_t (offload - records) + 1;
+  uint64_t current = Atomics::load (&head);
+  do Atomics::store_relaxed (&offload->next, uint32_t (current));
+  while (!Atomics::compare_exchange (&head, &current, ((current >> 32) + 1) << 32 | index));
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+
+/* 32비트 주소 기반 대기/깨우기. wait 는 *addr == expected 일 때만 잠들며 가짜 깨어남이 있을 수 있음 */
+namespace Futex
+{
+  void wait (volatile uint32_t *addr, uint32_t expected);
+  void wake_one (volatile uint32_t *addr);
+  void wake_all (volatile uint32_t *addr);
+} /* namespace Futex */
+
+/* ============ 구현 ============ */
+#if _WIN32
+#include <Windows.h>
+#pragma comment (lib, "Synchronization.lib")
+
+namespace Futex
+{
+  inline void wait (volatile uint32_t *addr, uint32_t expected)
+  {
+    WaitOnAddress (addr, &expected, sizeof (uint32_t), INFINITE);
+  }
+
+  inline void wake_one (volatile uint32_t *addr) { WakeByAddressSingle ((void *) addr); }
+  inline void wake_all (volatile uint32_t *addr) { WakeByAddressAll ((void *) addr); }
+} /* namespace Futex */
+
+#elif __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <climits>
+
+namespace Futex
+{
+  inline void wait (volatile uint32_t *addr, uint32_t expected)
+  {
+    syscall (SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+  }
+
+  inline void wake_one (volatile uint32_t *addr) { syscall (SYS_futex, addr, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0); }
+  inline void wake_all (volatile uint32_t *addr) { syscall (SYS_futex, addr, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0); }
+} /* namespace Futex */
+
+#elif __APPLE__
+
+extern "C" int __ulock_wait (uint32_t operation, void *addr, uint64_t value, uint32_t timeout);
+extern "C" int __ulock_wake (uint32_t operation, void *addr, uint64_t wake_value);
+
+namespace Futex
+{
+  namespace Detail
+  {
+    inline constexpr uint32_t UL_COMPARE_AND_WAIT = 1;
+    inline constexpr uint32_t ULF_WAKE_ALL = 0x00000100;
+    inline constexpr uint32_t ULF_NO_ERRNO = 0x01000000;
+  }
+
+  inline void wait (volatile uint32_t *addr, uint32_t expected)
+  {
+    __ulock_wait (Detail::UL_COMPARE_AND_WAIT | Detail::ULF_NO_ERRNO, (void *) addr, expected, 0);
+  }
+
+  inline void wake_one (volatile uint32_t *addr)
+  {
+    __ulock_wake (Detail::UL_COMPARE_AND_WAIT | Detail::ULF_NO_ERRNO, (void *) addr, 0);
+  }
+
+  inline void wake_all (volatile uint32_t *addr)
+  {
+    __ulock_wake (Detail::UL_COMPARE_AND_WAIT | Detail::ULF_WAKE_ALL | Detail::ULF_NO_ERRNO, (void *) addr, 0);
+  }
+} /* namespace Futex */
+
+#endif
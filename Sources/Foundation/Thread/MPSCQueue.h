@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "Foundation/Thread/Atomics.h"
+
+/* 다중 생산자/단일 소비자 유계 큐 */
+template <typename T, size_t Capacity>
+requires ((Capacity & (Capacity - 1)) == 0 && std::is_trivially_copyable_v <T>)
+class MPSCQueue
+{
+  struct Cell
+  {
+    size_t sequence;
+    T value;
+  };
+
+  alignas (CACHE_LINE_SIZE) size_t tail = 0;
+  alignas (CACHE_LINE_SIZE) size_t head = 0;
+  alignas (CACHE_LINE_SIZE) Cell cells[Capacity];
+
+public:
+  MPSCQueue ()
+  {
+    for (size_t i = 0; i < Capacity; ++i) cells[i].sequence = i;
+  }
+
+  MPSCQueue (const MPSCQueue &) = delete;
+  MPSCQueue &operator= (const MPSCQueue &) = delete;
+
+  bool push (const T &value);
+  bool pop (T *out);
+};
+
+/* ============ 구현 ============ */
+template <typename T, size_t Capacity>
+requires ((Capacity & (Capacity - 1)) == 0 && std::is_trivially_copyable_v <T>)
+bool MPSCQueue <T, Capacity>::push (const T &value)
+{
+  size_t pos = Atomics::load_relaxed (&tail);
+  Cell *cell;
+
+  for (;;)
+  {
+    cell = &cells[pos & (Capacity - 1)];
+    const intptr_t diff = intptr_t (Atomics::load_acquire (&cell->sequence)) - intptr_t (pos);
+    if (diff == 0)
+    {
+      if (Atomics::compare_exchange (&tail, &pos, pos + 1)) break;
+    }
+    else if (diff < 0) return false;
+    else pos = Atomics::load_relaxed (&tail);
+  }
+
+  cell->value = value;
+  Atomics::store_release (&cell->sequence, pos + 1);
+  return true;
+}
+
+template <typename T, size_t Capacity>
+requires ((Capacity & (Capacity - 1)) == 0 && std::is_trivially_copyable_v <T>)
+bool MPSCQueue <T, Capacity>::pop (T *out)
+{
+  Cell &cell = cells[head & (Capacity - 1)];
+  if (Atomics::load_acquire (&cell.sequence) != head + 1) return false;
+
+  *out = cell.value;
+  Atomics::store_release (&cell.sequence, head + Capacity);
+  ++head;
+  return true;
+}
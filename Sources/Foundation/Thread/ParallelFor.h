@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "Foundation/Thread/Atomics.h"
+#include "Foundation/Thread/ThreadPool.h"
+
+/* [0, count) 를 chunk_size 단위로 나눠 func (begin, end) 를 병렬 실행하고 모두 끝날 때까지 대기.
+   작업은 워커 수만큼만 제출하고 각 작업이 남은 청크를 번갈아 가져가므로 청크 수와 무관하게 제출 비용이 일정함.
+   호출한 스레드도 청크를 처리함 */
+template <typename F>
+void parallel_for (ThreadPool &pool, size_t count, size_t chunk_size, F &&func);
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  template <typename F>
+  struct ParallelFor
+  {
+    F *func;
+    size_t count;
+    size_t chunk_size;
+    size_t chunk_count;
+    size_t next_chunk;
+
+    void run ()
+    {
+      for (;;)
+      {
+        const size_t chunk = Atomics::fetch_add (&next_chunk, size_t (1));
+        if (chunk >= chunk_count) return;
+        const size_t begin = chunk * chunk_size;
+        const size_t end = begin + chunk_size < count ? begin + chunk_size : count;
+        (*func) (begin, end);
+      }
+    }
+
+    static void entry (void *arg) { static_cast <ParallelFor *> (arg)->run (); }
+  };
+}
+
+template <typename F>
+void parallel_for (ThreadPool &pool, const size_t count, size_t chunk_size, F &&func)
+{
+  if (!count) return;
+  if (!chunk_size) chunk_size = 1;
+
+  Detail::ParallelFor <std::remove_reference_t <F>> context { &func, count, chunk_size, (count + chunk_size - 1) / chunk_size, 0 };
+  if (context.chunk_count == 1)
+  {
+    func (size_t (0), count);
+    return;
+  }
+
+  JobCounter counter;
+  const size_t helpers = context.chunk_count - 1 < pool.worker_count () ? context.chunk_count - 1 : pool.worker_count ();
+
+  Job jobs[64];
+  for (size_t submitted = 0; submitted < helpers;)
+  {
+    size_t batch = helpers - submitted < 64 ? helpers - submitted : 64;
+    for (size_t i = 0; i < batch; ++i) jobs[i] = { Detail::ParallelFor <std::remove_reference_t <F>>::entry, &context, &counter };
+    pool.submit (jobs, batch);
+    submitted += batch;
+  }
+
+  context.run ();
+  pool.wait (&counter);
+}
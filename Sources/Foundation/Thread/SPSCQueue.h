@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "Foundation/Thread/Atomics.h"
+
+/* 단일 생산자/단일 소비자 링 버퍼. 포인터를 갖지 않으므로 0으로 채워진 공유 메모리에 그대로 배치 가능 */
+template <typename T, size_t Capacity>
+requires ((Capacity & (Capacity - 1)) == 0 && std::is_trivially_copyable_v <T>)
+class SPSCQueue
+{
+  alignas (CACHE_LINE_SIZE) size_t head = 0;
+  size_t cached_tail = 0;
+
+  alignas (CACHE_LINE_SIZE) size_t tail = 0;
+  size_t cached_head = 0;
+
+  alignas (CACHE_LINE_SIZE) T slots[Capacity];
+
+public:
+  /* 생산자: 슬롯에 직접 쓴 뒤 end_push 로 공개 */
+  T *begin_push ();
+  void end_push ();
+  bool push (const T &value);
+
+  /* 소비자: front 가 가리키는 슬롯을 읽은 뒤 pop 으로 반환 */
+  T *front ();
+  void pop ();
+  bool pop (T *out);
+
+  size_t size () const { return Atomics::load (&tail) - Atomics::load (&head); }
+  bool empty () const { return size () == 0; }
+  static constexpr size_t capacity () { return Capacity; }
+};
+
+/* ============ 구현 ============ */
+template <typename T, size_t Capacity>
+requires ((Capacity & (Capacity - 1)) == 0 && std::is_trivially_copyable_v <T>)
+T *SPSCQueue <T, Capacity>::begin_push ()
+{
+  const size_t current = tail;
+  if (current - cached_head == Capacity)
+  {
+    cached_head = Atomics::load (&head);
+    if (current - cached_head == Capacity) return nullptr;
+  }
+  return &slots[current & (Capacity - 1)];
+}
+
+template <typename T, size_t Capacity>
+requires ((Capacity & (Capacity - 1)) == 0 && std::is_trivially_copyable_v <T>)
+void SPSCQueue <T, Capacity>::end_push ()
+{
+  Atomics::store (&tail, tail + 1);
+}
+
+template <typename T, size_t Capacity>
+requires ((Capacity & (Capacity - 1)) == 0 && std::is_trivially_copyable_v <T>)
+bool SPSCQueue <T, Capacity>::push (const T &value)
+{
+  T *slot = begin_push ();
+  if (!slot) return false;
+  *slot = value;
+  end_push ();
+  return true;
+}
+
+template <typename T, size_t Capacity>
+requires ((Capacity & (Capacity - 1)) == 0 && std::is_trivially_copyable_v <T>)
+T *SPSCQueue <T, Capacity>::front ()
+{
+  const size_t current = head;
+  if (current == cached_tail)
+  {
+    cached_tail = Atomics::load (&tail);
+    if (current == cached_tail) return nullptr;
+  }
+  return &slots[current & (Capacity - 1)];
+}
+
+template <typename T, size_t Capacity>
+requires ((Capacity & (Capacity - 1)) == 0 && std::is_trivially_copyable_v <T>)
+void SPSCQueue <T, Capacity>::pop ()
+{
+  Atomics::store (&head, head + 1);
+}
+
+template <typename T, size_t Capacity>
+requires ((Capacity & (Capacity - 1)) == 0 && std::is_trivially_copyable_v <T>)
+bool SPSCQueue <T, Capacity>::pop (T *out)
+{
+  T *slot = front ();
+  if (!slot) return false;
+  *out = *slot;
+  pop ();
+  return true;
+}
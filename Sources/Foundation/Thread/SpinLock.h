@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Foundation/Thread/Atomics.h"
+
+/* 아주 짧은 임계 구역 전용 */
+class SpinLock
+{
+  uint32_t locked = 0;
+
+public:
+  void lock ()
+  {
+    for (;;)
+    {
+      if (!Atomics::exchange (&locked, 1u)) return;
+      while (Atomics::load_relaxed (&locked)) Atomics::pause ();
+    }
+  }
+
+  bool try_lock () { return !Atomics::load_relaxed (&locked) && !Atomics::exchange (&locked, 1u); }
+  void unlock () { Atomics::store_release (&locked, 0u); }
+};
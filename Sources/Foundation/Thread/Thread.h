@@ -2,11 +2,15 @@
 
 #include <cstdlib>
 
+#include "Foundation/Thread/ThreadLocal.h"
+
 #if _WIN32
 #include <Windows.h>
 #include <process.h>
 #elif __APPLE__ || __linux__
 #include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
 using HANDLE = pthread_t;
 #endif
 
@@ -24,19 +28,43 @@ public:
   void create (void *(*func)(void *), void *arg);
   void join ();
 
+  static unsigned hardware_concurrency ();
+  /* 호출한 스레드를 실시간 우선순위로 올림. 권한이 없으면 false 이고 우선순위는 그대로 */
+  static bool set_realtime_priority ();
+
 private:
   HANDLE handle;
   bool joinable;
 };
 
 /* ============ 구현 ============ */
+namespace Detail
+{
+  struct ThreadStart
+  {
+    void *(*func)(void *);
+    void *arg;
+  };
+
+  inline void *thread_entry (void *p)
+  {
+    const ThreadStart start = *static_cast <ThreadStart *> (p);
+    delete static_cast <ThreadStart *> (p);
+
+    ThreadLocal::attach ();
+    void *result = start.func (start.arg);
+    ThreadLocal::detach ();
+    return result;
+  }
+}
+
 #if _WIN32
 
 inline void Thread::create (void *(*func)(void *), void *arg)
 {
   if (joinable) abort ();
 
-  auto *ctx = new auto ([=] () { func (arg); });
+  auto *ctx = new auto ([=] () { Detail::thread_entry (new Detail::ThreadStart { func, arg }); });
 
   handle = reinterpret_cast <HANDLE> (_beginthreadex (
     nullptr, 0,
@@ -67,12 +95,29 @@ inline void Thread::join ()
 
   joinable = false;
 }
+inline unsigned Thread::hardware_concurrency ()
+{
+  SYSTEM_INFO info;
+  GetSystemInfo (&info);
+  return info.dwNumberOfProcessors;
+}
+inline bool Thread::set_realtime_priority ()
+{
+  return SetThreadPriority (GetCurrentThread (), THREAD_PRIORITY_TIME_CRITICAL) != 0;
+}
 
 #elif __APPLE__ || __linux__
 
 inline void Thread::create (void *(*func)(void *), void *arg)
 {
-  if (joinable || pthread_create (&handle, nullptr, func, arg)) abort ();
+  if (joinable) abort ();
+
+  auto *start = new Detail::ThreadStart { func, arg };
+  if (pthread_create (&handle, nullptr, Detail::thread_entry, start))
+  {
+    delete start;
+    abort ();
+  }
   joinable = true;
 }
 inline void Thread::join ()
@@ -80,5 +125,16 @@ inline void Thread::join ()
   if (!joinable || pthread_join (handle, nullptr)) abort ();
   joinable = false;
 }
+inline unsigned Thread::hardware_concurrency ()
+{
+  const long count = sysconf (_SC_NPROCESSORS_ONLN);
+  return count > 0 ? static_cast <unsigned> (count) : 1;
+}
+inline bool Thread::set_realtime_priority ()
+{
+  sched_param param = {};
+  param.sched_priority = sched_get_priority_max (SCHED_FIFO) - 1;
+  return pthread_setschedparam (pthread_self (), SCHED_FIFO, &param) == 0;
+}
 
 #endif
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include "Foundation/Thread/Atomics.h"
+
+/* 스레드마다 연속된 컨텍스트 블록 하나를 두고, 모듈은 시작 시 등록한 슬롯 오프셋으로 접근.
+   슬롯 등록은 첫 컨텍스트 생성 전에 끝나야 함.
+   Thread 로 만든 스레드는 자동으로 붙고, 메인 스레드나 ThreadPool 을 만드는 스레드 같은 그 밖의 스레드는
+   get / index 전에 attach 해야 함 (ThreadPool 생성자는 붙어 있지 않은 소유 스레드를 붙임).
+   붙지 않은 스레드에서 get / index 를 부르면 메시지를 남기고 중단 */
+namespace ThreadLocal
+{
+  inline constexpr uint32_t MAX_THREADS = 256;
+  inline constexpr uint32_t MAX_SLOTS = 64;
+
+  struct Slot { uint32_t offset; };
+
+  Slot register_slot (size_t size, size_t align, void (*init) (void *) = nullptr, void (*fini) (void *) = nullptr);
+  /* T 를 attach 때 기본 생성하고 detach 때 소멸시킴 (자명한 타입은 0 으로 채운 채 둠) */
+  template <typename T>
+  Slot register_slot ();
+
+  void attach ();
+  void detach ();
+  bool attached ();
+
+  template <typename T>
+  T *get (Slot slot);
+  uint32_t index ();
+} /* namespace ThreadLocal */
+
+/* ============ 구현 ============ */
+namespace ThreadLocal
+{
+  namespace Detail
+  {
+    struct Header
+    {
+      uint32_t index;
+    };
+
+    struct SlotInfo
+    {
+      uint32_t offset;
+      void (*init) (void *);
+      void (*fini) (void *);
+    };
+
+    constinit inline thread_local std::byte *context = nullptr;
+
+    inline size_t context_size = sizeof (Header);
+    inline size_t context_align = alignof (Header);
+    inline SlotInfo slots[MAX_SLOTS];
+    inline uint32_t slot_count = 0;
+    inline bool frozen = false;
+    inline uint64_t used_indices[MAX_THREADS / 64];
+
+    inline uint32_t acquire_index ()
+    {
+      for (uint32_t word = 0; word < MAX_THREADS / 64; ++word)
+      {
+        uint64_t bits = Atomics::load (&used_indices[word]);
+        while (~bits)
+        {
+          const uint32_t bit = __builtin_ctzll (~bits);
+          if (Atomics::compare_exchange (&used_indices[word], &bits, bits | (uint64_t (1) << bit)))
+            return word * 64 + bit;
+        }
+      }
+      abort ();
+    }
+
+    inline void release_index (const uint32_t index)
+    {
+      Atomics::fetch_and (&used_indices[index / 64], ~(uint64_t (1) << (index % 64)));
+    }
+
+    [[noreturn]] inline void not_attached ()
+    {
+      fputs ("ThreadLocal: thread is not attached; call ThreadLocal::attach () first\n", stderr);
+      abort ();
+    }
+
+#if _WIN32
+    inline void *allocate_block (size_t align, size_t size) { return _aligned_malloc (size, align); }
+    inline void free_block (void *block) { _aligned_free (block); }
+#else
+    inline void *allocate_block (size_t align, size_t size) { return aligned_alloc (align, size); }
+    inline void free_block (void *block) { free (block); }
+#endif
+  }
+
+  inline Slot register_slot (const size_t size, const size_t align, void (*init) (void *), void (*fini) (void *))
+  {
+    if (Atomics::load (&Detail::frozen) || Detail::slot_count == MAX_SLOTS || (align & (align - 1))) abort ();
+
+    const size_t offset = (Detail::context_size + (align - 1)) & ~(align - 1);
+    Detail::context_size = offset + size;
+    if (align > Detail::context_align) Detail::context_align = align;
+
+    Detail::slots[Detail::slot_count++] = { static_cast <uint32_t> (offset), init, fini };
+    return { static_cast <uint32_t> (offset) };
+  }
+
+  template <typename T>
+  Slot register_slot ()
+  {
+    void (*init) (void *) = nullptr;
+    void (*fini) (void *) = nullptr;
+    if constexpr (!std::is_trivially_default_constructible_v <T>) init = [] (void *p) { new (p) T (); };
+    if constexpr (!std::is_trivially_destructible_v <T>) fini = [] (void *p) { static_cast <T *> (p)->~T (); };
+    return register_slot (sizeof (T), alignof (T), init, fini);
+  }
+
+  inline void attach ()
+  {
+    if (Detail::context) abort ();
+    Atomics::store (&Detail::frozen, true);
+
+    const size_t align = Detail::context_align < alignof (max_align_t) ? alignof (max_align_t) : Detail::context_align;
+    const size_t size = (Detail::context_size + (align - 1)) & ~(align - 1);
+    auto *block = static_cast <std::byte *> (Detail::allocate_block (align, size));
+    if (!block) abort ();
+    memset (block, 0, size);
+
+    reinterpret_cast <Detail::Header *> (block)->index = Detail::acquire_index ();
+    Detail::context = block;
+
+    for (uint32_t i = 0; i < Detail::slot_count; ++i)
+      if (Detail::slots[i].init) Detail::slots[i].init (block + Detail::slots[i].offset);
+  }
+
+  inline void detach ()
+  {
+    std::byte *block = Detail::context;
+    if (!block) abort ();
+
+    for (uint32_t i = Detail::slot_count; i-- > 0;)
+      if (Detail::slots[i].fini) Detail::slots[i].fini (block + Detail::slots[i].offset);
+
+    Detail::release_index (reinterpret_cast <Detail::Header *> (block)->index);
+    Detail::context = nullptr;
+    Detail::free_block (block);
+  }
+
+  inline bool attached ()
+  {
+    return Detail::context != nullptr;
+  }
+
+  template <typename T>
+  T *get (const Slot slot)
+  {
+    if (!Detail::context) [[unlikely]] Detail::not_attached ();
+    return reinterpret_cast <T *> (Detail::context + slot.offset);
+  }
+
+  inline uint32_t index ()
+  {
+    if (!Detail::context) [[unlikely]] Detail::not_attached ();
+    return reinterpret_cast <const Detail::Header *> (Detail::context)->index;
+  }
+} /* namespace ThreadLocal */
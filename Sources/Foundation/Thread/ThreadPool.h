@@ -0,0 +1,583 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include "Foundation/Thread/Atomics.h"
+#include "Foundation/Thread/Futex.h"
+#include "Foundation/Thread/SpinLock.h"
+#include "Foundation/Thread/Thread.h"
+#include "Foundation/Thread/ThreadLocal.h"
+#include "Foundation/Time/Clock.h"
+
+enum class JobPriority : uint8_t
+{
+  Critical,
+  High,
+  Normal,
+  Background,
+};
+
+inline constexpr uint32_t JOB_PRIORITY_COUNT = 4;
+
+struct JobCounter
+{
+  uint32_t pending = 0;
+};
+
+struct Job
+{
+  void (*func) (void *);
+  void *arg;
+  JobCounter *counter = nullptr;
+  JobPriority priority = JobPriority::Normal;
+  uint64_t deadline = 0;          /* Clock::now 기준 절대 시각, 0 이면 없음. 우선순위를 올리기만 하고 내리지 않음 */
+};
+
+struct ThreadPoolConfig
+{
+  uint32_t worker_count = 0;      /* 0 이면 하드웨어 스레드 수 - 1 */
+  uint32_t queue_capacity = 4096; /* 우선순위별 큐 크기, 2의 거듭제곱 */
+  uint32_t spin_count = 4096;     /* 잠들기 전 pause 반복 횟수. 0 이면 바로 잠듦 */
+  uint32_t burst_threshold = 0;   /* 한 번에 이 수 이상 제출하면 모두 깨움. 0 이면 worker_count */
+  bool help_when_full = true;     /* 큐가 가득 차면 제출한 스레드가 작업을 대신 실행 */
+  uint64_t deadline_window_ns = 2000000; /* 마감까지 이 시간 이내면 모든 큐보다 먼저 (임박한 것끼리는 우선순위 순) */
+  uint32_t starvation_interval = 32;     /* 워커마다 이 횟수에 한 번은 낮은 우선순위부터 확인. 0 이면 끔 */
+};
+
+struct JobLatency
+{
+  uint64_t count;
+  uint64_t total_ns;
+  uint64_t max_ns;
+};
+
+struct ThreadPoolMetrics
+{
+  uint64_t jobs_executed;
+  uint64_t spin_hits;
+  uint64_t parks;
+  uint64_t wakeups;
+  uint64_t wake_latency_total_ns;
+  uint64_t wake_latency_max_ns;
+  uint64_t deadline_promotions;
+  JobLatency latency[JOB_PRIORITY_COUNT]; /* 제출부터 실행 시작까지 */
+};
+
+class ThreadPool
+{
+public:
+  explicit ThreadPool (const ThreadPoolConfig &config = {});
+  ~ThreadPool ();
+
+  ThreadPool (const ThreadPool &) = delete;
+  ThreadPool (ThreadPool &&) = delete;
+
+  ThreadPool &operator= (const ThreadPool &) = delete;
+  ThreadPool &operator= (ThreadPool &&) = delete;
+
+  void submit (const Job &job);
+  void submit (const Job *jobs, size_t count);
+  /* 큐가 가득 차면 기다리거나 대신 실행하지 않고 바로 false */
+  bool try_submit (const Job &job);
+  bool try_run_one ();
+  void wait (JobCounter *counter);
+
+  uint32_t worker_count () const { return config.worker_count; }
+  ThreadPoolMetrics metrics () const;
+
+  static ThreadPool *current ();
+
+private:
+  struct Entry
+  {
+    Job job;
+    uint64_t submitted;
+  };
+
+  struct Cell
+  {
+    size_t sequence;
+    Entry entry;
+  };
+
+  struct Queue
+  {
+    Cell *cells;
+    size_t mask;
+    alignas (CACHE_LINE_SIZE) size_t enqueue_pos;
+    alignas (CACHE_LINE_SIZE) size_t dequeue_pos;
+
+    bool push (const Entry &entry);
+    bool pop (Entry *entry);
+    bool empty () const { return Atomics::load_relaxed (&enqueue_pos) == Atomics::load_relaxed (&dequeue_pos); }
+  };
+
+  struct DeadlineEntry
+  {
+    uint64_t deadline;
+    Entry entry;
+  };
+
+  /* 우선순위마다 마감 순 힙 하나. 마감 작업은 자기 우선순위 안에서 마감 없는 작업보다 먼저 나가고,
+     마감이 임박하면 모든 큐보다 먼저 나감 */
+  struct alignas (CACHE_LINE_SIZE) DeadlineHeap
+  {
+    SpinLock lock;
+    DeadlineEntry *entries;
+    uint32_t count;
+    uint64_t top;                 /* 가장 이른 마감, 비었으면 UINT64_MAX. 잠금 없이 읽음 */
+  };
+
+  struct alignas (CACHE_LINE_SIZE) Worker
+  {
+    ThreadPool *pool;
+    uint32_t index;
+    uint32_t ticket;
+    ThreadPoolMetrics metrics;
+    Thread thread;
+  };
+
+  void enqueue (const Job &job, uint64_t submitted);
+  bool push_deadline (const Entry &entry);
+  bool pop_deadline (uint32_t level, Entry *entry);
+  bool pop (Entry *entry, uint32_t *ticket, bool *promoted);
+  bool has_work () const;
+  void run (const Entry &entry, ThreadPoolMetrics *metrics, bool promoted);
+  void notify (size_t count);
+  void worker_loop (Worker &self);
+  static void *worker_main (void *arg);
+
+  ThreadPoolConfig config;
+  Queue queues[JOB_PRIORITY_COUNT];
+  Worker *workers;
+
+  DeadlineHeap deadlines[JOB_PRIORITY_COUNT];
+
+  alignas (CACHE_LINE_SIZE) uint32_t wake_epoch = 0;
+  uint32_t sleepers = 0;
+  uint64_t wake_stamp = 0;
+  bool stopping = false;
+  bool attached_owner = false;    /* 생성자가 소유 스레드를 ThreadLocal 에 붙였으면 소멸자가 뗌 */
+
+  alignas (CACHE_LINE_SIZE) ThreadPoolMetrics external_metrics = {};
+};
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  inline const ThreadLocal::Slot pool_worker_slot = ThreadLocal::register_slot <void *> ();
+}
+
+inline ThreadPool::ThreadPool (const ThreadPoolConfig &config) : config (config)
+{
+  /* parallel_for 는 호출한 스레드에서도 청크를 돌리므로 소유 스레드도 컨텍스트가 있어야 함 */
+  if (!ThreadLocal::attached ())
+  {
+    ThreadLocal::attach ();
+    attached_owner = true;
+  }
+  if (!this->config.worker_count)
+  {
+    const unsigned hardware = Thread::hardware_concurrency ();
+    this->config.worker_count = hardware > 1 ? hardware - 1 : 1;
+  }
+  if (!this->config.burst_threshold) this->config.burst_threshold = this->config.worker_count;
+
+  const uint32_t capacity = this->config.queue_capacity;
+  if (!capacity || (capacity & (capacity - 1))) abort ();
+
+  for (Queue &queue : queues)
+  {
+    queue.cells = new Cell[capacity];
+    queue.mask = capacity - 1;
+    queue.enqueue_pos = 0;
+    queue.dequeue_pos = 0;
+    for (uint32_t i = 0; i < capacity; ++i) queue.cells[i].sequence = i;
+  }
+  for (DeadlineHeap &heap : deadlines)
+  {
+    heap.entries = new DeadlineEntry[capacity];
+    heap.count = 0;
+    heap.top = UINT64_MAX;
+  }
+
+  workers = new Worker[this->config.worker_count];
+  for (uint32_t i = 0; i < this->config.worker_count; ++i)
+  {
+    workers[i].pool = this;
+    workers[i].index = i;
+    workers[i].ticket = 0;
+    workers[i].metrics = {};
+    workers[i].thread.create (worker_main, &workers[i]);
+  }
+}
+
+inline ThreadPool::~ThreadPool ()
+{
+  Atomics::store (&stopping, true);
+  Atomics::fetch_add (&wake_epoch, 1u);
+  Futex::wake_all (&wake_epoch);
+
+  for (uint32_t i = 0; i < config.worker_count; ++i) workers[i].thread.join ();
+
+  delete[] workers;
+  for (DeadlineHeap &heap : deadlines) delete[] heap.entries;
+  for (Queue &queue : queues) delete[] queue.cells;
+  if (attached_owner) ThreadLocal::detach ();
+}
+
+inline bool ThreadPool::Queue::push (const Entry &entry)
+{
+  size_t pos = Atomics::load_relaxed (&enqueue_pos);
+  Cell *cell;
+
+  for (;;)
+  {
+    cell = &cells[pos & mask];
+    const size_t sequence = Atomics::load_acquire (&cell->sequence);
+    const intptr_t diff = intptr_t (sequence) - intptr_t (pos);
+    if (diff == 0)
+    {
+      if (Atomics::compare_exchange (&enqueue_pos, &pos, pos + 1)) break;
+    }
+    else if (diff < 0) return false;
+    else pos = Atomics::load_relaxed (&enqueue_pos);
+  }
+
+  cell->entry = entry;
+  Atomics::store_release (&cell->sequence, pos + 1);
+  return true;
+}
+
+inline bool ThreadPool::Queue::pop (Entry *entry)
+{
+  size_t pos = Atomics::load_relaxed (&dequeue_pos);
+  Cell *cell;
+
+  for (;;)
+  {
+    cell = &cells[pos & mask];
+    const size_t sequence = Atomics::load_acquire (&cell->sequence);
+    const intptr_t diff = intptr_t (sequence) - intptr_t (pos + 1);
+    if (diff == 0)
+    {
+      if (Atomics::compare_exchange (&dequeue_pos, &pos, pos + 1)) break;
+    }
+    else if (diff < 0) return false;
+    else pos = Atomics::load_relaxed (&dequeue_pos);
+  }
+
+  *entry = cell->entry;
+  Atomics::store_release (&cell->sequence, pos + mask + 1);
+  return true;
+}
+
+inline bool ThreadPool::push_deadline (const Entry &entry)
+{
+  DeadlineHeap &heap = deadlines[uint32_t (entry.job.priority)];
+  heap.lock.lock ();
+  if (heap.count == config.queue_capacity)
+  {
+    heap.lock.unlock ();
+    return false;
+  }
+
+  uint32_t i = heap.count++;
+  while (i)
+  {
+    const uint32_t parent = (i - 1) / 2;
+    if (heap.entries[parent].deadline <= entry.job.deadline) break;
+    heap.entries[i] = heap.entries[parent];
+    i = parent;
+  }
+  heap.entries[i] = { entry.job.deadline, entry };
+
+  Atomics::store (&heap.top, heap.entries[0].deadline);
+  heap.lock.unlock ();
+  return true;
+}
+
+inline bool ThreadPool::pop_deadline (const uint32_t level, Entry *entry)
+{
+  DeadlineHeap &heap = deadlines[level];
+  heap.lock.lock ();
+  if (!heap.count)
+  {
+    heap.lock.unlock ();
+    return false;
+  }
+
+  *entry = heap.entries[0].entry;
+  const DeadlineEntry last = heap.entries[--heap.count];
+  uint32_t i = 0;
+  for (;;)
+  {
+    uint32_t child = i * 2 + 1;
+    if (child >= heap.count) break;
+    if (child + 1 < heap.count && heap.entries[child + 1].deadline < heap.entries[child].deadline) ++child;
+    if (last.deadline <= heap.entries[child].deadline) break;
+    heap.entries[i] = heap.entries[child];
+    i = child;
+  }
+  if (heap.count) heap.entries[i] = last;
+
+  Atomics::store (&heap.top, heap.count ? heap.entries[0].deadline : UINT64_MAX);
+  heap.lock.unlock ();
+  return true;
+}
+
+inline bool ThreadPool::pop (Entry *entry, uint32_t *ticket, bool *promoted)
+{
+  *promoted = false;
+
+  uint64_t earliest = UINT64_MAX;
+  for (const DeadlineHeap &heap : deadlines)
+  {
+    const uint64_t top = Atomics::load_relaxed (&heap.top);
+    if (top < earliest) earliest = top;
+  }
+  if (earliest != UINT64_MAX)
+  {
+    /* 임박한 마감 작업끼리는 높은 우선순위부터. 늦은 마감의 Critical 이 이른 마감의 Background 뒤에 서지 않음 */
+    const uint64_t due = Clock::now () + config.deadline_window_ns;
+    for (uint32_t level = 0; level < JOB_PRIORITY_COUNT; ++level)
+      if (Atomics::load_relaxed (&deadlines[level].top) <= due && pop_deadline (level, entry))
+      {
+        *promoted = true;
+        return true;
+      }
+  }
+
+  const bool reverse = config.starvation_interval && ++*ticket % config.starvation_interval == 0;
+  for (uint32_t i = 0; i < JOB_PRIORITY_COUNT; ++i)
+  {
+    const uint32_t level = reverse ? JOB_PRIORITY_COUNT - 1 - i : i;
+    if (Atomics::load_relaxed (&deadlines[level].top) != UINT64_MAX && pop_deadline (level, entry)) return true;
+    if (queues[level].pop (entry)) return true;
+  }
+  return false;
+}
+
+inline bool ThreadPool::has_work () const
+{
+  for (const DeadlineHeap &heap : deadlines)
+    if (Atomics::load_relaxed (&heap.top) != UINT64_MAX) return true;
+  for (const Queue &queue : queues)
+    if (!queue.empty ()) return true;
+  return false;
+}
+
+inline void ThreadPool::run (const Entry &entry, ThreadPoolMetrics *metrics, const bool promoted)
+{
+  const uint64_t latency = Clock::now () - entry.submitted;
+  JobLatency &slot = metrics->latency[uint32_t (entry.job.priority)];
+
+  if (metrics == &external_metrics)
+  {
+    Atomics::fetch_add (&metrics->jobs_executed, uint64_t (1));
+    if (promoted) Atomics::fetch_add (&metrics->deadline_promotions, uint64_t (1));
+    Atomics::fetch_add (&slot.count, uint64_t (1));
+    Atomics::fetch_add (&slot.total_ns, latency);
+    uint64_t max = Atomics::load_relaxed (&slot.max_ns);
+    while (latency > max && !Atomics::compare_exchange (&slot.max_ns, &max, latency))
+      ;
+  }
+  else
+  {
+    Atomics::store_relaxed (&metrics->jobs_executed, metrics->jobs_executed + 1);
+    if (promoted) Atomics::store_relaxed (&metrics->deadline_promotions, metrics->deadline_promotions + 1);
+    Atomics::store_relaxed (&slot.count, slot.count + 1);
+    Atomics::store_relaxed (&slot.total_ns, slot.total_ns + latency);
+    if (latency > slot.max_ns) Atomics::store_relaxed (&slot.max_ns, latency);
+  }
+
+  const Job &job = entry.job;
+  job.func (job.arg);
+  if (job.counter && Atomics::fetch_sub (&job.counter->pending, 1u) == 1)
+    Futex::wake_all (&job.counter->pending);
+}
+
+inline void ThreadPool::notify (const size_t count)
+{
+  /* 큐에 넣은 저장이 sleepers 읽기보다 먼저 보여야 함. 아니면 잠들기 직전 pop 을 다시 본 일꾼과 서로 놓쳐
+     작업이 남은 채 모두 잠들 수 있음 (일꾼 쪽도 sleepers 증가 뒤 같은 장벽을 둠) */
+  Atomics::fence ();
+  if (!Atomics::load (&sleepers)) return;
+
+  Atomics::store_relaxed (&wake_stamp, Clock::now ());
+  Atomics::fetch_add (&wake_epoch, 1u);
+
+  if (count >= config.burst_threshold)
+  {
+    Futex::wake_all (&wake_epoch);
+    return;
+  }
+  for (size_t i = 0; i < count; ++i) Futex::wake_one (&wake_epoch);
+}
+
+inline void ThreadPool::enqueue (const Job &job, const uint64_t submitted)
+{
+  if (job.counter) Atomics::fetch_add (&job.counter->pending, 1u);
+
+  const Entry entry = { job, submitted };
+  if (job.deadline && push_deadline (entry)) return;
+
+  Queue &queue = queues[uint32_t (job.priority)];
+  while (!queue.push (entry))
+    if (!config.help_when_full || !try_run_one ()) Atomics::pause ();
+}
+
+inline void ThreadPool::submit (const Job &job)
+{
+  enqueue (job, Clock::now ());
+  notify (1);
+}
+
+inline void ThreadPool::submit (const Job *jobs, const size_t count)
+{
+  const uint64_t submitted = Clock::now ();
+  for (size_t i = 0; i < count; ++i) enqueue (jobs[i], submitted);
+  notify (count);
+}
+
+inline bool ThreadPool::try_submit (const Job &job)
+{
+  if (job.counter) Atomics::fetch_add (&job.counter->pending, 1u);
+
+  const Entry entry = { job, Clock::now () };
+  if (!(job.deadline && push_deadline (entry)) && !queues[uint32_t (job.priority)].push (entry))
+  {
+    if (job.counter && Atomics::fetch_sub (&job.counter->pending, 1u) == 1)
+      Futex::wake_all (&job.counter->pending);
+    return false;
+  }
+  notify (1);
+  return true;
+}
+
+inline bool ThreadPool::try_run_one ()
+{
+  Entry entry;
+  uint32_t ticket = 1;
+  bool promoted;
+  if (!pop (&entry, &ticket, &promoted)) return false;
+  run (entry, &external_metrics, promoted);
+  return true;
+}
+
+inline void ThreadPool::wait (JobCounter *counter)
+{
+  for (;;)
+  {
+    if (!Atomics::load (&counter->pending)) return;
+    if (try_run_one ()) continue;
+
+    for (uint32_t i = 0; i < config.spin_count && Atomics::load_relaxed (&counter->pending); ++i)
+      Atomics::pause ();
+
+    const uint32_t pending = Atomics::load (&counter->pending);
+    if (!pending) return;
+    if (has_work ()) continue;
+    Futex::wait (&counter->pending, pending);
+  }
+}
+
+inline void ThreadPool::worker_loop (Worker &self)
+{
+  ThreadPoolMetrics &metrics = self.metrics;
+  Entry entry;
+  bool promoted;
+
+  for (;;)
+  {
+    if (pop (&entry, &self.ticket, &promoted))
+    {
+      run (entry, &metrics, promoted);
+      continue;
+    }
+
+    bool found = false;
+    for (uint32_t i = 0; i < config.spin_count; ++i)
+    {
+      Atomics::pause ();
+      if ((i & 15) == 15 && (found = pop (&entry, &self.ticket, &promoted))) break;
+    }
+    if (found)
+    {
+      Atomics::store_relaxed (&metrics.spin_hits, metrics.spin_hits + 1);
+      run (entry, &metrics, promoted);
+      continue;
+    }
+
+    if (Atomics::load (&stopping)) return;
+
+    const uint32_t epoch = Atomics::load (&wake_epoch);
+    Atomics::fetch_add (&sleepers, 1u);
+    Atomics::fence ();
+    if (pop (&entry, &self.ticket, &promoted))
+    {
+      Atomics::fetch_sub (&sleepers, 1u);
+      run (entry, &metrics, promoted);
+      continue;
+    }
+    if (Atomics::load (&stopping))
+    {
+      Atomics::fetch_sub (&sleepers, 1u);
+      return;
+    }
+
+    Atomics::store_relaxed (&metrics.parks, metrics.parks + 1);
+    Futex::wait (&wake_epoch, epoch);
+    Atomics::fetch_sub (&sleepers, 1u);
+
+    if (Atomics::load (&wake_epoch) == epoch) continue;
+
+    const uint64_t latency = Clock::now () - Atomics::load_relaxed (&wake_stamp);
+    Atomics::store_relaxed (&metrics.wakeups, metrics.wakeups + 1);
+    Atomics::store_relaxed (&metrics.wake_latency_total_ns, metrics.wake_latency_total_ns + latency);
+    if (latency > metrics.wake_latency_max_ns) Atomics::store_relaxed (&metrics.wake_latency_max_ns, latency);
+  }
+}
+
+inline void *ThreadPool::worker_main (void *arg)
+{
+  Worker &self = *static_cast <Worker *> (arg);
+  *ThreadLocal::get <void *> (Detail::pool_worker_slot) = &self;
+  self.pool->worker_loop (self);
+  return nullptr;
+}
+
+inline ThreadPoolMetrics ThreadPool::metrics () const
+{
+  ThreadPoolMetrics total = {};
+  for (uint32_t i = 0; i <= config.worker_count; ++i)
+  {
+    const ThreadPoolMetrics &m = i < config.worker_count ? workers[i].metrics : external_metrics;
+    total.jobs_executed += Atomics::load_relaxed (&m.jobs_executed);
+    total.spin_hits += Atomics::load_relaxed (&m.spin_hits);
+    total.parks += Atomics::load_relaxed (&m.parks);
+    total.wakeups += Atomics::load_relaxed (&m.wakeups);
+    total.wake_latency_total_ns += Atomics::load_relaxed (&m.wake_latency_total_ns);
+    const uint64_t max = Atomics::load_relaxed (&m.wake_latency_max_ns);
+    if (max > total.wake_latency_max_ns) total.wake_latency_max_ns = max;
+    total.deadline_promotions += Atomics::load_relaxed (&m.deadline_promotions);
+
+    for (uint32_t p = 0; p < JOB_PRIORITY_COUNT; ++p)
+    {
+      total.latency[p].count += Atomics::load_relaxed (&m.latency[p].count);
+      total.latency[p].total_ns += Atomics::load_relaxed (&m.latency[p].total_ns);
+      const uint64_t latency_max = Atomics::load_relaxed (&m.latency[p].max_ns);
+      if (latency_max > total.latency[p].max_ns) total.latency[p].max_ns = latency_max;
+    }
+  }
+  return total;
+}
+
+inline ThreadPool *ThreadPool::current ()
+{
+  if (!ThreadLocal::attached ()) return nullptr;
+  const auto *worker = static_cast <const Worker *> (*ThreadLocal::get <void *> (Detail::pool_worker_slot));
+  return worker ? worker->pool : nullptr;
+}
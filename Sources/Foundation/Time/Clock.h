@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Clock
+{
+  /* 단조 증가 시계, 나노초 */
+  uint64_t now ();
+} /* namespace Clock */
+
+/* ============ 구현 ============ */
+#if _WIN32
+#include <Windows.h>
+
+namespace Clock
+{
+  inline uint64_t now ()
+  {
+    static const uint64_t frequency = [] { LARGE_INTEGER f; QueryPerformanceFrequency (&f); return uint64_t (f.QuadPart); } ();
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter (&counter);
+    const uint64_t ticks = uint64_t (counter.QuadPart);
+    return ticks / frequency * 1000000000ull + ticks % frequency * 1000000000ull / frequency;
+  }
+} /* namespace Clock */
+
+#elif __APPLE__ || __linux__
+#include <time.h>
+
+namespace Clock
+{
+  inline uint64_t now ()
+  {
+    timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return uint64_t (ts.tv_sec) * 1000000000ull + uint64_t (ts.tv_nsec);
+  }
+} /* namespace Clock */
+
+#endif
@@ -0,0 +1,342 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include "Foundation/Heap/PoolAllocator.h"
+#include "Foundation/Thread/Atomics.h"
+#include "Foundation/Thread/MPSCQueue.h"
+
+/* 세대 0 은 쓰지 않으므로 기본값 TimerHandle {} 은 어떤 타이머도 가리키지 않음 */
+struct TimerHandle
+{
+  uint32_t index;
+  uint32_t generation;
+
+  bool valid () const { return generation != 0; }
+};
+
+/* 4단계 x 256 슬롯 계층형 타이머 휠. 삽입/취소 O(1), advance 에서 만료된 슬롯을 한꺼번에 처리.
+   schedule/cancel/advance 는 소유 스레드 전용이고 다른 스레드는 post/post_cancel 사용.
+   post 는 소유 스레드가 advance 때마다 채워 두는 예비 노드에서 하나를 꺼내 핸들을 바로 돌려주므로
+   다음 advance 전에도 post_cancel 로 취소 가능. 예비 노드나 요청 큐가 바닥나면 무효 핸들 */
+class TimerWheel
+{
+public:
+  using Callback = void (*) (void *arg);
+
+  explicit TimerWheel (size_t max_timers = 1 << 20);
+
+  TimerWheel (const TimerWheel &) = delete;
+  TimerWheel &operator= (const TimerWheel &) = delete;
+
+  TimerHandle schedule (uint64_t delay, Callback callback, void *arg, uint64_t interval = 0);
+  bool cancel (TimerHandle handle);
+
+  TimerHandle post (uint64_t delay, Callback callback, void *arg, uint64_t interval = 0);
+  bool post_cancel (TimerHandle handle);
+
+  size_t advance (uint64_t ticks = 1);
+
+  uint64_t now () const { return current; }
+  size_t size () const { return timers.size () - Atomics::load (&reserve_count); }
+
+private:
+  static constexpr uint32_t LEVELS = 4;
+  static constexpr uint32_t SLOT_BITS = 8;
+  static constexpr uint32_t SLOTS = 1 << SLOT_BITS;
+  static constexpr uint64_t MAX_DELAY = (uint64_t (1) << (LEVELS * SLOT_BITS)) - (uint64_t (1) << ((LEVELS - 1) * SLOT_BITS)) - 1;
+  static constexpr uint32_t POST_RESERVE = 256;
+
+  struct Node
+  {
+    Node *next;
+    Node *prev;
+    uint64_t expires;
+    uint64_t interval;
+    Callback callback;
+    void *arg;
+    uint32_t generation;
+    uint32_t reserve_next;            /* 예비 스택에서 다음 노드의 인덱스 + 1 */
+  };
+
+  struct List
+  {
+    Node *next;
+    Node *prev;
+  };
+
+  struct Request
+  {
+    uint64_t delay;
+    uint64_t interval;
+    Callback callback;
+    void *arg;
+    TimerHandle handle;
+  };
+
+  static Node *sentinel (List &list) { return reinterpret_cast <Node *> (&list); }
+  static void link (List &list, Node *node);
+  static void unlink (Node *node);
+
+  void arm (Node *node, uint64_t delay, Callback callback, void *arg, uint64_t interval);
+  void insert (Node *node);
+  void release (Node *node);
+  Node *resolve (TimerHandle handle) const;
+  void cascade (uint32_t level);
+  size_t expire (uint32_t slot);
+  void drain_requests ();
+  void refill_reserve ();
+  Node *pop_reserve ();
+  void push_reserve (Node *node);
+
+  PoolAllocator timers;
+  List wheel[LEVELS][SLOTS];
+  uint64_t occupied[SLOTS / 64];
+  List expiring;
+  uint64_t current = 0;
+  MPSCQueue <Request, 4096> requests;
+
+  /* 예비 노드 스택. 상위 32 비트 태그 (ABA 방지) 와 하위 32 비트 인덱스 + 1 */
+  uint64_t reserve_head = 0;
+  uint32_t reserve_count = 0;
+};
+
+/* ============ 구현 ============ */
+inline TimerWheel::TimerWheel (const size_t max_timers) : timers (sizeof (Node), max_timers)
+{
+  for (auto &level : wheel)
+    for (List &list : level) list = { sentinel (list), sentinel (list) };
+  for (uint64_t &bits : occupied) bits = 0;
+  expiring = { sentinel (expiring), sentinel (expiring) };
+  refill_reserve ();
+}
+
+inline void TimerWheel::link (List &list, Node *node)
+{
+  Node *head = sentinel (list);
+  node->next = head;
+  node->prev = list.prev;
+  list.prev->next = node;
+  list.prev = node;
+}
+
+/* 뗀 노드는 자기 자신을 가리키므로 콜백 안에서 자기 핸들을 취소해 다시 떼어도 이웃을 건드리지 않음 */
+inline void TimerWheel::unlink (Node *node)
+{
+  node->prev->next = node->next;
+  node->next->prev = node->prev;
+  node->next = node->prev = node;
+}
+
+inline void TimerWheel::insert (Node *node)
+{
+  const uint64_t delta = node->expires - current;
+
+  uint32_t level = 0;
+  while (level + 1 < LEVELS && delta >= (uint64_t (1) << ((level + 1) * SLOT_BITS))) ++level;
+
+  const uint32_t slot = uint32_t (node->expires >> (level * SLOT_BITS)) & (SLOTS - 1);
+  link (wheel[level][slot], node);
+  if (level == 0) occupied[slot >> 6] |= uint64_t (1) << (slot & 63);
+}
+
+inline void TimerWheel::release (Node *node)
+{
+  node->callback = nullptr;
+  if (++node->generation == 0) node->generation = 1;
+  timers.free (node);
+}
+
+inline TimerWheel::Node *TimerWheel::resolve (const TimerHandle handle) const
+{
+  if (!handle.generation || handle.index >= timers.used ()) return nullptr;
+  Node *node = static_cast <Node *> (timers.at (handle.index));
+  if (node->generation != handle.generation || !node->callback) return nullptr;
+  return node;
+}
+
+inline void TimerWheel::arm (Node *node, const uint64_t delay, const Callback callback, void *arg, const uint64_t interval)
+{
+  node->expires = current + (delay == 0 ? 1 : delay > MAX_DELAY ? MAX_DELAY : delay);
+  node->interval = interval > MAX_DELAY ? MAX_DELAY : interval;
+  node->callback = callback;
+  node->arg = arg;
+  insert (node);
+}
+
+inline TimerHandle TimerWheel::schedule (const uint64_t delay, const Callback callback, void *arg, const uint64_t interval)
+{
+  Node *node = static_cast <Node *> (timers.allocate ());
+  if (!node || !callback) abort ();
+
+  /* 새로 커밋된 블록은 0 으로 차 있고, 해제된 블록은 0 이 아닌 세대를 가짐 */
+  if (!node->generation) node->generation = 1;
+  arm (node, delay, callback, arg, interval);
+
+  return { uint32_t (timers.index_of (node)), node->generation };
+}
+
+inline bool TimerWheel::cancel (const TimerHandle handle)
+{
+  Node *node = resolve (handle);
+  if (!node) return false;
+  unlink (node);
+  release (node);
+  return true;
+}
+
+inline TimerHandle TimerWheel::post (const uint64_t delay, const Callback callback, void *arg, const uint64_t interval)
+{
+  if (!callback) abort ();
+
+  Node *node = pop_reserve ();
+  if (!node) return {};
+
+  const TimerHandle handle = { uint32_t (timers.index_of (node)), node->generation };
+  if (requests.push ({ delay, interval, callback, arg, handle })) return handle;
+
+  push_reserve (node);
+  return {};
+}
+
+inline bool TimerWheel::post_cancel (const TimerHandle handle)
+{
+  return requests.push ({ 0, 0, nullptr, nullptr, handle });
+}
+
+inline void TimerWheel::drain_requests ()
+{
+  Request request;
+  while (requests.pop (&request))
+  {
+    if (request.callback) arm (static_cast <Node *> (timers.at (request.handle.index)), request.delay, request.callback, request.arg, request.interval);
+    else cancel (request.handle);
+  }
+  refill_reserve ();
+}
+
+inline void TimerWheel::refill_reserve ()
+{
+  while (Atomics::load (&reserve_count) < POST_RESERVE)
+  {
+    Node *node = static_cast <Node *> (timers.allocate ());
+    if (!node) return;
+    if (!node->generation) node->generation = 1;
+    node->callback = nullptr;
+    push_reserve (node);
+  }
+}
+
+inline TimerWheel::Node *TimerWheel::pop_reserve ()
+{
+  uint64_t head = Atomics::load (&reserve_head);
+  for (;;)
+  {
+    const uint32_t index = uint32_t (head);
+    if (!index) return nullptr;
+    Node *node = static_cast <Node *> (timers.at (index - 1));
+    const uint64_t next = ((head >> 32) + 1) << 32 | Atomics::load_relaxed (&node->reserve_next);
+    if (Atomics::compare_exchange (&reserve_head, &head, next))
+    {
+      Atomics::fetch_sub (&reserve_count, 1u);
+      return node;
+    }
+  }
+}
+
+inline void TimerWheel::push_reserve (Node *node)
+{
+  const uint32_t index = uint32_t (timers.index_of (node)) + 1;
+  uint64_t head = Atomics::load (&reserve_head);
+  do Atomics::store_relaxed (&node->reserve_next, uint32_t (head));
+  while (!Atomics::compare_exchange (&reserve_head, &head, ((head >> 32) + 1) << 32 | index));
+  Atomics::fetch_add (&reserve_count, 1u);
+}
+
+inline void TimerWheel::cascade (const uint32_t level)
+{
+  List &list = wheel[level][uint32_t (current >> (level * SLOT_BITS)) & (SLOTS - 1)];
+  Node *node = list.next;
+  list = { sentinel (list), sentinel (list) };
+
+  while (node != sentinel (list))
+  {
+    Node *next = node->next;
+    insert (node);
+    node = next;
+  }
+}
+
+inline size_t TimerWheel::expire (const uint32_t slot)
+{
+  List &list = wheel[0][slot];
+  occupied[slot >> 6] &= ~(uint64_t (1) << (slot & 63));
+  if (list.next == sentinel (list)) return 0;
+
+  expiring.next = list.next;
+  expiring.prev = list.prev;
+  expiring.next->prev = sentinel (expiring);
+  expiring.prev->next = sentinel (expiring);
+  list = { sentinel (list), sentinel (list) };
+
+  size_t fired = 0;
+  while (expiring.next != sentinel (expiring))
+  {
+    Node *node = expiring.next;
+    unlink (node);
+
+    const uint32_t generation = node->generation;
+    node->callback (node->arg);
+    ++fired;
+
+    if (node->generation != generation || !node->callback) continue;
+    if (node->interval)
+    {
+      node->expires = current + node->interval;
+      insert (node);
+    }
+    else release (node);
+  }
+  return fired;
+}
+
+inline size_t TimerWheel::advance (const uint64_t ticks)
+{
+  drain_requests ();
+
+  const uint64_t target = current + ticks;
+  size_t fired = 0;
+
+  while (current < target)
+  {
+    const uint64_t boundary = (current | (SLOTS - 1)) + 1;
+    const uint64_t stop = boundary < target ? boundary : target;
+
+    uint64_t next = stop;
+    for (uint64_t tick = current + 1; tick < stop;)
+    {
+      const uint32_t slot = uint32_t (tick) & (SLOTS - 1);
+      const uint64_t bits = occupied[slot >> 6] >> (slot & 63);
+      if (bits)
+      {
+        const uint64_t candidate = tick + __builtin_ctzll (bits);
+        next = candidate < stop ? candidate : stop;
+        break;
+      }
+      tick += 64 - (slot & 63);
+    }
+    current = next;
+
+    if ((current & (SLOTS - 1)) == 0)
+      for (uint32_t level = 1; level < LEVELS; ++level)
+      {
+        cascade (level);
+        if ((current >> (level * SLOT_BITS)) & (SLOTS - 1)) break;
+      }
+
+    fired += expire (uint32_t (current) & (SLOTS - 1));
+  }
+  return fired;
+}
@@ -1,7 +1,12 @@
 #include <cstdio>
 
+#include "Foundation/Thread/ThreadLocal.h"
+
 int main ()
 {
+  /* 스레드별 컨텍스트를 쓰는 모듈 (EventBus, 경로 탐색, 행동 트리, 명령 버킷) 을 메인 스레드에서도 부를 수 있도록 */
+  ThreadLocal::attach ();
   printf ("Hello, World!\n");
+  ThreadLocal::detach ();
   return 0;
 }
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+/* 정점마다 그 정점을 쓰는 삼각형 목록 (CSR). 정점 v 의 삼각형은 triangles[offsets[v]] 부터 counts[v] 개.
+   counts 는 처리 중 삼각형을 지울 때 줄여 쓰도록 따로 둠 */
+struct MeshAdjacency
+{
+  uint32_t *offsets = nullptr;
+  uint32_t *counts = nullptr;
+  uint32_t *triangles = nullptr;
+
+  MeshAdjacency (const uint32_t *indices, size_t index_count, size_t vertex_count);
+  ~MeshAdjacency ();
+
+  MeshAdjacency (const MeshAdjacency &) = delete;
+  MeshAdjacency &operator= (const MeshAdjacency &) = delete;
+
+  /* 정점 v 의 목록에서 삼각형 하나를 지움 (순서는 유지하지 않음) */
+  void remove (uint32_t vertex, uint32_t triangle);
+};
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  /* 도구용 임시 배열. 실패하면 중단 */
+  template <typename T>
+  T *mesh_allocate (const size_t count)
+  {
+    T *data = static_cast <T *> (malloc (sizeof (T) * (count ? count : 1)));
+    if (!data) abort ();
+    return data;
+  }
+}
+
+inline MeshAdjacency::MeshAdjacency (const uint32_t *indices, const size_t index_count, const size_t vertex_count)
+{
+  offsets = Detail::mesh_allocate <uint32_t> (vertex_count + 1);
+  counts = Detail::mesh_allocate <uint32_t> (vertex_count);
+  triangles = Detail::mesh_allocate <uint32_t> (index_count);
+  memset (counts, 0, sizeof (uint32_t) * vertex_count);
+
+  for (size_t i = 0; i < index_count; ++i) ++counts[indices[i]];
+  uint32_t offset = 0;
+  for (size_t v = 0; v < vertex_count; ++v)
+  {
+    offsets[v] = offset;
+    offset += counts[v];
+    counts[v] = 0;
+  }
+  offsets[vertex_count] = offset;
+
+  for (size_t i = 0; i < index_count; ++i)
+  {
+    const uint32_t v = indices[i];
+    triangles[offsets[v] + counts[v]++] = uint32_t (i / 3);
+  }
+}
+
+inline MeshAdjacency::~MeshAdjacency ()
+{
+  free (offsets);
+  free (counts);
+  free (triangles);
+}
+
+inline void MeshAdjacency::remove (const uint32_t vertex, const uint32_t triangle)
+{
+  uint32_t *list = triangles + offsets[vertex];
+  const uint32_t count = counts[vertex];
+  for (uint32_t i = 0; i < count; ++i)
+    if (list[i] == triangle)
+    {
+      list[i] = list[count - 1];
+      counts[vertex] = count - 1;
+      return;
+    }
+}
@@ -0,0 +1,278 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "Mesh/MeshAdjacency.h"
+
+/* 이차 오차 (quadric error) 기반 변 붕괴로 삼각형 수를 줄여 LOD 인덱스를 만듦. 정점은 새로 만들지 않고
+   기존 정점으로만 합치므로 모든 LOD 가 원래 정점 버퍼를 같이 씀.
+   positions 는 position_stride 바이트 간격의 float3. target_error 는 메시 크기 (가장 긴 축) 에 대한 비율.
+   열린 경계와 속성 이음매 (위치가 같은 다른 정점) 의 정점은 움직이지 않아 틈이 생기지 않음.
+   out 과 indices 는 같아도 됨. 반환값은 남은 인덱스 수, result_error 에는 실제 최대 오차 (같은 단위) */
+size_t simplify_mesh (uint32_t *out, const uint32_t *indices, size_t index_count, const float *positions, size_t vertex_count,
+                      size_t position_stride, size_t target_index_count, float target_error, float *result_error = nullptr);
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  /* 평면 거리 제곱의 합. Q(p) = p^T A p + 2 b.p + c, weight 는 넓이 합 */
+  struct Quadric
+  {
+    float a00, a11, a22, a01, a02, a12;
+    float b0, b1, b2;
+    float c;
+    float weight;
+
+    void add (const Quadric &other)
+    {
+      a00 += other.a00; a11 += other.a11; a22 += other.a22;
+      a01 += other.a01; a02 += other.a02; a12 += other.a12;
+      b0 += other.b0; b1 += other.b1; b2 += other.b2;
+      c += other.c;
+      weight += other.weight;
+    }
+
+    float error (const float *p) const
+    {
+      const float x = p[0], y = p[1], z = p[2];
+      const float value = a00 * x * x + a11 * y * y + a22 * z * z + 2.0f * (a01 * x * y + a02 * x * z + a12 * y * z)
+                          + 2.0f * (b0 * x + b1 * y + b2 * z) + c;
+      return value > 0.0f ? value : 0.0f;
+    }
+  };
+
+  inline void mesh_triangle_normal (const float *a, const float *b, const float *c, float *normal)
+  {
+    const float e0[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] }, e1[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+    normal[0] = e0[1] * e1[2] - e0[2] * e1[1];
+    normal[1] = e0[2] * e1[0] - e0[0] * e1[2];
+    normal[2] = e0[0] * e1[1] - e0[1] * e1[0];
+  }
+
+  struct MeshCollapse
+  {
+    uint32_t source;
+    uint32_t target;
+    float error;
+  };
+
+  /* 위치가 정확히 같은 정점끼리 묶어 이음매를 찾음. 대표 정점이 아닌 것이 하나라도 있으면 그 위치는 이음매 */
+  inline void mesh_mark_seams (const float *positions, const size_t vertex_count, uint8_t *locked)
+  {
+    size_t capacity = 64;
+    while (capacity < vertex_count * 2) capacity *= 2;
+    uint32_t *table = mesh_allocate <uint32_t> (capacity);
+    memset (table, 0xff, sizeof (uint32_t) * capacity);
+
+    for (size_t v = 0; v < vertex_count; ++v)
+    {
+      const float *p = positions + v * 3;
+      uint32_t bits[3];
+      memcpy (bits, p, sizeof (bits));
+      size_t slot = size_t ((bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u)) & (capacity - 1);
+      for (;;)
+      {
+        const uint32_t other = table[slot];
+        if (other == ~0u)
+        {
+          table[slot] = uint32_t (v);
+          break;
+        }
+        if (!memcmp (positions + size_t (other) * 3, p, sizeof (float) * 3))
+        {
+          locked[v] = locked[other] = 1;
+          break;
+        }
+        slot = (slot + 1) & (capacity - 1);
+      }
+    }
+    free (table);
+  }
+
+  /* 반대 방향 반변이 없는 변의 양 끝은 열린 경계 */
+  inline void mesh_mark_borders (const uint32_t *indices, const size_t index_count, const MeshAdjacency &adjacency, uint8_t *locked)
+  {
+    for (size_t i = 0; i < index_count; ++i)
+    {
+      const uint32_t a = indices[i], b = indices[i - i % 3 + (i + 1) % 3];
+      bool opposite = false;
+      const uint32_t *list = adjacency.triangles + adjacency.offsets[b];
+      for (uint32_t j = 0; j < adjacency.counts[b] && !opposite; ++j)
+      {
+        const uint32_t *corner = indices + list[j] * 3;
+        for (int k = 0; k < 3; ++k) opposite |= corner[k] == b && corner[(k + 1) % 3] == a;
+      }
+      if (!opposite) locked[a] = locked[b] = 1;
+    }
+  }
+}
+
+inline size_t simplify_mesh (uint32_t *out, const uint32_t *indices, size_t index_count, const float *positions, const size_t vertex_count,
+                             const size_t position_stride, const size_t target_index_count, const float target_error, float *result_error)
+{
+  using namespace Detail;
+
+  index_count -= index_count % 3;
+  if (out != indices) memcpy (out, indices, sizeof (uint32_t) * index_count);
+  if (result_error) *result_error = 0.0f;
+  if (index_count <= target_index_count || !vertex_count) return index_count;
+
+  /* 가장 긴 축이 1 이 되도록 옮겨 오차를 크기와 무관하게 맞춤 */
+  float low[3] = { 1e30f, 1e30f, 1e30f }, high[3] = { -1e30f, -1e30f, -1e30f };
+  for (size_t v = 0; v < vertex_count; ++v)
+  {
+    const float *p = reinterpret_cast <const float *> (reinterpret_cast <const uint8_t *> (positions) + v * position_stride);
+    for (int c = 0; c < 3; ++c)
+    {
+      low[c] = p[c] < low[c] ? p[c] : low[c];
+      high[c] = p[c] > high[c] ? p[c] : high[c];
+    }
+  }
+  float extent = high[0] - low[0];
+  extent = high[1] - low[1] > extent ? high[1] - low[1] : extent;
+  extent = high[2] - low[2] > extent ? high[2] - low[2] : extent;
+  const float scale = extent > 0.0f ? 1.0f / extent : 1.0f;
+
+  float *points = mesh_allocate <float> (vertex_count * 3);
+  for (size_t v = 0; v < vertex_count; ++v)
+  {
+    const float *p = reinterpret_cast <const float *> (reinterpret_cast <const uint8_t *> (positions) + v * position_stride);
+    for (int c = 0; c < 3; ++c) points[v * 3 + c] = (p[c] - low[c]) * scale;
+  }
+
+  uint8_t *locked = mesh_allocate <uint8_t> (vertex_count);
+  memset (locked, 0, vertex_count);
+  mesh_mark_seams (points, vertex_count, locked);
+  {
+    const MeshAdjacency adjacency (out, index_count, vertex_count);
+    mesh_mark_borders (out, index_count, adjacency, locked);
+  }
+
+  Quadric *quadrics = mesh_allocate <Quadric> (vertex_count);
+  memset (static_cast <void *> (quadrics), 0, sizeof (Quadric) * vertex_count);
+  for (size_t i = 0; i < index_count; i += 3)
+  {
+    const float *a = points + out[i] * 3, *b = points + out[i + 1] * 3, *c = points + out[i + 2] * 3;
+    float n[3];
+    mesh_triangle_normal (a, b, c, n);
+    const float length = sqrtf (n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    if (length <= 0.0f) continue;
+    const float area = length * 0.5f;
+    for (float &x : n) x /= length;
+    const float d = -(n[0] * a[0] + n[1] * a[1] + n[2] * a[2]);
+    const Quadric q = { n[0] * n[0] * area, n[1] * n[1] * area, n[2] * n[2] * area, n[0] * n[1] * area, n[0] * n[2] * area, n[1] * n[2] * area,
+                        n[0] * d * area, n[1] * d * area, n[2] * d * area, d * d * area, area };
+    for (int k = 0; k < 3; ++k) quadrics[out[i + k]].add (q);
+  }
+
+  uint32_t *remap = mesh_allocate <uint32_t> (vertex_count);
+  uint8_t *touched = mesh_allocate <uint8_t> (vertex_count);
+  MeshCollapse *collapses = mesh_allocate <MeshCollapse> (index_count);
+  for (size_t v = 0; v < vertex_count; ++v) remap[v] = uint32_t (v);
+
+  const float error_limit = target_error * target_error;
+  float max_error = 0.0f;
+
+  /* 한 번에 서로 닿지 않는 붕괴를 오차 순으로 골라 적용하고 인덱스를 다시 씀. 더 못 줄이면 멈춤 */
+  while (index_count > target_index_count)
+  {
+    const MeshAdjacency adjacency (out, index_count, vertex_count);
+
+    size_t collapse_count = 0;
+    for (size_t i = 0; i < index_count; ++i)
+    {
+      uint32_t a = out[i], b = out[i - i % 3 + (i + 1) % 3];
+      if (a > b)
+      {
+        const uint32_t swap = a;
+        a = b;
+        b = swap;
+      }
+      if (locked[a] && locked[b]) continue;
+
+      /* 매니폴드면 같은 변이 두 번 나오므로 작은 번호에서 큰 번호로 가는 반변만 */
+      if (out[i] != a) continue;
+
+      Quadric q = quadrics[a];
+      q.add (quadrics[b]);
+      const float weight = q.weight > 0.0f ? 1.0f / q.weight : 0.0f;
+      const float to_b = locked[a] ? 1e30f : q.error (points + b * 3) * weight;
+      const float to_a = locked[b] ? 1e30f : q.error (points + a * 3) * weight;
+      if (to_b <= to_a) collapses[collapse_count++] = { a, b, to_b };
+      else collapses[collapse_count++] = { b, a, to_a };
+    }
+
+    qsort (collapses, collapse_count, sizeof (MeshCollapse), [] (const void *x, const void *y)
+    {
+      const float ex = static_cast <const MeshCollapse *> (x)->error, ey = static_cast <const MeshCollapse *> (y)->error;
+      return ex < ey ? -1 : ex > ey ? 1 : 0;
+    });
+
+    /* 붕괴 하나가 삼각형 두 개쯤을 지움 */
+    const size_t wanted = (index_count - target_index_count) / 6 + 1;
+    memset (touched, 0, vertex_count);
+    size_t applied = 0;
+    for (size_t c = 0; c < collapse_count && applied < wanted; ++c)
+    {
+      const MeshCollapse &collapse = collapses[c];
+      if (collapse.error > error_limit) break;
+      if (touched[collapse.source] || touched[collapse.target]) continue;
+
+      /* 남는 삼각형이 뒤집히지 않는지 */
+      const uint32_t *list = adjacency.triangles + adjacency.offsets[collapse.source];
+      const uint32_t count = adjacency.counts[collapse.source];
+      bool flipped = false;
+      for (uint32_t j = 0; j < count && !flipped; ++j)
+      {
+        const uint32_t *corner = out + list[j] * 3;
+        if (corner[0] == collapse.target || corner[1] == collapse.target || corner[2] == collapse.target) continue;
+        const float *p[3], *moved[3];
+        for (int k = 0; k < 3; ++k)
+        {
+          p[k] = points + corner[k] * 3;
+          moved[k] = corner[k] == collapse.source ? points + collapse.target * 3 : p[k];
+        }
+        float before[3], after[3];
+        mesh_triangle_normal (p[0], p[1], p[2], before);
+        mesh_triangle_normal (moved[0], moved[1], moved[2], after);
+        flipped = before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0f;
+      }
+      if (flipped) continue;
+
+      /* 이웃 정점까지 잠가야 같은 번에 적용한 붕괴끼리 뒤집힘 검사가 어긋나지 않음 */
+      for (uint32_t j = 0; j < count; ++j)
+        for (int k = 0; k < 3; ++k) touched[out[list[j] * 3 + k]] = 1;
+      touched[collapse.target] = 1;
+
+      remap[collapse.source] = collapse.target;
+      quadrics[collapse.target].add (quadrics[collapse.source]);
+      max_error = collapse.error > max_error ? collapse.error : max_error;
+      ++applied;
+    }
+    if (!applied) break;
+
+    size_t write = 0;
+    for (size_t i = 0; i < index_count; i += 3)
+    {
+      const uint32_t a = remap[out[i]], b = remap[out[i + 1]], c = remap[out[i + 2]];
+      if (a == b || b == c || a == c) continue;
+      out[write++] = a;
+      out[write++] = b;
+      out[write++] = c;
+    }
+    index_count = write;
+  }
+
+  free (points);
+  free (locked);
+  free (quadrics);
+  free (remap);
+  free (touched);
+  free (collapses);
+  if (result_error) *result_error = sqrtf (max_error);
+  return index_count;
+}
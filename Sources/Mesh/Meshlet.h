@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Mesh/MeshAdjacency.h"
+
+/* 정점 max_vertices 개, 삼각형 max_triangles 개 이하의 작은 묶음. 삼각형은 meshlet_vertices 안의 지역 번호
+   (바이트) 세 개씩. 경계 구와 법선 원뿔로 묶음 단위 가시성/뒷면 컬링을 할 수 있음 */
+struct Meshlet
+{
+  uint32_t vertex_offset;     /* meshlet_vertices 안 시작 위치 */
+  uint32_t triangle_offset;   /* meshlet_triangles 안 시작 위치 (바이트) */
+  uint32_t vertex_count;
+  uint32_t triangle_count;
+
+  float center[3];
+  float radius;
+  /* normalize (apex - camera) . axis >= cutoff 이면 모든 삼각형이 뒷면. 원뿔이 너무 넓으면 cutoff 는 1 (컬링 안 함) */
+  float cone_apex[3];
+  float cone_axis[3];
+  float cone_cutoff;
+};
+
+/* meshlets 배열에 필요한 최대 개수. meshlet_vertices 와 meshlet_triangles 는 index_count 개면 충분 */
+size_t meshlet_bound (size_t index_count, uint32_t max_vertices, uint32_t max_triangles);
+
+/* 현재 묶음과 정점을 가장 많이 공유하는 이웃 삼각형을 탐욕적으로 붙여 나감. 이웃이 없으면 입력 순서상 다음 삼각형에서
+   새로 시작하므로 정점 캐시 최적화 뒤에 부르면 좋음. max_vertices 는 255 이하. 반환값은 묶음 수 */
+size_t build_meshlets (Meshlet *meshlets, uint32_t *meshlet_vertices, uint8_t *meshlet_triangles, const uint32_t *indices, size_t index_count,
+                       const float *positions, size_t vertex_count, size_t position_stride, uint32_t max_vertices = 64, uint32_t max_triangles = 124);
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  inline const float *meshlet_position (const float *positions, const size_t stride, const uint32_t vertex)
+  {
+    return reinterpret_cast <const float *> (reinterpret_cast <const uint8_t *> (positions) + size_t (vertex) * stride);
+  }
+
+  inline void meshlet_bounds (Meshlet &meshlet, const uint32_t *vertices, const uint8_t *triangles, const float *positions, const size_t stride)
+  {
+    float low[3] = { 1e30f, 1e30f, 1e30f }, high[3] = { -1e30f, -1e30f, -1e30f };
+    for (uint32_t i = 0; i < meshlet.vertex_count; ++i)
+    {
+      const float *p = meshlet_position (positions, stride, vertices[i]);
+      for (int c = 0; c < 3; ++c)
+      {
+        low[c] = p[c] < low[c] ? p[c] : low[c];
+        high[c] = p[c] > high[c] ? p[c] : high[c];
+      }
+    }
+    float radius = 0.0f;
+    for (int c = 0; c < 3; ++c) meshlet.center[c] = (low[c] + high[c]) * 0.5f;
+    for (uint32_t i = 0; i < meshlet.vertex_count; ++i)
+    {
+      const float *p = meshlet_position (positions, stride, vertices[i]);
+      const float dx = p[0] - meshlet.center[0], dy = p[1] - meshlet.center[1], dz = p[2] - meshlet.center[2];
+      const float d = dx * dx + dy * dy + dz * dz;
+      radius = d > radius ? d : radius;
+    }
+    meshlet.radius = sqrtf (radius);
+
+    /* 넓이로 가중한 법선 평균이 축. 가장 벗어난 법선과의 각이 90 도에 가까우면 원뿔을 쓰지 않음 */
+    float axis[3] = {};
+    for (uint32_t t = 0; t < meshlet.triangle_count; ++t)
+    {
+      const float *a = meshlet_position (positions, stride, vertices[triangles[t * 3]]);
+      const float *b = meshlet_position (positions, stride, vertices[triangles[t * 3 + 1]]);
+      const float *c = meshlet_position (positions, stride, vertices[triangles[t * 3 + 2]]);
+      const float e0[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] }, e1[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+      axis[0] += e0[1] * e1[2] - e0[2] * e1[1];
+      axis[1] += e0[2] * e1[0] - e0[0] * e1[2];
+      axis[2] += e0[0] * e1[1] - e0[1] * e1[0];
+    }
+    const float axis_length = sqrtf (axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+    for (int c = 0; c < 3; ++c)
+    {
+      meshlet.cone_axis[c] = axis_length > 0.0f ? axis[c] / axis_length : 0.0f;
+      meshlet.cone_apex[c] = meshlet.center[c];
+    }
+
+    float min_dot = 1.0f;
+    for (uint32_t t = 0; t < meshlet.triangle_count && axis_length > 0.0f; ++t)
+    {
+      const float *a = meshlet_position (positions, stride, vertices[triangles[t * 3]]);
+      const float *b = meshlet_position (positions, stride, vertices[triangles[t * 3 + 1]]);
+      const float *c = meshlet_position (positions, stride, vertices[triangles[t * 3 + 2]]);
+      const float e0[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] }, e1[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+      const float n[3] = { e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0] };
+      const float length = sqrtf (n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+      if (length <= 0.0f) continue;
+      const float d = (n[0] * meshlet.cone_axis[0] + n[1] * meshlet.cone_axis[1] + n[2] * meshlet.cone_axis[2]) / length;
+      min_dot = d < min_dot ? d : min_dot;
+    }
+    if (axis_length <= 0.0f || min_dot <= 0.1f)
+    {
+      meshlet.cone_cutoff = 1.0f;
+      return;
+    }
+
+    /* 꼭짓점은 중심에서 축 반대로, 모든 삼각형 평면의 뒤쪽에 올 때까지 물러난 점 */
+    float back = 0.0f;
+    for (uint32_t t = 0; t < meshlet.triangle_count; ++t)
+    {
+      const float *a = meshlet_position (positions, stride, vertices[triangles[t * 3]]);
+      const float *b = meshlet_position (positions, stride, vertices[triangles[t * 3 + 1]]);
+      const float *c = meshlet_position (positions, stride, vertices[triangles[t * 3 + 2]]);
+      const float e0[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] }, e1[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+      const float n[3] = { e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0] };
+      const float dc = (meshlet.center[0] - a[0]) * n[0] + (meshlet.center[1] - a[1]) * n[1] + (meshlet.center[2] - a[2]) * n[2];
+      const float dn = meshlet.cone_axis[0] * n[0] + meshlet.cone_axis[1] * n[1] + meshlet.cone_axis[2] * n[2];
+      if (dn > 0.0f && dc / dn > back) back = dc / dn;
+    }
+    for (int c = 0; c < 3; ++c) meshlet.cone_apex[c] = meshlet.center[c] - meshlet.cone_axis[c] * back;
+    meshlet.cone_cutoff = sqrtf (1.0f - min_dot * min_dot);
+  }
+}
+
+inline size_t meshlet_bound (const size_t index_count, const uint32_t max_vertices, const uint32_t max_triangles)
+{
+  /* 묶음은 다음 삼각형이 들어가지 않을 때만 닫히므로 적어도 min (max_triangles, max_vertices / 3) 개를 가짐 */
+  uint32_t minimum = max_vertices / 3 < max_triangles ? max_vertices / 3 : max_triangles;
+  if (!minimum) minimum = 1;
+  return (index_count / 3 + minimum - 1) / minimum;
+}
+
+inline size_t build_meshlets (Meshlet *meshlets, uint32_t *meshlet_vertices, uint8_t *meshlet_triangles, const uint32_t *indices, size_t index_count,
+                              const float *positions, const size_t vertex_count, const size_t position_stride, const uint32_t max_vertices,
+                              const uint32_t max_triangles)
+{
+  using namespace Detail;
+
+  index_count -= index_count % 3;
+  const size_t triangle_count = index_count / 3;
+  if (!triangle_count) return 0;
+
+  MeshAdjacency adjacency (indices, index_count, vertex_count);
+  uint8_t *slots = mesh_allocate <uint8_t> (vertex_count);
+  uint8_t *used = mesh_allocate <uint8_t> (triangle_count);
+  memset (slots, 0xff, vertex_count);
+  memset (used, 0, triangle_count);
+
+  size_t meshlet_count = 0, vertex_offset = 0, triangle_offset = 0, cursor = 0;
+  Meshlet current = {};
+
+  auto new_vertices = [&] (const uint32_t triangle)
+  {
+    const uint32_t *corner = indices + triangle * 3;
+    uint32_t count = 0;
+    for (int k = 0; k < 3; ++k)
+      count += slots[corner[k]] == 0xff && (k == 0 || corner[k] != corner[0]) && (k < 2 || corner[2] != corner[1]);
+    return count;
+  };
+
+  auto finish = [&]
+  {
+    if (!current.triangle_count) return;
+    meshlet_bounds (current, meshlet_vertices + current.vertex_offset, meshlet_triangles + current.triangle_offset, positions, position_stride);
+    for (uint32_t i = 0; i < current.vertex_count; ++i) slots[meshlet_vertices[current.vertex_offset + i]] = 0xff;
+    meshlets[meshlet_count++] = current;
+    vertex_offset += current.vertex_count;
+    triangle_offset += size_t (current.triangle_count) * 3;
+    current = {};
+    current.vertex_offset = uint32_t (vertex_offset);
+    current.triangle_offset = uint32_t (triangle_offset);
+  };
+
+  for (size_t written = 0; written < triangle_count; ++written)
+  {
+    /* 현재 묶음의 정점에 붙은 삼각형 가운데 새 정점이 가장 적게 드는 것 */
+    uint32_t best = ~0u, best_cost = 4;
+    for (uint32_t i = 0; i < current.vertex_count && best_cost; ++i)
+    {
+      const uint32_t v = meshlet_vertices[current.vertex_offset + i];
+      const uint32_t *list = adjacency.triangles + adjacency.offsets[v];
+      for (uint32_t j = 0; j < adjacency.counts[v]; ++j)
+      {
+        const uint32_t cost = new_vertices (list[j]);
+        if (cost < best_cost)
+        {
+          best_cost = cost;
+          best = list[j];
+          if (!cost) break;
+        }
+      }
+    }
+    if (best == ~0u)
+    {
+      while (used[cursor]) ++cursor;
+      best = uint32_t (cursor);
+      best_cost = new_vertices (best);
+    }
+
+    if (current.vertex_count + best_cost > max_vertices || current.triangle_count + 1 > max_triangles) finish ();
+
+    const uint32_t *corner = indices + best * 3;
+    uint8_t *local = meshlet_triangles + current.triangle_offset + current.triangle_count * 3;
+    for (int k = 0; k < 3; ++k)
+    {
+      uint8_t &slot = slots[corner[k]];
+      if (slot == 0xff)
+      {
+        slot = uint8_t (current.vertex_count);
+        meshlet_vertices[current.vertex_offset + current.vertex_count++] = corner[k];
+      }
+      local[k] = slot;
+    }
+    ++current.triangle_count;
+    used[best] = 1;
+    for (int k = 0; k < 3; ++k) adjacency.remove (corner[k], best);
+  }
+  finish ();
+
+  free (slots);
+  free (used);
+  return meshlet_count;
+}
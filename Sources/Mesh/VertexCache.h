@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "Mesh/MeshAdjacency.h"
+
+struct VertexCacheStats
+{
+  float acmr;   /* 삼각형당 정점 셰이더 실행 수. 0.5 에 가까울수록 좋음 */
+  float atvr;   /* 실제 정점 수 대비 실행 수. 1 이 최선 */
+};
+
+/* 크기 cache_size 인 FIFO 캐시를 흉내 내 인덱스 순서의 효율을 잼 */
+VertexCacheStats analyze_vertex_cache (const uint32_t *indices, size_t index_count, size_t vertex_count, uint32_t cache_size = 16);
+
+/* 정점 캐시 재사용이 늘도록 삼각형 순서를 바꿈 (Forsyth 의 선형 탐욕 알고리즘, LRU 32).
+   out 과 indices 는 같아도 됨 */
+void optimize_vertex_cache (uint32_t *out, const uint32_t *indices, size_t index_count, size_t vertex_count);
+
+/* 인덱스에서 처음 쓰이는 순서대로 정점 번호를 다시 매겨 정점 읽기를 순차로 만듦.
+   쓰이지 않는 정점은 ~0u. 반환값은 남는 정점 수 */
+size_t optimize_vertex_fetch_remap (uint32_t *remap, const uint32_t *indices, size_t index_count, size_t vertex_count);
+/* out 과 indices 는 같아도 됨. out 과 vertices 는 달라야 함 */
+void remap_indices (uint32_t *out, const uint32_t *indices, size_t index_count, const uint32_t *remap);
+void remap_vertices (void *out, const void *vertices, size_t vertex_count, size_t vertex_size, const uint32_t *remap);
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  inline constexpr uint32_t VERTEX_CACHE_SIZE = 32;
+  inline constexpr uint32_t VERTEX_VALENCE_MAX = 32;
+
+  /* 캐시 위치 (없으면 -1) 와 남은 삼각형 수로 정하는 정점 점수. 최근 삼각형의 세 정점은 고정 점수,
+     나머지는 캐시 뒤쪽일수록 낮고, 남은 삼각형이 적은 정점은 빨리 끝내도록 가산점 */
+  struct VertexScoreTable
+  {
+    float cache[VERTEX_CACHE_SIZE + 1];
+    float live[VERTEX_VALENCE_MAX + 1];
+
+    VertexScoreTable ()
+    {
+      cache[0] = 0.0f;
+      for (uint32_t i = 0; i < VERTEX_CACHE_SIZE; ++i)
+        cache[i + 1] = i < 3 ? 0.75f : powf (1.0f - float (i - 3) / float (VERTEX_CACHE_SIZE - 3), 1.5f);
+      live[0] = 0.0f;
+      for (uint32_t i = 1; i <= VERTEX_VALENCE_MAX; ++i) live[i] = 2.0f / sqrtf (float (i));
+    }
+
+    float score (const int32_t position, const uint32_t live_count) const
+    {
+      if (!live_count) return -1.0f;
+      return cache[position + 1] + live[live_count < VERTEX_VALENCE_MAX ? live_count : VERTEX_VALENCE_MAX];
+    }
+  };
+}
+
+inline VertexCacheStats analyze_vertex_cache (const uint32_t *indices, const size_t index_count, const size_t vertex_count, const uint32_t cache_size)
+{
+  /* 캐시에 들어간 시각만 적어 두면 (현재 시각 - 들어간 시각) <= cache_size 일 때 아직 캐시에 있음 */
+  uint32_t *stamps = Detail::mesh_allocate <uint32_t> (vertex_count);
+  uint8_t *used = Detail::mesh_allocate <uint8_t> (vertex_count);
+  memset (stamps, 0, sizeof (uint32_t) * vertex_count);
+  memset (used, 0, vertex_count);
+
+  uint32_t time = cache_size + 1, misses = 0, unique = 0;
+  for (size_t i = 0; i < index_count; ++i)
+  {
+    const uint32_t v = indices[i];
+    if (time - stamps[v] > cache_size)
+    {
+      stamps[v] = time++;
+      ++misses;
+    }
+    unique += !used[v];
+    used[v] = 1;
+  }
+
+  free (stamps);
+  free (used);
+  const size_t triangles = index_count / 3;
+  return { triangles ? float (misses) / float (triangles) : 0.0f, unique ? float (misses) / float (unique) : 0.0f };
+}
+
+inline void optimize_vertex_cache (uint32_t *out, const uint32_t *indices, const size_t index_count, const size_t vertex_count)
+{
+  using namespace Detail;
+
+  static const VertexScoreTable table;
+  const size_t triangle_count = index_count / 3;
+  if (!triangle_count) return;
+
+  uint32_t *input = nullptr;
+  if (out == indices)
+  {
+    input = mesh_allocate <uint32_t> (index_count);
+    memcpy (input, indices, sizeof (uint32_t) * index_count);
+    indices = input;
+  }
+
+  MeshAdjacency adjacency (indices, triangle_count * 3, vertex_count);
+  float *vertex_scores = mesh_allocate <float> (vertex_count);
+  int32_t *positions = mesh_allocate <int32_t> (vertex_count);
+  uint8_t *emitted = mesh_allocate <uint8_t> (triangle_count);
+  memset (emitted, 0, triangle_count);
+  for (size_t v = 0; v < vertex_count; ++v)
+  {
+    positions[v] = -1;
+    vertex_scores[v] = table.score (-1, adjacency.counts[v]);
+  }
+
+  auto triangle_score = [&] (const uint32_t triangle)
+  {
+    const uint32_t *corner = indices + triangle * 3;
+    return vertex_scores[corner[0]] + vertex_scores[corner[1]] + vertex_scores[corner[2]];
+  };
+
+  uint32_t best = 0;
+  float best_score = -1e30f;
+  for (uint32_t t = 0; t < triangle_count; ++t)
+  {
+    const float score = triangle_score (t);
+    if (score > best_score)
+    {
+      best_score = score;
+      best = t;
+    }
+  }
+
+  uint32_t cache[VERTEX_CACHE_SIZE + 3], next_cache[VERTEX_CACHE_SIZE + 3];
+  uint32_t cache_count = 0;
+  size_t cursor = 0;
+
+  for (size_t written = 0; written < triangle_count; ++written)
+  {
+    /* 캐시 주변에 남은 삼각형이 없으면 아직 안 쓴 첫 삼각형부터 */
+    if (best == ~0u)
+    {
+      while (emitted[cursor]) ++cursor;
+      best = uint32_t (cursor);
+    }
+
+    const uint32_t *corner = indices + best * 3;
+    memcpy (out + written * 3, corner, sizeof (uint32_t) * 3);
+    emitted[best] = 1;
+    for (int k = 0; k < 3; ++k) adjacency.remove (corner[k], best);
+
+    /* 새 삼각형의 정점을 앞에 놓고 기존 캐시를 뒤에 이어 붙임. VERTEX_CACHE_SIZE 를 넘는 것은 밀려남 */
+    uint32_t next_count = 0;
+    for (int k = 0; k < 3; ++k)
+    {
+      const uint32_t v = corner[k];
+      bool duplicate = false;
+      for (uint32_t j = 0; j < next_count; ++j) duplicate |= next_cache[j] == v;
+      if (!duplicate) next_cache[next_count++] = v;
+    }
+    for (uint32_t i = 0; i < cache_count; ++i)
+    {
+      const uint32_t v = cache[i];
+      if (v != corner[0] && v != corner[1] && v != corner[2]) next_cache[next_count++] = v;
+    }
+
+    for (uint32_t i = 0; i < next_count; ++i)
+    {
+      const uint32_t v = next_cache[i];
+      positions[v] = i < VERTEX_CACHE_SIZE ? int32_t (i) : -1;
+      vertex_scores[v] = table.score (positions[v], adjacency.counts[v]);
+    }
+    cache_count = next_count < VERTEX_CACHE_SIZE ? next_count : VERTEX_CACHE_SIZE;
+    memcpy (cache, next_cache, sizeof (uint32_t) * cache_count);
+
+    /* 점수가 바뀐 정점은 모두 캐시 안에 있으므로 다음 후보도 캐시 정점의 삼각형 중에서만 찾음 */
+    best = ~0u;
+    best_score = -1e30f;
+    for (uint32_t i = 0; i < cache_count; ++i)
+    {
+      const uint32_t v = cache[i];
+      const uint32_t *list = adjacency.triangles + adjacency.offsets[v];
+      for (uint32_t j = 0; j < adjacency.counts[v]; ++j)
+      {
+        const float score = triangle_score (list[j]);
+        if (score > best_score)
+        {
+          best_score = score;
+          best = list[j];
+        }
+      }
+    }
+  }
+
+  free (vertex_scores);
+  free (positions);
+  free (emitted);
+  free (input);
+}
+
+inline size_t optimize_vertex_fetch_remap (uint32_t *remap, const uint32_t *indices, const size_t index_count, const size_t vertex_count)
+{
+  memset (remap, 0xff, sizeof (uint32_t) * vertex_count);
+  uint32_t next = 0;
+  for (size_t i = 0; i < index_count; ++i)
+  {
+    uint32_t &slot = remap[indices[i]];
+    if (slot == ~0u) slot = next++;
+  }
+  return next;
+}
+
+inline void remap_indices (uint32_t *out, const uint32_t *indices, const size_t index_count, const uint32_t *remap)
+{
+  for (size_t i = 0; i < index_count; ++i) out[i] = remap[indices[i]];
+}
+
+inline void remap_vertices (void *out, const void *vertices, const size_t vertex_count, const size_t vertex_size, const uint32_t *remap)
+{
+  uint8_t *target = static_cast <uint8_t *> (out);
+  const uint8_t *source = static_cast <const uint8_t *> (vertices);
+  for (size_t v = 0; v < vertex_count; ++v)
+    if (remap[v] != ~0u) memcpy (target + size_t (remap[v]) * vertex_size, source + v * vertex_size, vertex_size);
+}
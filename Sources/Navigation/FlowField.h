@@ -0,0 +1,363 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if __AVX2__
+#include <immintrin.h>
+#elif __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+#include "Foundation/Heap/VirtualArray.h"
+#include "Navigation/GridMap.h"
+#include "Navigation/PathScratch.h"
+
+inline constexpr uint32_t FLOW_TILE_SIZE = 16;
+inline constexpr uint16_t FLOW_UNREACHABLE = 0xffff;
+inline constexpr uint8_t FLOW_NO_DIRECTION = 8;
+
+/* 방향 번호 -> (dx, dy). 0..3 은 직선, 4..7 은 대각선 */
+inline constexpr int32_t FLOW_DIRECTIONS[8][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } };
+
+/* 목표 하나에 대한 흐름장. 모든 칸의 목표까지 비용 (integration) 과 다음 칸 방향 (direction) 을 가짐.
+   통합장은 비용 2 (직선) / 3 (대각선) 의 버킷 큐 파면 확장으로 만들고, 방향장은 16x16 타일 단위로 한 행씩 SIMD 로 계산.
+   장애물이 바뀌면 영향을 받는 칸만 다시 전파하고 바뀐 타일의 방향만 다시 계산함 */
+class FlowField
+{
+public:
+  explicit FlowField (const GridMap &map);
+  ~FlowField ();
+
+  FlowField (const FlowField &) = delete;
+  FlowField &operator= (const FlowField &) = delete;
+
+  void build (GridPoint goal);
+  /* 지도의 changed 칸들이 바뀐 뒤 호출 */
+  void repair (const GridPoint *changed, size_t count);
+
+  uint16_t integration (int32_t x, int32_t y) const { return cost[cell (x, y)]; }
+  uint8_t direction (int32_t x, int32_t y) const { return directions[size_t (y) * map.width () + x]; }
+  GridPoint goal () const { return target; }
+
+  /* 마지막 build/repair 에서 방향을 다시 계산한 타일 수 */
+  uint32_t updated_tiles () const { return last_updated_tiles; }
+
+private:
+  static constexpr uint16_t STRAIGHT = 2;
+  static constexpr uint16_t DIAGONAL = 3;
+
+  size_t cell (int32_t x, int32_t y) const { return size_t (y + 1) * stride + size_t (x + 1); }
+  bool can_step (int32_t x, int32_t y, int32_t dx, int32_t dy) const;
+  void mark_dirty (int32_t x, int32_t y);
+  void propagate ();
+  void update_directions ();
+  void direction_row (int32_t x0, int32_t y, uint32_t count);
+
+  const GridMap &map;
+  GridPoint target = { -1, -1 };
+  size_t stride;
+  uint32_t tiles_x;
+  uint32_t tiles_y;
+  uint32_t last_updated_tiles = 0;
+
+  uint16_t *cost;         /* 테두리 한 칸과 오른쪽 패딩을 포함한 행 우선 배열. 테두리/패딩은 항상 FLOW_UNREACHABLE */
+  uint8_t *directions;
+  uint64_t *dirty_tiles;
+  VirtualArray <uint32_t> buckets[4];
+  OpenList open;
+};
+
+/* ============ 구현 ============ */
+inline FlowField::FlowField (const GridMap &map)
+  : map (map),
+    stride ((map.width () + FLOW_TILE_SIZE - 1) / FLOW_TILE_SIZE * FLOW_TILE_SIZE + 2),
+    tiles_x ((map.width () + FLOW_TILE_SIZE - 1) / FLOW_TILE_SIZE),
+    tiles_y ((map.height () + FLOW_TILE_SIZE - 1) / FLOW_TILE_SIZE),
+    buckets { VirtualArray <uint32_t> (size_t (map.cell_count ()) * 8 + 64), VirtualArray <uint32_t> (size_t (map.cell_count ()) * 8 + 64),
+              VirtualArray <uint32_t> (size_t (map.cell_count ()) * 8 + 64), VirtualArray <uint32_t> (size_t (map.cell_count ()) * 8 + 64) },
+    open (size_t (map.cell_count ()) * 8 + 64)
+{
+  const size_t cost_count = (size_t (map.height ()) + 2) * stride + FLOW_TILE_SIZE;
+  cost = static_cast <uint16_t *> (malloc (sizeof (uint16_t) * cost_count));
+  directions = static_cast <uint8_t *> (malloc (size_t (map.cell_count ()) + 1));
+  dirty_tiles = static_cast <uint64_t *> (calloc ((size_t (tiles_x) * tiles_y + 63) / 64, sizeof (uint64_t)));
+  if (!cost || !directions || !dirty_tiles) abort ();
+
+  memset (cost, 0xff, sizeof (uint16_t) * cost_count);
+  memset (directions, FLOW_NO_DIRECTION, map.cell_count ());
+}
+
+inline FlowField::~FlowField ()
+{
+  free (cost);
+  free (directions);
+  free (dirty_tiles);
+}
+
+inline bool FlowField::can_step (const int32_t x, const int32_t y, const int32_t dx, const int32_t dy) const
+{
+  if (!map.walkable (x + dx, y + dy)) return false;
+  return !dx || !dy || (map.walkable (x + dx, y) && map.walkable (x, y + dy));
+}
+
+inline void FlowField::mark_dirty (const int32_t x, const int32_t y)
+{
+  /* 이웃 칸의 방향도 이 칸의 비용에 따라 바뀌므로 타일 경계에 걸치면 옆 타일도 표시 */
+  for (int32_t ny = y - 1; ny <= y + 1; ny += 2)
+    for (int32_t nx = x - 1; nx <= x + 1; nx += 2)
+    {
+      const int32_t cx = nx < 0 ? 0 : nx >= int32_t (map.width ()) ? int32_t (map.width ()) - 1 : nx;
+      const int32_t cy = ny < 0 ? 0 : ny >= int32_t (map.height ()) ? int32_t (map.height ()) - 1 : ny;
+      const uint32_t tile = uint32_t (cy) / FLOW_TILE_SIZE * tiles_x + uint32_t (cx) / FLOW_TILE_SIZE;
+      dirty_tiles[tile >> 6] |= uint64_t (1) << (tile & 63);
+    }
+}
+
+/* 버킷 큐 (Dial) 파면 확장. 간선 비용이 최대 3 이라 버킷 4 개를 돌려 쓰면 됨 */
+inline void FlowField::build (const GridPoint goal)
+{
+  target = goal;
+  for (uint32_t y = 0; y < map.height (); ++y)
+    memset (cost + cell (0, int32_t (y)), 0xff, sizeof (uint16_t) * map.width ());
+  memset (dirty_tiles, 0xff, sizeof (uint64_t) * ((size_t (tiles_x) * tiles_y + 63) / 64));
+
+  if (map.walkable (goal.x, goal.y))
+  {
+    for (auto &bucket : buckets) bucket.clear ();
+    cost[cell (goal.x, goal.y)] = 0;
+    buckets[0].push_back (map.index (goal));
+    size_t pending = 1;
+
+    for (uint32_t distance = 0; pending; ++distance)
+    {
+      VirtualArray <uint32_t> &bucket = buckets[distance & 3];
+      for (size_t i = 0; i < bucket.size (); ++i)
+      {
+        const GridPoint point = map.point (bucket[i]);
+        if (cost[cell (point.x, point.y)] != distance) continue;
+
+        for (uint32_t d = 0; d < 8; ++d)
+        {
+          const int32_t dx = FLOW_DIRECTIONS[d][0], dy = FLOW_DIRECTIONS[d][1];
+          if (!can_step (point.x, point.y, dx, dy)) continue;
+          const uint32_t next = distance + (d < 4 ? STRAIGHT : DIAGONAL);
+          uint16_t &neighbor = cost[cell (point.x + dx, point.y + dy)];
+          if (next >= neighbor) continue;
+          neighbor = uint16_t (next);
+          buckets[next & 3].push_back (map.index ({ point.x + dx, point.y + dy }));
+          ++pending;
+        }
+      }
+      pending -= bucket.size ();
+      bucket.clear ();
+    }
+  }
+
+  update_directions ();
+}
+
+/* 열린 목록에 든 칸부터 더 싼 비용을 퍼뜨림 */
+inline void FlowField::propagate ()
+{
+  while (!open.empty ())
+  {
+    const uint32_t node = open.pop ();
+    const GridPoint point = map.point (node);
+    const uint16_t distance = cost[cell (point.x, point.y)];
+
+    for (uint32_t d = 0; d < 8; ++d)
+    {
+      const int32_t dx = FLOW_DIRECTIONS[d][0], dy = FLOW_DIRECTIONS[d][1];
+      if (!can_step (point.x, point.y, dx, dy)) continue;
+      const uint32_t next = uint32_t (distance) + (d < 4 ? STRAIGHT : DIAGONAL);
+      uint16_t &neighbor = cost[cell (point.x + dx, point.y + dy)];
+      if (next >= neighbor) continue;
+      neighbor = uint16_t (next);
+      mark_dirty (point.x + dx, point.y + dy);
+      open.push (next, map.index ({ point.x + dx, point.y + dy }));
+    }
+  }
+}
+
+/* 막힌 칸과 그 칸을 거쳐 가던 칸 (방향을 따라가면 그 칸에 닿는 칸) 을 모두 무한으로 올린 뒤,
+   올린 영역 바깥 경계에서 다시 전파. 열린 칸은 이웃에서 전파되며 지름길이 생기면 그만큼 더 멀리 퍼짐 */
+inline void FlowField::repair (const GridPoint *changed, const size_t count)
+{
+  if (target.x < 0) return;
+  if (!map.walkable (target.x, target.y) || cost[cell (target.x, target.y)] != 0)
+  {
+    build (target);
+    return;
+  }
+
+  memset (dirty_tiles, 0, sizeof (uint64_t) * ((size_t (tiles_x) * tiles_y + 63) / 64));
+  for (auto &bucket : buckets) bucket.clear ();
+  VirtualArray <uint32_t> &raised = buckets[0];
+  open.clear ();
+
+  auto raise = [&] (const int32_t x, const int32_t y)
+  {
+    uint16_t &value = cost[cell (x, y)];
+    if (value == FLOW_UNREACHABLE) return;
+    value = FLOW_UNREACHABLE;
+    raised.push_back (map.index ({ x, y }));
+  };
+
+  for (size_t c = 0; c < count; ++c)
+  {
+    const GridPoint point = changed[c];
+    mark_dirty (point.x, point.y);
+    if (map.walkable (point.x, point.y))
+    {
+      /* 새로 열린 칸은 나중에 이웃 경계에서 채워짐 */
+      raised.push_back (map.index (point));
+      continue;
+    }
+    raise (point.x, point.y);
+
+    /* 이 칸 모서리를 스쳐 지나던 대각선 이동도 이제 불가능 */
+    for (uint32_t d = 0; d < 8; ++d)
+    {
+      const int32_t nx = point.x - FLOW_DIRECTIONS[d][0], ny = point.y - FLOW_DIRECTIONS[d][1];
+      if (!map.walkable (nx, ny)) continue;
+      const uint8_t dir = directions[size_t (ny) * map.width () + nx];
+      if (dir < 4 || dir == FLOW_NO_DIRECTION) continue;
+      const int32_t ddx = FLOW_DIRECTIONS[dir][0], ddy = FLOW_DIRECTIONS[dir][1];
+      if ((nx + ddx == point.x && ny == point.y) || (nx == point.x && ny + ddy == point.y)) raise (nx, ny);
+    }
+  }
+
+  /* 방향을 따라 올린 칸으로 들어오는 칸을 연쇄적으로 올림 */
+  for (size_t i = 0; i < raised.size (); ++i)
+  {
+    const GridPoint point = map.point (raised[i]);
+    mark_dirty (point.x, point.y);
+    for (uint32_t d = 0; d < 8; ++d)
+    {
+      const int32_t nx = point.x + FLOW_DIRECTIONS[d][0], ny = point.y + FLOW_DIRECTIONS[d][1];
+      if (!map.walkable (nx, ny)) continue;
+      const uint8_t dir = directions[size_t (ny) * map.width () + nx];
+      if (dir != FLOW_NO_DIRECTION && nx + FLOW_DIRECTIONS[dir][0] == point.x && ny + FLOW_DIRECTIONS[dir][1] == point.y) raise (nx, ny);
+    }
+  }
+
+  /* 올린 영역에 맞닿은 유한 비용 칸이 새 전파의 출발점 */
+  for (size_t i = 0; i < raised.size (); ++i)
+  {
+    const GridPoint point = map.point (raised[i]);
+    for (uint32_t d = 0; d < 8; ++d)
+    {
+      const int32_t nx = point.x + FLOW_DIRECTIONS[d][0], ny = point.y + FLOW_DIRECTIONS[d][1];
+      if (!map.walkable (nx, ny)) continue;
+      const uint16_t value = cost[cell (nx, ny)];
+      if (value != FLOW_UNREACHABLE) open.push (value, map.index ({ nx, ny }));
+    }
+  }
+
+  propagate ();
+  update_directions ();
+}
+
+inline void FlowField::update_directions ()
+{
+  uint32_t updated = 0;
+  for (uint32_t tile = 0; tile < tiles_x * tiles_y; ++tile)
+  {
+    if (!(dirty_tiles[tile >> 6] & (uint64_t (1) << (tile & 63)))) continue;
+    ++updated;
+
+    const int32_t x0 = int32_t (tile % tiles_x * FLOW_TILE_SIZE);
+    const int32_t y0 = int32_t (tile / tiles_x * FLOW_TILE_SIZE);
+    const uint32_t width = map.width () - uint32_t (x0) < FLOW_TILE_SIZE ? map.width () - uint32_t (x0) : FLOW_TILE_SIZE;
+    const int32_t y1 = y0 + int32_t (FLOW_TILE_SIZE) < int32_t (map.height ()) ? y0 + int32_t (FLOW_TILE_SIZE) : int32_t (map.height ());
+    for (int32_t y = y0; y < y1; ++y) direction_row (x0, y, width);
+  }
+  memset (dirty_tiles, 0, sizeof (uint64_t) * ((size_t (tiles_x) * tiles_y + 63) / 64));
+  last_updated_tiles = updated;
+}
+
+/* 타일 한 행 16 칸의 방향. 이웃 8 개 중 비용이 가장 작은 쪽을 고르되, 대각선은 양옆 직선 이웃이 막혀 있으면 제외.
+   자기보다 싼 이웃이 없으면 (목표, 막힘, 도달 불가) 방향 없음 */
+inline void FlowField::direction_row (const int32_t x0, const int32_t y, const uint32_t count)
+{
+  const uint16_t *center = cost + cell (x0, y);
+  uint8_t *out = directions + size_t (y) * map.width () + x0;
+  const ptrdiff_t offsets[8] = { 1, -1, ptrdiff_t (stride), -ptrdiff_t (stride), ptrdiff_t (stride) + 1, -ptrdiff_t (stride) + 1,
+                                 ptrdiff_t (stride) - 1, -ptrdiff_t (stride) - 1 };
+  /* 대각선 d 가 통과하려면 지나야 하는 직선 방향 두 개 */
+  static constexpr uint8_t SIDES[4][2] = { { 0, 2 }, { 0, 3 }, { 1, 2 }, { 1, 3 } };
+
+#if __AVX2__
+  const __m256i bias = _mm256_set1_epi16 (int16_t (0x8000));
+  const __m256i unreachable = _mm256_set1_epi16 (int16_t (FLOW_UNREACHABLE));
+  auto less = [&] (const __m256i a, const __m256i b) { return _mm256_cmpgt_epi16 (_mm256_xor_si256 (b, bias), _mm256_xor_si256 (a, bias)); };
+  auto load = [&] (const ptrdiff_t offset) { return _mm256_loadu_si256 (reinterpret_cast <const __m256i *> (center + offset)); };
+
+  const __m256i self = load (0);
+  __m256i best = unreachable;
+  __m256i best_direction = _mm256_set1_epi16 (FLOW_NO_DIRECTION);
+  __m256i blocked[4];
+  for (int d = 0; d < 4; ++d) blocked[d] = _mm256_cmpeq_epi16 (load (offsets[d]), unreachable);
+
+  for (int d = 0; d < 8; ++d)
+  {
+    __m256i candidate = load (offsets[d]);
+    if (d >= 4) candidate = _mm256_or_si256 (candidate, _mm256_or_si256 (blocked[SIDES[d - 4][0]], blocked[SIDES[d - 4][1]]));
+    const __m256i better = less (candidate, best);
+    best = _mm256_blendv_epi8 (best, candidate, better);
+    best_direction = _mm256_blendv_epi8 (best_direction, _mm256_set1_epi16 (int16_t (d)), better);
+  }
+  best_direction = _mm256_blendv_epi8 (_mm256_set1_epi16 (FLOW_NO_DIRECTION), best_direction, less (best, self));
+
+  alignas (16) uint8_t lanes[16];
+  _mm_store_si128 (reinterpret_cast <__m128i *> (lanes),
+                   _mm_packus_epi16 (_mm256_castsi256_si128 (best_direction), _mm256_extracti128_si256 (best_direction, 1)));
+  memcpy (out, lanes, count);
+#elif __ARM_NEON
+  const uint16x8_t unreachable = vdupq_n_u16 (FLOW_UNREACHABLE);
+  for (uint32_t half = 0; half < FLOW_TILE_SIZE; half += 8)
+  {
+    const uint16_t *base = center + half;
+    const uint16x8_t self = vld1q_u16 (base);
+    uint16x8_t best = unreachable;
+    uint16x8_t best_direction = vdupq_n_u16 (FLOW_NO_DIRECTION);
+    uint16x8_t blocked[4];
+    for (int d = 0; d < 4; ++d) blocked[d] = vceqq_u16 (vld1q_u16 (base + offsets[d]), unreachable);
+
+    for (int d = 0; d < 8; ++d)
+    {
+      uint16x8_t candidate = vld1q_u16 (base + offsets[d]);
+      if (d >= 4) candidate = vorrq_u16 (candidate, vorrq_u16 (blocked[SIDES[d - 4][0]], blocked[SIDES[d - 4][1]]));
+      const uint16x8_t better = vcltq_u16 (candidate, best);
+      best = vbslq_u16 (better, candidate, best);
+      best_direction = vbslq_u16 (better, vdupq_n_u16 (uint16_t (d)), best_direction);
+    }
+    best_direction = vbslq_u16 (vcltq_u16 (best, self), best_direction, vdupq_n_u16 (FLOW_NO_DIRECTION));
+
+    uint8_t lanes[8];
+    vst1_u8 (lanes, vmovn_u16 (best_direction));
+    if (half < count) memcpy (out + half, lanes, count - half < 8 ? count - half : 8);
+  }
+#else
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    const uint16_t *c = center + i;
+    uint16_t best = FLOW_UNREACHABLE;
+    uint8_t best_direction = FLOW_NO_DIRECTION;
+    for (int d = 0; d < 8; ++d)
+    {
+      uint16_t candidate = c[offsets[d]];
+      if (d >= 4 && (c[offsets[SIDES[d - 4][0]]] == FLOW_UNREACHABLE || c[offsets[SIDES[d - 4][1]]] == FLOW_UNREACHABLE)) candidate = FLOW_UNREACHABLE;
+      if (candidate < best)
+      {
+        best = candidate;
+        best_direction = uint8_t (d);
+      }
+    }
+    out[i] = best < c[0] ? best_direction : FLOW_NO_DIRECTION;
+  }
+#endif
+}
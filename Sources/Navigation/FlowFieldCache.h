@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include "Foundation/Thread/ParallelFor.h"
+#include "Foundation/Thread/ThreadPool.h"
+#include "Navigation/FlowField.h"
+#include "Navigation/GridMap.h"
+
+/* 목표별 흐름장 캐시. 같은 목표로 가는 유닛 무리는 필드 하나를 공유함.
+   request 로 목표를 요청하고 update 에서 새 필드 생성과 장애물 변경 반영을 작업 시스템으로 한꺼번에 처리.
+   슬롯이 모자라면 가장 오래 요청되지 않은 필드를 재사용 */
+class FlowFieldCache
+{
+public:
+  static constexpr uint32_t MAX_PENDING_CHANGES = 1024;
+
+  FlowFieldCache (GridMap &map, uint32_t capacity);
+  ~FlowFieldCache ();
+
+  FlowFieldCache (const FlowFieldCache &) = delete;
+  FlowFieldCache &operator= (const FlowFieldCache &) = delete;
+
+  /* 준비된 필드가 있으면 반환. 없으면 다음 update 에서 만들도록 예약하고 nullptr */
+  const FlowField *request (GridPoint goal);
+  /* 지도를 바로 바꾸고 캐시된 필드는 다음 update 에서 고침. update 도중에는 호출하면 안 됨 */
+  void set_walkable (int32_t x, int32_t y, bool walkable);
+  /* 예약된 필드를 만들고 바뀐 장애물을 반영. 필드 하나가 작업 하나 */
+  void update (ThreadPool &pool);
+
+  uint32_t capacity () const { return slot_count; }
+
+private:
+  struct Slot
+  {
+    FlowField *field;
+    GridPoint goal;
+    uint64_t last_request;
+    bool ready;
+  };
+
+  GridMap &map;
+  Slot *slots;
+  uint32_t slot_count;
+  uint64_t frame = 1;
+
+  GridPoint changes[MAX_PENDING_CHANGES];
+  uint32_t change_count = 0;
+  bool overflowed = false;
+
+  Slot **work;
+};
+
+/* ============ 구현 ============ */
+inline FlowFieldCache::FlowFieldCache (GridMap &map, const uint32_t capacity) : map (map), slot_count (capacity)
+{
+  slots = static_cast <Slot *> (malloc (sizeof (Slot) * capacity));
+  work = static_cast <Slot **> (malloc (sizeof (Slot *) * capacity));
+  if (!slots || !work) abort ();
+
+  for (uint32_t i = 0; i < capacity; ++i)
+    slots[i] = { nullptr, { -1, -1 }, 0, false };
+}
+
+inline FlowFieldCache::~FlowFieldCache ()
+{
+  for (uint32_t i = 0; i < slot_count; ++i) delete slots[i].field;
+  free (slots);
+  free (work);
+}
+
+inline const FlowField *FlowFieldCache::request (const GridPoint goal)
+{
+  Slot *victim = nullptr;
+  for (uint32_t i = 0; i < slot_count; ++i)
+  {
+    Slot &slot = slots[i];
+    if (slot.goal == goal)
+    {
+      slot.last_request = frame;
+      return slot.ready ? slot.field : nullptr;
+    }
+    /* 이번 프레임에 요청된 슬롯은 빼앗지 않음 */
+    if (slot.last_request != frame && (!victim || slot.last_request < victim->last_request)) victim = &slot;
+  }
+  if (!victim) return nullptr;
+
+  victim->goal = goal;
+  victim->last_request = frame;
+  victim->ready = false;
+  return nullptr;
+}
+
+inline void FlowFieldCache::set_walkable (const int32_t x, const int32_t y, const bool walkable)
+{
+  if (map.walkable (x, y) == walkable) return;
+  map.set_walkable (x, y, walkable);
+
+  if (change_count < MAX_PENDING_CHANGES) changes[change_count++] = { x, y };
+  else overflowed = true;
+}
+
+inline void FlowFieldCache::update (ThreadPool &pool)
+{
+  uint32_t work_count = 0;
+  for (uint32_t i = 0; i < slot_count; ++i)
+  {
+    Slot &slot = slots[i];
+    if (slot.goal.x < 0) continue;
+    /* 변경이 너무 많이 쌓였으면 고치는 것보다 새로 만드는 편이 쌈 */
+    if (overflowed) slot.ready = false;
+    if (!slot.ready || change_count) work[work_count++] = &slot;
+  }
+
+  parallel_for (pool, work_count, 1, [&] (const size_t begin, const size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+    {
+      Slot &slot = *work[i];
+      if (!slot.field) slot.field = new FlowField (map);
+      if (slot.ready) slot.field->repair (changes, change_count);
+      else slot.field->build (slot.goal);
+      slot.ready = true;
+    }
+  });
+
+  change_count = 0;
+  overflowed = false;
+  ++frame;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+struct GridPoint
+{
+  int32_t x;
+  int32_t y;
+
+  bool operator== (const GridPoint &) const = default;
+};
+
+/* [x0, x1) x [y0, y1) */
+struct GridBounds
+{
+  int32_t x0;
+  int32_t y0;
+  int32_t x1;
+  int32_t y1;
+
+  bool contains (int32_t x, int32_t y) const { return x >= x0 && x < x1 && y >= y0 && y < y1; }
+};
+
+/* 이동 비용은 정수로 다룸. 대각선은 sqrt(2) 근사 */
+inline constexpr uint32_t GRID_STRAIGHT_COST = 100;
+inline constexpr uint32_t GRID_DIAGONAL_COST = 141;
+
+/* 8방향 격자 지도. 대각선 이동은 양옆 두 칸이 모두 지나갈 수 있을 때만 허용 (모서리 통과 금지) */
+class GridMap
+{
+public:
+  GridMap (uint32_t width, uint32_t height);
+  ~GridMap ();
+
+  GridMap (const GridMap &) = delete;
+  GridMap &operator= (const GridMap &) = delete;
+
+  bool walkable (int32_t x, int32_t y) const { return uint32_t (x) < w && uint32_t (y) < h && !blocked[size_t (y) * w + x]; }
+  void set_walkable (int32_t x, int32_t y, bool walkable) { blocked[size_t (y) * w + x] = !walkable; }
+
+  uint32_t index (GridPoint point) const { return uint32_t (point.y) * w + uint32_t (point.x); }
+  GridPoint point (uint32_t index) const { return { int32_t (index % w), int32_t (index / w) }; }
+
+  uint32_t width () const { return w; }
+  uint32_t height () const { return h; }
+  uint32_t cell_count () const { return w * h; }
+  GridBounds bounds () const { return { 0, 0, int32_t (w), int32_t (h) }; }
+
+private:
+  uint32_t w;
+  uint32_t h;
+  uint8_t *blocked;
+};
+
+inline uint32_t octile_distance (const GridPoint a, const GridPoint b)
+{
+  const uint32_t dx = uint32_t (a.x > b.x ? a.x - b.x : b.x - a.x);
+  const uint32_t dy = uint32_t (a.y > b.y ? a.y - b.y : b.y - a.y);
+  const uint32_t low = dx < dy ? dx : dy;
+  const uint32_t high = dx < dy ? dy : dx;
+  return low * GRID_DIAGONAL_COST + (high - low) * GRID_STRAIGHT_COST;
+}
+
+/* ============ 구현 ============ */
+inline GridMap::GridMap (const uint32_t width, const uint32_t height) : w (width), h (height)
+{
+  blocked = static_cast <uint8_t *> (calloc (size_t (width) * height + 1, 1));
+  if (!blocked) abort ();
+}
+
+inline GridMap::~GridMap ()
+{
+  free (blocked);
+}
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Navigation/GridMap.h"
+#include "Navigation/PathScratch.h"
+
+/* 격자 경로 출력. points 가 capacity 보다 길면 BufferTooSmall 과 함께 length 에 필요한 길이가 들어감 */
+struct GridPath
+{
+  GridPoint *points;
+  uint32_t capacity;
+  uint32_t length;
+  uint32_t cost;
+};
+
+/* A*. 옥타일 거리 휴리스틱 */
+PathStatus find_grid_path (const GridMap &map, PathScratch &scratch, GridPoint start, GridPoint goal, GridPath &path);
+/* Jump Point Search. 균일 비용 격자에서 대칭 경로를 건너뛰어 A* 보다 훨씬 적은 노드만 열림. 결과는 칸 단위로 펼쳐서 출력 */
+PathStatus find_jump_point_path (const GridMap &map, PathScratch &scratch, GridPoint start, GridPoint goal, GridPath &path);
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  inline constexpr int32_t GRID_DIRECTIONS[8][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } };
+
+  /* bounds 밖은 막힌 칸으로 취급하는 지도 창. HPA* 의 클러스터 내부 탐색에 사용 */
+  struct GridView
+  {
+    const GridMap *map;
+    GridBounds bounds;
+
+    bool walkable (int32_t x, int32_t y) const { return bounds.contains (x, y) && map->walkable (x, y); }
+
+    bool can_step (int32_t x, int32_t y, int32_t dx, int32_t dy) const
+    {
+      if (!walkable (x + dx, y + dy)) return false;
+      return !dx || !dy || (walkable (x + dx, y) && walkable (x, y + dy));
+    }
+  };
+
+  inline int32_t sign (const int32_t value) { return (value > 0) - (value < 0); }
+
+  /* (x, y) 에서 (dx, dy) 방향으로 전진하며 다음 점프 포인트를 찾음 */
+  inline bool jump (const GridView &view, int32_t x, int32_t y, const int32_t dx, const int32_t dy, const GridPoint goal, GridPoint *out)
+  {
+    for (;;)
+    {
+      if (!view.walkable (x, y)) return false;
+      if (x == goal.x && y == goal.y) break;
+
+      if (dx && dy)
+      {
+        GridPoint unused;
+        if (jump (view, x + dx, y, dx, 0, goal, &unused) || jump (view, x, y + dy, 0, dy, goal, &unused)) break;
+        if (!view.walkable (x + dx, y) || !view.walkable (x, y + dy)) return false;
+      }
+      else if (dx)
+      {
+        if ((view.walkable (x, y - 1) && !view.walkable (x - dx, y - 1)) || (view.walkable (x, y + 1) && !view.walkable (x - dx, y + 1))) break;
+      }
+      else
+      {
+        if ((view.walkable (x - 1, y) && !view.walkable (x - 1, y - dy)) || (view.walkable (x + 1, y) && !view.walkable (x + 1, y - dy))) break;
+      }
+
+      x += dx;
+      y += dy;
+    }
+
+    *out = { x, y };
+    return true;
+  }
+
+  /* 부모 방향 기준으로 가지치기한 이웃 방향. 시작 노드는 모든 방향 */
+  inline uint32_t pruned_directions (const GridView &view, const GridPoint point, const GridPoint parent, const bool has_parent, int32_t (*out)[2])
+  {
+    uint32_t count = 0;
+    auto add = [&] (const int32_t dx, const int32_t dy)
+    {
+      if (view.can_step (point.x, point.y, dx, dy)) { out[count][0] = dx; out[count][1] = dy; ++count; }
+    };
+
+    if (!has_parent)
+    {
+      for (const auto &direction : GRID_DIRECTIONS) add (direction[0], direction[1]);
+      return count;
+    }
+
+    const int32_t dx = sign (point.x - parent.x);
+    const int32_t dy = sign (point.y - parent.y);
+    if (dx && dy)
+    {
+      add (0, dy);
+      add (dx, 0);
+      add (dx, dy);
+    }
+    else if (dx)
+    {
+      add (dx, 0);
+      if (view.walkable (point.x + dx, point.y))
+      {
+        add (dx, 1);
+        add (dx, -1);
+      }
+      add (0, 1);
+      add (0, -1);
+    }
+    else
+    {
+      add (0, dy);
+      if (view.walkable (point.x, point.y + dy))
+      {
+        add (1, dy);
+        add (-1, dy);
+      }
+      add (1, 0);
+      add (-1, 0);
+    }
+    return count;
+  }
+
+  /* goal 이 INVALID_NODE 이면 도달 가능한 모든 칸의 비용을 구하는 다익스트라 */
+  inline bool grid_search (const GridView &view, PathScratch &scratch, const GridPoint start, const GridPoint goal, const bool jump_points)
+  {
+    const GridMap &map = *view.map;
+    const bool has_goal = goal.x >= 0;
+    const uint32_t start_node = map.index (start);
+    const uint32_t goal_node = has_goal ? map.index (goal) : INVALID_NODE;
+
+    scratch.begin (map.cell_count ());
+    scratch.relax (start_node, 0, INVALID_NODE, has_goal ? octile_distance (start, goal) : 0);
+
+    for (uint32_t node; (node = scratch.pop ()) != INVALID_NODE;)
+    {
+      if (node == goal_node) return true;
+
+      const GridPoint point = map.point (node);
+      const uint32_t g = scratch.g (node);
+
+      if (jump_points)
+      {
+        const uint32_t parent_node = scratch.parent (node);
+        const GridPoint parent = parent_node == INVALID_NODE ? point : map.point (parent_node);
+        int32_t directions[8][2];
+        const uint32_t count = pruned_directions (view, point, parent, parent_node != INVALID_NODE, directions);
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+          GridPoint next;
+          if (!jump (view, point.x + directions[i][0], point.y + directions[i][1], directions[i][0], directions[i][1], goal, &next)) continue;
+          scratch.relax (map.index (next), g + octile_distance (point, next), node, octile_distance (next, goal));
+        }
+        continue;
+      }
+
+      for (const auto &direction : GRID_DIRECTIONS)
+      {
+        if (!view.can_step (point.x, point.y, direction[0], direction[1])) continue;
+        const GridPoint next = { point.x + direction[0], point.y + direction[1] };
+        const uint32_t step = direction[0] && direction[1] ? GRID_DIAGONAL_COST : GRID_STRAIGHT_COST;
+        scratch.relax (map.index (next), g + step, node, has_goal ? octile_distance (next, goal) : 0);
+      }
+    }
+    return !has_goal;
+  }
+
+  /* 부모 사슬을 따라가며 칸 단위로 펼친 경로를 path.points[offset..] 에 기록. 기록한 (또는 필요한) 칸 수를 반환.
+     skip_first 이면 시작 칸은 빼고 기록 (구간을 이어 붙일 때) */
+  inline uint32_t write_grid_path (const GridMap &map, const PathScratch &scratch, const uint32_t goal_node, GridPath &path,
+                                   const uint32_t offset, const bool skip_first)
+  {
+    uint32_t length = 1;
+    for (uint32_t node = goal_node; scratch.parent (node) != INVALID_NODE; node = scratch.parent (node))
+    {
+      const GridPoint a = map.point (node), b = map.point (scratch.parent (node));
+      const int32_t dx = a.x > b.x ? a.x - b.x : b.x - a.x;
+      const int32_t dy = a.y > b.y ? a.y - b.y : b.y - a.y;
+      length += uint32_t (dx > dy ? dx : dy);
+    }
+    if (skip_first) --length;
+    if (offset + length > path.capacity) return length;
+
+    uint32_t cursor = offset + length;
+    for (uint32_t node = goal_node;; node = scratch.parent (node))
+    {
+      const uint32_t parent = scratch.parent (node);
+      GridPoint point = map.point (node);
+      if (parent == INVALID_NODE)
+      {
+        if (!skip_first) path.points[--cursor] = point;
+        break;
+      }
+
+      const GridPoint target = map.point (parent);
+      const int32_t dx = sign (target.x - point.x), dy = sign (target.y - point.y);
+      while (!(point == target))
+      {
+        path.points[--cursor] = point;
+        point = { point.x + dx, point.y + dy };
+      }
+    }
+    return length;
+  }
+
+  inline PathStatus find_grid_path (const GridMap &map, PathScratch &scratch, const GridPoint start, const GridPoint goal, GridPath &path,
+                                    const bool jump_points)
+  {
+    path.length = 0;
+    path.cost = 0;
+    if (!map.walkable (start.x, start.y) || !map.walkable (goal.x, goal.y)) return PathStatus::InvalidEndpoints;
+
+    const GridView view = { &map, map.bounds () };
+    if (!grid_search (view, scratch, start, goal, jump_points)) return PathStatus::NotFound;
+
+    const uint32_t goal_node = map.index (goal);
+    path.cost = scratch.g (goal_node);
+    path.length = write_grid_path (map, scratch, goal_node, path, 0, false);
+    return path.length > path.capacity ? PathStatus::BufferTooSmall : PathStatus::Found;
+  }
+}
+
+inline PathStatus find_grid_path (const GridMap &map, PathScratch &scratch, const GridPoint start, const GridPoint goal, GridPath &path)
+{
+  return Detail::find_grid_path (map, scratch, start, goal, path, false);
+}
+
+inline PathStatus find_jump_point_path (const GridMap &map, PathScratch &scratch, const GridPoint start, const GridPoint goal, GridPath &path)
+{
+  return Detail::find_grid_path (map, scratch, start, goal, path, true);
+}
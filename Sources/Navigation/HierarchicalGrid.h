@@ -0,0 +1,361 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "Foundation/Thread/ParallelFor.h"
+#include "Foundation/Thread/ThreadPool.h"
+#include "Navigation/GridMap.h"
+#include "Navigation/GridSearch.h"
+#include "Navigation/PathScratch.h"
+
+/* HPA*. 격자를 cluster_size 크기 클러스터로 나누고 클러스터 경계의 입구만 추상 노드로 둠.
+   클러스터 안 입구 사이 비용은 build 에서 미리 구하고, 질의는 추상 그래프에서 찾은 뒤 구간마다 클러스터 안에서만 다시 탐색해 칸 경로로 펼침.
+   지도가 바뀌면 build 를 다시 호출. PathScratch 는 지도 칸 수 + 2 이상이어야 함 */
+class HierarchicalGrid
+{
+public:
+  explicit HierarchicalGrid (const GridMap &map, uint32_t cluster_size = 16);
+  ~HierarchicalGrid ();
+
+  HierarchicalGrid (const HierarchicalGrid &) = delete;
+  HierarchicalGrid &operator= (const HierarchicalGrid &) = delete;
+
+  void build (PathScratch &scratch);
+  /* 클러스터 내부 비용 계산을 클러스터 단위로 병렬 처리 */
+  void build (ThreadPool &pool, PathScratchPool &scratch);
+
+  PathStatus find_path (PathScratch &scratch, GridPoint start, GridPoint goal, GridPath &path) const;
+
+  uint32_t node_count () const { return count; }
+  uint32_t cluster_count () const { return clusters_x * clusters_y; }
+
+private:
+  /* 이보다 긴 입구는 가운데 한 곳 대신 양 끝 두 곳에 둬서 돌아가는 경로를 줄임 */
+  static constexpr uint32_t LONG_ENTRANCE = 6;
+
+  struct Node
+  {
+    uint32_t cell;
+    uint32_t cluster;
+    uint32_t inter[2];
+  };
+
+  uint32_t cluster_of (GridPoint point) const { return uint32_t (point.y) / cluster_size * clusters_x + uint32_t (point.x) / cluster_size; }
+  GridBounds cluster_bounds (uint32_t cluster) const;
+
+  void build_entrances ();
+  void add_transition (GridPoint a, GridPoint b, uint32_t *node_of_cell);
+  void build_cluster (PathScratch &scratch, uint32_t cluster);
+  uint32_t cost (uint32_t a, uint32_t b) const;
+
+  const GridMap &map;
+  uint32_t cluster_size;
+  uint32_t clusters_x;
+  uint32_t clusters_y;
+
+  Node *nodes = nullptr;
+  uint32_t count = 0;
+  uint32_t *cluster_first = nullptr;   /* 클러스터별 노드 범위 [first[c], first[c + 1]) */
+  uint32_t *cluster_costs = nullptr;   /* 클러스터별 k x k 비용 행렬의 시작 위치 */
+  uint32_t *costs = nullptr;
+};
+
+/* ============ 구현 ============ */
+inline HierarchicalGrid::HierarchicalGrid (const GridMap &map, const uint32_t cluster_size)
+  : map (map),
+    cluster_size (cluster_size),
+    clusters_x ((map.width () + cluster_size - 1) / cluster_size),
+    clusters_y ((map.height () + cluster_size - 1) / cluster_size)
+{
+}
+
+inline HierarchicalGrid::~HierarchicalGrid ()
+{
+  free (nodes);
+  free (cluster_first);
+  free (cluster_costs);
+  free (costs);
+}
+
+inline GridBounds HierarchicalGrid::cluster_bounds (const uint32_t cluster) const
+{
+  const int32_t x0 = int32_t (cluster % clusters_x * cluster_size);
+  const int32_t y0 = int32_t (cluster / clusters_x * cluster_size);
+  const int32_t x1 = x0 + int32_t (cluster_size) < int32_t (map.width ()) ? x0 + int32_t (cluster_size) : int32_t (map.width ());
+  const int32_t y1 = y0 + int32_t (cluster_size) < int32_t (map.height ()) ? y0 + int32_t (cluster_size) : int32_t (map.height ());
+  return { x0, y0, x1, y1 };
+}
+
+inline void HierarchicalGrid::add_transition (const GridPoint a, const GridPoint b, uint32_t *node_of_cell)
+{
+  uint32_t ids[2];
+  const GridPoint points[2] = { a, b };
+  for (int i = 0; i < 2; ++i)
+  {
+    const uint32_t cell = map.index (points[i]);
+    if (node_of_cell[cell] == INVALID_NODE)
+    {
+      nodes[count] = { cell, cluster_of (points[i]), { INVALID_NODE, INVALID_NODE } };
+      node_of_cell[cell] = count++;
+    }
+    ids[i] = node_of_cell[cell];
+  }
+
+  for (int i = 0; i < 2; ++i)
+  {
+    Node &node = nodes[ids[i]];
+    node.inter[node.inter[0] == INVALID_NODE ? 0 : 1] = ids[i ^ 1];
+  }
+}
+
+inline void HierarchicalGrid::build_entrances ()
+{
+  free (nodes);
+  const size_t max_nodes = 2 * (size_t (map.height ()) * (clusters_x - 1) + size_t (map.width ()) * (clusters_y - 1)) + 1;
+  nodes = static_cast <Node *> (malloc (sizeof (Node) * max_nodes));
+  uint32_t *node_of_cell = static_cast <uint32_t *> (malloc (sizeof (uint32_t) * map.cell_count ()));
+  if (!nodes || !node_of_cell) abort ();
+  memset (node_of_cell, 0xff, sizeof (uint32_t) * map.cell_count ());
+  count = 0;
+
+  /* 경계를 따라 양쪽 모두 지나갈 수 있는 연속 구간마다 입구를 만듦. vertical 이면 세로 경계 (좌우 클러스터 사이) */
+  auto scan = [&] (const bool vertical, const int32_t line, const int32_t begin, const int32_t end)
+  {
+    auto open = [&] (const int32_t t)
+    {
+      return vertical ? map.walkable (line, t) && map.walkable (line + 1, t) : map.walkable (t, line) && map.walkable (t, line + 1);
+    };
+    auto transition = [&] (const int32_t t)
+    {
+      if (vertical) add_transition ({ line, t }, { line + 1, t }, node_of_cell);
+      else add_transition ({ t, line }, { t, line + 1 }, node_of_cell);
+    };
+
+    for (int32_t t = begin; t < end;)
+    {
+      if (!open (t)) { ++t; continue; }
+      int32_t run_end = t;
+      while (run_end < end && open (run_end)) ++run_end;
+
+      if (uint32_t (run_end - t) >= LONG_ENTRANCE)
+      {
+        transition (t);
+        transition (run_end - 1);
+      }
+      else transition ((t + run_end - 1) / 2);
+      t = run_end;
+    }
+  };
+
+  for (uint32_t cy = 0; cy < clusters_y; ++cy)
+    for (uint32_t cx = 0; cx < clusters_x; ++cx)
+    {
+      const GridBounds bounds = cluster_bounds (cy * clusters_x + cx);
+      if (cx + 1 < clusters_x) scan (true, bounds.x1 - 1, bounds.y0, bounds.y1);
+      if (cy + 1 < clusters_y) scan (false, bounds.y1 - 1, bounds.x0, bounds.x1);
+    }
+  free (node_of_cell);
+
+  /* 클러스터 순으로 정렬해 클러스터 노드를 연속 구간으로 만듦 */
+  const uint32_t clusters = cluster_count ();
+  free (cluster_first);
+  cluster_first = static_cast <uint32_t *> (calloc (clusters + 1, sizeof (uint32_t)));
+  Node *sorted = static_cast <Node *> (malloc (sizeof (Node) * (count ? count : 1)));
+  uint32_t *remap = static_cast <uint32_t *> (malloc (sizeof (uint32_t) * (count ? count : 1)));
+  if (!cluster_first || !sorted || !remap) abort ();
+
+  for (uint32_t n = 0; n < count; ++n) ++cluster_first[nodes[n].cluster + 1];
+  for (uint32_t c = 0; c < clusters; ++c) cluster_first[c + 1] += cluster_first[c];
+  uint32_t *cursor = static_cast <uint32_t *> (malloc (sizeof (uint32_t) * clusters));
+  if (!cursor) abort ();
+  memcpy (cursor, cluster_first, sizeof (uint32_t) * clusters);
+  for (uint32_t n = 0; n < count; ++n) remap[n] = cursor[nodes[n].cluster]++;
+  for (uint32_t n = 0; n < count; ++n)
+  {
+    Node node = nodes[n];
+    for (uint32_t &partner : node.inter)
+      if (partner != INVALID_NODE) partner = remap[partner];
+    sorted[remap[n]] = node;
+  }
+
+  free (cursor);
+  free (remap);
+  free (nodes);
+  nodes = sorted;
+
+  free (cluster_costs);
+  free (costs);
+  cluster_costs = static_cast <uint32_t *> (malloc (sizeof (uint32_t) * (clusters + 1)));
+  if (!cluster_costs) abort ();
+  size_t total = 0;
+  for (uint32_t c = 0; c < clusters; ++c)
+  {
+    cluster_costs[c] = uint32_t (total);
+    const size_t k = cluster_first[c + 1] - cluster_first[c];
+    total += k * k;
+  }
+  cluster_costs[clusters] = uint32_t (total);
+  costs = static_cast <uint32_t *> (malloc (sizeof (uint32_t) * (total ? total : 1)));
+  if (!costs) abort ();
+}
+
+/* 입구마다 클러스터 안에서 다익스트라 한 번으로 같은 클러스터의 다른 입구까지 비용을 모두 구함 */
+inline void HierarchicalGrid::build_cluster (PathScratch &scratch, const uint32_t cluster)
+{
+  const uint32_t first = cluster_first[cluster];
+  const uint32_t k = cluster_first[cluster + 1] - first;
+  uint32_t *matrix = costs + cluster_costs[cluster];
+  const Detail::GridView view = { &map, cluster_bounds (cluster) };
+
+  for (uint32_t a = 0; a < k; ++a)
+  {
+    Detail::grid_search (view, scratch, map.point (nodes[first + a].cell), { -1, -1 }, false);
+    for (uint32_t b = 0; b < k; ++b)
+    {
+      const uint32_t cell = nodes[first + b].cell;
+      matrix[a * k + b] = scratch.visited (cell) ? scratch.g (cell) : INVALID_NODE;
+    }
+  }
+}
+
+inline void HierarchicalGrid::build (PathScratch &scratch)
+{
+  build_entrances ();
+  for (uint32_t c = 0; c < cluster_count (); ++c) build_cluster (scratch, c);
+}
+
+inline void HierarchicalGrid::build (ThreadPool &pool, PathScratchPool &scratch)
+{
+  build_entrances ();
+  parallel_for (pool, cluster_count (), 4, [&] (const size_t begin, const size_t end)
+  {
+    PathScratch &local = scratch.local ();
+    for (size_t c = begin; c < end; ++c) build_cluster (local, uint32_t (c));
+  });
+}
+
+inline uint32_t HierarchicalGrid::cost (const uint32_t a, const uint32_t b) const
+{
+  const uint32_t cluster = nodes[a].cluster;
+  const uint32_t first = cluster_first[cluster];
+  const uint32_t k = cluster_first[cluster + 1] - first;
+  return costs[cluster_costs[cluster] + (a - first) * k + (b - first)];
+}
+
+inline PathStatus HierarchicalGrid::find_path (PathScratch &scratch, const GridPoint start, const GridPoint goal, GridPath &path) const
+{
+  path.length = 0;
+  path.cost = 0;
+  if (!map.walkable (start.x, start.y) || !map.walkable (goal.x, goal.y)) return PathStatus::InvalidEndpoints;
+
+  const uint32_t start_cluster = cluster_of (start);
+  const uint32_t goal_cluster = cluster_of (goal);
+
+  /* 같은 클러스터 안에서 이어지면 추상 그래프를 거치지 않음 */
+  if (start_cluster == goal_cluster)
+  {
+    const Detail::GridView view = { &map, cluster_bounds (start_cluster) };
+    if (Detail::grid_search (view, scratch, start, goal, false))
+    {
+      const uint32_t goal_node = map.index (goal);
+      path.cost = scratch.g (goal_node);
+      path.length = Detail::write_grid_path (map, scratch, goal_node, path, 0, false);
+      return path.length > path.capacity ? PathStatus::BufferTooSmall : PathStatus::Found;
+    }
+  }
+
+  /* 시작/목표에서 각자 클러스터 입구까지 비용. buffer = [시작 비용 ks][목표 비용 kg][추상 경로] */
+  const uint32_t start_first = cluster_first[start_cluster], start_k = cluster_first[start_cluster + 1] - start_first;
+  const uint32_t goal_first = cluster_first[goal_cluster], goal_k = cluster_first[goal_cluster + 1] - goal_first;
+  scratch.buffer.resize (start_k + goal_k + count + 2);
+  uint32_t *start_costs = scratch.buffer.data ();
+  uint32_t *goal_costs = start_costs + start_k;
+  uint32_t *route = goal_costs + goal_k;
+
+  const GridPoint endpoints[2] = { start, goal };
+  uint32_t *endpoint_costs[2] = { start_costs, goal_costs };
+  const uint32_t endpoint_first[2] = { start_first, goal_first };
+  const uint32_t endpoint_k[2] = { start_k, goal_k };
+  const uint32_t endpoint_cluster[2] = { start_cluster, goal_cluster };
+  for (int e = 0; e < 2; ++e)
+  {
+    const Detail::GridView view = { &map, cluster_bounds (endpoint_cluster[e]) };
+    Detail::grid_search (view, scratch, endpoints[e], { -1, -1 }, false);
+    for (uint32_t i = 0; i < endpoint_k[e]; ++i)
+    {
+      const uint32_t cell = nodes[endpoint_first[e] + i].cell;
+      endpoint_costs[e][i] = scratch.visited (cell) ? scratch.g (cell) : INVALID_NODE;
+    }
+  }
+
+  /* 추상 그래프 A*. 시작 = count, 목표 = count + 1 */
+  const uint32_t start_node = count, goal_node = count + 1;
+  auto point_of = [&] (const uint32_t node) { return node == start_node ? start : node == goal_node ? goal : map.point (nodes[node].cell); };
+
+  scratch.begin (count + 2);
+  scratch.relax (start_node, 0, INVALID_NODE, octile_distance (start, goal));
+  bool found = false;
+  for (uint32_t node; (node = scratch.pop ()) != INVALID_NODE;)
+  {
+    if (node == goal_node)
+    {
+      found = true;
+      break;
+    }
+
+    const uint32_t g = scratch.g (node);
+    auto relax = [&] (const uint32_t next, const uint32_t step)
+    {
+      if (step != INVALID_NODE) scratch.relax (next, g + step, node, octile_distance (point_of (next), goal));
+    };
+
+    if (node == start_node)
+    {
+      for (uint32_t i = 0; i < start_k; ++i) relax (start_first + i, start_costs[i]);
+      continue;
+    }
+
+    const Node &abstract = nodes[node];
+    for (const uint32_t partner : abstract.inter)
+      if (partner != INVALID_NODE) relax (partner, GRID_STRAIGHT_COST);
+
+    const uint32_t first = cluster_first[abstract.cluster], last = cluster_first[abstract.cluster + 1];
+    for (uint32_t other = first; other < last; ++other)
+      if (other != node) relax (other, cost (node, other));
+
+    if (abstract.cluster == goal_cluster) relax (goal_node, goal_costs[node - goal_first]);
+  }
+  if (!found) return PathStatus::NotFound;
+
+  path.cost = scratch.g (goal_node);
+  uint32_t route_length = 0;
+  for (uint32_t node = goal_node; node != INVALID_NODE; node = scratch.parent (node)) ++route_length;
+  for (uint32_t node = goal_node, i = route_length; node != INVALID_NODE; node = scratch.parent (node)) route[--i] = node;
+
+  /* 추상 경로의 각 구간을 칸 경로로 펼침. 클러스터 사이 구간은 인접한 두 칸이라 탐색이 필요 없음 */
+  uint32_t length = 0;
+  for (uint32_t i = 0; i + 1 < route_length; ++i)
+  {
+    const GridPoint from = point_of (route[i]), to = point_of (route[i + 1]);
+    const uint32_t from_cluster = cluster_of (from);
+
+    if (from_cluster != cluster_of (to))
+    {
+      if (i == 0 && length < path.capacity) path.points[length] = from;
+      if (i == 0) ++length;
+      if (length < path.capacity) path.points[length] = to;
+      ++length;
+      continue;
+    }
+
+    const Detail::GridView view = { &map, cluster_bounds (from_cluster) };
+    Detail::grid_search (view, scratch, from, to, false);
+    length += Detail::write_grid_path (map, scratch, map.index (to), path, length, i != 0);
+  }
+
+  path.length = length;
+  return length > path.capacity ? PathStatus::BufferTooSmall : PathStatus::Found;
+}
@@ -0,0 +1,332 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "Navigation/PathScratch.h"
+
+/* 경로 출력. points 는 (x, z) 쌍 */
+struct NavPath
+{
+  float *points;
+  uint32_t capacity;
+  uint32_t length;
+  float cost;
+};
+
+/* 바닥 평면 (x, z) 위의 볼록 다각형 메시. 다각형은 반시계 방향으로 감겨 있어야 함.
+   공유 변으로 인접 관계를 만들고, 다각형 중심 사이 A* 후 통로 변을 따라 줄 당기기 (funnel) 로 경로를 다듬음 */
+class NavMesh
+{
+public:
+  /* indices 에 다각형 꼭짓점 번호가 이어서 들어 있고 polygon_sizes[i] 가 i 번째 다각형의 꼭짓점 수 */
+  NavMesh (const float *vertices, uint32_t vertex_count, const uint32_t *indices, const uint32_t *polygon_sizes, uint32_t polygon_count);
+  ~NavMesh ();
+
+  NavMesh (const NavMesh &) = delete;
+  NavMesh &operator= (const NavMesh &) = delete;
+
+  /* 점을 포함하는 다각형. 없으면 INVALID_NODE */
+  uint32_t locate (float x, float z) const;
+
+  PathStatus find_path (PathScratch &scratch, const float *start, const float *goal, NavPath &path) const;
+
+  uint32_t polygon_count () const { return count; }
+
+private:
+  struct Polygon
+  {
+    uint32_t first;
+    uint32_t size;
+    float center[2];
+    float min[2];
+    float max[2];
+  };
+
+  const float *vertex (uint32_t polygon, uint32_t corner) const { return vertices + 2 * indices[polygons[polygon].first + corner]; }
+  bool contains (uint32_t polygon, float x, float z) const;
+  void build_adjacency ();
+
+  float *vertices;
+  uint32_t *indices;
+  uint32_t *neighbors;  /* 변마다 맞닿은 다각형, 없으면 INVALID_NODE. indices 와 같은 배치 */
+  Polygon *polygons;
+  uint32_t count;
+};
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  /* 양수면 c 가 a->b 의 오른쪽 (시계 방향) */
+  inline float funnel_area (const float *a, const float *b, const float *c)
+  {
+    return (c[0] - a[0]) * (b[1] - a[1]) - (b[0] - a[0]) * (c[1] - a[1]);
+  }
+
+  inline bool same_point (const float *a, const float *b)
+  {
+    const float dx = a[0] - b[0], dz = a[1] - b[1];
+    return dx * dx + dz * dz < 1e-12f;
+  }
+
+  /* float 비용을 열린 목록의 정수 키로. 음이 아닌 float 는 비트 순서와 크기 순서가 같음 */
+  inline uint32_t float_key (const float value)
+  {
+    uint32_t bits;
+    memcpy (&bits, &value, sizeof (bits));
+    return bits;
+  }
+
+  inline float key_float (const uint32_t bits)
+  {
+    float value;
+    memcpy (&value, &bits, sizeof (value));
+    return value;
+  }
+
+  /* portals 는 (왼쪽 x, z, 오른쪽 x, z) 의 나열. 첫 통로는 시작점, 마지막 통로는 목표점이 양쪽에 들어 있음 */
+  inline uint32_t string_pull (const float *portals, const uint32_t portal_count, float *out, const uint32_t capacity)
+  {
+    float apex[2] = { portals[0], portals[1] };
+    float left[2] = { portals[0], portals[1] };
+    float right[2] = { portals[2], portals[3] };
+    uint32_t apex_index = 0, left_index = 0, right_index = 0;
+
+    uint32_t count = 0;
+    float last[2];
+    auto emit = [&] (const float *point)
+    {
+      if (count && same_point (last, point)) return;
+      memcpy (last, point, sizeof (last));
+      if (count < capacity) memcpy (out + 2 * count, point, sizeof (last));
+      ++count;
+    };
+    emit (apex);
+
+    for (uint32_t i = 1; i < portal_count; ++i)
+    {
+      const float *portal_left = portals + i * 4;
+      const float *portal_right = portals + i * 4 + 2;
+
+      if (funnel_area (apex, right, portal_right) <= 0.0f)
+      {
+        if (same_point (apex, right) || funnel_area (apex, left, portal_right) > 0.0f)
+        {
+          memcpy (right, portal_right, sizeof (right));
+          right_index = i;
+        }
+        else
+        {
+          emit (left);
+          memcpy (apex, left, sizeof (apex));
+          apex_index = left_index;
+          memcpy (right, apex, sizeof (right));
+          right_index = apex_index;
+          i = apex_index;
+          continue;
+        }
+      }
+
+      if (funnel_area (apex, left, portal_left) >= 0.0f)
+      {
+        if (same_point (apex, left) || funnel_area (apex, right, portal_left) < 0.0f)
+        {
+          memcpy (left, portal_left, sizeof (left));
+          left_index = i;
+        }
+        else
+        {
+          emit (right);
+          memcpy (apex, right, sizeof (apex));
+          apex_index = right_index;
+          memcpy (left, apex, sizeof (left));
+          left_index = apex_index;
+          i = apex_index;
+          continue;
+        }
+      }
+    }
+
+    emit (portals + (portal_count - 1) * 4);
+    return count;
+  }
+}
+
+inline NavMesh::NavMesh (const float *vertex_data, const uint32_t vertex_count, const uint32_t *index_data, const uint32_t *polygon_sizes,
+                         const uint32_t polygon_count)
+  : count (polygon_count)
+{
+  uint32_t index_count = 0;
+  for (uint32_t p = 0; p < polygon_count; ++p) index_count += polygon_sizes[p];
+
+  vertices = static_cast <float *> (malloc (sizeof (float) * 2 * (vertex_count ? vertex_count : 1)));
+  indices = static_cast <uint32_t *> (malloc (sizeof (uint32_t) * (index_count ? index_count : 1)));
+  neighbors = static_cast <uint32_t *> (malloc (sizeof (uint32_t) * (index_count ? index_count : 1)));
+  polygons = static_cast <Polygon *> (malloc (sizeof (Polygon) * (polygon_count ? polygon_count : 1)));
+  if (!vertices || !indices || !neighbors || !polygons) abort ();
+
+  memcpy (vertices, vertex_data, sizeof (float) * 2 * vertex_count);
+  memcpy (indices, index_data, sizeof (uint32_t) * index_count);
+
+  for (uint32_t p = 0, first = 0; p < polygon_count; first += polygon_sizes[p++])
+  {
+    Polygon &polygon = polygons[p];
+    polygon = { first, polygon_sizes[p], { 0.0f, 0.0f }, { INFINITY, INFINITY }, { -INFINITY, -INFINITY } };
+    for (uint32_t c = 0; c < polygon.size; ++c)
+    {
+      const float *v = vertex (p, c);
+      for (int axis = 0; axis < 2; ++axis)
+      {
+        polygon.center[axis] += v[axis] / float (polygon.size);
+        polygon.min[axis] = fminf (polygon.min[axis], v[axis]);
+        polygon.max[axis] = fmaxf (polygon.max[axis], v[axis]);
+      }
+    }
+  }
+
+  build_adjacency ();
+}
+
+inline NavMesh::~NavMesh ()
+{
+  free (vertices);
+  free (indices);
+  free (neighbors);
+  free (polygons);
+}
+
+/* 변을 (작은 꼭짓점, 큰 꼭짓점) 키로 정렬해 같은 키를 가진 두 변을 이웃으로 묶음 */
+inline void NavMesh::build_adjacency ()
+{
+  struct Edge
+  {
+    uint64_t key;
+    uint32_t slot;
+    uint32_t polygon;
+  };
+
+  uint32_t edge_count = 0;
+  for (uint32_t p = 0; p < count; ++p) edge_count += polygons[p].size;
+
+  Edge *edges = static_cast <Edge *> (malloc (sizeof (Edge) * (edge_count ? edge_count : 1)));
+  if (!edges) abort ();
+
+  for (uint32_t p = 0, e = 0; p < count; ++p)
+    for (uint32_t c = 0; c < polygons[p].size; ++c, ++e)
+    {
+      const uint32_t a = indices[polygons[p].first + c];
+      const uint32_t b = indices[polygons[p].first + (c + 1) % polygons[p].size];
+      edges[e] = { (uint64_t (a < b ? a : b) << 32) | (a < b ? b : a), polygons[p].first + c, p };
+      neighbors[polygons[p].first + c] = INVALID_NODE;
+    }
+
+  qsort (edges, edge_count, sizeof (Edge), [] (const void *a, const void *b)
+  {
+    const uint64_t x = static_cast <const Edge *> (a)->key, y = static_cast <const Edge *> (b)->key;
+    return (x > y) - (x < y);
+  });
+
+  for (uint32_t e = 0; e + 1 < edge_count; ++e)
+    if (edges[e].key == edges[e + 1].key)
+    {
+      neighbors[edges[e].slot] = edges[e + 1].polygon;
+      neighbors[edges[e + 1].slot] = edges[e].polygon;
+      ++e;
+    }
+
+  free (edges);
+}
+
+inline bool NavMesh::contains (const uint32_t polygon, const float x, const float z) const
+{
+  const Polygon &p = polygons[polygon];
+  if (x < p.min[0] || x > p.max[0] || z < p.min[1] || z > p.max[1]) return false;
+
+  const float point[2] = { x, z };
+  for (uint32_t c = 0; c < p.size; ++c)
+    if (Detail::funnel_area (vertex (polygon, c), vertex (polygon, (c + 1) % p.size), point) > 0.0f) return false;
+  return true;
+}
+
+inline uint32_t NavMesh::locate (const float x, const float z) const
+{
+  for (uint32_t p = 0; p < count; ++p)
+    if (contains (p, x, z)) return p;
+  return INVALID_NODE;
+}
+
+inline PathStatus NavMesh::find_path (PathScratch &scratch, const float *start, const float *goal, NavPath &path) const
+{
+  path.length = 0;
+  path.cost = 0.0f;
+
+  const uint32_t start_polygon = locate (start[0], start[1]);
+  const uint32_t goal_polygon = locate (goal[0], goal[1]);
+  if (start_polygon == INVALID_NODE || goal_polygon == INVALID_NODE) return PathStatus::InvalidEndpoints;
+
+  auto position = [&] (const uint32_t polygon) { return polygon == start_polygon ? start : polygon == goal_polygon ? goal : polygons[polygon].center; };
+  auto distance = [] (const float *a, const float *b) { return sqrtf ((a[0] - b[0]) * (a[0] - b[0]) + (a[1] - b[1]) * (a[1] - b[1])); };
+
+  scratch.begin (count);
+  scratch.relax (start_polygon, 0, INVALID_NODE, Detail::float_key (distance (start, goal)));
+
+  bool found = false;
+  for (uint32_t node; (node = scratch.pop ()) != INVALID_NODE;)
+  {
+    if (node == goal_polygon)
+    {
+      found = true;
+      break;
+    }
+
+    const float g = Detail::key_float (scratch.g (node));
+    const Polygon &polygon = polygons[node];
+    for (uint32_t c = 0; c < polygon.size; ++c)
+    {
+      const uint32_t next = neighbors[polygon.first + c];
+      if (next == INVALID_NODE) continue;
+      const float next_g = g + distance (position (node), position (next));
+      /* relax 는 g + h 를 정수로 더하므로 h 를 키 차이로 넘겨 합이 f 의 키가 되게 함 */
+      const uint32_t g_key = Detail::float_key (next_g);
+      scratch.relax (next, g_key, node, Detail::float_key (next_g + distance (position (next), goal)) - g_key);
+    }
+  }
+  if (!found) return PathStatus::NotFound;
+
+  /* 다각형 경로를 통로 목록으로. 목표에서 거꾸로 따라가며 portals 끝에서부터 채움 */
+  uint32_t corridor = 0;
+  for (uint32_t node = goal_polygon; node != INVALID_NODE; node = scratch.parent (node)) ++corridor;
+
+  const uint32_t portal_count = corridor + 1;
+  scratch.points.resize (size_t (portal_count) * 4);
+  float *portals = scratch.points.data ();
+
+  memcpy (portals, start, sizeof (float) * 2);
+  memcpy (portals + 2, start, sizeof (float) * 2);
+  memcpy (portals + (portal_count - 1) * 4, goal, sizeof (float) * 2);
+  memcpy (portals + (portal_count - 1) * 4 + 2, goal, sizeof (float) * 2);
+
+  uint32_t i = portal_count - 1;
+  for (uint32_t node = goal_polygon; scratch.parent (node) != INVALID_NODE; node = scratch.parent (node))
+  {
+    const uint32_t from = scratch.parent (node);
+    const Polygon &polygon = polygons[from];
+    for (uint32_t c = 0; c < polygon.size; ++c)
+      if (neighbors[polygon.first + c] == node)
+      {
+        /* 반시계 다각형에서 밖으로 나가는 변 a->b: 나가는 방향 기준 b 가 왼쪽, a 가 오른쪽 */
+        --i;
+        memcpy (portals + i * 4, vertex (from, (c + 1) % polygon.size), sizeof (float) * 2);
+        memcpy (portals + i * 4 + 2, vertex (from, c), sizeof (float) * 2);
+        break;
+      }
+  }
+
+  path.length = Detail::string_pull (portals, portal_count, path.points, path.capacity);
+  const uint32_t written = path.length < path.capacity ? path.length : path.capacity;
+  for (uint32_t p = 1; p < written; ++p) path.cost += distance (path.points + 2 * (p - 1), path.points + 2 * p);
+  return path.length > path.capacity ? PathStatus::BufferTooSmall : PathStatus::Found;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Foundation/Thread/ParallelFor.h"
+#include "Foundation/Thread/ThreadPool.h"
+#include "Navigation/GridSearch.h"
+#include "Navigation/HierarchicalGrid.h"
+#include "Navigation/NavMesh.h"
+#include "Navigation/PathScratch.h"
+
+enum class GridAlgorithm : uint8_t
+{
+  AStar,
+  JumpPoint,
+  Hierarchical,
+};
+
+/* 경로 질의 하나. path 버퍼는 호출자가 준비하고 status/path.length/path.cost 에 결과가 들어감 */
+struct GridPathQuery
+{
+  GridPoint start;
+  GridPoint goal;
+  GridAlgorithm algorithm;
+  PathStatus status;
+  GridPath path;
+};
+
+struct NavPathQuery
+{
+  float start[2];
+  float goal[2];
+  PathStatus status;
+  NavPath path;
+};
+
+/* 한 프레임에 모인 질의를 워커에 나눠 처리. 각 스레드는 PathScratchPool 에서 자기 스크래치를 꺼내 쓰므로 잠금이 없음.
+   hierarchy 는 Hierarchical 질의가 있을 때만 필요 */
+void find_paths (ThreadPool &pool, PathScratchPool &scratch, const GridMap &map, const HierarchicalGrid *hierarchy,
+                 GridPathQuery *queries, size_t count, size_t chunk_size = 8);
+void find_paths (ThreadPool &pool, PathScratchPool &scratch, const NavMesh &mesh, NavPathQuery *queries, size_t count, size_t chunk_size = 8);
+
+/* ============ 구현 ============ */
+inline void find_paths (ThreadPool &pool, PathScratchPool &scratch, const GridMap &map, const HierarchicalGrid *hierarchy,
+                        GridPathQuery *queries, const size_t count, const size_t chunk_size)
+{
+  parallel_for (pool, count, chunk_size, [&] (const size_t begin, const size_t end)
+  {
+    PathScratch &local = scratch.local ();
+    for (size_t i = begin; i < end; ++i)
+    {
+      GridPathQuery &query = queries[i];
+      switch (query.algorithm)
+      {
+      case GridAlgorithm::AStar:
+        query.status = find_grid_path (map, local, query.start, query.goal, query.path);
+        break;
+      case GridAlgorithm::JumpPoint:
+        query.status = find_jump_point_path (map, local, query.start, query.goal, query.path);
+        break;
+      case GridAlgorithm::Hierarchical:
+        query.status = hierarchy ? hierarchy->find_path (local, query.start, query.goal, query.path) : PathStatus::NotFound;
+        break;
+      }
+    }
+  });
+}
+
+inline void find_paths (ThreadPool &pool, PathScratchPool &scratch, const NavMesh &mesh, NavPathQuery *queries, const size_t count,
+                        const size_t chunk_size)
+{
+  parallel_for (pool, count, chunk_size, [&] (const size_t begin, const size_t end)
+  {
+    PathScratch &local = scratch.local ();
+    for (size_t i = begin; i < end; ++i)
+      queries[i].status = mesh.find_path (local, queries[i].start, queries[i].goal, queries[i].path);
+  });
+}
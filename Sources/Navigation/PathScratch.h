@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Foundation/Heap/VirtualArray.h"
+#include "Foundation/Thread/ThreadLocal.h"
+
+inline constexpr uint32_t INVALID_NODE = ~0u;
+
+enum class PathStatus : uint8_t
+{
+  Found,
+  NotFound,
+  BufferTooSmall,   /* 경로는 있지만 버퍼가 작음. length 에 필요한 길이가 들어감 */
+  InvalidEndpoints,
+};
+
+/* (f, node) 를 64비트 하나로 묶은 이진 최소 힙. 키 감소 대신 중복 삽입하고 꺼낼 때 닫힌 노드를 건너뜀.
+   저장소는 미리 예약된 가상 메모리라 탐색 중 할당이 없음 */
+class OpenList
+{
+public:
+  explicit OpenList (size_t max_entries) : heap (max_entries) {}
+
+  void clear () { heap.clear (); }
+  bool empty () const { return heap.size () == 0; }
+
+  void push (uint32_t key, uint32_t node);
+  uint32_t pop ();
+
+private:
+  VirtualArray <uint64_t> heap;
+};
+
+/* 탐색 한 번에 필요한 노드 상태와 열린 목록. 세대 번호로 방문 여부를 판단하므로 탐색마다 배열을 지우지 않음.
+   스레드마다 하나씩 두고 재사용 */
+class PathScratch
+{
+public:
+  struct Node
+  {
+    uint32_t g;
+    uint32_t parent;
+    uint32_t stamp;
+  };
+
+  explicit PathScratch (size_t max_nodes);
+
+  PathScratch (const PathScratch &) = delete;
+  PathScratch &operator= (const PathScratch &) = delete;
+
+  void begin (size_t node_count);
+
+  bool visited (uint32_t node) const { return nodes[node].stamp >= generation; }
+  bool closed (uint32_t node) const { return nodes[node].stamp == generation + 1; }
+  uint32_t g (uint32_t node) const { return nodes[node].g; }
+  uint32_t parent (uint32_t node) const { return nodes[node].parent; }
+
+  /* 처음 보거나 더 싼 경로면 갱신하고 열린 목록에 넣음 */
+  bool relax (uint32_t node, uint32_t g, uint32_t parent, uint32_t h);
+  /* 열린 목록에서 가장 싼 노드를 꺼내 닫음. 비었으면 INVALID_NODE */
+  uint32_t pop ();
+
+  size_t max_nodes () const { return nodes.capacity (); }
+
+  /* 탐색 결과를 다음 탐색 전에 옮겨 두는 임시 공간 */
+  VirtualArray <uint32_t> buffer;
+  VirtualArray <float> points;
+
+private:
+  VirtualArray <Node> nodes;
+  OpenList open;
+  uint32_t generation = 0;
+};
+
+/* 스레드마다 PathScratch 하나. 처음 쓰는 스레드에서 만들고 이후 재사용.
+   ThreadLocal 슬롯이라 local 을 부르는 스레드는 붙어 있어야 함 (ThreadLocal.h 참고) */
+class PathScratchPool
+{
+public:
+  explicit PathScratchPool (size_t max_nodes) : max_nodes (max_nodes) {}
+  ~PathScratchPool ();
+
+  PathScratchPool (const PathScratchPool &) = delete;
+  PathScratchPool &operator= (const PathScratchPool &) = delete;
+
+  PathScratch &local ();
+
+private:
+  size_t max_nodes;
+  PathScratch *scratches[ThreadLocal::MAX_THREADS] = {};
+};
+
+/* ============ 구현 ============ */
+inline void OpenList::push (const uint32_t key, const uint32_t node)
+{
+  const uint64_t entry = (uint64_t (key) << 32) | node;
+  heap.push_back (entry);
+  uint64_t *data = heap.data ();
+  size_t i = heap.size () - 1;
+  while (i)
+  {
+    const size_t parent = (i - 1) / 2;
+    if (data[parent] <= entry) break;
+    data[i] = data[parent];
+    i = parent;
+  }
+  data[i] = entry;
+}
+
+inline uint32_t OpenList::pop ()
+{
+  uint64_t *data = heap.data ();
+  const uint32_t top = uint32_t (data[0]);
+  const size_t count = heap.size () - 1;
+  const uint64_t last = data[count];
+  heap.resize (count);
+
+  size_t i = 0;
+  for (;;)
+  {
+    size_t child = i * 2 + 1;
+    if (child >= count) break;
+    if (child + 1 < count && data[child + 1] < data[child]) ++child;
+    if (last <= data[child]) break;
+    data[i] = data[child];
+    i = child;
+  }
+  if (count) data[i] = last;
+  return top;
+}
+
+inline PathScratch::PathScratch (const size_t max_nodes)
+  : buffer (max_nodes * 2 + 64), points (max_nodes * 4 + 64), nodes (max_nodes), open (max_nodes * 8 + 64)
+{
+}
+
+inline void PathScratch::begin (const size_t node_count)
+{
+  nodes.resize (node_count);
+  open.clear ();
+
+  /* 세대는 2씩 증가 (짝수: 열림, 홀수: 닫힘). 넘치면 한 번 지우고 다시 시작 */
+  if (generation >= ~0u - 4)
+  {
+    memset (static_cast <void *> (nodes.data ()), 0, sizeof (Node) * nodes.size ());
+    generation = 0;
+  }
+  generation += 2;
+}
+
+inline bool PathScratch::relax (const uint32_t node, const uint32_t g, const uint32_t parent, const uint32_t h)
+{
+  Node &state = nodes[node];
+  if (state.stamp == generation + 1) return false;
+  if (state.stamp == generation && state.g <= g) return false;
+
+  state = { g, parent, generation };
+  open.push (g + h, node);
+  return true;
+}
+
+inline uint32_t PathScratch::pop ()
+{
+  while (!open.empty ())
+  {
+    const uint32_t node = open.pop ();
+    if (nodes[node].stamp == generation + 1) continue;
+    nodes[node].stamp = generation + 1;
+    return node;
+  }
+  return INVALID_NODE;
+}
+
+inline PathScratchPool::~PathScratchPool ()
+{
+  for (PathScratch *scratch : scratches) delete scratch;
+}
+
+inline PathScratch &PathScratchPool::local ()
+{
+  PathScratch *&scratch = scratches[ThreadLocal::index ()];
+  if (!scratch) scratch = new PathScratch (max_nodes);
+  return *scratch;
+}
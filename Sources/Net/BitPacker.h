@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/* 비트 단위 기록. 64 비트 임시 값에 모았다가 32 비트씩 리틀 엔디언으로 내보냄.
+   넘치면 overflow 가 서고 이후 기록은 무시됨. mark / rewind 로 방금 쓴 레코드를 되돌릴 수 있음 */
+class BitWriter
+{
+public:
+  struct Mark
+  {
+    uint64_t scratch;
+    size_t position;
+    uint32_t scratch_bits;
+    bool overflow;
+  };
+
+  BitWriter (uint8_t *data, size_t capacity) : data (data), capacity (capacity) {}
+
+  /* bits 는 1 ~ 32. value 의 위쪽 비트는 버림 */
+  void write (uint32_t value, uint32_t bits);
+  void write_bool (bool value) { write (value, 1); }
+  /* 남은 비트를 바이트 경계까지 채워 내보내고 전체 바이트 수를 돌려줌 */
+  size_t flush ();
+
+  size_t bits_written () const { return position * 8 + scratch_bits; }
+  bool overflow () const { return overflowed; }
+
+  Mark mark () const { return { scratch, position, scratch_bits, overflowed }; }
+  void rewind (const Mark &mark);
+
+private:
+  uint8_t *data;
+  size_t capacity;
+  size_t position = 0;
+  uint64_t scratch = 0;
+  uint32_t scratch_bits = 0;
+  bool overflowed = false;
+};
+
+/* BitWriter 가 쓴 것을 같은 순서로 읽음. 끝을 넘어 읽으면 0 을 돌려주고 overflow 가 섬 */
+class BitReader
+{
+public:
+  BitReader (const uint8_t *data, size_t size) : data (data), size (size) {}
+
+  uint32_t read (uint32_t bits);
+  bool read_bool () { return read (1) != 0; }
+
+  size_t bits_read () const { return consumed; }
+  bool overflow () const { return overflowed; }
+
+private:
+  const uint8_t *data;
+  size_t size;
+  size_t position = 0;
+  size_t consumed = 0;
+  uint64_t scratch = 0;
+  uint32_t scratch_bits = 0;
+  bool overflowed = false;
+};
+
+/* 0 ~ max_value 를 담는 데 필요한 비트 수 (최소 1) */
+inline uint32_t bits_required (uint32_t max_value)
+{
+  uint32_t bits = 1;
+  while (bits < 32 && (max_value >> bits)) ++bits;
+  return bits;
+}
+
+/* [min, max] 를 2^bits - 1 칸으로 나눠 가장 가까운 칸으로. 범위를 벗어나면 잘림 */
+inline uint32_t quantize_float (float value, float min, float max, uint32_t bits)
+{
+  const uint32_t steps = bits >= 32 ? ~0u : (1u << bits) - 1;
+  const float t = (value - min) / (max - min);
+  if (!(t > 0.0f)) return 0;
+  if (t >= 1.0f) return steps;
+  return uint32_t (t * float (steps) + 0.5f);
+}
+
+inline float dequantize_float (uint32_t value, float min, float max, uint32_t bits)
+{
+  const uint32_t steps = bits >= 32 ? ~0u : (1u << bits) - 1;
+  return min + (max - min) * (float (value) / float (steps));
+}
+
+/* ============ 구현 ============ */
+inline void BitWriter::write (const uint32_t value, const uint32_t bits)
+{
+  if (overflowed) return;
+  const uint64_t mask = bits >= 32 ? 0xffffffffull : (1ull << bits) - 1;
+  scratch |= (uint64_t (value) & mask) << scratch_bits;
+  scratch_bits += bits;
+  if (scratch_bits < 32) return;
+
+  if (position + 4 > capacity)
+  {
+    overflowed = true;
+    return;
+  }
+  const uint32_t word = uint32_t (scratch);
+  memcpy (data + position, &word, 4);
+  position += 4;
+  scratch >>= 32;
+  scratch_bits -= 32;
+}
+
+inline size_t BitWriter::flush ()
+{
+  const size_t tail = (scratch_bits + 7) / 8;
+  if (overflowed || position + tail > capacity)
+  {
+    overflowed = true;
+    return position;
+  }
+  for (size_t i = 0; i < tail; ++i) data[position + i] = uint8_t (scratch >> (8 * i));
+  position += tail;
+  scratch = 0;
+  scratch_bits = 0;
+  return position;
+}
+
+inline void BitWriter::rewind (const Mark &mark)
+{
+  scratch = mark.scratch;
+  position = mark.position;
+  scratch_bits = mark.scratch_bits;
+  overflowed = mark.overflow;
+}
+
+inline uint32_t BitReader::read (const uint32_t bits)
+{
+  if (overflowed || consumed + bits > size * 8)
+  {
+    overflowed = true;
+    return 0;
+  }
+  if (scratch_bits < bits)
+  {
+    uint32_t word = 0;
+    const size_t available = size - position < 4 ? size - position : 4;
+    memcpy (&word, data + position, available);
+    position += available;
+    scratch |= uint64_t (word) << scratch_bits;
+    scratch_bits += 32;
+  }
+  const uint64_t mask = bits >= 32 ? 0xffffffffull : (1ull << bits) - 1;
+  const uint32_t value = uint32_t (scratch & mask);
+  scratch >>= bits;
+  scratch_bits -= bits;
+  consumed += bits;
+  return value;
+}
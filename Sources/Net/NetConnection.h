@@ -0,0 +1,348 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Foundation/Heap/PoolAllocator.h"
+
+/* 16 비트 순번을 감아 도는 것까지 고려해 비교 */
+inline bool net_sequence_greater (uint16_t a, uint16_t b)
+{
+  return uint16_t (a - b) != 0 && uint16_t (a - b) < 32768;
+}
+
+struct NetConnectionStats
+{
+  uint64_t packets_sent;
+  uint64_t packets_received;
+  uint64_t packets_acked;
+  uint64_t packets_lost;        /* 확인 없이 기록 창에서 밀려난 패킷 */
+  uint64_t messages_resent;
+  uint64_t stale_dropped;       /* 순서가 지난 비신뢰 페이로드 */
+  float rtt_ms;
+};
+
+/* 연결 하나의 신뢰성과 순서. 소켓과 무관해 패킷 버퍼만 주고받음.
+   패킷 머리: 매직 2, 순번 2, 확인 2, 확인 비트 4 (확인 앞 32 개), 신뢰 메시지 수 1.
+   그 뒤 신뢰 메시지 (번호 2, 길이 2, 내용) 들, 나머지는 비신뢰 메시지 (길이 2, 내용) 들.
+   신뢰 메시지는 담긴 패킷이 확인될 때까지 재전송 간격마다 다음 패킷에 다시 실리고 받는 쪽에서 번호 순으로 전달됨.
+   비신뢰 메시지는 이미 받은 것보다 오래된 패킷에 실려 오면 버림 (순서 보장, 최신만).
+   메시지 내용 복사본은 모두 풀 블록에 둠 */
+class NetConnection
+{
+public:
+  static constexpr uint16_t MAGIC = 0x4b49;
+  static constexpr uint32_t HEADER_SIZE = 11;
+  static constexpr uint32_t MAX_PACKET_SIZE = 1200;
+  static constexpr uint32_t MAX_MESSAGE_SIZE = MAX_PACKET_SIZE - HEADER_SIZE - 4;
+  static constexpr uint32_t SENT_WINDOW = 256;
+  static constexpr uint32_t MESSAGE_WINDOW = 256;
+  static constexpr uint32_t MAX_MESSAGES_PER_PACKET = 32;
+  static constexpr uint64_t MIN_RESEND_NS = 30000000;
+  static constexpr uint64_t KEEPALIVE_NS = 100000000;
+
+  /* pool 블록은 MAX_PACKET_SIZE 이상 */
+  explicit NetConnection (PoolAllocator &pool) : pool (pool) {}
+  ~NetConnection () { reset (); }
+
+  NetConnection (const NetConnection &) = delete;
+  NetConnection &operator= (const NetConnection &) = delete;
+
+  /* 보낼 것을 쌓음. 창이 차거나 풀이 비거나 비신뢰 버퍼가 차면 false */
+  bool queue_reliable (const void *data, uint32_t size);
+  bool queue_unreliable (const void *data, uint32_t size);
+
+  /* 보낼 것이 있거나 확인을 돌려줘야 하면 패킷 하나를 out (MAX_PACKET_SIZE) 에 만들어 크기를 돌려줌. 없으면 0 */
+  uint32_t write_packet (uint8_t *out, uint64_t now);
+  /* on_message (data, size, reliable). 형식이 틀리면 false */
+  template <typename F>
+  bool read_packet (const uint8_t *data, uint32_t size, uint64_t now, F &&on_message);
+
+  /* 쌓인 것과 상태를 모두 버리고 풀 블록을 돌려줌 */
+  void reset ();
+
+  bool has_pending () const { return oldest_unacked != next_message_id || unreliable_size; }
+  uint64_t last_received () const { return last_receive_time; }
+  const NetConnectionStats &stats () const { return counters; }
+
+private:
+  struct SentPacket
+  {
+    uint64_t time;
+    uint16_t sequence;
+    bool used;
+    bool acked;
+    uint8_t message_count;
+    uint16_t messages[MAX_MESSAGES_PER_PACKET];
+  };
+
+  struct Message
+  {
+    uint8_t *data;
+    uint64_t last_sent;
+    uint16_t id;
+    uint16_t size;
+    bool used;
+  };
+
+  void process_acks (uint16_t ack, uint32_t ack_bits, uint64_t now);
+  uint8_t *copy (const void *data, uint32_t size);
+
+  PoolAllocator &pool;
+
+  uint16_t local_sequence = 0;
+  uint16_t remote_sequence = 0;
+  uint32_t received_bits = 0;
+  bool any_received = false;
+  bool ack_pending = false;
+  uint64_t last_send_time = 0;
+  uint64_t last_receive_time = 0;
+
+  uint16_t next_message_id = 0;
+  uint16_t oldest_unacked = 0;
+  uint16_t next_delivery = 0;
+  uint16_t last_unreliable = 0;
+  bool any_unreliable = false;
+
+  uint8_t *unreliable = nullptr;
+  uint32_t unreliable_size = 0;
+
+  NetConnectionStats counters = {};
+  SentPacket sent[SENT_WINDOW] = {};
+  Message outgoing[MESSAGE_WINDOW] = {};
+  Message incoming[MESSAGE_WINDOW] = {};
+};
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  inline void net_put16 (uint8_t *p, const uint16_t value) { p[0] = uint8_t (value); p[1] = uint8_t (value >> 8); }
+  inline void net_put32 (uint8_t *p, const uint32_t value) { for (int i = 0; i < 4; ++i) p[i] = uint8_t (value >> (8 * i)); }
+  inline uint16_t net_get16 (const uint8_t *p) { return uint16_t (p[0] | p[1] << 8); }
+  inline uint32_t net_get32 (const uint8_t *p) { return uint32_t (p[0]) | uint32_t (p[1]) << 8 | uint32_t (p[2]) << 16 | uint32_t (p[3]) << 24; }
+}
+
+inline uint8_t *NetConnection::copy (const void *data, const uint32_t size)
+{
+  uint8_t *block = static_cast <uint8_t *> (pool.allocate ());
+  if (block) memcpy (block, data, size);
+  return block;
+}
+
+inline void NetConnection::reset ()
+{
+  for (Message &message : outgoing)
+    if (message.used) pool.free (message.data);
+  for (Message &message : incoming)
+    if (message.used) pool.free (message.data);
+  if (unreliable) pool.free (unreliable);
+
+  local_sequence = remote_sequence = 0;
+  received_bits = 0;
+  any_received = ack_pending = any_unreliable = false;
+  last_send_time = last_receive_time = 0;
+  next_message_id = oldest_unacked = next_delivery = last_unreliable = 0;
+  unreliable = nullptr;
+  unreliable_size = 0;
+  counters = {};
+  memset (static_cast <void *> (sent), 0, sizeof (sent));
+  memset (static_cast <void *> (outgoing), 0, sizeof (outgoing));
+  memset (static_cast <void *> (incoming), 0, sizeof (incoming));
+}
+
+inline bool NetConnection::queue_reliable (const void *data, const uint32_t size)
+{
+  if (size > MAX_MESSAGE_SIZE || uint16_t (next_message_id - oldest_unacked) >= MESSAGE_WINDOW) return false;
+  uint8_t *block = copy (data, size);
+  if (!block) return false;
+
+  outgoing[next_message_id % MESSAGE_WINDOW] = { block, 0, next_message_id, uint16_t (size), true };
+  ++next_message_id;
+  return true;
+}
+
+inline bool NetConnection::queue_unreliable (const void *data, const uint32_t size)
+{
+  if (unreliable_size + 2 + size > MAX_PACKET_SIZE - HEADER_SIZE) return false;
+  if (!unreliable)
+  {
+    unreliable = static_cast <uint8_t *> (pool.allocate ());
+    if (!unreliable) return false;
+  }
+  Detail::net_put16 (unreliable + unreliable_size, uint16_t (size));
+  memcpy (unreliable + unreliable_size + 2, data, size);
+  unreliable_size += 2 + size;
+  return true;
+}
+
+inline uint32_t NetConnection::write_packet (uint8_t *out, const uint64_t now)
+{
+  using namespace Detail;
+
+  /* 재전송 간격은 왕복 시간의 1.5 배, 너무 짧지 않게 */
+  const uint64_t rtt_ns = uint64_t (counters.rtt_ms * 1.5e6f);
+  const uint64_t resend = rtt_ns > MIN_RESEND_NS ? rtt_ns : MIN_RESEND_NS;
+
+  uint32_t size = HEADER_SIZE;
+  uint8_t count = 0;
+  SentPacket &record = sent[local_sequence % SENT_WINDOW];
+  uint16_t included[MAX_MESSAGES_PER_PACKET];
+
+  /* 신뢰 메시지 뒤에 비신뢰 메시지가 다 들어가도록 자리를 남김 */
+  const uint32_t reliable_budget = MAX_PACKET_SIZE - unreliable_size;
+  for (uint16_t id = oldest_unacked; id != next_message_id && count < MAX_MESSAGES_PER_PACKET; ++id)
+  {
+    Message &message = outgoing[id % MESSAGE_WINDOW];
+    if (!message.used || (message.last_sent && now - message.last_sent < resend)) continue;
+    if (size + 4 + message.size > reliable_budget) break;
+    net_put16 (out + size, id);
+    net_put16 (out + size + 2, message.size);
+    memcpy (out + size + 4, message.data, message.size);
+    size += 4 + message.size;
+    counters.messages_resent += message.last_sent != 0;
+    message.last_sent = now;
+    included[count++] = id;
+  }
+
+  if (unreliable_size)
+  {
+    memcpy (out + size, unreliable, unreliable_size);
+    size += unreliable_size;
+    unreliable_size = 0;
+    pool.free (unreliable);
+    unreliable = nullptr;
+  }
+
+  const bool keepalive = now - last_send_time >= KEEPALIVE_NS;
+  if (size == HEADER_SIZE && !ack_pending && !keepalive) return 0;
+
+  net_put16 (out, MAGIC);
+  net_put16 (out + 2, local_sequence);
+  net_put16 (out + 4, remote_sequence);
+  net_put32 (out + 6, received_bits);
+  out[10] = count;
+
+  if (record.used && !record.acked) ++counters.packets_lost;
+  record.time = now;
+  record.sequence = local_sequence;
+  record.used = true;
+  record.acked = false;
+  record.message_count = count;
+  memcpy (record.messages, included, sizeof (uint16_t) * count);
+
+  ++local_sequence;
+  ++counters.packets_sent;
+  ack_pending = false;
+  last_send_time = now;
+  return size;
+}
+
+inline void NetConnection::process_acks (const uint16_t ack, const uint32_t ack_bits, const uint64_t now)
+{
+  for (uint32_t i = 0; i <= 32; ++i)
+  {
+    if (i && !(ack_bits & (1u << (i - 1)))) continue;
+    const uint16_t sequence = uint16_t (ack - i);
+    SentPacket &record = sent[sequence % SENT_WINDOW];
+    if (!record.used || record.acked || record.sequence != sequence) continue;
+
+    record.acked = true;
+    ++counters.packets_acked;
+    const float sample = float (now - record.time) * 1e-6f;
+    counters.rtt_ms = counters.rtt_ms == 0.0f ? sample : counters.rtt_ms + (sample - counters.rtt_ms) * 0.1f;
+
+    for (uint32_t m = 0; m < record.message_count; ++m)
+    {
+      Message &message = outgoing[record.messages[m] % MESSAGE_WINDOW];
+      if (!message.used || message.id != record.messages[m]) continue;
+      pool.free (message.data);
+      message.used = false;
+    }
+  }
+  while (oldest_unacked != next_message_id && !outgoing[oldest_unacked % MESSAGE_WINDOW].used) ++oldest_unacked;
+}
+
+template <typename F>
+bool NetConnection::read_packet (const uint8_t *data, const uint32_t size, const uint64_t now, F &&on_message)
+{
+  using namespace Detail;
+
+  if (size < HEADER_SIZE || net_get16 (data) != MAGIC) return false;
+  const uint16_t sequence = net_get16 (data + 2);
+  const uint16_t ack = net_get16 (data + 4);
+  const uint32_t ack_bits = net_get32 (data + 6);
+  const uint8_t count = data[10];
+
+  /* 받은 순번 기록 (다음에 보낼 확인) */
+  if (!any_received || net_sequence_greater (sequence, remote_sequence))
+  {
+    const uint16_t shift = uint16_t (sequence - remote_sequence);
+    if (!any_received || shift > 32) received_bits = 0;
+    else received_bits = (shift == 32 ? 0 : received_bits << shift) | 1u << (shift - 1);
+    remote_sequence = sequence;
+    any_received = true;
+  }
+  else
+  {
+    const uint16_t behind = uint16_t (remote_sequence - sequence);
+    if (behind >= 1 && behind <= 32) received_bits |= 1u << (behind - 1);
+  }
+  ack_pending = true;
+  last_receive_time = now;
+  ++counters.packets_received;
+  process_acks (ack, ack_bits, now);
+
+  /* 신뢰 메시지: 다음 차례면 바로 전달하고 아니면 창 안에 보관 */
+  uint32_t offset = HEADER_SIZE;
+  for (uint8_t m = 0; m < count; ++m)
+  {
+    if (offset + 4 > size) return false;
+    const uint16_t id = net_get16 (data + offset), length = net_get16 (data + offset + 2);
+    if (offset + 4 + length > size) return false;
+    const uint8_t *payload = data + offset + 4;
+    offset += 4 + length;
+
+    const uint16_t ahead = uint16_t (id - next_delivery);
+    if (ahead >= MESSAGE_WINDOW) continue;    /* 이미 전달했거나 창 밖 */
+    if (ahead == 0)
+    {
+      on_message (payload, uint32_t (length), true);
+      ++next_delivery;
+      continue;
+    }
+    Message &slot = incoming[id % MESSAGE_WINDOW];
+    if (slot.used) continue;
+    uint8_t *block = copy (payload, length);
+    if (!block) continue;                     /* 풀이 비면 버리고 재전송을 기다림 */
+    slot = { block, 0, id, length, true };
+  }
+  for (Message *slot = &incoming[next_delivery % MESSAGE_WINDOW]; slot->used && slot->id == next_delivery;
+       slot = &incoming[next_delivery % MESSAGE_WINDOW])
+  {
+    on_message (static_cast <const uint8_t *> (slot->data), uint32_t (slot->size), true);
+    pool.free (slot->data);
+    slot->used = false;
+    ++next_delivery;
+  }
+
+  /* 비신뢰 메시지: 이미 더 새 패킷의 것을 전달했으면 통째로 버림 */
+  if (offset < size)
+  {
+    if (any_unreliable && !net_sequence_greater (sequence, last_unreliable))
+    {
+      ++counters.stale_dropped;
+      return true;
+    }
+    any_unreliable = true;
+    last_unreliable = sequence;
+    while (offset + 2 <= size)
+    {
+      const uint16_t length = net_get16 (data + offset);
+      if (offset + 2 + length > size) return false;
+      on_message (data + offset + 2, uint32_t (length), false);
+      offset += 2 + length;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include "Foundation/Heap/PoolAllocator.h"
+#include "Foundation/Math/Random.h"
+#include "Net/NetConnection.h"
+#include "Net/UdpSocket.h"
+
+/* 소켓 하나로 여러 연결을 다루는 끝점. 한 스레드에서 poll 과 flush 를 번갈아 부름.
+   받기는 풀에서 미리 잡아 둔 MAX_BATCH 개 블록으로 recvmmsg 한 번에 모아 받고,
+   보내기는 연결마다 패킷을 풀 블록에 만들어 모았다가 sendmmsg 한 번에 내보냄.
+   모르는 주소에서 온 올바른 패킷은 accept 가 켜져 있으면 새 연결로 받음 */
+class NetEndpoint
+{
+public:
+  static constexpr uint32_t INVALID = ~0u;
+  static constexpr uint32_t BLOCK_SIZE = 1536;
+  static constexpr uint64_t TIMEOUT_NS = 5000000000ull;
+  static constexpr uint32_t MAX_PACKETS_PER_FLUSH = 8;
+
+  /* max_packets 는 풀 블록 수: 받기 묶음, 보낼 패킷, 재전송을 기다리거나 순서를 기다리는 메시지가 모두 여기서 나옴 */
+  explicit NetEndpoint (uint32_t max_connections, uint32_t max_packets = 16384);
+  ~NetEndpoint ();
+
+  NetEndpoint (const NetEndpoint &) = delete;
+  NetEndpoint &operator= (const NetEndpoint &) = delete;
+
+  bool open (uint16_t port = 0, bool loopback_only = false) { return socket.open (port, loopback_only); }
+  uint16_t port () const { return socket.port (); }
+  void set_accept (bool enabled) { accept = enabled; }
+  /* 시험용: 받은 데이터그램을 probability 확률로 버림 */
+  void set_simulated_loss (float probability, uint64_t seed = 1);
+
+  /* 가득 차면 INVALID. 이미 있는 주소면 그 연결. now 는 아무것도 받지 못한 연결의 시간 초과 기준 */
+  uint32_t connect (const NetAddress &address, uint64_t now);
+  void disconnect (uint32_t id);
+  bool connected (uint32_t id) const { return id < max_connections && slots[id].active; }
+  const NetAddress &address (uint32_t id) const { return slots[id].address; }
+  const NetConnection &connection (uint32_t id) const { return *slots[id].connection; }
+  uint32_t connection_count () const { return active_count; }
+
+  /* 다음 flush 에 실림. 창이나 풀이 차면 false */
+  bool send (uint32_t id, const void *data, uint32_t size, bool reliable);
+
+  /* 받을 것이 없을 때까지 받아 on_message (id, data, size, reliable) 로 전달. 처리한 데이터그램 수 */
+  template <typename F>
+  size_t poll (uint64_t now, F &&on_message);
+  /* 연결마다 보낼 패킷을 만들어 내보냄. 보낸 데이터그램 수 */
+  size_t flush (uint64_t now);
+  /* timeout 동안 아무것도 받지 못한 연결을 끊음. 한 번도 받지 못했으면 연결을 만든 때부터 셈. 끊은 수 */
+  size_t expire (uint64_t now, uint64_t timeout = TIMEOUT_NS);
+
+  size_t packets_in_use () const { return pool.size (); }
+
+private:
+  struct Slot
+  {
+    NetConnection *connection;
+    NetAddress address;
+    uint64_t connected_at;
+    uint32_t active_index;
+    bool active;
+  };
+
+  static constexpr uint32_t EMPTY = ~0u;
+
+  uint32_t find (const NetAddress &address) const;
+  uint32_t bucket (const NetAddress &address) const;
+  size_t send_pending ();
+
+  UdpSocket socket;
+  PoolAllocator pool;
+  uint32_t max_connections;
+  Slot *slots;
+  uint32_t *active_ids;
+  uint32_t active_count = 0;
+  uint32_t *table;              /* 주소 → 연결. 선형 탐사 */
+  uint32_t table_mask;
+  bool accept = true;
+
+  float loss = 0.0f;
+  Xoshiro256 random;
+
+  NetDatagram receiving[UdpSocket::MAX_BATCH];
+  NetDatagram pending[UdpSocket::MAX_BATCH];
+  size_t pending_count = 0;
+};
+
+/* ============ 구현 ============ */
+inline NetEndpoint::NetEndpoint (const uint32_t max_connections, const uint32_t max_packets)
+  : pool (BLOCK_SIZE, max_packets), max_connections (max_connections)
+{
+  if (max_packets <= UdpSocket::MAX_BATCH * 2) abort ();
+  slots = static_cast <Slot *> (calloc (max_connections, sizeof (Slot)));
+  active_ids = static_cast <uint32_t *> (malloc (sizeof (uint32_t) * max_connections));
+  uint32_t table_size = 16;
+  while (table_size < max_connections * 2) table_size *= 2;
+  table = static_cast <uint32_t *> (malloc (sizeof (uint32_t) * table_size));
+  if (!slots || !active_ids || !table) abort ();
+  for (uint32_t i = 0; i < table_size; ++i) table[i] = EMPTY;
+  table_mask = table_size - 1;
+
+  for (NetDatagram &datagram : receiving) datagram.data = static_cast <uint8_t *> (pool.allocate ());
+}
+
+inline NetEndpoint::~NetEndpoint ()
+{
+  for (uint32_t i = 0; i < max_connections; ++i) delete slots[i].connection;
+  free (slots);
+  free (active_ids);
+  free (table);
+}
+
+inline void NetEndpoint::set_simulated_loss (const float probability, const uint64_t seed)
+{
+  loss = probability;
+  random = Xoshiro256 (seed);
+}
+
+inline uint32_t NetEndpoint::bucket (const NetAddress &address) const
+{
+  const uint64_t key = uint64_t (address.ip) << 16 | address.port;
+  return uint32_t ((key * 0x9e3779b97f4a7c15ull) >> 32) & table_mask;
+}
+
+inline uint32_t NetEndpoint::find (const NetAddress &address) const
+{
+  for (uint32_t i = bucket (address);; i = (i + 1) & table_mask)
+  {
+    const uint32_t id = table[i];
+    if (id == EMPTY) return INVALID;
+    if (slots[id].address == address) return id;
+  }
+}
+
+inline uint32_t NetEndpoint::connect (const NetAddress &address, const uint64_t now)
+{
+  const uint32_t existing = find (address);
+  if (existing != INVALID) return existing;
+  if (active_count == max_connections) return INVALID;
+
+  uint32_t id = 0;
+  while (slots[id].active) ++id;
+  Slot &slot = slots[id];
+  if (!slot.connection) slot.connection = new NetConnection (pool);
+  slot.address = address;
+  slot.connected_at = now;
+  slot.active = true;
+  slot.active_index = active_count;
+  active_ids[active_count++] = id;
+
+  uint32_t i = bucket (address);
+  while (table[i] != EMPTY) i = (i + 1) & table_mask;
+  table[i] = id;
+  return id;
+}
+
+inline void NetEndpoint::disconnect (const uint32_t id)
+{
+  if (!connected (id)) return;
+  Slot &slot = slots[id];
+  uint32_t hole = bucket (slot.address);
+  while (table[hole] != id) hole = (hole + 1) & table_mask;
+  /* 뒤따르는 항목을 당겨 빈칸 없이 탐사가 이어지게 함 (묘비를 남기지 않음) */
+  for (uint32_t i = (hole + 1) & table_mask; table[i] != EMPTY; i = (i + 1) & table_mask)
+  {
+    const uint32_t home = bucket (slots[table[i]].address);
+    if (((i - home) & table_mask) < ((i - hole) & table_mask)) continue;
+    table[hole] = table[i];
+    hole = i;
+  }
+  table[hole] = EMPTY;
+
+  const uint32_t last = active_ids[--active_count];
+  active_ids[slot.active_index] = last;
+  slots[last].active_index = slot.active_index;
+  slot.connection->reset ();
+  slot.active = false;
+}
+
+inline bool NetEndpoint::send (const uint32_t id, const void *data, const uint32_t size, const bool reliable)
+{
+  if (!connected (id)) return false;
+  NetConnection &connection = *slots[id].connection;
+  return reliable ? connection.queue_reliable (data, size) : connection.queue_unreliable (data, size);
+}
+
+template <typename F>
+size_t NetEndpoint::poll (const uint64_t now, F &&on_message)
+{
+  size_t total = 0;
+  for (;;)
+  {
+    const size_t received = socket.receive (receiving, UdpSocket::MAX_BATCH, BLOCK_SIZE);
+    for (size_t i = 0; i < received; ++i)
+    {
+      const NetDatagram &datagram = receiving[i];
+      if (datagram.size < NetConnection::HEADER_SIZE || Detail::net_get16 (datagram.data) != NetConnection::MAGIC) continue;
+      if (loss > 0.0f && random.next_float () < loss) continue;
+
+      uint32_t id = find (datagram.address);
+      if (id == INVALID)
+      {
+        if (!accept || (id = connect (datagram.address, now)) == INVALID) continue;
+      }
+      slots[id].connection->read_packet (datagram.data, datagram.size, now, [&] (const uint8_t *data, uint32_t size, bool reliable)
+      {
+        on_message (id, data, size, reliable);
+      });
+    }
+    total += received;
+    if (received < UdpSocket::MAX_BATCH) return total;
+  }
+}
+
+inline size_t NetEndpoint::send_pending ()
+{
+  const size_t sent = socket.send (pending, pending_count);
+  /* 커널 버퍼가 차서 못 보낸 것은 잃어버린 패킷과 같음: 신뢰 메시지는 재전송이 해결 */
+  for (size_t i = 0; i < pending_count; ++i) pool.free (pending[i].data);
+  pending_count = 0;
+  return sent;
+}
+
+inline size_t NetEndpoint::flush (const uint64_t now)
+{
+  size_t sent = 0;
+  for (uint32_t a = 0; a < active_count; ++a)
+  {
+    const Slot &slot = slots[active_ids[a]];
+    /* 밀린 신뢰 메시지가 많으면 연결 하나가 여러 패킷을 냄. 머리만 있는 패킷 (확인, 생존 신호) 이면 끝 */
+    for (uint32_t n = 0; n < MAX_PACKETS_PER_FLUSH; ++n)
+    {
+      uint8_t *block = static_cast <uint8_t *> (pool.allocate ());
+      if (!block) break;
+      const uint32_t size = slot.connection->write_packet (block, now);
+      if (!size)
+      {
+        pool.free (block);
+        break;
+      }
+      pending[pending_count++] = { slot.address, block, size };
+      if (pending_count == UdpSocket::MAX_BATCH) sent += send_pending ();
+      if (size == NetConnection::HEADER_SIZE) break;
+    }
+  }
+  if (pending_count) sent += send_pending ();
+  return sent;
+}
+
+inline size_t NetEndpoint::expire (const uint64_t now, const uint64_t timeout)
+{
+  size_t count = 0;
+  for (uint32_t a = active_count; a-- > 0;)
+  {
+    const uint32_t id = active_ids[a];
+    const uint64_t received = slots[id].connection->last_received ();
+    const uint64_t last = received ? received : slots[id].connected_at;
+    if (now - last > timeout)
+    {
+      disconnect (id);
+      ++count;
+    }
+  }
+  return count;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "Net/BitPacker.h"
+#include "Net/ReplicationSchema.h"
+
+/* 클라이언트 쪽 스냅숏 적용. 개체마다 최근 HISTORY 개 순번에 받은 상태를 두어
+   서버가 기준으로 고른 (확인된) 스냅숏의 상태를 찾아 차이를 되살림.
+   순서가 뒤바뀌어 온 스냅숏은 기록에만 남기고 현재 상태는 더 새 것을 유지함 */
+class ReplicationClient
+{
+public:
+  ReplicationClient (const ReplicationSchema &schema, uint32_t max_entities);
+  ~ReplicationClient ();
+
+  ReplicationClient (const ReplicationClient &) = delete;
+  ReplicationClient &operator= (const ReplicationClient &) = delete;
+
+  /* 스냅숏 하나를 적용하고 서버에 확인으로 돌려보낼 순번을 sequence 에 씀.
+     형식이 틀리거나 기준 상태가 없으면 아무것도 바꾸지 않고 false (확인하지 않음) */
+  bool read (const uint8_t *data, size_t size, uint16_t *sequence);
+
+  bool is_alive (uint32_t entity) const { return (flags[entity] & CURRENT_ALIVE) != 0; }
+  uint32_t value (uint32_t entity, uint32_t field) const { return current[entity * field_count + field]; }
+  float get_float (uint32_t entity, uint32_t field) const { return schema.dequantize (field, value (entity, field)); }
+
+private:
+  static constexpr uint8_t CURRENT = 1;
+  static constexpr uint8_t CURRENT_ALIVE = 2;
+  static constexpr uint8_t HISTORY_ALIVE = 1;
+
+  ReplicationSchema schema;
+  uint32_t field_count;
+  uint32_t max_entities;
+  uint32_t index_bits;
+
+  /* 순번은 받은 16 비트를 가장 최근 순번 근처로 넓힌 32 비트 */
+  uint32_t latest = 0;
+  bool any_received = false;
+
+  uint32_t *current;
+  uint32_t *current_sequence;
+  uint8_t *flags;
+
+  uint32_t *history;                  /* 개체 × HISTORY × 필드 수 */
+  uint32_t *history_sequence;
+  uint8_t *history_flags;
+
+  uint32_t *decoded_entities;         /* 적용 전 한 스냅숏을 풀어 둘 곳 */
+  uint32_t *decoded_states;
+};
+
+/* ============ 구현 ============ */
+inline ReplicationClient::ReplicationClient (const ReplicationSchema &schema, const uint32_t max_entities)
+  : schema (schema), field_count (schema.field_count), max_entities (max_entities), index_bits (bits_required (max_entities ? max_entities - 1 : 0))
+{
+  using namespace Detail;
+  constexpr uint32_t HISTORY = ReplicationSchema::HISTORY;
+  current = replication_allocate <uint32_t> (size_t (max_entities) * field_count);
+  current_sequence = replication_allocate <uint32_t> (max_entities);
+  flags = replication_allocate <uint8_t> (max_entities);
+  history = replication_allocate <uint32_t> (size_t (max_entities) * HISTORY * field_count);
+  history_sequence = replication_allocate <uint32_t> (size_t (max_entities) * HISTORY);
+  history_flags = replication_allocate <uint8_t> (size_t (max_entities) * HISTORY);
+  decoded_entities = replication_allocate <uint32_t> (ReplicationSchema::MAX_RECORDS);
+  decoded_states = replication_allocate <uint32_t> (size_t (ReplicationSchema::MAX_RECORDS) * field_count);
+}
+
+inline ReplicationClient::~ReplicationClient ()
+{
+  free (current);
+  free (current_sequence);
+  free (flags);
+  free (history);
+  free (history_sequence);
+  free (history_flags);
+  free (decoded_entities);
+  free (decoded_states);
+}
+
+inline bool ReplicationClient::read (const uint8_t *data, const size_t size, uint16_t *sequence)
+{
+  constexpr uint32_t HISTORY = ReplicationSchema::HISTORY;
+  constexpr uint32_t REMOVED = 0x80000000u;
+
+  BitReader reader (data, size);
+  const uint16_t wire = uint16_t (reader.read (16));
+  const uint32_t snapshot = any_received ? latest + uint32_t (int32_t (int16_t (uint16_t (wire - uint16_t (latest))))) : wire;
+
+  /* 먼저 모두 풀어 보고 실패하면 아무것도 바꾸지 않음 */
+  uint32_t count = 0;
+  while (reader.read_bool ())
+  {
+    const uint32_t entity = reader.read (index_bits);
+    if (reader.overflow () || entity >= max_entities || count == ReplicationSchema::MAX_RECORDS) return false;
+    uint32_t *out = decoded_states + size_t (count) * field_count;
+    if (reader.read_bool ())
+    {
+      decoded_entities[count++] = entity | REMOVED;
+      continue;
+    }
+
+    const uint32_t *base = nullptr;
+    if (reader.read_bool ())
+    {
+      const uint32_t base_sequence = snapshot - reader.read (ReplicationSchema::HISTORY_BITS);
+      const size_t slot = size_t (entity) * HISTORY + base_sequence % HISTORY;
+      if (!(history_flags[slot] & HISTORY_ALIVE) || history_sequence[slot] != base_sequence) return false;
+      base = history + slot * field_count;
+    }
+    for (uint32_t f = 0; f < field_count; ++f)
+      out[f] = base && !reader.read_bool () ? base[f] : reader.read (schema.fields[f].bits);
+    decoded_entities[count++] = entity;
+  }
+  if (reader.overflow ()) return false;
+
+  for (uint32_t r = 0; r < count; ++r)
+  {
+    const uint32_t entity = decoded_entities[r] & ~REMOVED;
+    const bool alive = !(decoded_entities[r] & REMOVED);
+    const uint32_t *values = decoded_states + size_t (r) * field_count;
+
+    const size_t slot = size_t (entity) * HISTORY + snapshot % HISTORY;
+    history_sequence[slot] = snapshot;
+    history_flags[slot] = alive ? HISTORY_ALIVE : 0;
+    if (alive) memcpy (history + slot * field_count, values, sizeof (uint32_t) * field_count);
+
+    /* 이미 더 새 스냅숏으로 갱신된 개체면 현재 상태는 그대로 */
+    if ((flags[entity] & CURRENT) && current_sequence[entity] > snapshot) continue;
+    current_sequence[entity] = snapshot;
+    flags[entity] = alive ? CURRENT | CURRENT_ALIVE : CURRENT;
+    if (alive) memcpy (current + size_t (entity) * field_count, values, sizeof (uint32_t) * field_count);
+  }
+  if (!any_received || snapshot > latest) latest = snapshot;
+  any_received = true;
+  *sequence = wire;
+  return true;
+}
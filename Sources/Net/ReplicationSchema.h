@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include "Net/BitPacker.h"
+
+/* 복제되는 개체 상태의 필드 목록. 상태는 필드마다 양자화된 uint32 값 하나로 저장되고 비교되며
+   선에는 필드의 비트 수만큼만 실림.
+   스냅숏 형식: 순번 16 비트, 레코드들, 끝 표시 0 비트 하나.
+   레코드: 계속 1, 개체 번호, 삭제 1 비트. 삭제가 아니면 기준 유무 1 비트 (있으면 순번 차이 HISTORY_BITS),
+   필드마다 기준이 있으면 바뀜 1 비트와 바뀐 값, 없으면 값 */
+struct ReplicationSchema
+{
+  static constexpr uint32_t MAX_FIELDS = 16;
+  static constexpr uint32_t HISTORY = 32;         /* 기준으로 쓸 수 있는 스냅숏 순번 범위 */
+  static constexpr uint32_t HISTORY_BITS = 5;
+  static constexpr uint32_t MAX_RECORDS = 256;     /* 스냅숏 하나에 실리는 최대 레코드 수 */
+
+  struct Field
+  {
+    float min;
+    float max;
+    uint32_t bits;
+    bool integer;
+  };
+
+  Field fields[MAX_FIELDS] = {};
+  uint32_t field_count = 0;
+
+  /* 추가된 필드 번호. 자리가 없으면 abort */
+  uint32_t add_float (float min, float max, uint32_t bits) { return add ({ min, max, bits, false }); }
+  uint32_t add_integer (uint32_t bits) { return add ({ 0.0f, 0.0f, bits, true }); }
+
+  uint32_t quantize (uint32_t field, float value) const { return quantize_float (value, fields[field].min, fields[field].max, fields[field].bits); }
+  float dequantize (uint32_t field, uint32_t value) const { return dequantize_float (value, fields[field].min, fields[field].max, fields[field].bits); }
+  /* 기준 없이 보낼 때 상태 하나의 비트 수 */
+  uint32_t state_bits () const;
+
+private:
+  uint32_t add (const Field &field);
+};
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  /* 0 으로 채운 배열. 실패하면 중단 */
+  template <typename T>
+  T *replication_allocate (const size_t count)
+  {
+    T *data = static_cast <T *> (calloc (count ? count : 1, sizeof (T)));
+    if (!data) abort ();
+    return data;
+  }
+}
+
+inline uint32_t ReplicationSchema::add (const Field &field)
+{
+  if (field_count == MAX_FIELDS || field.bits == 0 || field.bits > 32) abort ();
+  fields[field_count] = field;
+  return field_count++;
+}
+
+inline uint32_t ReplicationSchema::state_bits () const
+{
+  uint32_t bits = 0;
+  for (uint32_t f = 0; f < field_count; ++f) bits += fields[f].bits;
+  return bits;
+}
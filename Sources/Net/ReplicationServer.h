@@ -0,0 +1,369 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "Foundation/Thread/ParallelFor.h"
+#include "Foundation/Thread/ThreadPool.h"
+#include "Net/BitPacker.h"
+#include "Net/ReplicationSchema.h"
+
+/* 서버 쪽 스냅숏 복제. 게임 스레드가 개체 상태를 양자화해 한 번만 기록하면
+   update 가 클라이언트마다 워커 스레드에서 패킷 하나를 만듦.
+   클라이언트마다 확인받은 개체 상태 (기준) 를 두고 그와 다른 개체만 후보로 삼아,
+   시야 거리로 가중한 우선순위를 쌓아 높은 순서대로 패킷 예산이 찰 때까지 기준과의 차이만 실음.
+   보내지 못한 개체는 우선순위가 계속 쌓여 다음 스냅숏에서 앞으로 옴.
+   클라이언트가 스냅숏 순번을 확인해 오면 그 스냅숏에 실었던 상태가 새 기준이 됨 */
+class ReplicationServer
+{
+public:
+  ReplicationServer (const ReplicationSchema &schema, uint32_t max_entities, uint32_t max_clients, uint32_t packet_bytes = 1024);
+  ~ReplicationServer ();
+
+  ReplicationServer (const ReplicationServer &) = delete;
+  ReplicationServer &operator= (const ReplicationServer &) = delete;
+
+  /* 개체. update 사이에 게임 스레드에서 */
+  void spawn (uint32_t entity, float importance = 1.0f);
+  void despawn (uint32_t entity) { alive[entity] = 0; }
+  bool is_alive (uint32_t entity) const { return alive[entity] != 0; }
+  void set_float (uint32_t entity, uint32_t field, float value) { store (entity, field, schema.quantize (field, value)); }
+  void set_integer (uint32_t entity, uint32_t field, uint32_t value);
+  uint32_t value (uint32_t entity, uint32_t field) const { return state[entity * field_count + field]; }
+  /* 우선순위 계산에만 쓰는 위치 (복제할 필드와 별개) */
+  void set_position (uint32_t entity, float x, float y, float z);
+
+  /* 클라이언트 번호는 호출한 쪽이 정함 (보통 NetEndpoint 연결 번호) */
+  void add_client (uint32_t client);
+  void remove_client (uint32_t client);
+  void set_view (uint32_t client, float x, float y, float z, float radius);
+  void acknowledge (uint32_t client, uint16_t sequence);
+
+  /* 모든 클라이언트의 패킷을 만듦 */
+  void update (ThreadPool &pool);
+  void update_client (uint32_t client);
+
+  const uint8_t *packet (uint32_t client) const { return clients[client]->packet; }
+  uint32_t packet_size (uint32_t client) const { return clients[client]->packet_size; }
+  uint32_t records_sent (uint32_t client) const { return clients[client]->record_count; }
+
+private:
+  struct Candidate
+  {
+    float priority;
+    uint32_t entity;
+  };
+
+  /* 순번은 내부에서 32 비트로 세고 선에는 아래 16 비트만 실음 */
+  struct Snapshot
+  {
+    uint32_t sequence;
+    uint32_t count;
+    bool pending;
+  };
+
+  struct Client
+  {
+    float view[3];
+    float radius_sq;
+    uint32_t sequence;
+    uint32_t packet_size;
+    uint32_t record_count;
+
+    float *priority;
+    uint32_t *acked;                  /* 개체마다 확인받은 상태와 그 판 */
+    uint32_t *acked_version;
+    uint32_t *acked_sequence;
+    uint32_t *sent_sequence;          /* 개체를 마지막으로 실은 스냅숏 */
+    uint8_t *acked_flags;
+    Candidate *candidates;
+
+    Snapshot history[ReplicationSchema::HISTORY];
+    uint32_t *history_entities;       /* HISTORY × MAX_RECORDS. 위 비트는 삭제 표시 */
+    uint32_t *history_states;         /* HISTORY × MAX_RECORDS × 필드 수 */
+    uint32_t *history_versions;
+    uint8_t *packet;
+  };
+
+  static constexpr uint8_t ACKED = 1;           /* 확인받은 적 있음 (acked_sequence 가 유효) */
+  static constexpr uint8_t ACKED_ALIVE = 2;     /* 클라이언트가 acked 상태로 개체를 가지고 있음 */
+  static constexpr uint8_t SENT = 4;            /* 보낸 적 있음 (sent_sequence 가 유효) */
+  static constexpr uint32_t REMOVED = 0x80000000u;
+
+  /* 값이 실제로 바뀔 때만 판을 올려 기준과의 비교를 판 하나로 끝냄 */
+  void store (uint32_t entity, uint32_t field, uint32_t value);
+
+  ReplicationSchema schema;
+  uint32_t field_count;
+  uint32_t max_entities;
+  uint32_t max_clients;
+  uint32_t packet_bytes;
+  uint32_t index_bits;
+
+  uint32_t *state;
+  uint32_t *version;
+  float *positions;
+  float *importance;
+  uint8_t *alive;
+  Client **clients;
+};
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  /* 우선순위가 높은 순으로 앞 k 개만 정렬 (뒤쪽 순서는 정하지 않음). k 를 넘는 구간은 나누기만 하고 버리는 부분 퀵정렬 */
+  template <typename T>
+  void replication_sort_top (T *items, size_t begin, size_t end, const size_t k)
+  {
+    while (begin < k && end - begin > 16)
+    {
+      const float pivot = items[begin + (end - begin) / 2].priority;
+      size_t i = begin, j = end - 1;
+      for (;;)
+      {
+        while (items[i].priority > pivot) ++i;
+        while (items[j].priority < pivot) --j;
+        if (i >= j) break;
+        const T swap = items[i];
+        items[i++] = items[j];
+        items[j--] = swap;
+      }
+      /* [begin, j] 는 pivot 이상, [j + 1, end) 는 pivot 이하 */
+      replication_sort_top (items, begin, j + 1, k);
+      begin = j + 1;
+    }
+    if (begin >= k) return;
+    for (size_t i = begin + 1; i < end; ++i)
+    {
+      const T item = items[i];
+      size_t j = i;
+      for (; j > begin && items[j - 1].priority < item.priority; --j) items[j] = items[j - 1];
+      items[j] = item;
+    }
+  }
+}
+
+inline ReplicationServer::ReplicationServer (const ReplicationSchema &schema, const uint32_t max_entities, const uint32_t max_clients,
+                                             const uint32_t packet_bytes)
+  : schema (schema), field_count (schema.field_count), max_entities (max_entities), max_clients (max_clients), packet_bytes (packet_bytes),
+    index_bits (bits_required (max_entities ? max_entities - 1 : 0))
+{
+  using namespace Detail;
+  state = replication_allocate <uint32_t> (size_t (max_entities) * field_count);
+  version = replication_allocate <uint32_t> (max_entities);
+  positions = replication_allocate <float> (size_t (max_entities) * 3);
+  importance = replication_allocate <float> (max_entities);
+  alive = replication_allocate <uint8_t> (max_entities);
+  clients = replication_allocate <Client *> (max_clients);
+}
+
+inline ReplicationServer::~ReplicationServer ()
+{
+  for (uint32_t c = 0; c < max_clients; ++c) remove_client (c);
+  free (state);
+  free (version);
+  free (positions);
+  free (importance);
+  free (alive);
+  free (clients);
+}
+
+inline void ReplicationServer::spawn (const uint32_t entity, const float weight)
+{
+  alive[entity] = 1;
+  importance[entity] = weight;
+}
+
+inline void ReplicationServer::set_integer (const uint32_t entity, const uint32_t field, const uint32_t value)
+{
+  const uint32_t bits = schema.fields[field].bits;
+  store (entity, field, bits >= 32 ? value : value & ((1u << bits) - 1));
+}
+
+inline void ReplicationServer::store (const uint32_t entity, const uint32_t field, const uint32_t value)
+{
+  uint32_t &slot = state[entity * field_count + field];
+  if (slot == value) return;
+  slot = value;
+  ++version[entity];
+}
+
+inline void ReplicationServer::set_position (const uint32_t entity, const float x, const float y, const float z)
+{
+  positions[entity * 3] = x;
+  positions[entity * 3 + 1] = y;
+  positions[entity * 3 + 2] = z;
+}
+
+inline void ReplicationServer::add_client (const uint32_t client)
+{
+  using namespace Detail;
+  if (clients[client]) remove_client (client);
+
+  Client *c = replication_allocate <Client> (1);
+  c->radius_sq = 1.0f;
+  c->priority = replication_allocate <float> (max_entities);
+  c->acked = replication_allocate <uint32_t> (size_t (max_entities) * field_count);
+  c->acked_version = replication_allocate <uint32_t> (max_entities);
+  c->acked_sequence = replication_allocate <uint32_t> (max_entities);
+  c->sent_sequence = replication_allocate <uint32_t> (max_entities);
+  c->acked_flags = replication_allocate <uint8_t> (max_entities);
+  c->candidates = replication_allocate <Candidate> (max_entities);
+  c->history_entities = replication_allocate <uint32_t> (ReplicationSchema::HISTORY * ReplicationSchema::MAX_RECORDS);
+  c->history_states = replication_allocate <uint32_t> (size_t (ReplicationSchema::HISTORY) * ReplicationSchema::MAX_RECORDS * field_count);
+  c->history_versions = replication_allocate <uint32_t> (ReplicationSchema::HISTORY * ReplicationSchema::MAX_RECORDS);
+  c->packet = replication_allocate <uint8_t> (packet_bytes);
+  clients[client] = c;
+}
+
+inline void ReplicationServer::remove_client (const uint32_t client)
+{
+  Client *c = clients[client];
+  if (!c) return;
+  free (c->priority);
+  free (c->acked);
+  free (c->acked_version);
+  free (c->acked_sequence);
+  free (c->sent_sequence);
+  free (c->acked_flags);
+  free (c->candidates);
+  free (c->history_entities);
+  free (c->history_states);
+  free (c->history_versions);
+  free (c->packet);
+  free (c);
+  clients[client] = nullptr;
+}
+
+inline void ReplicationServer::set_view (const uint32_t client, const float x, const float y, const float z, const float radius)
+{
+  Client &c = *clients[client];
+  c.view[0] = x;
+  c.view[1] = y;
+  c.view[2] = z;
+  c.radius_sq = radius * radius;
+}
+
+inline void ReplicationServer::acknowledge (const uint32_t client, const uint16_t sequence)
+{
+  Client *c = clients[client];
+  if (!c) return;
+  Snapshot &snapshot = c->history[sequence % ReplicationSchema::HISTORY];
+  if (!snapshot.pending || uint16_t (snapshot.sequence) != sequence) return;
+  snapshot.pending = false;
+
+  const uint32_t slot = sequence % ReplicationSchema::HISTORY;
+  const uint32_t *entities = c->history_entities + slot * ReplicationSchema::MAX_RECORDS;
+  const uint32_t *states = c->history_states + size_t (slot) * ReplicationSchema::MAX_RECORDS * field_count;
+  for (uint32_t r = 0; r < snapshot.count; ++r)
+  {
+    const uint32_t entity = entities[r] & ~REMOVED;
+    /* 같은 개체를 실은 더 새 스냅숏이 먼저 확인됐으면 무시 */
+    if ((c->acked_flags[entity] & ACKED) && c->acked_sequence[entity] >= snapshot.sequence) continue;
+
+    c->acked_sequence[entity] = snapshot.sequence;
+    if (entities[r] & REMOVED)
+    {
+      c->acked_flags[entity] = (c->acked_flags[entity] & SENT) | ACKED;
+      continue;
+    }
+    c->acked_flags[entity] = (c->acked_flags[entity] & SENT) | ACKED | ACKED_ALIVE;
+    c->acked_version[entity] = c->history_versions[slot * ReplicationSchema::MAX_RECORDS + r];
+    memcpy (c->acked + size_t (entity) * field_count, states + size_t (r) * field_count, sizeof (uint32_t) * field_count);
+  }
+}
+
+inline void ReplicationServer::update (ThreadPool &pool)
+{
+  parallel_for (pool, max_clients, 1, [&] (const size_t begin, const size_t end)
+  {
+    for (size_t c = begin; c < end; ++c)
+      if (clients[c]) update_client (uint32_t (c));
+  });
+}
+
+inline void ReplicationServer::update_client (const uint32_t client)
+{
+  constexpr uint32_t HISTORY = ReplicationSchema::HISTORY;
+  Client &c = *clients[client];
+  const size_t state_bytes = sizeof (uint32_t) * field_count;
+
+  /* 기준과 다른 개체만 후보. 같더라도 기준 뒤에 보낸 것이 아직 확인되지 않았으면 클라이언트가 그것을
+     가지고 있을 수 있으므로 다시 보냄. 보낼 것이 없으면 우선순위도 쌓지 않음 */
+  uint32_t candidate_count = 0;
+  for (uint32_t e = 0; e < max_entities; ++e)
+  {
+    const uint8_t flags = c.acked_flags[e];
+    const bool known = flags & ACKED_ALIVE;
+    const bool in_flight = (flags & SENT) && (!(flags & ACKED) || c.sent_sequence[e] > c.acked_sequence[e]);
+    if (!in_flight && (alive[e] ? known && c.acked_version[e] == version[e] : !known))
+    {
+      c.priority[e] = 0.0f;
+      continue;
+    }
+    const float dx = positions[e * 3] - c.view[0], dy = positions[e * 3 + 1] - c.view[1], dz = positions[e * 3 + 2] - c.view[2];
+    c.priority[e] += importance[e] * c.radius_sq / (c.radius_sq + dx * dx + dy * dy + dz * dz);
+    c.candidates[candidate_count++] = { c.priority[e], e };
+  }
+  /* 한 스냅숏에 MAX_RECORDS 이상은 실리지 않으므로 그만큼만 정렬 */
+  Detail::replication_sort_top (c.candidates, 0, candidate_count, ReplicationSchema::MAX_RECORDS);
+  if (candidate_count > ReplicationSchema::MAX_RECORDS) candidate_count = ReplicationSchema::MAX_RECORDS;
+
+  const uint32_t sequence = c.sequence++;
+  const uint32_t slot = sequence % HISTORY;
+  Snapshot &snapshot = c.history[slot];
+  snapshot = { sequence, 0, true };
+  uint32_t *entities = c.history_entities + slot * ReplicationSchema::MAX_RECORDS;
+  uint32_t *states = c.history_states + size_t (slot) * ReplicationSchema::MAX_RECORDS * field_count;
+
+  /* 끝 표시 1 비트를 남겨 둠 */
+  BitWriter writer (c.packet, packet_bytes);
+  const size_t budget = size_t (packet_bytes) * 8 - 1;
+  writer.write (sequence & 0xffff, 16);
+  for (uint32_t i = 0; i < candidate_count && snapshot.count < ReplicationSchema::MAX_RECORDS; ++i)
+  {
+    const uint32_t e = c.candidates[i].entity;
+    const uint32_t *current = state + size_t (e) * field_count;
+    const BitWriter::Mark mark = writer.mark ();
+
+    writer.write_bool (true);
+    writer.write (e, index_bits);
+    writer.write_bool (!alive[e]);
+    if (alive[e])
+    {
+      const uint32_t offset = sequence - c.acked_sequence[e];
+      const bool has_base = (c.acked_flags[e] & ACKED_ALIVE) && offset < HISTORY;
+      const uint32_t *base = c.acked + size_t (e) * field_count;
+      writer.write_bool (has_base);
+      if (has_base) writer.write (offset, ReplicationSchema::HISTORY_BITS);
+      for (uint32_t f = 0; f < field_count; ++f)
+      {
+        if (has_base)
+        {
+          const bool changed = current[f] != base[f];
+          writer.write_bool (changed);
+          if (!changed) continue;
+        }
+        writer.write (current[f], schema.fields[f].bits);
+      }
+    }
+    if (writer.overflow () || writer.bits_written () > budget)
+    {
+      writer.rewind (mark);
+      break;
+    }
+
+    entities[snapshot.count] = alive[e] ? e : e | REMOVED;
+    memcpy (states + size_t (snapshot.count) * field_count, current, state_bytes);
+    c.history_versions[slot * ReplicationSchema::MAX_RECORDS + snapshot.count] = version[e];
+    ++snapshot.count;
+    c.sent_sequence[e] = sequence;
+    c.acked_flags[e] |= SENT;
+    c.priority[e] = 0.0f;
+  }
+  writer.write_bool (false);
+  c.packet_size = uint32_t (writer.flush ());
+  c.record_count = snapshot.count;
+}
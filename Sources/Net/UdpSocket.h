@@ -0,0 +1,237 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if _WIN32
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#pragma comment (lib, "Ws2_32.lib")
+#elif __APPLE__ || __linux__
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+/* IPv4 주소. ip 와 port 는 호스트 바이트 순서 */
+struct NetAddress
+{
+  uint32_t ip;
+  uint16_t port;
+
+  static NetAddress loopback (uint16_t port) { return { 0x7f000001u, port }; }
+  bool operator== (const NetAddress &other) const { return ip == other.ip && port == other.port; }
+};
+
+/* 보내거나 받은 데이터그램 하나. data 는 호출한 쪽 버퍼 (보통 패킷 풀 블록) */
+struct NetDatagram
+{
+  NetAddress address;
+  uint8_t *data;
+  uint32_t size;
+};
+
+/* 논블로킹 UDP 소켓. 리눅스에서는 recvmmsg / sendmmsg 로 시스템 호출 한 번에 여러 데이터그램을 주고받고
+   다른 플랫폼에서는 같은 인터페이스를 recvfrom / sendto 반복으로 흉내 냄 */
+class UdpSocket
+{
+public:
+  static constexpr uint32_t MAX_BATCH = 64;
+
+  UdpSocket () = default;
+  ~UdpSocket () { close (); }
+
+  UdpSocket (const UdpSocket &) = delete;
+  UdpSocket &operator= (const UdpSocket &) = delete;
+
+  /* port 가 0 이면 임의 포트. buffer_bytes 는 커널 송수신 버퍼 크기 요청 */
+  bool open (uint16_t port = 0, bool loopback_only = false, int buffer_bytes = 4 << 20);
+  void close ();
+  bool is_open () const { return handle != INVALID; }
+  uint16_t port () const { return bound_port; }
+
+  /* 각 datagrams[i].data 에 capacity 바이트 버퍼가 있어야 함. 받은 개수 (없으면 0) */
+  size_t receive (NetDatagram *datagrams, size_t count, uint32_t capacity);
+  /* 보낸 개수. 커널 버퍼가 차면 앞쪽 일부만 보낼 수 있음 */
+  size_t send (const NetDatagram *datagrams, size_t count);
+
+private:
+#if _WIN32
+  using Handle = SOCKET;
+  static constexpr Handle INVALID = INVALID_SOCKET;
+#else
+  using Handle = int;
+  static constexpr Handle INVALID = -1;
+#endif
+
+  Handle handle = INVALID;
+  uint16_t bound_port = 0;
+};
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  inline sockaddr_in net_sockaddr (const NetAddress &address)
+  {
+    sockaddr_in result;
+    memset (&result, 0, sizeof (result));
+    result.sin_family = AF_INET;
+    result.sin_addr.s_addr = htonl (address.ip);
+    result.sin_port = htons (address.port);
+    return result;
+  }
+
+  inline NetAddress net_address (const sockaddr_in &address)
+  {
+    return { ntohl (address.sin_addr.s_addr), ntohs (address.sin_port) };
+  }
+}
+
+inline bool UdpSocket::open (const uint16_t port, const bool loopback_only, const int buffer_bytes)
+{
+  close ();
+#if _WIN32
+  static const bool started = [] { WSADATA data; return WSAStartup (MAKEWORD (2, 2), &data) == 0; } ();
+  if (!started) return false;
+#endif
+
+  handle = socket (AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (handle == INVALID) return false;
+
+#if _WIN32
+  u_long non_blocking = 1;
+  bool ok = ioctlsocket (handle, FIONBIO, &non_blocking) == 0;
+#else
+  bool ok = fcntl (handle, F_SETFL, fcntl (handle, F_GETFL, 0) | O_NONBLOCK) == 0;
+#endif
+  setsockopt (handle, SOL_SOCKET, SO_RCVBUF, reinterpret_cast <const char *> (&buffer_bytes), sizeof (buffer_bytes));
+  setsockopt (handle, SOL_SOCKET, SO_SNDBUF, reinterpret_cast <const char *> (&buffer_bytes), sizeof (buffer_bytes));
+
+  sockaddr_in address = Detail::net_sockaddr ({ loopback_only ? 0x7f000001u : 0u, port });
+  ok = ok && bind (handle, reinterpret_cast <const sockaddr *> (&address), sizeof (address)) == 0;
+
+  socklen_t length = sizeof (address);
+  ok = ok && getsockname (handle, reinterpret_cast <sockaddr *> (&address), &length) == 0;
+  if (!ok)
+  {
+    close ();
+    return false;
+  }
+  bound_port = ntohs (address.sin_port);
+  return true;
+}
+
+inline void UdpSocket::close ()
+{
+  if (handle == INVALID) return;
+#if _WIN32
+  closesocket (handle);
+#else
+  ::close (handle);
+#endif
+  handle = INVALID;
+  bound_port = 0;
+}
+
+#if __linux__
+
+inline size_t UdpSocket::receive (NetDatagram *datagrams, const size_t count, const uint32_t capacity)
+{
+  mmsghdr headers[MAX_BATCH];
+  iovec vectors[MAX_BATCH];
+  sockaddr_in addresses[MAX_BATCH];
+
+  size_t total = 0;
+  while (total < count)
+  {
+    const size_t batch = count - total < MAX_BATCH ? count - total : MAX_BATCH;
+    for (size_t i = 0; i < batch; ++i)
+    {
+      vectors[i] = { datagrams[total + i].data, capacity };
+      memset (&headers[i], 0, sizeof (mmsghdr));
+      headers[i].msg_hdr.msg_name = &addresses[i];
+      headers[i].msg_hdr.msg_namelen = sizeof (sockaddr_in);
+      headers[i].msg_hdr.msg_iov = &vectors[i];
+      headers[i].msg_hdr.msg_iovlen = 1;
+    }
+    const int received = recvmmsg (handle, headers, unsigned (batch), MSG_DONTWAIT, nullptr);
+    if (received <= 0) break;
+    for (int i = 0; i < received; ++i)
+    {
+      NetDatagram &datagram = datagrams[total + size_t (i)];
+      datagram.address = Detail::net_address (addresses[i]);
+      /* 잘린 데이터그램은 버림 */
+      datagram.size = headers[i].msg_hdr.msg_flags & MSG_TRUNC ? 0 : headers[i].msg_len;
+    }
+    total += size_t (received);
+    if (size_t (received) < batch) break;
+  }
+  return total;
+}
+
+inline size_t UdpSocket::send (const NetDatagram *datagrams, const size_t count)
+{
+  mmsghdr headers[MAX_BATCH];
+  iovec vectors[MAX_BATCH];
+  sockaddr_in addresses[MAX_BATCH];
+
+  size_t total = 0;
+  while (total < count)
+  {
+    const size_t batch = count - total < MAX_BATCH ? count - total : MAX_BATCH;
+    for (size_t i = 0; i < batch; ++i)
+    {
+      const NetDatagram &datagram = datagrams[total + i];
+      addresses[i] = Detail::net_sockaddr (datagram.address);
+      vectors[i] = { datagram.data, datagram.size };
+      memset (&headers[i], 0, sizeof (mmsghdr));
+      headers[i].msg_hdr.msg_name = &addresses[i];
+      headers[i].msg_hdr.msg_namelen = sizeof (sockaddr_in);
+      headers[i].msg_hdr.msg_iov = &vectors[i];
+      headers[i].msg_hdr.msg_iovlen = 1;
+    }
+    const int sent = sendmmsg (handle, headers, unsigned (batch), MSG_DONTWAIT);
+    if (sent <= 0) break;
+    total += size_t (sent);
+    if (size_t (sent) < batch) break;
+  }
+  return total;
+}
+
+#else
+
+inline size_t UdpSocket::receive (NetDatagram *datagrams, const size_t count, const uint32_t capacity)
+{
+  size_t total = 0;
+  while (total < count)
+  {
+    sockaddr_in address;
+    socklen_t length = sizeof (address);
+    NetDatagram &datagram = datagrams[total];
+    const auto received = recvfrom (handle, reinterpret_cast <char *> (datagram.data), int (capacity), 0, reinterpret_cast <sockaddr *> (&address), &length);
+    if (received < 0) break;
+    datagram.address = Detail::net_address (address);
+    datagram.size = uint32_t (received);
+    ++total;
+  }
+  return total;
+}
+
+inline size_t UdpSocket::send (const NetDatagram *datagrams, const size_t count)
+{
+  size_t total = 0;
+  for (; total < count; ++total)
+  {
+    const NetDatagram &datagram = datagrams[total];
+    const sockaddr_in address = Detail::net_sockaddr (datagram.address);
+    if (sendto (handle, reinterpret_cast <const char *> (datagram.data), int (datagram.size), 0, reinterpret_cast <const sockaddr *> (&address),
+                sizeof (address)) < 0)
+      break;
+  }
+  return total;
+}
+
+#endif
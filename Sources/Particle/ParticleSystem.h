@@ -0,0 +1,225 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Foundation/Heap/VirtualArray.h"
+#include "Foundation/Math/Random.h"
+#include "Foundation/Math/Simd.h"
+#include "Foundation/Thread/ParallelFor.h"
+#include "Foundation/Thread/ThreadPool.h"
+
+/* 점 인력. 가속도 = strength * d / (|d|^2 + softening)^1.5 */
+struct ParticleAttractor
+{
+  float position[3];
+  float strength;
+  float softening = 1.0f;
+};
+
+struct ParticleForces
+{
+  float gravity[3] = { 0.0f, -9.8f, 0.0f };
+  float drag = 0.0f;
+  const ParticleAttractor *attractors = nullptr;
+  uint32_t attractor_count = 0;
+};
+
+/* position 주변 ±spread 상자 안에서, 속도와 수명은 각 범위에서 균등 분포로 생성 */
+struct ParticleEmitter
+{
+  float position[3];
+  float spread[3];
+  float velocity_min[3];
+  float velocity_max[3];
+  float life_min;
+  float life_max;
+};
+
+/* 위치/속도/수명을 축별 SoA 배열로 저장하는 CPU 파티클 시스템.
+   update 는 SIMD_WIDTH 단위로 적분하고 수명이 다한 파티클을 마지막 원소와 맞바꿔 제거하므로 순서는 유지되지 않음 */
+class ParticleSystem
+{
+public:
+  static constexpr size_t DEFAULT_CHUNK_SIZE = 16 << 10;
+
+  explicit ParticleSystem (size_t max_particles = 1 << 24);
+
+  ParticleSystem (const ParticleSystem &) = delete;
+  ParticleSystem &operator= (const ParticleSystem &) = delete;
+
+  /* 실제로 생성된 수를 반환. 최대 수를 넘는 만큼은 버림 */
+  size_t emit (const ParticleEmitter &emitter, size_t count, XoshiroWide &random);
+
+  void update (float dt, const ParticleForces &forces);
+  void update (ThreadPool &pool, float dt, const ParticleForces &forces, size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+  /* 수명이 0 이하인 파티클 제거. 제거한 수를 반환 */
+  size_t compact ();
+
+  const float *position (int axis) const { return positions[axis].data (); }
+  const float *velocity (int axis) const { return velocities[axis].data (); }
+  const float *life () const { return lives.data (); }
+
+  size_t size () const { return count; }
+  size_t capacity () const { return max_particles; }
+
+private:
+  void integrate (size_t begin, size_t end, float dt, const ParticleForces &forces);
+  void resize (size_t n);
+
+  VirtualArray <float> positions[3];
+  VirtualArray <float> velocities[3];
+  VirtualArray <float> lives;
+  size_t max_particles;
+  size_t count = 0;
+};
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  inline size_t simd_padded (const size_t n)
+  {
+    return (n + SIMD_WIDTH - 1) & ~(SIMD_WIDTH - 1);
+  }
+}
+
+inline ParticleSystem::ParticleSystem (const size_t max_particles)
+  : positions { VirtualArray <float> (Detail::simd_padded (max_particles)), VirtualArray <float> (Detail::simd_padded (max_particles)),
+                VirtualArray <float> (Detail::simd_padded (max_particles)) },
+    velocities { VirtualArray <float> (Detail::simd_padded (max_particles)), VirtualArray <float> (Detail::simd_padded (max_particles)),
+                 VirtualArray <float> (Detail::simd_padded (max_particles)) },
+    lives (Detail::simd_padded (max_particles)),
+    max_particles (max_particles)
+{
+}
+
+/* 마지막 SIMD 묶음이 배열 끝을 넘어 읽고 써도 되도록 항상 SIMD_WIDTH 배수까지 커밋 */
+inline void ParticleSystem::resize (const size_t n)
+{
+  const size_t padded = Detail::simd_padded (n);
+  for (auto &array : positions) array.resize (padded);
+  for (auto &array : velocities) array.resize (padded);
+  lives.resize (padded);
+  count = n;
+}
+
+inline size_t ParticleSystem::emit (const ParticleEmitter &emitter, size_t emit_count, XoshiroWide &random)
+{
+  if (emit_count > max_particles - count) emit_count = max_particles - count;
+  if (!emit_count) return 0;
+
+  const size_t first = count;
+  resize (count + emit_count);
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    random.fill (positions[axis].data () + first, emit_count,
+                 emitter.position[axis] - emitter.spread[axis], emitter.position[axis] + emitter.spread[axis]);
+    random.fill (velocities[axis].data () + first, emit_count, emitter.velocity_min[axis], emitter.velocity_max[axis]);
+  }
+  random.fill (lives.data () + first, emit_count, emitter.life_min, emitter.life_max);
+  return emit_count;
+}
+
+inline void ParticleSystem::integrate (const size_t begin, const size_t end, const float dt, const ParticleForces &forces)
+{
+  float *px = positions[0].data (), *py = positions[1].data (), *pz = positions[2].data ();
+  float *vx = velocities[0].data (), *vy = velocities[1].data (), *vz = velocities[2].data ();
+  float *life = lives.data ();
+
+  const SimdFloat step = Simd::splat (dt);
+  const SimdFloat damping = Simd::splat (-forces.drag);
+  const SimdFloat gx = Simd::splat (forces.gravity[0]);
+  const SimdFloat gy = Simd::splat (forces.gravity[1]);
+  const SimdFloat gz = Simd::splat (forces.gravity[2]);
+
+  for (size_t i = begin; i < end; i += SIMD_WIDTH)
+  {
+    SimdFloat x = Simd::load (px + i), y = Simd::load (py + i), z = Simd::load (pz + i);
+    SimdFloat u = Simd::load (vx + i), v = Simd::load (vy + i), w = Simd::load (vz + i);
+
+    SimdFloat ax = Simd::mul_add (u, damping, gx);
+    SimdFloat ay = Simd::mul_add (v, damping, gy);
+    SimdFloat az = Simd::mul_add (w, damping, gz);
+
+    for (uint32_t a = 0; a < forces.attractor_count; ++a)
+    {
+      const ParticleAttractor &attractor = forces.attractors[a];
+      const SimdFloat dx = Simd::splat (attractor.position[0]) - x;
+      const SimdFloat dy = Simd::splat (attractor.position[1]) - y;
+      const SimdFloat dz = Simd::splat (attractor.position[2]) - z;
+      const SimdFloat distance2 = Simd::mul_add (dx, dx, Simd::mul_add (dy, dy, Simd::mul_add (dz, dz, Simd::splat (attractor.softening))));
+      const SimdFloat distance = Simd::sqrt (distance2);
+      const SimdFloat scale = Simd::splat (attractor.strength) / (distance2 * distance);
+      ax = Simd::mul_add (dx, scale, ax);
+      ay = Simd::mul_add (dy, scale, ay);
+      az = Simd::mul_add (dz, scale, az);
+    }
+
+    u = Simd::mul_add (ax, step, u);
+    v = Simd::mul_add (ay, step, v);
+    w = Simd::mul_add (az, step, w);
+
+    Simd::store (vx + i, u);
+    Simd::store (vy + i, v);
+    Simd::store (vz + i, w);
+    Simd::store (px + i, Simd::mul_add (u, step, x));
+    Simd::store (py + i, Simd::mul_add (v, step, y));
+    Simd::store (pz + i, Simd::mul_add (w, step, z));
+    Simd::store (life + i, Simd::load (life + i) - step);
+  }
+}
+
+inline void ParticleSystem::update (const float dt, const ParticleForces &forces)
+{
+  integrate (0, count, dt, forces);
+  compact ();
+}
+
+inline void ParticleSystem::update (ThreadPool &pool, const float dt, const ParticleForces &forces, const size_t chunk_size)
+{
+  parallel_for (pool, count, Detail::simd_padded (chunk_size), [&] (const size_t begin, const size_t end)
+  {
+    integrate (begin, end, dt, forces);
+  });
+  compact ();
+}
+
+inline size_t ParticleSystem::compact ()
+{
+  float *arrays[7] = { positions[0].data (), positions[1].data (), positions[2].data (),
+                       velocities[0].data (), velocities[1].data (), velocities[2].data (), lives.data () };
+  const float *life = lives.data ();
+  const SimdFloat zero = Simd::zero ();
+
+  size_t alive = count;
+  size_t i = 0;
+  while (i < alive)
+  {
+    /* 살아 있는 묶음은 마스크 한 번으로 건너뜀 */
+    if (i + SIMD_WIDTH <= alive)
+    {
+      const uint32_t dead = Simd::mask_bits (Simd::less_equal (Simd::load (life + i), zero));
+      if (!dead)
+      {
+        i += SIMD_WIDTH;
+        continue;
+      }
+      i += __builtin_ctz (dead);
+    }
+    else if (life[i] > 0.0f)
+    {
+      ++i;
+      continue;
+    }
+
+    --alive;
+    for (float *array : arrays) array[i] = array[alive];
+  }
+
+  const size_t removed = count - alive;
+  resize (alive);
+  return removed;
+}
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "Foundation/Math/Simd.h"
+
+inline constexpr uint32_t STATIC_BODY = ~0u;
+
+/* 접촉점 하나. normal 은 a 에서 b 로 향하고 ra, rb 는 각 물체 중심에서 접촉점까지. a 또는 b 가 STATIC_BODY 일 수 있음 */
+struct Contact
+{
+  uint32_t a;
+  uint32_t b;
+  float normal[3];
+  float ra[3];
+  float rb[3];
+  float penetration;
+  float friction;
+  float normal_impulse;     /* 이전 프레임에서 이어받은 누적 충격량 (warm start) */
+  float tangent_impulse[2];
+};
+
+/* 같은 색 (서로 물체를 공유하지 않는) 접촉 SIMD_WIDTH 개를 레인별로 담은 묶음.
+   레인끼리 쓰는 속도가 겹치지 않으므로 모아 읽고 계산한 뒤 흩어 쓰면 됨. 빈 레인은 질량이 0 이라 아무 영향이 없음 */
+struct alignas (32) ContactBatch
+{
+  uint32_t a[SIMD_WIDTH];
+  uint32_t b[SIMD_WIDTH];
+  uint32_t contact[SIMD_WIDTH];
+  uint32_t count;
+
+  float normal[3][SIMD_WIDTH];
+  float tangent1[3][SIMD_WIDTH];
+  float tangent2[3][SIMD_WIDTH];
+  float ra[3][SIMD_WIDTH];
+  float rb[3][SIMD_WIDTH];
+  float inverse_mass_a[SIMD_WIDTH];
+  float inverse_mass_b[SIMD_WIDTH];
+  float inverse_inertia_a[SIMD_WIDTH];
+  float inverse_inertia_b[SIMD_WIDTH];
+  float normal_mass[SIMD_WIDTH];
+  float tangent_mass1[SIMD_WIDTH];
+  float tangent_mass2[SIMD_WIDTH];
+  float bias[SIMD_WIDTH];
+  float friction[SIMD_WIDTH];
+  float normal_impulse[SIMD_WIDTH];
+  float tangent_impulse1[SIMD_WIDTH];
+  float tangent_impulse2[SIMD_WIDTH];
+};
+
+/* 구 (球) 만 다루므로 관성은 스칼라 하나. 속도는 축마다 배열 하나 (SoA) */
+struct BodyState
+{
+  float *velocity[3];
+  float *angular[3];
+  const float *inverse_mass;
+  const float *inverse_inertia;
+};
+
+/* 접촉 하나를 묶음의 lane 에 채움. 유효 질량과 위치 보정 속도를 미리 계산 */
+void prepare_contact (ContactBatch &batch, uint32_t lane, const Contact &contact, uint32_t index, const BodyState &bodies, float inverse_dt,
+                      float baumgarte, float slop);
+/* 빈 레인 채우기 */
+void clear_lanes (ContactBatch &batch);
+/* 누적 충격량을 속도에 미리 적용 */
+void warm_start (const ContactBatch &batch, const BodyState &bodies);
+/* 순차 충격량 한 번. 마찰 두 축을 먼저, 그다음 법선 */
+void solve_batch (ContactBatch &batch, const BodyState &bodies);
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  struct SimdVector
+  {
+    SimdFloat x, y, z;
+  };
+
+  inline SimdVector load_vector (const float (*v)[SIMD_WIDTH]) { return { Simd::load (v[0]), Simd::load (v[1]), Simd::load (v[2]) }; }
+  inline SimdFloat vector_dot (const SimdVector &a, const SimdVector &b) { return Simd::mul_add (a.x, b.x, Simd::mul_add (a.y, b.y, a.z * b.z)); }
+  inline SimdVector vector_cross (const SimdVector &a, const SimdVector &b)
+  {
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+  }
+  inline SimdVector vector_scale (const SimdVector &v, SimdFloat s) { return { v.x * s, v.y * s, v.z * s }; }
+  inline SimdVector vector_add (const SimdVector &a, const SimdVector &b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+  inline SimdVector vector_sub (const SimdVector &a, const SimdVector &b) { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+
+  /* 레인별 물체 속도. 정적 물체와 빈 레인은 0 */
+  struct GatheredVelocity
+  {
+    alignas (32) float linear[3][SIMD_WIDTH];
+    alignas (32) float angular[3][SIMD_WIDTH];
+  };
+
+  inline void gather_velocity (GatheredVelocity &out, const uint32_t *index, const uint32_t count, const BodyState &bodies)
+  {
+    for (uint32_t lane = 0; lane < SIMD_WIDTH; ++lane)
+    {
+      const bool valid = lane < count && index[lane] != STATIC_BODY;
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        out.linear[axis][lane] = valid ? bodies.velocity[axis][index[lane]] : 0.0f;
+        out.angular[axis][lane] = valid ? bodies.angular[axis][index[lane]] : 0.0f;
+      }
+    }
+  }
+
+  inline void scatter_velocity (const GatheredVelocity &in, const uint32_t *index, const uint32_t count, const BodyState &bodies)
+  {
+    for (uint32_t lane = 0; lane < count; ++lane)
+    {
+      if (index[lane] == STATIC_BODY) continue;
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        bodies.velocity[axis][index[lane]] = in.linear[axis][lane];
+        bodies.angular[axis][index[lane]] = in.angular[axis][lane];
+      }
+    }
+  }
+
+  inline void store_vector (float (*out)[SIMD_WIDTH], const SimdVector &v)
+  {
+    Simd::store (out[0], v.x);
+    Simd::store (out[1], v.y);
+    Simd::store (out[2], v.z);
+  }
+
+  inline float cross_length_squared (const float *r, const float *n)
+  {
+    const float x = r[1] * n[2] - r[2] * n[1], y = r[2] * n[0] - r[0] * n[2], z = r[0] * n[1] - r[1] * n[0];
+    return x * x + y * y + z * z;
+  }
+
+  /* 속도 갱신: vA -= mA P, wA -= iA (rA x P), vB += mB P, wB += iB (rB x P) */
+  struct BatchBodies
+  {
+    SimdVector va, wa, vb, wb;
+    SimdFloat ma, ia, mb, ib;
+
+    void apply (const SimdVector &impulse, const SimdVector &ra, const SimdVector &rb)
+    {
+      va = vector_sub (va, vector_scale (impulse, ma));
+      wa = vector_sub (wa, vector_scale (vector_cross (ra, impulse), ia));
+      vb = vector_add (vb, vector_scale (impulse, mb));
+      wb = vector_add (wb, vector_scale (vector_cross (rb, impulse), ib));
+    }
+
+    SimdVector relative_velocity (const SimdVector &ra, const SimdVector &rb) const
+    {
+      return vector_sub (vector_add (vb, vector_cross (wb, rb)), vector_add (va, vector_cross (wa, ra)));
+    }
+  };
+}
+
+inline void prepare_contact (ContactBatch &batch, const uint32_t lane, const Contact &contact, const uint32_t index, const BodyState &bodies,
+                             const float inverse_dt, const float baumgarte, const float slop)
+{
+  const float ma = contact.a == STATIC_BODY ? 0.0f : bodies.inverse_mass[contact.a];
+  const float mb = contact.b == STATIC_BODY ? 0.0f : bodies.inverse_mass[contact.b];
+  const float ia = contact.a == STATIC_BODY ? 0.0f : bodies.inverse_inertia[contact.a];
+  const float ib = contact.b == STATIC_BODY ? 0.0f : bodies.inverse_inertia[contact.b];
+  const float *n = contact.normal;
+
+  /* 법선에 수직인 두 축 */
+  float t1[3];
+  if (n[0] > 0.57735f || n[0] < -0.57735f) { t1[0] = n[1]; t1[1] = -n[0]; t1[2] = 0.0f; }
+  else { t1[0] = 0.0f; t1[1] = n[2]; t1[2] = -n[1]; }
+  const float length = 1.0f / sqrtf (t1[0] * t1[0] + t1[1] * t1[1] + t1[2] * t1[2]);
+  for (float &value : t1) value *= length;
+  const float t2[3] = { n[1] * t1[2] - n[2] * t1[1], n[2] * t1[0] - n[0] * t1[2], n[0] * t1[1] - n[1] * t1[0] };
+
+  auto effective_mass = [&] (const float *axis)
+  {
+    const float k = ma + mb + ia * Detail::cross_length_squared (contact.ra, axis) + ib * Detail::cross_length_squared (contact.rb, axis);
+    return k > 0.0f ? 1.0f / k : 0.0f;
+  };
+
+  batch.a[lane] = contact.a;
+  batch.b[lane] = contact.b;
+  batch.contact[lane] = index;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    batch.normal[axis][lane] = n[axis];
+    batch.tangent1[axis][lane] = t1[axis];
+    batch.tangent2[axis][lane] = t2[axis];
+    batch.ra[axis][lane] = contact.ra[axis];
+    batch.rb[axis][lane] = contact.rb[axis];
+  }
+  batch.inverse_mass_a[lane] = ma;
+  batch.inverse_mass_b[lane] = mb;
+  batch.inverse_inertia_a[lane] = ia;
+  batch.inverse_inertia_b[lane] = ib;
+  batch.normal_mass[lane] = effective_mass (n);
+  batch.tangent_mass1[lane] = effective_mass (t1);
+  batch.tangent_mass2[lane] = effective_mass (t2);
+  /* 겹친 깊이 중 slop 을 넘는 부분만 baumgarte 비율로 밀어냄 */
+  const float depth = contact.penetration - slop;
+  batch.bias[lane] = depth > 0.0f ? -baumgarte * inverse_dt * depth : 0.0f;
+  batch.friction[lane] = contact.friction;
+  batch.normal_impulse[lane] = contact.normal_impulse;
+  batch.tangent_impulse1[lane] = contact.tangent_impulse[0];
+  batch.tangent_impulse2[lane] = contact.tangent_impulse[1];
+}
+
+inline void clear_lanes (ContactBatch &batch)
+{
+  for (uint32_t lane = batch.count; lane < SIMD_WIDTH; ++lane)
+  {
+    batch.a[lane] = STATIC_BODY;
+    batch.b[lane] = STATIC_BODY;
+    batch.contact[lane] = 0;
+    for (int axis = 0; axis < 3; ++axis)
+      batch.normal[axis][lane] = batch.tangent1[axis][lane] = batch.tangent2[axis][lane] = batch.ra[axis][lane] = batch.rb[axis][lane] = 0.0f;
+    batch.inverse_mass_a[lane] = batch.inverse_mass_b[lane] = batch.inverse_inertia_a[lane] = batch.inverse_inertia_b[lane] = 0.0f;
+    batch.normal_mass[lane] = batch.tangent_mass1[lane] = batch.tangent_mass2[lane] = batch.bias[lane] = batch.friction[lane] = 0.0f;
+    batch.normal_impulse[lane] = batch.tangent_impulse1[lane] = batch.tangent_impulse2[lane] = 0.0f;
+  }
+}
+
+inline void warm_start (const ContactBatch &batch, const BodyState &bodies)
+{
+  using namespace Detail;
+
+  GatheredVelocity a, b;
+  gather_velocity (a, batch.a, batch.count, bodies);
+  gather_velocity (b, batch.b, batch.count, bodies);
+  BatchBodies state = { load_vector (a.linear), load_vector (a.angular), load_vector (b.linear), load_vector (b.angular),
+                        Simd::load (batch.inverse_mass_a), Simd::load (batch.inverse_inertia_a),
+                        Simd::load (batch.inverse_mass_b), Simd::load (batch.inverse_inertia_b) };
+
+  const SimdVector normal = vector_scale (load_vector (batch.normal), Simd::load (batch.normal_impulse));
+  const SimdVector tangent1 = vector_scale (load_vector (batch.tangent1), Simd::load (batch.tangent_impulse1));
+  const SimdVector tangent2 = vector_scale (load_vector (batch.tangent2), Simd::load (batch.tangent_impulse2));
+  const SimdVector impulse = vector_add (normal, vector_add (tangent1, tangent2));
+  state.apply (impulse, load_vector (batch.ra), load_vector (batch.rb));
+
+  store_vector (a.linear, state.va);
+  store_vector (a.angular, state.wa);
+  store_vector (b.linear, state.vb);
+  store_vector (b.angular, state.wb);
+  scatter_velocity (a, batch.a, batch.count, bodies);
+  scatter_velocity (b, batch.b, batch.count, bodies);
+}
+
+inline void solve_batch (ContactBatch &batch, const BodyState &bodies)
+{
+  using namespace Detail;
+
+  GatheredVelocity a, b;
+  gather_velocity (a, batch.a, batch.count, bodies);
+  gather_velocity (b, batch.b, batch.count, bodies);
+  BatchBodies state = { load_vector (a.linear), load_vector (a.angular), load_vector (b.linear), load_vector (b.angular),
+                        Simd::load (batch.inverse_mass_a), Simd::load (batch.inverse_inertia_a),
+                        Simd::load (batch.inverse_mass_b), Simd::load (batch.inverse_inertia_b) };
+
+  const SimdVector ra = load_vector (batch.ra), rb = load_vector (batch.rb);
+  const SimdVector normal = load_vector (batch.normal);
+  SimdFloat normal_impulse = Simd::load (batch.normal_impulse);
+
+  /* 마찰: |λt| <= μ λn */
+  const SimdFloat max_friction = Simd::load (batch.friction) * normal_impulse;
+  const SimdFloat min_friction = Simd::zero () - max_friction;
+  auto solve_tangent = [&] (const SimdVector &axis, const float *mass, float *accumulated)
+  {
+    const SimdFloat speed = vector_dot (state.relative_velocity (ra, rb), axis);
+    const SimdFloat old_impulse = Simd::load (accumulated);
+    const SimdFloat new_impulse = Simd::min (Simd::max (old_impulse - Simd::load (mass) * speed, min_friction), max_friction);
+    Simd::store (accumulated, new_impulse);
+    state.apply (vector_scale (axis, new_impulse - old_impulse), ra, rb);
+  };
+  solve_tangent (load_vector (batch.tangent1), batch.tangent_mass1, batch.tangent_impulse1);
+  solve_tangent (load_vector (batch.tangent2), batch.tangent_mass2, batch.tangent_impulse2);
+
+  /* 법선: 누적 충격량은 0 이상 */
+  const SimdFloat speed = vector_dot (state.relative_velocity (ra, rb), normal);
+  const SimdFloat lambda = Simd::zero () - Simd::load (batch.normal_mass) * (speed + Simd::load (batch.bias));
+  const SimdFloat new_impulse = Simd::max (normal_impulse + lambda, Simd::zero ());
+  state.apply (vector_scale (normal, new_impulse - normal_impulse), ra, rb);
+  normal_impulse = new_impulse;
+  Simd::store (batch.normal_impulse, normal_impulse);
+
+  store_vector (a.linear, state.va);
+  store_vector (a.angular, state.wa);
+  store_vector (b.linear, state.vb);
+  store_vector (b.angular, state.wb);
+  scatter_velocity (a, batch.a, batch.count, bodies);
+  scatter_velocity (b, batch.b, batch.count, bodies);
+}
@@ -0,0 +1,709 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "Foundation/Heap/VirtualArray.h"
+#include "Foundation/Math/Simd.h"
+#include "Foundation/Thread/ParallelFor.h"
+#include "Foundation/Thread/ThreadPool.h"
+#include "Physics/ContactSolver.h"
+
+struct PhysicsSettings
+{
+  float gravity[3] = { 0.0f, -9.81f, 0.0f };
+  uint32_t iterations = 8;
+  float baumgarte = 0.2f;
+  float slop = 0.005f;
+  float friction = 0.5f;
+  float linear_damping = 0.05f;
+  float angular_damping = 0.05f;
+  float sleep_velocity = 0.05f;
+  float sleep_time = 0.5f;
+  uint32_t large_island = 256;      /* 접촉이 이보다 많은 섬은 색 단위로 묶음을 나눠 병렬 처리 */
+};
+
+/* dot (normal, p) = offset 인 무한 평면. 항상 정적 */
+struct PhysicsPlane
+{
+  float normal[3];
+  float offset;
+};
+
+/* 구 강체 월드. 물체 상태는 축별 SoA 배열이고 한 스텝은
+   속도 적분 -> 격자 광역 검사와 접촉 생성 -> 섬 분리 -> 섬마다 그래프 색칠과 SIMD 묶음 구성 -> 순차 충격량 -> 위치 적분 -> 수면 판정.
+   작은 섬은 섬 하나가 작업 하나이고, 큰 섬은 같은 색 묶음들을 parallel_for 로 나눔.
+   접촉 충격량은 물체 쌍을 키로 다음 프레임에 이어 씀 (warm start) */
+class PhysicsWorld
+{
+public:
+  static constexpr uint32_t MAX_PLANES = 16;
+  static constexpr uint32_t MAX_COLORS = 32;
+  static constexpr uint32_t CONTACTS_PER_BODY = 8;
+
+  explicit PhysicsWorld (uint32_t max_bodies, const PhysicsSettings &settings = {});
+  ~PhysicsWorld ();
+
+  PhysicsWorld (const PhysicsWorld &) = delete;
+  PhysicsWorld &operator= (const PhysicsWorld &) = delete;
+
+  /* mass 가 0 이면 정적 물체. 가득 차면 ~0u */
+  uint32_t add_sphere (const float *position, float radius, float mass);
+  void add_plane (const float *normal, float offset);
+  void set_velocity (uint32_t body, const float *linear, const float *angular);
+  void wake (uint32_t body);
+
+  void step (ThreadPool &pool, float dt);
+
+  const float *position (int axis) const { return column (POSITION + axis); }
+  /* x, y, z, w */
+  const float *orientation (int axis) const { return column (ORIENTATION + axis); }
+  const float *velocity (int axis) const { return column (VELOCITY + axis); }
+  float radius (uint32_t body) const { return column (RADIUS)[body]; }
+  bool sleeping (uint32_t body) const { return !awake[body]; }
+
+  uint32_t body_count () const { return count; }
+  uint32_t contact_count () const { return uint32_t (contacts.size ()); }
+  uint32_t island_count () const { return uint32_t (islands.size ()); }
+  uint32_t batch_count () const { return last_batch_count; }
+
+private:
+  enum Column
+  {
+    POSITION = 0,
+    ORIENTATION = 3,
+    VELOCITY = 7,
+    ANGULAR = 10,
+    INVERSE_MASS = 13,
+    INVERSE_INERTIA,
+    RADIUS,
+    MOTION,             /* 깨어 있는 동적 물체면 1, 아니면 0. 중력 적용 마스크 */
+    SLEEP_TIMER,
+    COLUMN_COUNT,
+  };
+
+  struct Island
+  {
+    uint32_t contact_begin;
+    uint32_t contact_count;
+    uint32_t body_begin;
+    uint32_t body_count;
+    uint32_t batch_begin;
+    uint32_t color_batches[MAX_COLORS + 2];   /* 색 c 의 묶음은 [color_batches[c], color_batches[c + 1]). 마지막 색은 색칠에 실패한 접촉 */
+  };
+
+  struct CachedImpulse
+  {
+    uint64_t key;
+    uint32_t frame;
+    float impulse[3];
+  };
+
+  float *column (int index) const { return columns + size_t (index) * stride; }
+  BodyState body_state () const;
+  bool active (uint32_t body) const { return awake[body] && column (INVERSE_MASS)[body] > 0.0f; }
+
+  void integrate_velocities (size_t begin, size_t end, float dt);
+  void integrate_positions (size_t begin, size_t end, float dt);
+  void find_contacts ();
+  void add_contact (uint32_t a, uint32_t b, uint64_t key, const float *normal, const float *point, float penetration);
+  void build_islands ();
+  void build_batches (Island &island, float inverse_dt);
+  void store_impulses (const Island &island);
+  void update_sleep (float dt);
+
+  uint32_t find_root (uint32_t body);
+  const float *cached_impulse (uint64_t key) const;
+  void cache_impulse (uint64_t key, const float *impulse);
+
+  PhysicsSettings settings;
+  uint32_t max_bodies;
+  uint32_t count = 0;
+  size_t stride;
+  float *columns;
+  uint8_t *awake;
+
+  PhysicsPlane planes[MAX_PLANES];
+  uint32_t plane_count = 0;
+  float max_radius = 0.0f;
+
+  /* 광역 검사 격자 */
+  int32_t *cells;
+  uint32_t *bucket_start;
+  uint32_t *bucket_bodies;
+  uint32_t bucket_mask = 0;
+
+  /* 섬 */
+  uint32_t *parent;
+  uint32_t *body_island;
+  uint64_t *color_mask;
+  VirtualArray <Contact> contacts;
+  VirtualArray <uint64_t> contact_keys;
+  VirtualArray <uint32_t> contact_order;
+  VirtualArray <uint8_t> contact_color;
+  VirtualArray <uint32_t> island_bodies;
+  VirtualArray <Island> islands;
+  VirtualArray <ContactBatch> batches;
+  uint32_t last_batch_count = 0;
+  float inverse_dt = 0.0f;
+
+  /* warm start 용 충격량. 두 표를 프레임마다 번갈아 씀 */
+  CachedImpulse *impulse_tables[2];
+  uint32_t impulse_mask;
+  uint32_t frame = 2;       /* 칸의 frame 이 0 이면 빈 칸. 첫 프레임의 이전 표 (frame 1) 도 비어 있도록 2 부터 */
+};
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  inline uint32_t physics_cell_hash (const int32_t x, const int32_t y, const int32_t z)
+  {
+    return (uint32_t (x) * 73856093u) ^ (uint32_t (y) * 19349663u) ^ (uint32_t (z) * 83492791u);
+  }
+
+  inline uint32_t physics_key_hash (const uint64_t key)
+  {
+    uint64_t x = key * 0x9e3779b97f4a7c15;
+    return uint32_t (x >> 32);
+  }
+}
+
+inline PhysicsWorld::PhysicsWorld (const uint32_t max_bodies, const PhysicsSettings &settings)
+  : settings (settings), max_bodies (max_bodies), stride ((size_t (max_bodies) + SIMD_WIDTH - 1) & ~(SIMD_WIDTH - 1)),
+    contacts (size_t (max_bodies) * CONTACTS_PER_BODY + 64), contact_keys (size_t (max_bodies) * CONTACTS_PER_BODY + 64),
+    contact_order (size_t (max_bodies) * CONTACTS_PER_BODY + 64), contact_color (size_t (max_bodies) * CONTACTS_PER_BODY + 64),
+    island_bodies (size_t (max_bodies) + 64), islands (size_t (max_bodies) + 64),
+    batches (size_t (max_bodies) * (CONTACTS_PER_BODY + MAX_COLORS + 1) + 64)
+{
+  const uint32_t table_size = std::bit_ceil (max_bodies * 2 + 16);
+  bucket_mask = table_size - 1;
+  impulse_mask = std::bit_ceil (max_bodies * CONTACTS_PER_BODY * 2 + 16) - 1;
+
+  columns = static_cast <float *> (calloc (stride * COLUMN_COUNT, sizeof (float)));
+  awake = static_cast <uint8_t *> (calloc (stride, 1));
+  cells = static_cast <int32_t *> (malloc (sizeof (int32_t) * 3 * stride));
+  bucket_start = static_cast <uint32_t *> (malloc (sizeof (uint32_t) * (table_size + 1)));
+  bucket_bodies = static_cast <uint32_t *> (malloc (sizeof (uint32_t) * stride));
+  parent = static_cast <uint32_t *> (malloc (sizeof (uint32_t) * stride));
+  body_island = static_cast <uint32_t *> (malloc (sizeof (uint32_t) * stride));
+  color_mask = static_cast <uint64_t *> (calloc (stride, sizeof (uint64_t)));
+  impulse_tables[0] = static_cast <CachedImpulse *> (calloc (size_t (impulse_mask) + 1, sizeof (CachedImpulse)));
+  impulse_tables[1] = static_cast <CachedImpulse *> (calloc (size_t (impulse_mask) + 1, sizeof (CachedImpulse)));
+  if (!columns || !awake || !cells || !bucket_start || !bucket_bodies || !parent || !body_island || !color_mask || !impulse_tables[0] ||
+      !impulse_tables[1])
+    abort ();
+}
+
+inline PhysicsWorld::~PhysicsWorld ()
+{
+  free (columns);
+  free (awake);
+  free (cells);
+  free (bucket_start);
+  free (bucket_bodies);
+  free (parent);
+  free (body_island);
+  free (color_mask);
+  free (impulse_tables[0]);
+  free (impulse_tables[1]);
+}
+
+inline uint32_t PhysicsWorld::add_sphere (const float *position, const float radius, const float mass)
+{
+  if (count == max_bodies) return ~0u;
+  const uint32_t body = count++;
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    column (POSITION + axis)[body] = position[axis];
+    column (ORIENTATION + axis)[body] = 0.0f;
+    column (VELOCITY + axis)[body] = 0.0f;
+    column (ANGULAR + axis)[body] = 0.0f;
+  }
+  column (ORIENTATION + 3)[body] = 1.0f;
+  column (INVERSE_MASS)[body] = mass > 0.0f ? 1.0f / mass : 0.0f;
+  /* 꽉 찬 구: I = 2/5 m r^2 */
+  column (INVERSE_INERTIA)[body] = mass > 0.0f ? 1.0f / (0.4f * mass * radius * radius) : 0.0f;
+  column (RADIUS)[body] = radius;
+  column (MOTION)[body] = mass > 0.0f ? 1.0f : 0.0f;
+  column (SLEEP_TIMER)[body] = 0.0f;
+  awake[body] = mass > 0.0f;
+  if (radius > max_radius) max_radius = radius;
+  return body;
+}
+
+inline void PhysicsWorld::add_plane (const float *normal, const float offset)
+{
+  if (plane_count == MAX_PLANES) abort ();
+  const float length = sqrtf (normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+  planes[plane_count++] = { { normal[0] / length, normal[1] / length, normal[2] / length }, offset };
+}
+
+inline void PhysicsWorld::set_velocity (const uint32_t body, const float *linear, const float *angular)
+{
+  if (column (INVERSE_MASS)[body] <= 0.0f) return;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    column (VELOCITY + axis)[body] = linear[axis];
+    column (ANGULAR + axis)[body] = angular[axis];
+  }
+  wake (body);
+}
+
+inline void PhysicsWorld::wake (const uint32_t body)
+{
+  if (column (INVERSE_MASS)[body] <= 0.0f) return;
+  awake[body] = 1;
+  column (MOTION)[body] = 1.0f;
+  column (SLEEP_TIMER)[body] = 0.0f;
+}
+
+inline BodyState PhysicsWorld::body_state () const
+{
+  return { { column (VELOCITY), column (VELOCITY + 1), column (VELOCITY + 2) }, { column (ANGULAR), column (ANGULAR + 1), column (ANGULAR + 2) },
+           column (INVERSE_MASS), column (INVERSE_INERTIA) };
+}
+
+inline void PhysicsWorld::integrate_velocities (const size_t begin, const size_t end, const float dt)
+{
+  const SimdFloat linear_damping = Simd::splat (1.0f / (1.0f + dt * settings.linear_damping));
+  const SimdFloat angular_damping = Simd::splat (1.0f / (1.0f + dt * settings.angular_damping));
+  const float *motion = column (MOTION);
+
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    float *v = column (VELOCITY + axis), *w = column (ANGULAR + axis);
+    const SimdFloat gravity = Simd::splat (settings.gravity[axis] * dt);
+    for (size_t i = begin; i < end; i += SIMD_WIDTH)
+    {
+      Simd::store (v + i, Simd::mul_add (gravity, Simd::load (motion + i), Simd::load (v + i)) * linear_damping);
+      Simd::store (w + i, Simd::load (w + i) * angular_damping);
+    }
+  }
+}
+
+inline void PhysicsWorld::integrate_positions (const size_t begin, const size_t end, const float dt)
+{
+  const SimdFloat step = Simd::splat (dt);
+  const SimdFloat half_step = Simd::splat (0.5f * dt);
+  float *p[3] = { column (POSITION), column (POSITION + 1), column (POSITION + 2) };
+  float *q[4] = { column (ORIENTATION), column (ORIENTATION + 1), column (ORIENTATION + 2), column (ORIENTATION + 3) };
+  const float *v[3] = { column (VELOCITY), column (VELOCITY + 1), column (VELOCITY + 2) };
+  const float *w[3] = { column (ANGULAR), column (ANGULAR + 1), column (ANGULAR + 2) };
+
+  for (size_t i = begin; i < end; i += SIMD_WIDTH)
+  {
+    for (int axis = 0; axis < 3; ++axis)
+      Simd::store (p[axis] + i, Simd::mul_add (Simd::load (v[axis] + i), step, Simd::load (p[axis] + i)));
+
+    /* q += dt/2 * (w, 0) * q 후 정규화 */
+    const SimdFloat wx = Simd::load (w[0] + i), wy = Simd::load (w[1] + i), wz = Simd::load (w[2] + i);
+    const SimdFloat qx = Simd::load (q[0] + i), qy = Simd::load (q[1] + i), qz = Simd::load (q[2] + i), qw = Simd::load (q[3] + i);
+    SimdFloat nx = qx + half_step * (wx * qw + wy * qz - wz * qy);
+    SimdFloat ny = qy + half_step * (wy * qw + wz * qx - wx * qz);
+    SimdFloat nz = qz + half_step * (wz * qw + wx * qy - wy * qx);
+    SimdFloat nw = qw - half_step * (wx * qx + wy * qy + wz * qz);
+    const SimdFloat length = Simd::sqrt (nx * nx + ny * ny + nz * nz + nw * nw);
+    const SimdFloat inverse = Simd::select (Simd::less (Simd::zero (), length), Simd::splat (1.0f) / length, Simd::zero ());
+    Simd::store (q[0] + i, nx * inverse);
+    Simd::store (q[1] + i, ny * inverse);
+    Simd::store (q[2] + i, nz * inverse);
+    Simd::store (q[3] + i, Simd::select (Simd::less (Simd::zero (), length), nw * inverse, Simd::splat (1.0f)));
+  }
+}
+
+inline const float *PhysicsWorld::cached_impulse (const uint64_t key) const
+{
+  const CachedImpulse *table = impulse_tables[(frame - 1) & 1];
+  for (uint32_t slot = Detail::physics_key_hash (key) & impulse_mask;; slot = (slot + 1) & impulse_mask)
+  {
+    const CachedImpulse &entry = table[slot];
+    if (entry.frame != frame - 1) return nullptr;
+    if (entry.key == key) return entry.impulse;
+  }
+}
+
+inline void PhysicsWorld::cache_impulse (const uint64_t key, const float *impulse)
+{
+  CachedImpulse *table = impulse_tables[frame & 1];
+  uint32_t slot = Detail::physics_key_hash (key) & impulse_mask;
+  while (table[slot].frame == frame) slot = (slot + 1) & impulse_mask;
+  table[slot] = { key, frame, { impulse[0], impulse[1], impulse[2] } };
+}
+
+inline void PhysicsWorld::add_contact (const uint32_t a, const uint32_t b, const uint64_t key, const float *normal, const float *point,
+                                       const float penetration)
+{
+  if (contacts.size () == contacts.capacity ()) return;
+
+  Contact contact;
+  contact.a = a != STATIC_BODY && column (INVERSE_MASS)[a] > 0.0f ? a : STATIC_BODY;
+  contact.b = b != STATIC_BODY && column (INVERSE_MASS)[b] > 0.0f ? b : STATIC_BODY;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    contact.normal[axis] = normal[axis];
+    contact.ra[axis] = point[axis] - (a == STATIC_BODY ? point[axis] : column (POSITION + axis)[a]);
+    contact.rb[axis] = point[axis] - (b == STATIC_BODY ? point[axis] : column (POSITION + axis)[b]);
+  }
+  contact.penetration = penetration;
+  contact.friction = settings.friction;
+
+  const float *previous = cached_impulse (key);
+  contact.normal_impulse = previous ? previous[0] : 0.0f;
+  contact.tangent_impulse[0] = previous ? previous[1] : 0.0f;
+  contact.tangent_impulse[1] = previous ? previous[2] : 0.0f;
+
+  contacts.push_back (contact);
+  contact_keys.push_back (key);
+}
+
+/* 구 중심을 격자 칸 하나에 넣고 (칸 크기 = 최대 지름) 주변 27 칸만 검사. 해시가 겹쳐도 칸 좌표를 비교해 같은 쌍을 두 번 보지 않음 */
+inline void PhysicsWorld::find_contacts ()
+{
+  contacts.clear ();
+  contact_keys.clear ();
+  if (!count) return;
+
+  const float cell_size = max_radius * 2.0f;
+  const float inverse_cell = 1.0f / cell_size;
+  const float *p[3] = { column (POSITION), column (POSITION + 1), column (POSITION + 2) };
+  const float *radius = column (RADIUS);
+
+  memset (bucket_start, 0, sizeof (uint32_t) * (size_t (bucket_mask) + 2));
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    int32_t *cell = cells + size_t (i) * 3;
+    for (int axis = 0; axis < 3; ++axis) cell[axis] = int32_t (floorf (p[axis][i] * inverse_cell));
+    ++bucket_start[(Detail::physics_cell_hash (cell[0], cell[1], cell[2]) & bucket_mask) + 1];
+  }
+  for (uint32_t b = 0; b <= bucket_mask; ++b) bucket_start[b + 1] += bucket_start[b];
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    const int32_t *cell = cells + size_t (i) * 3;
+    const uint32_t bucket = Detail::physics_cell_hash (cell[0], cell[1], cell[2]) & bucket_mask;
+    /* bucket_start[bucket] 을 채우면서 밀고 나중에 되돌림 */
+    bucket_bodies[bucket_start[bucket]++] = i;
+  }
+  for (uint32_t b = bucket_mask + 1; b > 0; --b) bucket_start[b] = bucket_start[b - 1];
+  bucket_start[0] = 0;
+
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    const bool i_active = active (i);
+    const int32_t *cell = cells + size_t (i) * 3;
+
+    for (int32_t dz = -1; dz <= 1; ++dz)
+      for (int32_t dy = -1; dy <= 1; ++dy)
+        for (int32_t dx = -1; dx <= 1; ++dx)
+        {
+          const int32_t cx = cell[0] + dx, cy = cell[1] + dy, cz = cell[2] + dz;
+          const uint32_t bucket = Detail::physics_cell_hash (cx, cy, cz) & bucket_mask;
+          for (uint32_t k = bucket_start[bucket]; k < bucket_start[bucket + 1]; ++k)
+          {
+            const uint32_t j = bucket_bodies[k];
+            if (j <= i) continue;
+            const int32_t *other = cells + size_t (j) * 3;
+            if (other[0] != cx || other[1] != cy || other[2] != cz) continue;
+
+            const bool j_active = active (j);
+            if (!i_active && !j_active) continue;
+
+            const float d[3] = { p[0][j] - p[0][i], p[1][j] - p[1][i], p[2][j] - p[2][i] };
+            const float distance_squared = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+            const float reach = radius[i] + radius[j];
+            if (distance_squared >= reach * reach) continue;
+
+            /* 깨어 있는 물체에 닿은 잠든 물체는 깨움 */
+            if (!i_active) wake (i);
+            if (!j_active) wake (j);
+
+            const float distance = sqrtf (distance_squared);
+            float normal[3] = { 0.0f, 1.0f, 0.0f };
+            if (distance > 1e-6f)
+              for (int axis = 0; axis < 3; ++axis) normal[axis] = d[axis] / distance;
+            const float penetration = reach - distance;
+            const float point[3] = { p[0][i] + normal[0] * (radius[i] - penetration * 0.5f), p[1][i] + normal[1] * (radius[i] - penetration * 0.5f),
+                                     p[2][i] + normal[2] * (radius[i] - penetration * 0.5f) };
+            add_contact (i, j, uint64_t (i) << 32 | j, normal, point, penetration);
+          }
+        }
+
+    if (!active (i)) continue;
+    for (uint32_t plane = 0; plane < plane_count; ++plane)
+    {
+      const float *n = planes[plane].normal;
+      const float distance = n[0] * p[0][i] + n[1] * p[1][i] + n[2] * p[2][i] - planes[plane].offset;
+      if (distance >= radius[i]) continue;
+      const float point[3] = { p[0][i] - n[0] * radius[i], p[1][i] - n[1] * radius[i], p[2][i] - n[2] * radius[i] };
+      add_contact (STATIC_BODY, i, (uint64_t (0xffff0000u | plane) << 32) | i, n, point, radius[i] - distance);
+    }
+  }
+}
+
+inline uint32_t PhysicsWorld::find_root (uint32_t body)
+{
+  while (parent[body] != body)
+  {
+    parent[body] = parent[parent[body]];
+    body = parent[body];
+  }
+  return body;
+}
+
+/* 동적 물체끼리의 접촉으로 합집합-찾기. 정적 물체는 섬을 잇지 않음. 접촉과 물체를 섬 순서로 계수 정렬 */
+inline void PhysicsWorld::build_islands ()
+{
+  islands.clear ();
+  for (uint32_t i = 0; i < count; ++i) parent[i] = i;
+
+  const uint32_t contact_count = uint32_t (contacts.size ());
+  for (uint32_t c = 0; c < contact_count; ++c)
+  {
+    const Contact &contact = contacts[c];
+    if (contact.a == STATIC_BODY || contact.b == STATIC_BODY) continue;
+    const uint32_t a = find_root (contact.a), b = find_root (contact.b);
+    if (a != b) parent[a < b ? b : a] = a < b ? a : b;
+  }
+
+  /* 깨어 있는 동적 물체마다 섬 번호. 뿌리 물체의 body_island 를 먼저 정함 */
+  for (uint32_t i = 0; i < count; ++i) body_island[i] = ~0u;
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    if (!active (i)) continue;
+    const uint32_t root = find_root (i);
+    if (body_island[root] == ~0u)
+    {
+      body_island[root] = uint32_t (islands.size ());
+      Island island = {};
+      islands.push_back (island);
+    }
+    body_island[i] = body_island[root];
+  }
+
+  const uint32_t island_count = uint32_t (islands.size ());
+  for (uint32_t c = 0; c < contact_count; ++c)
+  {
+    const Contact &contact = contacts[c];
+    ++islands[body_island[contact.a != STATIC_BODY ? contact.a : contact.b]].contact_count;
+  }
+  for (uint32_t i = 0; i < count; ++i)
+    if (body_island[i] != ~0u) ++islands[body_island[i]].body_count;
+
+  uint32_t contact_offset = 0, body_offset = 0, batch_offset = 0;
+  for (uint32_t n = 0; n < island_count; ++n)
+  {
+    Island &island = islands[n];
+    island.contact_begin = contact_offset;
+    island.body_begin = body_offset;
+    island.batch_begin = batch_offset;
+    contact_offset += island.contact_count;
+    body_offset += island.body_count;
+    /* 색마다 마지막 묶음이 덜 찰 수 있으므로 최악의 경우만큼 자리 확보 */
+    batch_offset += island.contact_count ? island.contact_count + MAX_COLORS + 1 : 0;
+    island.contact_count = 0;
+    island.body_count = 0;
+  }
+
+  contact_order.resize (contact_count);
+  contact_color.resize (contact_count);
+  island_bodies.resize (body_offset);
+  batches.resize (batch_offset);
+  for (uint32_t c = 0; c < contact_count; ++c)
+  {
+    const Contact &contact = contacts[c];
+    Island &island = islands[body_island[contact.a != STATIC_BODY ? contact.a : contact.b]];
+    contact_order[island.contact_begin + island.contact_count++] = c;
+  }
+  for (uint32_t i = 0; i < count; ++i)
+    if (body_island[i] != ~0u)
+    {
+      Island &island = islands[body_island[i]];
+      island_bodies[island.body_begin + island.body_count++] = i;
+    }
+}
+
+/* 탐욕 그래프 색칠. 접촉마다 두 물체가 아직 쓰지 않은 가장 작은 색을 고르고, MAX_COLORS 를 넘으면 마지막 (순차) 색으로.
+   같은 색 접촉을 SIMD_WIDTH 개씩 묶음으로 만듦. 순차 색은 묶음 하나에 접촉 하나 */
+inline void PhysicsWorld::build_batches (Island &island, const float inverse_dt)
+{
+  const BodyState bodies = body_state ();
+  const uint32_t *order = contact_order.data () + island.contact_begin;
+
+  for (uint32_t k = 0; k < island.contact_count; ++k)
+  {
+    const Contact &contact = contacts[order[k]];
+    if (contact.a != STATIC_BODY) color_mask[contact.a] = 0;
+    if (contact.b != STATIC_BODY) color_mask[contact.b] = 0;
+  }
+
+  uint32_t color_counts[MAX_COLORS + 1] = {};
+  for (uint32_t k = 0; k < island.contact_count; ++k)
+  {
+    const Contact &contact = contacts[order[k]];
+    const uint64_t used = (contact.a != STATIC_BODY ? color_mask[contact.a] : 0) | (contact.b != STATIC_BODY ? color_mask[contact.b] : 0);
+    uint32_t color = uint32_t (std::countr_one (used));
+    if (color >= MAX_COLORS) color = MAX_COLORS;
+    else
+    {
+      if (contact.a != STATIC_BODY) color_mask[contact.a] |= uint64_t (1) << color;
+      if (contact.b != STATIC_BODY) color_mask[contact.b] |= uint64_t (1) << color;
+    }
+    contact_color[order[k]] = uint8_t (color);
+    ++color_counts[color];
+  }
+
+  uint32_t batch = island.batch_begin;
+  for (uint32_t color = 0; color <= MAX_COLORS; ++color)
+  {
+    island.color_batches[color] = batch;
+    if (!color_counts[color]) continue;
+    const uint32_t width = color == MAX_COLORS ? 1 : SIMD_WIDTH;
+
+    ContactBatch *current = nullptr;
+    for (uint32_t k = 0; k < island.contact_count; ++k)
+    {
+      const uint32_t index = order[k];
+      if (contact_color[index] != color) continue;
+      if (!current || current->count == width)
+      {
+        if (current) clear_lanes (*current);
+        current = &batches[batch++];
+        current->count = 0;
+      }
+      prepare_contact (*current, current->count++, contacts[index], index, bodies, inverse_dt, settings.baumgarte, settings.slop);
+    }
+    clear_lanes (*current);
+  }
+  island.color_batches[MAX_COLORS + 1] = batch;
+}
+
+inline void PhysicsWorld::store_impulses (const Island &island)
+{
+  for (uint32_t b = island.color_batches[0]; b < island.color_batches[MAX_COLORS + 1]; ++b)
+  {
+    const ContactBatch &batch = batches[b];
+    for (uint32_t lane = 0; lane < batch.count; ++lane)
+    {
+      Contact &contact = contacts[batch.contact[lane]];
+      contact.normal_impulse = batch.normal_impulse[lane];
+      contact.tangent_impulse[0] = batch.tangent_impulse1[lane];
+      contact.tangent_impulse[1] = batch.tangent_impulse2[lane];
+    }
+  }
+}
+
+/* 섬의 모든 물체가 sleep_time 이상 느리게 움직였으면 섬 전체를 재움 */
+inline void PhysicsWorld::update_sleep (const float dt)
+{
+  const float threshold = settings.sleep_velocity * settings.sleep_velocity;
+  float *timer = column (SLEEP_TIMER);
+
+  for (uint32_t n = 0; n < islands.size (); ++n)
+  {
+    const Island &island = islands[n];
+    float min_timer = settings.sleep_time * 2.0f;
+    for (uint32_t k = 0; k < island.body_count; ++k)
+    {
+      const uint32_t body = island_bodies[island.body_begin + k];
+      float speed = 0.0f;
+      for (int axis = 0; axis < 3; ++axis)
+        speed += column (VELOCITY + axis)[body] * column (VELOCITY + axis)[body] + column (ANGULAR + axis)[body] * column (ANGULAR + axis)[body];
+      timer[body] = speed < threshold ? timer[body] + dt : 0.0f;
+      if (timer[body] < min_timer) min_timer = timer[body];
+    }
+    if (min_timer < settings.sleep_time) continue;
+
+    for (uint32_t k = 0; k < island.body_count; ++k)
+    {
+      const uint32_t body = island_bodies[island.body_begin + k];
+      awake[body] = 0;
+      column (MOTION)[body] = 0.0f;
+      for (int axis = 0; axis < 3; ++axis) column (VELOCITY + axis)[body] = column (ANGULAR + axis)[body] = 0.0f;
+    }
+  }
+}
+
+inline void PhysicsWorld::step (ThreadPool &pool, const float dt)
+{
+  if (dt <= 0.0f || !count) return;
+  inverse_dt = 1.0f / dt;
+  const size_t padded = (size_t (count) + SIMD_WIDTH - 1) & ~(SIMD_WIDTH - 1);
+  constexpr size_t BODY_CHUNK = 1024;
+
+  parallel_for (pool, padded / SIMD_WIDTH, BODY_CHUNK / SIMD_WIDTH, [&] (const size_t begin, const size_t end)
+  {
+    integrate_velocities (begin * SIMD_WIDTH, end * SIMD_WIDTH, dt);
+  });
+
+  find_contacts ();
+  build_islands ();
+
+  const BodyState bodies = body_state ();
+  const uint32_t island_count = uint32_t (islands.size ());
+  const uint32_t iterations = settings.iterations;
+
+  /* 작은 섬: 섬 하나를 작업 하나가 처음부터 끝까지 */
+  parallel_for (pool, island_count, 16, [&] (const size_t begin, const size_t end)
+  {
+    for (size_t n = begin; n < end; ++n)
+    {
+      Island &island = islands[n];
+      if (!island.contact_count || island.contact_count > settings.large_island) continue;
+      build_batches (island, inverse_dt);
+      const uint32_t first = island.color_batches[0], last = island.color_batches[MAX_COLORS + 1];
+      for (uint32_t b = first; b < last; ++b) warm_start (batches[b], bodies);
+      for (uint32_t iteration = 0; iteration < iterations; ++iteration)
+        for (uint32_t b = first; b < last; ++b) solve_batch (batches[b], bodies);
+      store_impulses (island);
+    }
+  });
+
+  /* 큰 섬: 같은 색 묶음끼리는 물체를 공유하지 않으므로 색마다 병렬 */
+  uint32_t batch_total = 0;
+  for (uint32_t n = 0; n < island_count; ++n)
+  {
+    Island &island = islands[n];
+    if (island.contact_count > settings.large_island)
+    {
+      build_batches (island, inverse_dt);
+      for (uint32_t b = island.color_batches[0]; b < island.color_batches[MAX_COLORS + 1]; ++b) warm_start (batches[b], bodies);
+
+      for (uint32_t iteration = 0; iteration < iterations; ++iteration)
+        for (uint32_t color = 0; color <= MAX_COLORS; ++color)
+        {
+          const uint32_t first = island.color_batches[color], last = island.color_batches[color + 1];
+          if (color == MAX_COLORS)
+          {
+            for (uint32_t b = first; b < last; ++b) solve_batch (batches[b], bodies);
+            continue;
+          }
+          parallel_for (pool, last - first, 8, [&] (const size_t begin, const size_t end)
+          {
+            for (size_t b = begin; b < end; ++b) solve_batch (batches[first + b], bodies);
+          });
+        }
+      store_impulses (island);
+    }
+    if (island.contact_count) batch_total += island.color_batches[MAX_COLORS + 1] - island.color_batches[0];
+  }
+  last_batch_count = batch_total;
+
+  for (uint32_t c = 0; c < contacts.size (); ++c)
+  {
+    const Contact &contact = contacts[c];
+    const float impulse[3] = { contact.normal_impulse, contact.tangent_impulse[0], contact.tangent_impulse[1] };
+    cache_impulse (contact_keys[c], impulse);
+  }
+  ++frame;
+
+  parallel_for (pool, padded / SIMD_WIDTH, BODY_CHUNK / SIMD_WIDTH, [&] (const size_t begin, const size_t end)
+  {
+    integrate_positions (begin * SIMD_WIDTH, end * SIMD_WIDTH, dt);
+  });
+
+  update_sleep (dt);
+}
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "Foundation/Heap/FrameArena.h"
+#include "Foundation/Heap/VirtualArray.h"
+#include "Foundation/Thread/ParallelFor.h"
+#include "Foundation/Thread/ThreadLocal.h"
+#include "Foundation/Thread/ThreadPool.h"
+#include "Render/RenderCommand.h"
+
+/* 흔한 키 배치. 위에서부터 레이어 4 비트, 반투명 1 비트, 나머지 59 비트는
+   불투명이면 재질 (상태 변경 최소화) 다음 가까운 순 깊이, 반투명이면 먼 순 깊이 다음 재질.
+   depth 는 [0, 1] */
+uint64_t render_sort_key (uint32_t layer, bool translucent, float depth, uint32_t material);
+
+struct CommandPacket
+{
+  uint64_t key;
+  RenderDraw draw;
+};
+
+/* 여러 스레드가 정렬 키와 함께 그리기 패킷을 쌓고, 프레임 끝에 키 순으로 정렬해 명령 스트림에 차례로 넣는 버킷.
+   패킷은 호출한 스레드 전용 FrameArena 에 이어 붙으므로 add 에는 잠금도 원자 연산도 없음.
+   정렬은 8 비트씩 최대 8 번의 병렬 LSD 기수 정렬이고 모든 키가 같은 자리는 건너뜀. 같은 키 사이의 순서는 스레드별 추가 순서 */
+class CommandBucket
+{
+public:
+  static constexpr uint32_t SORT_BLOCK = 16384;
+  static constexpr uint32_t MAX_SORT_BLOCKS = 64;
+
+  /* arena_size 는 스레드 하나가 한 프레임에 쓸 수 있는 패킷 메모리 */
+  explicit CommandBucket (size_t max_packets, size_t arena_size = 16 << 20);
+  ~CommandBucket ();
+
+  CommandBucket (const CommandBucket &) = delete;
+  CommandBucket &operator= (const CommandBucket &) = delete;
+
+  /* ThreadLocal 에 붙은 스레드라면 어디서나 호출. 자리가 없으면 false */
+  bool add (uint64_t key, const RenderMesh &mesh, const float *world, uint32_t color, bool cull_back = true);
+
+  /* 아래는 모든 add 가 끝난 뒤 한 스레드에서 */
+  void sort (ThreadPool &pool);
+  void submit (RenderCommandStream &stream) const;
+  void reset ();
+
+  size_t size () const { return sorted_count; }
+  const CommandPacket *packet (size_t index) const { return sorted[index].packet; }
+  uint64_t key (size_t index) const { return sorted[index].key; }
+
+private:
+  struct Entry
+  {
+    uint64_t key;
+    const CommandPacket *packet;
+  };
+
+  struct ThreadBucket
+  {
+    explicit ThreadBucket (size_t arena_size) : arena (arena_size) {}
+
+    FrameArena arena;
+    CommandPacket *first = nullptr;   /* 한 스레드만 할당하므로 패킷은 first 부터 연속 */
+    uint32_t count = 0;
+  };
+
+  ThreadBucket &local ();
+  void radix_pass (ThreadPool &pool, const Entry *source, Entry *target, uint32_t shift, uint32_t block_count);
+
+  ThreadBucket *threads[ThreadLocal::MAX_THREADS] = {};
+  size_t arena_size;
+  VirtualArray <Entry> entries;
+  VirtualArray <Entry> scratch;
+  uint32_t (*histograms)[256];
+  const Entry *sorted = nullptr;    /* entries 또는 scratch */
+  size_t sorted_count = 0;
+};
+
+/* ============ 구현 ============ */
+inline uint64_t render_sort_key (const uint32_t layer, const bool translucent, const float depth, const uint32_t material)
+{
+  const float clamped = depth < 0.0f ? 0.0f : depth > 1.0f ? 1.0f : depth;
+  const uint64_t quantized = uint64_t (clamped * float ((1 << 24) - 1));
+  uint64_t key = uint64_t (layer & 0xf) << 60 | uint64_t (translucent) << 59;
+  if (translucent) key |= (0xffffff - quantized) << 35 | (material & 0x7ffffffu) << 8;
+  else key |= uint64_t (material & 0x7ffffffu) << 32 | quantized << 8;
+  return key;
+}
+
+inline CommandBucket::CommandBucket (const size_t max_packets, const size_t arena_size)
+  : arena_size (arena_size), entries (max_packets), scratch (max_packets)
+{
+  histograms = static_cast <uint32_t (*)[256]> (malloc (sizeof (uint32_t) * 256 * MAX_SORT_BLOCKS));
+  if (!histograms) abort ();
+}
+
+inline CommandBucket::~CommandBucket ()
+{
+  for (ThreadBucket *bucket : threads) delete bucket;
+  free (histograms);
+}
+
+inline CommandBucket::ThreadBucket &CommandBucket::local ()
+{
+  ThreadBucket *&bucket = threads[ThreadLocal::index ()];
+  if (!bucket) bucket = new ThreadBucket (arena_size);
+  return *bucket;
+}
+
+inline bool CommandBucket::add (const uint64_t key, const RenderMesh &mesh, const float *world, const uint32_t color, const bool cull_back)
+{
+  ThreadBucket &bucket = local ();
+  CommandPacket *packet = bucket.arena.allocate <CommandPacket> (1);
+  if (!packet) return false;
+  if (!bucket.first) bucket.first = packet;
+  ++bucket.count;
+
+  packet->key = key;
+  packet->draw.mesh = &mesh;
+  memcpy (packet->draw.world, world, sizeof (packet->draw.world));
+  packet->draw.color = color;
+  packet->draw.cull_back = cull_back;
+  return true;
+}
+
+inline void CommandBucket::reset ()
+{
+  for (ThreadBucket *bucket : threads)
+  {
+    if (!bucket) continue;
+    bucket->arena.reset ();
+    bucket->first = nullptr;
+    bucket->count = 0;
+  }
+  entries.clear ();
+  scratch.clear ();
+  sorted = nullptr;
+  sorted_count = 0;
+}
+
+/* 블록마다 이 자리의 히스토그램 -> (자리값, 블록) 순으로 시작 위치 -> 블록마다 안정적으로 흩뿌림 */
+inline void CommandBucket::radix_pass (ThreadPool &pool, const Entry *source, Entry *target, const uint32_t shift, const uint32_t block_count)
+{
+  const size_t count = sorted_count;
+
+  parallel_for (pool, block_count, 1, [&] (const size_t begin, const size_t end)
+  {
+    for (size_t block = begin; block < end; ++block)
+    {
+      uint32_t *histogram = histograms[block];
+      memset (histogram, 0, sizeof (uint32_t) * 256);
+      const size_t first = count * block / block_count, last = count * (block + 1) / block_count;
+      for (size_t i = first; i < last; ++i) ++histogram[(source[i].key >> shift) & 0xff];
+    }
+  });
+
+  uint32_t offset = 0;
+  for (uint32_t digit = 0; digit < 256; ++digit)
+    for (uint32_t block = 0; block < block_count; ++block)
+    {
+      const uint32_t n = histograms[block][digit];
+      histograms[block][digit] = offset;
+      offset += n;
+    }
+
+  parallel_for (pool, block_count, 1, [&] (const size_t begin, const size_t end)
+  {
+    for (size_t block = begin; block < end; ++block)
+    {
+      uint32_t *histogram = histograms[block];
+      const size_t first = count * block / block_count, last = count * (block + 1) / block_count;
+      for (size_t i = first; i < last; ++i) target[histogram[(source[i].key >> shift) & 0xff]++] = source[i];
+    }
+  });
+}
+
+inline void CommandBucket::sort (ThreadPool &pool)
+{
+  ThreadBucket *active[ThreadLocal::MAX_THREADS];
+  size_t offsets[ThreadLocal::MAX_THREADS];
+  uint64_t differences[ThreadLocal::MAX_THREADS];
+  uint32_t active_count = 0;
+  size_t total = 0;
+  for (ThreadBucket *bucket : threads)
+  {
+    if (!bucket || !bucket->count) continue;
+    offsets[active_count] = total;
+    active[active_count++] = bucket;
+    total += bucket->count;
+  }
+  if (total > entries.capacity ()) abort ();
+
+  entries.resize (total);
+  scratch.resize (total);
+  sorted = entries.data ();
+  sorted_count = total;
+  if (!total) return;
+
+  /* 스레드 번호 순으로 모으면서 첫 키와 다른 비트를 모음. 그 비트가 하나도 없는 자리는 모든 키가 같으므로 건너뜀 */
+  const uint64_t reference = active[0]->first->key;
+  parallel_for (pool, active_count, 1, [&] (const size_t begin, const size_t end)
+  {
+    for (size_t n = begin; n < end; ++n)
+    {
+      const ThreadBucket &bucket = *active[n];
+      Entry *out = entries.data () + offsets[n];
+      uint64_t difference = 0;
+      for (uint32_t i = 0; i < bucket.count; ++i)
+      {
+        const CommandPacket *packet = bucket.first + i;
+        out[i] = { packet->key, packet };
+        difference |= packet->key ^ reference;
+      }
+      differences[n] = difference;
+    }
+  });
+
+  uint64_t difference = 0;
+  for (uint32_t n = 0; n < active_count; ++n) difference |= differences[n];
+
+  uint32_t block_count = uint32_t ((total + SORT_BLOCK - 1) / SORT_BLOCK);
+  if (block_count > MAX_SORT_BLOCKS) block_count = MAX_SORT_BLOCKS;
+
+  Entry *source = entries.data (), *target = scratch.data ();
+  for (uint32_t shift = 0; shift < 64; shift += 8)
+  {
+    if (!((difference >> shift) & 0xff)) continue;
+    radix_pass (pool, source, target, shift, block_count);
+    Entry *swap = source;
+    source = target;
+    target = swap;
+  }
+  sorted = source;
+}
+
+inline void CommandBucket::submit (RenderCommandStream &stream) const
+{
+  for (size_t i = 0; i < sorted_count; ++i)
+  {
+    const RenderDraw &draw = sorted[i].packet->draw;
+    stream.draw (*draw.mesh, draw.world, draw.color, draw.cull_back);
+  }
+}
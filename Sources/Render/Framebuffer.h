@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Foundation/Heap/OSAllocator.h"
+
+/* 소프트웨어 래스터라이저의 출력. 색 (0xAABBGGRR), 깊이, 8x8 블록마다 최대 깊이 (계층 Z) 를
+   한 번 예약한 가상 메모리에 이어 붙임. 가로와 세로는 블록 단위로 올림해 블록이 밖으로 나가지 않음 */
+class Framebuffer
+{
+public:
+  static constexpr uint32_t BLOCK_SIZE = 8;
+  static constexpr uint32_t MAX_SIZE = 4096;
+
+  Framebuffer (uint32_t width, uint32_t height);
+
+  Framebuffer (const Framebuffer &) = delete;
+  Framebuffer &operator= (const Framebuffer &) = delete;
+
+  uint32_t width () const { return width_; }
+  uint32_t height () const { return height_; }
+  /* 행 간격 (픽셀) */
+  uint32_t stride () const { return stride_; }
+  uint32_t block_stride () const { return stride_ / BLOCK_SIZE; }
+
+  uint32_t *color () const { return color_; }
+  float *depth () const { return depth_; }
+  float *block_depth () const { return block_depth_; }
+
+  /* 헤드리스 캡처용. 알파는 버림 */
+  bool write_ppm (const char *path) const;
+
+private:
+  uint32_t width_;
+  uint32_t height_;
+  uint32_t stride_;
+  uint32_t padded_height;
+  OSAllocator memory;
+  uint32_t *color_;
+  float *depth_;
+  float *block_depth_;
+};
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  inline size_t framebuffer_bytes (const uint32_t width, const uint32_t height)
+  {
+    const size_t stride = (width + Framebuffer::BLOCK_SIZE - 1) & ~size_t (Framebuffer::BLOCK_SIZE - 1);
+    const size_t rows = (height + Framebuffer::BLOCK_SIZE - 1) & ~size_t (Framebuffer::BLOCK_SIZE - 1);
+    return stride * rows * (sizeof (uint32_t) + sizeof (float)) + stride * rows / (Framebuffer::BLOCK_SIZE * Framebuffer::BLOCK_SIZE) * sizeof (float);
+  }
+}
+
+inline Framebuffer::Framebuffer (const uint32_t width, const uint32_t height)
+  : width_ (width), height_ (height),
+    stride_ ((width + BLOCK_SIZE - 1) & ~(BLOCK_SIZE - 1)),
+    padded_height ((height + BLOCK_SIZE - 1) & ~(BLOCK_SIZE - 1)),
+    memory (Detail::framebuffer_bytes (width, height))
+{
+  if (!width || !height || width > MAX_SIZE || height > MAX_SIZE) abort ();
+  memory.map (Detail::framebuffer_bytes (width, height));
+
+  const size_t pixels = size_t (stride_) * padded_height;
+  color_ = static_cast <uint32_t *> (memory.data ());
+  depth_ = reinterpret_cast <float *> (color_ + pixels);
+  block_depth_ = depth_ + pixels;
+}
+
+inline bool Framebuffer::write_ppm (const char *path) const
+{
+  FILE *file = fopen (path, "wb");
+  if (!file) return false;
+
+  fprintf (file, "P6\n%u %u\n255\n", width_, height_);
+  uint8_t row[MAX_SIZE * 3];
+  bool ok = true;
+  for (uint32_t y = 0; y < height_ && ok; ++y)
+  {
+    const uint32_t *source = color_ + size_t (y) * stride_;
+    for (uint32_t x = 0; x < width_; ++x)
+    {
+      row[x * 3 + 0] = uint8_t (source[x]);
+      row[x * 3 + 1] = uint8_t (source[x] >> 8);
+      row[x * 3 + 2] = uint8_t (source[x] >> 16);
+    }
+    ok = fwrite (row, 3, width_, file) == width_;
+  }
+  return fclose (file) == 0 && ok;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Foundation/Heap/VirtualArray.h"
+
+/* 행렬은 열 우선 (column-major) 4x4 이고 clip = M * (x, y, z, 1). 깊이 범위는 [0, w] */
+
+/* 메시는 호출한 쪽이 소유하며 스트림을 실행할 때까지 살아 있어야 함 */
+struct RenderMesh
+{
+  const float *positions;     /* 정점마다 x, y, z */
+  const uint32_t *indices;    /* 삼각형마다 3 개. 앞면은 NDC 기준 반시계 */
+  uint32_t vertex_count;
+  uint32_t triangle_count;
+};
+
+enum class RenderCommandType : uint8_t
+{
+  Clear,
+  SetCamera,
+  SetLight,
+  Draw,
+};
+
+struct RenderClear
+{
+  uint32_t color;     /* 0xAABBGGRR */
+  float depth;
+};
+
+struct RenderLight
+{
+  float direction[3];   /* 빛이 오는 쪽을 향하는 월드 방향 */
+  float ambient;
+};
+
+struct RenderDraw
+{
+  const RenderMesh *mesh;
+  float world[16];
+  uint32_t color;
+  bool cull_back;
+};
+
+struct RenderCommand
+{
+  RenderCommandType type;
+  union
+  {
+    RenderClear clear;
+    float view_projection[16];
+    RenderLight light;
+    RenderDraw draw;
+  };
+};
+
+/* 한 프레임의 렌더 명령을 순서대로 쌓는 스트림. 백엔드는 앞에서부터 실행하며
+   카메라와 조명은 다음 SetCamera / SetLight 까지 이후 Draw 에 적용됨 */
+class RenderCommandStream
+{
+public:
+  explicit RenderCommandStream (size_t max_commands) : commands (max_commands) {}
+
+  void clear (uint32_t color, float depth = 1.0f);
+  void set_camera (const float *view_projection);
+  void set_light (const float *direction, float ambient);
+  void draw (const RenderMesh &mesh, const float *world, uint32_t color, bool cull_back = true);
+  void reset () { commands.clear (); }
+
+  const RenderCommand *data () const { return commands.data (); }
+  size_t size () const { return commands.size (); }
+
+private:
+  VirtualArray <RenderCommand> commands;
+};
+
+/* ============ 구현 ============ */
+inline void RenderCommandStream::clear (const uint32_t color, const float depth)
+{
+  RenderCommand command;
+  command.type = RenderCommandType::Clear;
+  command.clear = { color, depth };
+  commands.push_back (command);
+}
+
+inline void RenderCommandStream::set_camera (const float *view_projection)
+{
+  RenderCommand command;
+  command.type = RenderCommandType::SetCamera;
+  memcpy (command.view_projection, view_projection, sizeof (command.view_projection));
+  commands.push_back (command);
+}
+
+inline void RenderCommandStream::set_light (const float *direction, const float ambient)
+{
+  RenderCommand command;
+  command.type = RenderCommandType::SetLight;
+  command.light = { { direction[0], direction[1], direction[2] }, ambient };
+  commands.push_back (command);
+}
+
+inline void RenderCommandStream::draw (const RenderMesh &mesh, const float *world, const uint32_t color, const bool cull_back)
+{
+  RenderCommand command;
+  command.type = RenderCommandType::Draw;
+  command.draw.mesh = &mesh;
+  memcpy (command.draw.world, world, sizeof (command.draw.world));
+  command.draw.color = color;
+  command.draw.cull_back = cull_back;
+  commands.push_back (command);
+}
@@ -0,0 +1,656 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "Foundation/Heap/VirtualArray.h"
+#include "Foundation/Math/Simd.h"
+#include "Foundation/Thread/ParallelFor.h"
+#include "Foundation/Thread/ThreadPool.h"
+#include "Render/Framebuffer.h"
+#include "Render/RenderCommand.h"
+
+struct RasterStats
+{
+  uint64_t triangles;     /* 들어온 삼각형 */
+  uint64_t visible;       /* 컬링과 클리핑 후 래스터화한 삼각형 */
+  uint64_t bin_entries;   /* 타일 목록에 들어간 총 항목 */
+  uint64_t split_chunks;  /* 클리핑으로 청크 자리가 모자라 나머지를 다음 청크로 넘긴 횟수 */
+  uint64_t bin_passes;    /* 타일 목록이 한 번에 들어가지 않아 청크를 나눠 그린 횟수 (한 번에 그리면 1) */
+};
+
+/* 타일 기반 소프트웨어 래스터라이저. 렌더 명령 스트림을 순서대로 실행하며 Draw 를 모아 두었다가
+   Clear 나 스트림 끝에서 한꺼번에 그림.
+   1. 삼각형 CHUNK_SIZE 개마다 작업 하나: 변환, 근평면/가드 밴드 클리핑, 후면 컬링, 고정소수점 (1/16 픽셀) 에지 함수 준비, 타일별 개수 세기.
+      클리핑으로 늘어난 삼각형이 청크 자리를 넘으면 남은 입력을 새 청크로 넘기고, 새 청크는 원래 청크 바로 뒤 순서로 그림
+   2. 타일마다 청크 순서로 자리를 나눠 주고 청크별로 타일 목록에 기록 (잠금 없음, 제출 순서 유지).
+      타일 목록이 bins 에 다 들어가지 않으면 앞에서부터 들어가는 만큼의 청크씩 나눠 2, 3 을 되풀이
+   3. 타일마다 작업 하나: 8x8 블록 단위로 계층 Z 와 에지 범위로 통째로 버리거나 받아들이고, 걸친 블록만 SIMD 로 픽셀 판정 */
+class SoftwareRasterizer
+{
+public:
+  static constexpr uint32_t TILE_SIZE = 64;
+  static constexpr uint32_t CHUNK_SIZE = 1024;
+  static constexpr uint32_t CHUNK_SLOTS = CHUNK_SIZE * 2;    /* 클리핑으로 늘어나는 몫까지 */
+  static constexpr uint32_t MAX_CLIPPED = 6;                  /* 다섯 평면으로 자른 삼각형 하나가 만드는 최대 수 */
+  /* 입력 청크 하나가 이어지는 청크를 포함해 차지할 수 있는 최대 청크 수 */
+  static constexpr uint32_t CHUNK_SPLITS = CHUNK_SIZE * MAX_CLIPPED / (CHUNK_SLOTS - MAX_CLIPPED + 1) + 1;
+  static constexpr uint32_t MAX_TILES = (Framebuffer::MAX_SIZE / TILE_SIZE) * (Framebuffer::MAX_SIZE / TILE_SIZE);
+
+  /* max_triangles 는 한 번에 모아 그리는 삼각형 수. 넘으면 중간에 나눠 그림 */
+  explicit SoftwareRasterizer (size_t max_triangles, size_t max_draws = 65536);
+
+  SoftwareRasterizer (const SoftwareRasterizer &) = delete;
+  SoftwareRasterizer &operator= (const SoftwareRasterizer &) = delete;
+
+  void execute (ThreadPool &pool, const RenderCommandStream &stream, Framebuffer &target);
+  const RasterStats &stats () const { return stats_; }
+
+private:
+  struct DrawItem
+  {
+    const RenderMesh *mesh;
+    float clip[16];             /* view_projection * world */
+    float normal[9];            /* world 의 3x3 */
+    float light[3];
+    float ambient;
+    uint32_t color;
+    bool cull_back;
+    uint32_t first_triangle;    /* 모은 삼각형 전체에서의 시작 번호 */
+    uint32_t mesh_triangle;     /* 메시 안에서의 시작 삼각형 (큰 메시를 나눠 그릴 때) */
+  };
+
+  /* 픽셀 (i, j) 에서 에지 k 의 값은 step_x[k] * i + step_y[k] * j + origin[k]. 0 이상이면 안쪽 */
+  struct RasterTriangle
+  {
+    int64_t origin[3];
+    int32_t step_x[3];
+    int32_t step_y[3];
+    float z_dx, z_dy, z_origin;
+    float z_min;
+    int32_t min_x, min_y, max_x, max_y;
+    uint32_t color;
+  };
+
+  struct ClipVertex
+  {
+    float x, y, z, w;
+  };
+
+  static constexpr uint32_t NO_CHUNK = ~0u;
+
+  /* 입력 삼각형 [first, last) 를 맡은 청크. 자리가 모자라 resume 에서 멈추면 나머지는 next 청크가 맡음 */
+  struct RasterChunk
+  {
+    uint32_t first;
+    uint32_t last;
+    uint32_t resume;
+    uint32_t produced;
+    uint64_t entries;             /* 타일 목록에 들어갈 항목 수 */
+    uint32_t next;
+  };
+
+  void add_draw (const RenderDraw &draw, const float *view_projection, const RenderLight &light, ThreadPool &pool, Framebuffer &target);
+  void flush (ThreadPool &pool, Framebuffer &target);
+  void clear (ThreadPool &pool, Framebuffer &target, const RenderClear &command);
+  void setup_chunk (uint32_t chunk, const Framebuffer &target);
+  bool setup_triangle (const ClipVertex *v, uint32_t color, bool cull_back, const Framebuffer &target, RasterTriangle &out) const;
+  void bin_chunk (uint32_t chunk);
+  void raster_pass (ThreadPool &pool, Framebuffer &target, const uint32_t *order, uint32_t count);
+  void raster_tile (uint32_t tile, Framebuffer &target) const;
+
+  VirtualArray <DrawItem> draws;
+  VirtualArray <RasterTriangle> triangles;
+  VirtualArray <RasterChunk> chunks;
+  VirtualArray <uint32_t> chunk_order;    /* 그릴 순서 (원래 청크 뒤에 이어지는 청크) */
+  VirtualArray <uint32_t> bin_offsets;    /* [chunk * tile_count + tile] */
+  VirtualArray <uint32_t> tile_begin;
+  VirtualArray <uint32_t> bins;
+  size_t max_triangles;
+  uint32_t pending_triangles = 0;
+  uint32_t tiles_x = 0;
+  uint32_t tiles_y = 0;
+  RasterStats stats_ = {};
+};
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  /* 열 우선: out = a * b */
+  inline void raster_multiply (float *out, const float *a, const float *b)
+  {
+    for (int column = 0; column < 4; ++column)
+      for (int row = 0; row < 4; ++row)
+        out[column * 4 + row] = a[row] * b[column * 4] + a[4 + row] * b[column * 4 + 1] + a[8 + row] * b[column * 4 + 2] + a[12 + row] * b[column * 4 + 3];
+  }
+
+  inline int64_t raster_floor_div (const int64_t a, const int64_t b)
+  {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+  }
+
+  inline uint32_t raster_shade (const uint32_t color, const float shade)
+  {
+    uint32_t result = color & 0xff000000u;
+    for (int shift = 0; shift < 24; shift += 8)
+    {
+      const float channel = float ((color >> shift) & 0xff) * shade + 0.5f;
+      result |= uint32_t (channel < 255.0f ? channel : 255.0f) << shift;
+    }
+    return result;
+  }
+
+  alignas (32) inline constexpr float RASTER_LANES[8] = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f };
+}
+
+inline SoftwareRasterizer::SoftwareRasterizer (const size_t max_triangles, const size_t max_draws)
+  : draws (max_draws),
+    triangles ((max_triangles + CHUNK_SIZE - 1) / CHUNK_SIZE * CHUNK_SPLITS * CHUNK_SLOTS),
+    chunks ((max_triangles + CHUNK_SIZE - 1) / CHUNK_SIZE * CHUNK_SPLITS),
+    chunk_order ((max_triangles + CHUNK_SIZE - 1) / CHUNK_SIZE * CHUNK_SPLITS),
+    bin_offsets ((max_triangles + CHUNK_SIZE - 1) / CHUNK_SIZE * CHUNK_SPLITS * MAX_TILES),
+    tile_begin (MAX_TILES + 1),
+    /* 삼각형 하나가 평균 32 타일을 덮는 정도에, 모든 타일을 덮는 청크 하나는 언제나 들어가도록.
+       더 많으면 나눠 그림. 가상 예약이라 실제로 쓴 만큼만 커밋됨 */
+    bins (max_triangles * 32 + size_t (CHUNK_SLOTS) * MAX_TILES),
+    max_triangles (max_triangles)
+{
+}
+
+inline void SoftwareRasterizer::execute (ThreadPool &pool, const RenderCommandStream &stream, Framebuffer &target)
+{
+  static constexpr float IDENTITY[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+  float view_projection[16];
+  memcpy (view_projection, IDENTITY, sizeof (view_projection));
+  RenderLight light = { { 0.0f, 0.0f, 1.0f }, 1.0f };
+
+  stats_ = {};
+  tiles_x = (target.width () + TILE_SIZE - 1) / TILE_SIZE;
+  tiles_y = (target.height () + TILE_SIZE - 1) / TILE_SIZE;
+
+  for (size_t i = 0; i < stream.size (); ++i)
+  {
+    const RenderCommand &command = stream.data ()[i];
+    switch (command.type)
+    {
+      case RenderCommandType::Clear:
+        flush (pool, target);
+        clear (pool, target, command.clear);
+        break;
+      case RenderCommandType::SetCamera:
+        memcpy (view_projection, command.view_projection, sizeof (view_projection));
+        break;
+      case RenderCommandType::SetLight:
+        light = command.light;
+        break;
+      case RenderCommandType::Draw:
+        add_draw (command.draw, view_projection, light, pool, target);
+        break;
+    }
+  }
+  flush (pool, target);
+}
+
+inline void SoftwareRasterizer::add_draw (const RenderDraw &draw, const float *view_projection, const RenderLight &light, ThreadPool &pool,
+                                          Framebuffer &target)
+{
+  DrawItem item;
+  item.mesh = draw.mesh;
+  Detail::raster_multiply (item.clip, view_projection, draw.world);
+  for (int column = 0; column < 3; ++column)
+    for (int row = 0; row < 3; ++row) item.normal[column * 3 + row] = draw.world[column * 4 + row];
+  const float length = sqrtf (light.direction[0] * light.direction[0] + light.direction[1] * light.direction[1] + light.direction[2] * light.direction[2]);
+  for (int axis = 0; axis < 3; ++axis) item.light[axis] = length > 0.0f ? light.direction[axis] / length : 0.0f;
+  item.ambient = light.ambient;
+  item.color = draw.color;
+  item.cull_back = draw.cull_back;
+
+  /* 모을 자리가 모자라면 앞의 것을 먼저 그리고 나머지를 이어서 */
+  uint32_t done = 0;
+  while (done < draw.mesh->triangle_count)
+  {
+    if (pending_triangles == max_triangles || draws.size () == draws.capacity ()) flush (pool, target);
+    const uint32_t room = uint32_t (max_triangles - pending_triangles);
+    const uint32_t take = draw.mesh->triangle_count - done < room ? draw.mesh->triangle_count - done : room;
+    item.first_triangle = pending_triangles;
+    item.mesh_triangle = done;
+    draws.push_back (item);
+    pending_triangles += take;
+    done += take;
+  }
+}
+
+inline void SoftwareRasterizer::clear (ThreadPool &pool, Framebuffer &target, const RenderClear &command)
+{
+  const uint32_t block_rows = target.height () / Framebuffer::BLOCK_SIZE + (target.height () % Framebuffer::BLOCK_SIZE != 0);
+  const uint32_t stride = target.stride ();
+  parallel_for (pool, block_rows, 8, [&] (const size_t begin, const size_t end)
+  {
+    const SimdFloat depth = Simd::splat (command.depth);
+    for (size_t block_row = begin; block_row < end; ++block_row)
+    {
+      uint32_t *color = target.color () + block_row * Framebuffer::BLOCK_SIZE * stride;
+      float *depths = target.depth () + block_row * Framebuffer::BLOCK_SIZE * stride;
+      for (size_t i = 0; i < size_t (Framebuffer::BLOCK_SIZE) * stride; i += SIMD_WIDTH) Simd::store (depths + i, depth);
+      for (size_t i = 0; i < size_t (Framebuffer::BLOCK_SIZE) * stride; ++i) color[i] = command.color;
+      float *blocks = target.block_depth () + block_row * target.block_stride ();
+      for (uint32_t i = 0; i < target.block_stride (); ++i) blocks[i] = command.depth;
+    }
+  });
+}
+
+inline void SoftwareRasterizer::flush (ThreadPool &pool, Framebuffer &target)
+{
+  if (!pending_triangles)
+  {
+    draws.clear ();
+    return;
+  }
+
+  const uint32_t input_chunks = (pending_triangles + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  const uint32_t tile_count = tiles_x * tiles_y;
+  chunks.clear ();
+  for (uint32_t chunk = 0; chunk < input_chunks; ++chunk)
+  {
+    const uint32_t first = chunk * CHUNK_SIZE;
+    chunks.push_back ({ first, first + CHUNK_SIZE < pending_triangles ? first + CHUNK_SIZE : pending_triangles, 0, 0, 0, NO_CHUNK });
+  }
+
+  /* 멈춘 청크가 없어질 때까지 남은 입력을 새 청크로 넘겨 다시 준비 */
+  for (uint32_t round_begin = 0; round_begin < chunks.size ();)
+  {
+    const uint32_t round_end = uint32_t (chunks.size ());
+    triangles.resize (size_t (round_end) * CHUNK_SLOTS);
+    bin_offsets.resize (size_t (round_end) * tile_count);
+    memset (bin_offsets.data () + size_t (round_begin) * tile_count, 0, sizeof (uint32_t) * (round_end - round_begin) * tile_count);
+
+    parallel_for (pool, round_end - round_begin, 1, [&] (const size_t begin, const size_t end)
+    {
+      for (size_t chunk = begin; chunk < end; ++chunk) setup_chunk (round_begin + uint32_t (chunk), target);
+    });
+
+    for (uint32_t chunk = round_begin; chunk < round_end; ++chunk)
+    {
+      if (chunks[chunk].resume == chunks[chunk].last) continue;
+      chunks[chunk].next = uint32_t (chunks.size ());
+      chunks.push_back ({ chunks[chunk].resume, chunks[chunk].last, 0, 0, 0, NO_CHUNK });
+      ++stats_.split_chunks;
+    }
+    round_begin = round_end;
+  }
+
+  chunk_order.clear ();
+  for (uint32_t chunk = 0; chunk < input_chunks; ++chunk)
+    for (uint32_t link = chunk; link != NO_CHUNK; link = chunks[link].next) chunk_order.push_back (link);
+
+  /* bins 에 들어가는 만큼씩 앞에서부터 나눠 그림. 청크 하나는 언제나 들어감 */
+  uint32_t pass_begin = 0;
+  uint64_t pass_entries = 0;
+  for (uint32_t i = 0; i < chunk_order.size (); ++i)
+  {
+    const uint64_t entries = chunks[chunk_order[i]].entries;
+    if (i > pass_begin && pass_entries + entries > bins.capacity ())
+    {
+      raster_pass (pool, target, chunk_order.data () + pass_begin, i - pass_begin);
+      pass_begin = i;
+      pass_entries = 0;
+    }
+    pass_entries += entries;
+  }
+  raster_pass (pool, target, chunk_order.data () + pass_begin, uint32_t (chunk_order.size ()) - pass_begin);
+
+  stats_.triangles += pending_triangles;
+  for (uint32_t chunk = 0; chunk < chunks.size (); ++chunk) stats_.visible += chunks[chunk].produced;
+  pending_triangles = 0;
+  draws.clear ();
+}
+
+inline void SoftwareRasterizer::raster_pass (ThreadPool &pool, Framebuffer &target, const uint32_t *order, const uint32_t count)
+{
+  /* 타일 순서, 그 안에서 청크 순서로 자리 배정 */
+  const uint32_t tile_count = tiles_x * tiles_y;
+  tile_begin.resize (tile_count + 1);
+  uint32_t offset = 0;
+  for (uint32_t tile = 0; tile < tile_count; ++tile)
+  {
+    tile_begin[tile] = offset;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      uint32_t &slot = bin_offsets[size_t (order[i]) * tile_count + tile];
+      const uint32_t n = slot;
+      slot = offset;
+      offset += n;
+    }
+  }
+  tile_begin[tile_count] = offset;
+  bins.resize (offset);
+
+  parallel_for (pool, count, 1, [&] (const size_t begin, const size_t end)
+  {
+    for (size_t i = begin; i < end; ++i) bin_chunk (order[i]);
+  });
+
+  parallel_for (pool, tile_count, 1, [&] (const size_t begin, const size_t end)
+  {
+    for (size_t tile = begin; tile < end; ++tile) raster_tile (uint32_t (tile), target);
+  });
+
+  stats_.bin_entries += offset;
+  ++stats_.bin_passes;
+}
+
+inline void SoftwareRasterizer::setup_chunk (const uint32_t chunk, const Framebuffer &target)
+{
+  RasterChunk &state = chunks[chunk];
+  const uint32_t first = state.first;
+  const uint32_t last = state.last;
+  const uint32_t tile_count = tiles_x * tiles_y;
+  RasterTriangle *out = triangles.data () + size_t (chunk) * CHUNK_SLOTS;
+  uint32_t *counts = bin_offsets.data () + size_t (chunk) * tile_count;
+  uint32_t produced = 0;
+  uint64_t entries = 0;
+  uint32_t resume = last;
+
+  /* first 를 품은 그리기 찾기 */
+  size_t draw_index = 0;
+  for (size_t low = 0, high = draws.size (); low < high;)
+  {
+    const size_t mid = (low + high) / 2;
+    if (draws[mid].first_triangle <= first) { draw_index = mid; low = mid + 1; }
+    else high = mid;
+  }
+
+  /* 가드 밴드: 화면 중심에서 ±2048 픽셀. 고정소수점 에지 값이 블록 안에서 float 로 정확히 표현되는 범위 */
+  const float guard_x = 4096.0f / float (target.width ());
+  const float guard_y = 4096.0f / float (target.height ());
+
+  for (uint32_t t = first; t < last; ++t)
+  {
+    /* 클리핑 결과가 다 들어갈 자리가 없으면 이 삼각형부터 다음 청크로 */
+    if (produced + MAX_CLIPPED > CHUNK_SLOTS)
+    {
+      resume = t;
+      break;
+    }
+
+    while (draw_index + 1 < draws.size () && draws[draw_index + 1].first_triangle <= t) ++draw_index;
+    const DrawItem &draw = draws[draw_index];
+    const uint32_t *index = draw.mesh->indices + size_t (draw.mesh_triangle + t - draw.first_triangle) * 3;
+
+    ClipVertex v[3];
+    const float *p[3];
+    uint32_t inside_all = 0x1f, outside_any = 0;
+    for (int k = 0; k < 3; ++k)
+    {
+      p[k] = draw.mesh->positions + size_t (index[k]) * 3;
+      const float *m = draw.clip;
+      v[k] = { m[0] * p[k][0] + m[4] * p[k][1] + m[8] * p[k][2] + m[12], m[1] * p[k][0] + m[5] * p[k][1] + m[9] * p[k][2] + m[13],
+               m[2] * p[k][0] + m[6] * p[k][1] + m[10] * p[k][2] + m[14], m[3] * p[k][0] + m[7] * p[k][1] + m[11] * p[k][2] + m[15] };
+      const uint32_t code = (v[k].z < 0.0f) | (v[k].x > guard_x * v[k].w) << 1 | (v[k].x < -guard_x * v[k].w) << 2 |
+                            (v[k].y > guard_y * v[k].w) << 3 | (v[k].y < -guard_y * v[k].w) << 4;
+      inside_all &= code;
+      outside_any |= code;
+    }
+    if (inside_all) continue;
+
+    /* 면 법선으로 한 번만 조명 */
+    const float e1[3] = { p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2] };
+    const float e2[3] = { p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2] };
+    const float local[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+    float normal[3];
+    for (int axis = 0; axis < 3; ++axis)
+      normal[axis] = draw.normal[axis] * local[0] + draw.normal[3 + axis] * local[1] + draw.normal[6 + axis] * local[2];
+    const float length = sqrtf (normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+    const float lambert = length > 0.0f ? (normal[0] * draw.light[0] + normal[1] * draw.light[1] + normal[2] * draw.light[2]) / length : 0.0f;
+    const uint32_t color = Detail::raster_shade (draw.color, draw.ambient + (1.0f - draw.ambient) * (lambert > 0.0f ? lambert : 0.0f));
+
+    auto emit = [&] (const ClipVertex *vertices)
+    {
+      RasterTriangle &triangle = out[produced];
+      if (!setup_triangle (vertices, color, draw.cull_back, target, triangle)) return;
+      ++produced;
+
+      const uint32_t tx0 = uint32_t (triangle.min_x) / TILE_SIZE, tx1 = uint32_t (triangle.max_x) / TILE_SIZE;
+      const uint32_t ty0 = uint32_t (triangle.min_y) / TILE_SIZE, ty1 = uint32_t (triangle.max_y) / TILE_SIZE;
+      for (uint32_t ty = ty0; ty <= ty1; ++ty)
+        for (uint32_t tx = tx0; tx <= tx1; ++tx) ++counts[ty * tiles_x + tx];
+      entries += uint64_t (tx1 - tx0 + 1) * (ty1 - ty0 + 1);
+    };
+
+    if (!outside_any)
+    {
+      emit (v);
+      continue;
+    }
+
+    /* 걸친 평면에 대해서만 동차 좌표에서 Sutherland-Hodgman. 결과 다각형은 부채꼴로 나눔 */
+    ClipVertex buffers[2][8];
+    uint32_t count = 3;
+    memcpy (buffers[0], v, sizeof (v));
+    ClipVertex *input = buffers[0], *output = buffers[1];
+    for (uint32_t plane = 0; plane < 5 && count; ++plane)
+    {
+      if (!(outside_any & (1u << plane))) continue;
+      auto distance = [&] (const ClipVertex &c)
+      {
+        switch (plane)
+        {
+          case 0: return c.z;
+          case 1: return guard_x * c.w - c.x;
+          case 2: return guard_x * c.w + c.x;
+          case 3: return guard_y * c.w - c.y;
+          default: return guard_y * c.w + c.y;
+        }
+      };
+
+      uint32_t written = 0;
+      for (uint32_t k = 0; k < count; ++k)
+      {
+        const ClipVertex &a = input[k], &b = input[(k + 1) % count];
+        const float da = distance (a), db = distance (b);
+        if (da >= 0.0f) output[written++] = a;
+        if ((da >= 0.0f) != (db >= 0.0f))
+        {
+          const float s = da / (da - db);
+          output[written++] = { a.x + (b.x - a.x) * s, a.y + (b.y - a.y) * s, a.z + (b.z - a.z) * s, a.w + (b.w - a.w) * s };
+        }
+      }
+      count = written;
+      ClipVertex *swap = input;
+      input = output;
+      output = swap;
+    }
+
+    for (uint32_t k = 1; k + 1 < count; ++k)
+    {
+      const ClipVertex fan[3] = { input[0], input[k], input[k + 1] };
+      emit (fan);
+    }
+  }
+
+  state.resume = resume;
+  state.produced = produced;
+  state.entries = entries;
+}
+
+/* 투영, 1/16 픽셀로 맞춤, 방향 정리와 컬링, 에지와 깊이 평면 계수 계산 */
+inline bool SoftwareRasterizer::setup_triangle (const ClipVertex *v, const uint32_t color, const bool cull_back, const Framebuffer &target,
+                                                RasterTriangle &out) const
+{
+  const int32_t width = int32_t (target.width ()), height = int32_t (target.height ());
+  int64_t x[3], y[3];
+  float z[3];
+  for (int k = 0; k < 3; ++k)
+  {
+    if (v[k].w <= 0.0f) return false;
+    const float inverse_w = 1.0f / v[k].w;
+    x[k] = int64_t (lrintf (v[k].x * inverse_w * float (width) * 8.0f));
+    y[k] = int64_t (lrintf (-v[k].y * inverse_w * float (height) * 8.0f));
+    z[k] = v[k].z * inverse_w;
+  }
+
+  /* y 가 아래로 자라므로 NDC 반시계 (앞면) 는 면적이 음수 */
+  int64_t area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+  if (area == 0 || (cull_back && area > 0)) return false;
+  if (area < 0)
+  {
+    int64_t t = x[1]; x[1] = x[2]; x[2] = t;
+    t = y[1]; y[1] = y[2]; y[2] = t;
+    const float s = z[1]; z[1] = z[2]; z[2] = s;
+    area = -area;
+  }
+
+  /* 픽셀 (i, j) 의 중심은 고정소수점으로 (16 i + 8 - 8 width, 16 j + 8 - 8 height) */
+  const int64_t offset_x = 8 - 8 * int64_t (width), offset_y = 8 - 8 * int64_t (height);
+  double z_dx = 0.0, z_dy = 0.0, z_origin = 0.0;
+  for (int k = 0; k < 3; ++k)
+  {
+    /* 에지 k 는 꼭짓점 k 의 맞은편: a -> b */
+    const int a = (k + 1) % 3, b = (k + 2) % 3;
+    const int64_t A = y[a] - y[b], B = x[b] - x[a];
+    const int64_t C = -(A * x[a] + B * y[a]);
+    const int64_t origin = A * offset_x + B * offset_y + C;
+    /* 채우기 규칙: 두 삼각형이 공유하는 에지 위의 픽셀은 정확히 한쪽만 가짐 */
+    const bool inclusive = A > 0 || (A == 0 && B > 0);
+    out.origin[k] = origin - (inclusive ? 0 : 1);
+    out.step_x[k] = int32_t (A * 16);
+    out.step_y[k] = int32_t (B * 16);
+
+    const double weight = double (z[k]) / double (area);
+    z_dx += double (A * 16) * weight;
+    z_dy += double (B * 16) * weight;
+    z_origin += double (origin) * weight;
+  }
+  out.z_dx = float (z_dx);
+  out.z_dy = float (z_dy);
+  out.z_origin = float (z_origin);
+  const float z_min = z[0] < z[1] ? (z[0] < z[2] ? z[0] : z[2]) : (z[1] < z[2] ? z[1] : z[2]);
+  out.z_min = z_min > 0.0f ? z_min : 0.0f;
+
+  const int64_t min_x = x[0] < x[1] ? (x[0] < x[2] ? x[0] : x[2]) : (x[1] < x[2] ? x[1] : x[2]);
+  const int64_t max_x = x[0] > x[1] ? (x[0] > x[2] ? x[0] : x[2]) : (x[1] > x[2] ? x[1] : x[2]);
+  const int64_t min_y = y[0] < y[1] ? (y[0] < y[2] ? y[0] : y[2]) : (y[1] < y[2] ? y[1] : y[2]);
+  const int64_t max_y = y[0] > y[1] ? (y[0] > y[2] ? y[0] : y[2]) : (y[1] > y[2] ? y[1] : y[2]);
+  int64_t x0 = Detail::raster_floor_div (min_x - offset_x + 15, 16), x1 = Detail::raster_floor_div (max_x - offset_x, 16);
+  int64_t y0 = Detail::raster_floor_div (min_y - offset_y + 15, 16), y1 = Detail::raster_floor_div (max_y - offset_y, 16);
+  if (x0 < 0) x0 = 0;
+  if (y0 < 0) y0 = 0;
+  if (x1 >= width) x1 = width - 1;
+  if (y1 >= height) y1 = height - 1;
+  if (x0 > x1 || y0 > y1) return false;
+
+  out.min_x = int32_t (x0);
+  out.min_y = int32_t (y0);
+  out.max_x = int32_t (x1);
+  out.max_y = int32_t (y1);
+  out.color = color;
+  return true;
+}
+
+inline void SoftwareRasterizer::bin_chunk (const uint32_t chunk)
+{
+  const uint32_t tile_count = tiles_x * tiles_y;
+  uint32_t *offsets = bin_offsets.data () + size_t (chunk) * tile_count;
+  const uint32_t base = chunk * CHUNK_SLOTS;
+
+  for (uint32_t k = 0; k < chunks[chunk].produced; ++k)
+  {
+    const RasterTriangle &triangle = triangles[base + k];
+    const uint32_t tx0 = uint32_t (triangle.min_x) / TILE_SIZE, tx1 = uint32_t (triangle.max_x) / TILE_SIZE;
+    const uint32_t ty0 = uint32_t (triangle.min_y) / TILE_SIZE, ty1 = uint32_t (triangle.max_y) / TILE_SIZE;
+    for (uint32_t ty = ty0; ty <= ty1; ++ty)
+      for (uint32_t tx = tx0; tx <= tx1; ++tx) bins[offsets[ty * tiles_x + tx]++] = base + k;
+  }
+}
+
+inline void SoftwareRasterizer::raster_tile (const uint32_t tile, Framebuffer &target) const
+{
+  constexpr int32_t BLOCK = int32_t (Framebuffer::BLOCK_SIZE);
+  const int32_t tile_x0 = int32_t (tile % tiles_x * TILE_SIZE), tile_y0 = int32_t (tile / tiles_x * TILE_SIZE);
+  const int32_t tile_x1 = tile_x0 + int32_t (TILE_SIZE) - 1, tile_y1 = tile_y0 + int32_t (TILE_SIZE) - 1;
+  const size_t stride = target.stride ();
+  const SimdFloat lanes = Simd::load (Detail::RASTER_LANES);
+
+  for (uint32_t entry = tile_begin[tile]; entry < tile_begin[tile + 1]; ++entry)
+  {
+    const RasterTriangle &triangle = triangles[bins[entry]];
+    const int32_t x0 = triangle.min_x > tile_x0 ? triangle.min_x : tile_x0, x1 = triangle.max_x < tile_x1 ? triangle.max_x : tile_x1;
+    const int32_t y0 = triangle.min_y > tile_y0 ? triangle.min_y : tile_y0, y1 = triangle.max_y < tile_y1 ? triangle.max_y : tile_y1;
+    const SimdFloat z_dx = Simd::splat (triangle.z_dx);
+
+    for (int32_t block_y = y0 / BLOCK; block_y <= y1 / BLOCK; ++block_y)
+      for (int32_t block_x = x0 / BLOCK; block_x <= x1 / BLOCK; ++block_x)
+      {
+        /* 계층 Z: 이 블록에서 가장 먼 깊이보다도 삼각형이 전부 멀면 버림 */
+        float &block_depth = target.block_depth ()[size_t (block_y) * target.block_stride () + size_t (block_x)];
+        if (triangle.z_min >= block_depth) continue;
+
+        const int32_t i0 = block_x * BLOCK, j0 = block_y * BLOCK;
+        int64_t corner[3];
+        int32_t step_x[3], step_y[3];
+        uint32_t crossing = 0;
+        bool outside = false;
+        for (int k = 0; k < 3; ++k)
+        {
+          const int64_t value = int64_t (triangle.step_x[k]) * i0 + int64_t (triangle.step_y[k]) * j0 + triangle.origin[k];
+          const int64_t dx = int64_t (triangle.step_x[k]) * (BLOCK - 1), dy = int64_t (triangle.step_y[k]) * (BLOCK - 1);
+          const int64_t high = value + (dx > 0 ? dx : 0) + (dy > 0 ? dy : 0);
+          const int64_t low = value + (dx < 0 ? dx : 0) + (dy < 0 ? dy : 0);
+          if (high < 0) { outside = true; break; }
+          if (low >= 0) continue;
+          /* 블록을 가로지르는 에지만 픽셀 단위로 평가. 이 값들은 2^24 안이라 float 로 정확함 */
+          corner[crossing] = value;
+          step_x[crossing] = triangle.step_x[k];
+          step_y[crossing] = triangle.step_y[k];
+          ++crossing;
+        }
+        if (outside) continue;
+
+        SimdFloat edge_dx[3];
+        for (uint32_t k = 0; k < crossing; ++k) edge_dx[k] = Simd::splat (float (step_x[k])) * lanes;
+
+        const float z_block = triangle.z_dx * float (i0) + triangle.z_dy * float (j0) + triangle.z_origin;
+        SimdFloat farthest = Simd::zero ();
+        bool written = false;
+        for (int32_t row = 0; row < BLOCK; ++row)
+          for (int32_t column = 0; column < BLOCK; column += int32_t (SIMD_WIDTH))
+          {
+            const size_t pixel = size_t (j0 + row) * stride + size_t (i0 + column);
+            SimdFloat coverage = Simd::splat (1.0f);
+            for (uint32_t k = 0; k < crossing; ++k)
+            {
+              const float start = float (corner[k] + int64_t (step_y[k]) * row + int64_t (step_x[k]) * column);
+              coverage = Simd::min (coverage, Simd::splat (start) + edge_dx[k]);
+            }
+            const SimdFloat z = Simd::mul_add (lanes, z_dx, Simd::splat (z_block + triangle.z_dy * float (row) + triangle.z_dx * float (column)));
+            const SimdFloat old_depth = Simd::load (target.depth () + pixel);
+            const SimdMask covered = Simd::less_equal (Simd::zero (), coverage);
+            const uint32_t mask = Simd::mask_bits (covered) & Simd::mask_bits (Simd::less (z, old_depth));
+            const SimdFloat new_depth = Simd::select (covered, Simd::min (z, old_depth), old_depth);
+            farthest = Simd::max (farthest, new_depth);
+            if (!mask) continue;
+
+            written = true;
+            Simd::store (target.depth () + pixel, new_depth);
+            uint32_t *color = target.color () + pixel;
+            if (mask == (1u << SIMD_WIDTH) - 1)
+              for (size_t lane = 0; lane < SIMD_WIDTH; ++lane) color[lane] = triangle.color;
+            else
+              for (uint32_t bits = mask; bits; bits &= bits - 1) color[__builtin_ctz (bits)] = triangle.color;
+          }
+
+        /* 블록 전체의 깊이를 다 봤으므로 최대값을 그대로 갱신 */
+        if (written)
+        {
+          alignas (32) float values[SIMD_WIDTH];
+          Simd::store (values, farthest);
+          float result = values[0];
+          for (size_t lane = 1; lane < SIMD_WIDTH; ++lane) result = values[lane] > result ? values[lane] : result;
+          block_depth = result;
+        }
+      }
+  }
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Foundation/Heap/VirtualArray.h"
+#include "Script/ScriptVM.h"
+
+/* 함수 하나의 바이트코드를 쌓는 도구. 레지스터 수는 쓰인 번호에서 자동으로 정해짐.
+   앞쪽 분기는 jump 가 돌려준 위치를 나중에 patch, 뒤쪽 분기는 here 로 받아 둔 위치로 jump_to */
+class ScriptAssembler
+{
+public:
+  explicit ScriptAssembler (uint32_t param_count)
+    : code (65536), constants (65536), sites (256), param_count (param_count), register_count (param_count)
+  {
+  }
+
+  ScriptAssembler (const ScriptAssembler &) = delete;
+  ScriptAssembler &operator= (const ScriptAssembler &) = delete;
+
+  uint32_t constant (Value value);
+
+  void load_constant (uint32_t a, Value value) { emit_bx (ScriptOp::LoadConstant, a, constant (value)); }
+  void load_nil (uint32_t a) { emit (ScriptOp::LoadNil, a, 0, 0); }
+  void load_bool (uint32_t a, bool value) { emit (ScriptOp::LoadBool, a, value, 0); }
+  void move (uint32_t a, uint32_t b) { emit (ScriptOp::Move, a, b, 0); touch (b); }
+  void binary (ScriptOp op, uint32_t a, uint32_t b, uint32_t c) { emit (op, a, b, c); touch (b); touch (c); }
+  void add_constant (uint32_t a, uint32_t b, Value value) { emit (ScriptOp::AddConstant, a, b, constant (value)); touch (b); }
+  void logical_not (uint32_t a, uint32_t b) { emit (ScriptOp::Not, a, b, 0); touch (b); }
+  void new_object (uint32_t a) { emit (ScriptOp::NewObject, a, 0, 0); }
+  /* 필드 접근은 명령마다 자기 인라인 캐시를 가짐 */
+  void get_field (uint32_t a, uint32_t object, uint32_t symbol) { emit (ScriptOp::GetField, a, object, site (symbol)); touch (object); }
+  void set_field (uint32_t object, uint32_t symbol, uint32_t value) { emit (ScriptOp::SetField, object, value, site (symbol)); touch (value); }
+  /* 인자는 R[a+1] .. R[a+count] 에 미리 넣어 둠 */
+  void call (uint32_t a, uint32_t function, uint32_t count) { emit (ScriptOp::Call, a, function, count); touch (a + count); }
+  void call_native (uint32_t a, uint32_t native, uint32_t count) { emit (ScriptOp::CallNative, a, native, count); touch (a + count); }
+  void ret (uint32_t a) { emit (ScriptOp::Return, a, 0, 0); }
+
+  uint32_t here () const { return uint32_t (code.size ()); }
+  /* op 는 Jump, JumpIfFalse, JumpIfTrue */
+  uint32_t jump (ScriptOp op, uint32_t a = 0);
+  void jump_to (ScriptOp op, uint32_t target, uint32_t a = 0);
+  void patch (uint32_t position);
+
+  /* VM 에 등록하고 함수 번호 반환. 검증에 실패하면 ~0u */
+  uint32_t finish (ScriptVM &vm) const;
+
+private:
+  void emit (ScriptOp op, uint32_t a, uint32_t b, uint32_t c);
+  void emit_bx (ScriptOp op, uint32_t a, uint32_t bx);
+  void touch (uint32_t reg) { if (reg + 1 > register_count) register_count = reg + 1; }
+  uint32_t site (uint32_t symbol);
+
+  VirtualArray <uint32_t> code;
+  VirtualArray <Value> constants;
+  VirtualArray <ScriptFieldSite> sites;
+  uint32_t param_count;
+  uint32_t register_count;
+  bool overflow = false;    /* 필드 폭을 넘는 번호가 한 번이라도 들어옴 */
+};
+
+/* ============ 구현 ============ */
+inline uint32_t ScriptAssembler::constant (const Value value)
+{
+  for (size_t i = 0; i < constants.size (); ++i)
+    if (constants[i].raw () == value.raw ()) return uint32_t (i);
+  constants.push_back (value);
+  return uint32_t (constants.size () - 1);
+}
+
+inline uint32_t ScriptAssembler::site (const uint32_t symbol)
+{
+  sites.push_back ({ symbol, 0, nullptr, nullptr });
+  return uint32_t (sites.size () - 1);
+}
+
+inline void ScriptAssembler::emit (const ScriptOp op, const uint32_t a, const uint32_t b, const uint32_t c)
+{
+  if ((a | b | c) > 0xff) overflow = true;
+  code.push_back (uint32_t (op) | (a & 0xff) << 8 | (b & 0xff) << 16 | (c & 0xff) << 24);
+  touch (a);
+}
+
+inline void ScriptAssembler::emit_bx (const ScriptOp op, const uint32_t a, const uint32_t bx)
+{
+  if (a > 0xff || bx > 0xffff) overflow = true;
+  code.push_back (uint32_t (op) | (a & 0xff) << 8 | (bx & 0xffff) << 16);
+  touch (a);
+}
+
+inline uint32_t ScriptAssembler::jump (const ScriptOp op, const uint32_t a)
+{
+  const uint32_t position = here ();
+  emit_bx (op, a, 32767);
+  return position;
+}
+
+inline void ScriptAssembler::jump_to (const ScriptOp op, const uint32_t target, const uint32_t a)
+{
+  const int32_t offset = int32_t (target) - int32_t (here ()) - 1 + 32767;
+  if (offset < 0) overflow = true;
+  emit_bx (op, a, uint32_t (offset));
+}
+
+inline void ScriptAssembler::patch (const uint32_t position)
+{
+  const int32_t offset = int32_t (here ()) - int32_t (position) - 1 + 32767;
+  if (offset > 0xffff) overflow = true;
+  code[position] = (code[position] & 0xffff) | uint32_t (offset & 0xffff) << 16;
+}
+
+inline uint32_t ScriptAssembler::finish (ScriptVM &vm) const
+{
+  if (overflow) return ~0u;
+  const ScriptFunction function = { code.data (), constants.data (), sites.data (), uint32_t (code.size ()), uint32_t (constants.size ()),
+                                    uint32_t (sites.size ()), param_count, register_count };
+  return vm.add_function (function);
+}
@@ -0,0 +1,589 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Foundation/Heap/FrameArena.h"
+#include "Foundation/Heap/VirtualArray.h"
+#include "Script/Value.h"
+
+/* GCC/Clang 은 레이블 주소로 명령마다 따로 분기 (computed goto). 그 외에는 switch.
+   같은 실행 루프를 switch 로도 돌릴 수 있어 (call <false>) 두 방식을 같은 바이트코드로 비교 가능 */
+#if defined(__GNUC__)
+#define IKYO_SCRIPT_COMPUTED_GOTO 1
+#else
+#define IKYO_SCRIPT_COMPUTED_GOTO 0
+#endif
+
+inline constexpr uint32_t SCRIPT_MAX_FIELDS = 16;
+
+/* 히든 클래스. 같은 순서로 필드가 추가된 객체는 같은 모양을 공유하므로 (모양, 슬롯) 으로 필드 접근을 캐시할 수 있음.
+   모양은 전이 트리로 연결되고 VM 이 없어질 때까지 유지됨 */
+struct ScriptShape
+{
+  ScriptShape *first_child;
+  ScriptShape *next_sibling;
+  uint32_t field_count;
+  uint32_t symbols[SCRIPT_MAX_FIELDS];
+
+  int32_t find (const uint32_t symbol) const
+  {
+    for (uint32_t i = 0; i < field_count; ++i)
+      if (symbols[i] == symbol) return int32_t (i);
+    return -1;
+  }
+};
+
+struct ScriptObject
+{
+  ScriptShape *shape;
+  Value slots[SCRIPT_MAX_FIELDS];
+};
+
+/* 32비트 명령. 하위 8비트 op, 그 위로 A, B, C 각 8비트. Bx 는 상위 16비트, sBx 는 Bx - 32767 */
+enum class ScriptOp : uint8_t
+{
+  LoadConstant,     /* R[A] = K[Bx] */
+  LoadNil,          /* R[A] = nil */
+  LoadBool,         /* R[A] = B != 0 */
+  Move,             /* R[A] = R[B] */
+  Add,              /* R[A] = R[B] + R[C] */
+  Sub,
+  Mul,
+  Div,
+  AddConstant,      /* R[A] = R[B] + K[C] */
+  Less,             /* R[A] = R[B] < R[C] */
+  LessEqual,
+  Equal,
+  Not,              /* R[A] = !R[B] */
+  Jump,             /* pc += sBx */
+  JumpIfFalse,      /* R[A] 이 거짓이면 pc += sBx */
+  JumpIfTrue,
+  NewObject,        /* R[A] = {} */
+  GetField,         /* R[A] = R[B].field (C 는 필드 사이트 번호) */
+  SetField,         /* R[A].field = R[B] */
+  Call,             /* R[A] = functions[B] (R[A+1] .. R[A+C]). B 가 8비트라 함수는 MAX_FUNCTIONS 개까지 */
+  CallNative,       /* R[A] = natives[B] (R[A+1] .. R[A+C]) */
+  Return,           /* return R[A] */
+  Count,
+};
+
+enum class ScriptStatus : uint8_t
+{
+  Ok,
+  TypeError,
+  BadCall,            /* 없는 함수 번호나 인자 수 불일치 */
+  StackOverflow,
+  OutOfMemory,
+  TooManyFields,
+  NativeError,
+};
+
+/* 필드 접근 명령 하나에 붙는 인라인 캐시. 쓰기 사이트는 필드 추가 전이 (shape -> next_shape) 까지 캐시 */
+struct ScriptFieldSite
+{
+  uint32_t symbol;
+  uint32_t slot;
+  ScriptShape *shape;
+  ScriptShape *next_shape;
+};
+
+struct ScriptFunction
+{
+  const uint32_t *code;
+  const Value *constants;
+  ScriptFieldSite *sites;
+  uint32_t code_size;
+  uint32_t constant_count;
+  uint32_t site_count;
+  uint32_t param_count;
+  uint32_t register_count;
+};
+
+/* 네이티브 함수. false 를 반환하면 스크립트 실행이 NativeError 로 끝남 */
+using ScriptNative = bool (*) (void *context, const Value *args, uint32_t count, Value *result);
+
+/* 레지스터 기반 바이트코드 VM. 호출 프레임은 미리 예약한 레지스터 스택에서 창을 밀어 가며 잡고,
+   인자는 호출자 레지스터에 둔 그대로 피호출자의 R[0..] 이 되므로 복사가 없음.
+   객체는 힙 아레나에서 할당하고 reset_heap 으로 한꺼번에 해제함 (GC 없음). 단일 스레드 전용 */
+class ScriptVM
+{
+public:
+  static constexpr uint32_t MAX_FUNCTIONS = 256;
+  static constexpr uint32_t MAX_NATIVES = 256;
+  static constexpr uint32_t MAX_CALL_DEPTH = 256;
+
+  explicit ScriptVM (size_t heap_size = size_t (64) << 20, size_t stack_size = size_t (1) << 20);
+
+  ScriptVM (const ScriptVM &) = delete;
+  ScriptVM &operator= (const ScriptVM &) = delete;
+
+  /* 코드, 상수, 사이트는 VM 안으로 복사됨. 함수 번호 반환, 가득 차면 ~0u */
+  uint32_t add_function (const ScriptFunction &function);
+  uint32_t add_native (ScriptNative func, void *context);
+
+  /* COMPUTED_GOTO 가 false 면 같은 실행 루프를 switch 디스패치로 돌림 */
+  template <bool COMPUTED_GOTO = IKYO_SCRIPT_COMPUTED_GOTO>
+  ScriptStatus call (uint32_t function, const Value *args, uint32_t count, Value *result);
+
+  /* 호스트 쪽 객체 접근. 스크립트와 같은 모양 전이를 거침 */
+  ScriptObject *new_object ();
+  Value get_field (const ScriptObject *object, uint32_t symbol) const;
+  ScriptStatus set_field (ScriptObject *object, uint32_t symbol, Value value);
+
+  void reset_heap () { heap.reset (); }
+  size_t heap_used () const { return heap.used (); }
+
+private:
+  struct Frame
+  {
+    const ScriptFunction *function;
+    const uint32_t *pc;
+    Value *base;
+  };
+
+  struct NativeSlot
+  {
+    ScriptNative func;
+    void *context;
+  };
+
+  ScriptShape *transition (ScriptShape *shape, uint32_t symbol);
+  template <bool COMPUTED_GOTO>
+  ScriptStatus run (const ScriptFunction *function, Value *base, Value *result);
+
+  FrameArena heap;
+  FrameArena program;     /* 함수 사본과 모양. 지우지 않음 */
+  VirtualArray <Value> stack;
+  Value *stack_top;
+  ScriptShape *root_shape;
+
+  ScriptFunction functions[MAX_FUNCTIONS];
+  uint32_t function_count = 0;
+  NativeSlot natives[MAX_NATIVES];
+  uint32_t native_count = 0;
+  Frame frames[MAX_CALL_DEPTH];
+  uint32_t frame_count = 0;   /* 네이티브에서 다시 들어온 run 은 이 위부터 프레임을 씀 */
+
+  static_assert (MAX_FUNCTIONS <= 256 && MAX_NATIVES <= 256, "Call / CallNative 의 B 는 8비트");
+};
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  inline uint32_t script_a (const uint32_t instruction) { return (instruction >> 8) & 0xff; }
+  inline uint32_t script_b (const uint32_t instruction) { return (instruction >> 16) & 0xff; }
+  inline uint32_t script_c (const uint32_t instruction) { return instruction >> 24; }
+  inline uint32_t script_bx (const uint32_t instruction) { return instruction >> 16; }
+  inline int32_t script_sbx (const uint32_t instruction) { return int32_t (instruction >> 16) - 32767; }
+
+  /* 실행 루프는 범위 검사를 하지 않으므로 등록할 때 한 번 검증. 레지스터, 상수, 사이트 번호와 분기 대상이
+     범위 안이고 마지막 명령이 Return 이나 Jump 라 코드 끝을 넘어 실행하지 않음을 확인 */
+  inline bool script_verify (const ScriptFunction &function)
+  {
+    if (!function.code_size || function.param_count > function.register_count) return false;
+
+    for (uint32_t pc = 0; pc < function.code_size; ++pc)
+    {
+      const uint32_t instruction = function.code[pc];
+      if ((instruction & 0xff) >= uint32_t (ScriptOp::Count)) return false;
+
+      const ScriptOp op = ScriptOp (instruction & 0xff);
+      const uint32_t a = script_a (instruction), b = script_b (instruction), c = script_c (instruction);
+      const uint32_t registers = function.register_count;
+      bool valid = a < registers;
+      switch (op)
+      {
+        case ScriptOp::LoadConstant: valid = valid && script_bx (instruction) < function.constant_count; break;
+        case ScriptOp::Move:
+        case ScriptOp::Not: valid = valid && b < registers; break;
+        case ScriptOp::AddConstant: valid = valid && b < registers && c < function.constant_count; break;
+        case ScriptOp::Add:
+        case ScriptOp::Sub:
+        case ScriptOp::Mul:
+        case ScriptOp::Div:
+        case ScriptOp::Less:
+        case ScriptOp::LessEqual:
+        case ScriptOp::Equal: valid = valid && b < registers && c < registers; break;
+        case ScriptOp::GetField:
+        case ScriptOp::SetField: valid = valid && b < registers && c < function.site_count; break;
+        case ScriptOp::Call:
+        case ScriptOp::CallNative: valid = valid && a + c < registers; break;
+        case ScriptOp::Jump: valid = true; [[fallthrough]];
+        case ScriptOp::JumpIfFalse:
+        case ScriptOp::JumpIfTrue:
+        {
+          const int64_t target = int64_t (pc) + 1 + script_sbx (instruction);
+          valid = valid && target >= 0 && target < int64_t (function.code_size);
+          break;
+        }
+        default: break;
+      }
+      if (!valid) return false;
+    }
+
+    const ScriptOp last = ScriptOp (function.code[function.code_size - 1] & 0xff);
+    return last == ScriptOp::Return || last == ScriptOp::Jump;
+  }
+}
+
+inline ScriptVM::ScriptVM (const size_t heap_size, const size_t stack_size)
+  : heap (heap_size), program (size_t (16) << 20), stack (stack_size)
+{
+  stack_top = stack.data ();
+  root_shape = program.allocate <ScriptShape> (1);
+  if (!root_shape) abort ();
+  memset (static_cast <void *> (root_shape), 0, sizeof (ScriptShape));
+}
+
+inline uint32_t ScriptVM::add_function (const ScriptFunction &function)
+{
+  if (function_count == MAX_FUNCTIONS || function.register_count > 256 || !Detail::script_verify (function)) return ~0u;
+
+  uint32_t *code = program.allocate <uint32_t> (function.code_size + 1);
+  Value *constants = program.allocate <Value> (function.constant_count + 1);
+  ScriptFieldSite *sites = program.allocate <ScriptFieldSite> (function.site_count + 1);
+  if (!code || !constants || !sites) return ~0u;
+
+  memcpy (code, function.code, sizeof (uint32_t) * function.code_size);
+  memcpy (static_cast <void *> (constants), function.constants, sizeof (Value) * function.constant_count);
+  for (uint32_t i = 0; i < function.site_count; ++i)
+    sites[i] = { function.sites[i].symbol, 0, nullptr, nullptr };
+
+  ScriptFunction &copy = functions[function_count];
+  copy = function;
+  copy.code = code;
+  copy.constants = constants;
+  copy.sites = sites;
+  return function_count++;
+}
+
+inline uint32_t ScriptVM::add_native (const ScriptNative func, void *context)
+{
+  if (native_count == MAX_NATIVES) return ~0u;
+  natives[native_count] = { func, context };
+  return native_count++;
+}
+
+inline ScriptObject *ScriptVM::new_object ()
+{
+  ScriptObject *object = heap.allocate <ScriptObject> (1);
+  if (object) object->shape = root_shape;
+  return object;
+}
+
+inline ScriptShape *ScriptVM::transition (ScriptShape *shape, const uint32_t symbol)
+{
+  for (ScriptShape *child = shape->first_child; child; child = child->next_sibling)
+    if (child->symbols[child->field_count - 1] == symbol) return child;
+
+  ScriptShape *child = program.allocate <ScriptShape> (1);
+  if (!child) return nullptr;
+  child->first_child = nullptr;
+  child->next_sibling = shape->first_child;
+  child->field_count = shape->field_count + 1;
+  memcpy (child->symbols, shape->symbols, sizeof (uint32_t) * shape->field_count);
+  child->symbols[shape->field_count] = symbol;
+  shape->first_child = child;
+  return child;
+}
+
+inline Value ScriptVM::get_field (const ScriptObject *object, const uint32_t symbol) const
+{
+  const int32_t slot = object->shape->find (symbol);
+  return slot < 0 ? Value::nil () : object->slots[slot];
+}
+
+inline ScriptStatus ScriptVM::set_field (ScriptObject *object, const uint32_t symbol, const Value value)
+{
+  const int32_t slot = object->shape->find (symbol);
+  if (slot >= 0)
+  {
+    object->slots[slot] = value;
+    return ScriptStatus::Ok;
+  }
+  if (object->shape->field_count == SCRIPT_MAX_FIELDS) return ScriptStatus::TooManyFields;
+
+  ScriptShape *next = transition (object->shape, symbol);
+  if (!next) return ScriptStatus::OutOfMemory;
+  object->slots[object->shape->field_count] = value;
+  object->shape = next;
+  return ScriptStatus::Ok;
+}
+
+template <bool COMPUTED_GOTO>
+ScriptStatus ScriptVM::call (const uint32_t index, const Value *args, const uint32_t count, Value *result)
+{
+  if (index >= function_count || count != functions[index].param_count) return ScriptStatus::BadCall;
+
+  const ScriptFunction *function = &functions[index];
+  Value *base = stack_top;
+  const size_t end = size_t (base - stack.data ()) + function->register_count;
+  if (end > stack.capacity ()) return ScriptStatus::StackOverflow;
+  stack.reserve (end);
+
+  for (uint32_t i = 0; i < count; ++i) base[i] = args[i];
+  for (uint32_t i = count; i < function->register_count; ++i) base[i] = Value::nil ();
+
+  /* 네이티브가 다시 call 을 불러도 이 호출의 레지스터를 덮지 않도록 스택 꼭대기를 되돌려 둠 */
+  Value *saved_top = stack_top;
+  const ScriptStatus status = run <COMPUTED_GOTO> (function, base, result);
+  stack_top = saved_top;
+  return status;
+}
+
+template <bool COMPUTED_GOTO>
+ScriptStatus ScriptVM::run (const ScriptFunction *function, Value *base, Value *result)
+{
+  static_assert (!COMPUTED_GOTO || IKYO_SCRIPT_COMPUTED_GOTO, "computed goto needs GCC or Clang");
+  using namespace Detail;
+
+  const uint32_t *pc = function->code;
+  const Value *constants = function->constants;
+  ScriptFieldSite *sites = function->sites;
+  Frame *const frame_stack = frames + frame_count;
+  const uint32_t max_depth = MAX_CALL_DEPTH - frame_count;
+  uint32_t depth = 0;
+  uint32_t instruction;
+
+  /* 두 방식 모두 같은 case 본문을 씀. computed goto 는 처음 한 번만 switch 앞에서 레이블로 뛰고
+     이후로는 본문 끝에서 다음 명령의 레이블로 바로 감 */
+#if IKYO_SCRIPT_COMPUTED_GOTO
+  [[maybe_unused]] static void *const LABELS[] = { &&op_LoadConstant, &&op_LoadNil, &&op_LoadBool, &&op_Move, &&op_Add, &&op_Sub, &&op_Mul, &&op_Div,
+                                  &&op_AddConstant, &&op_Less, &&op_LessEqual, &&op_Equal, &&op_Not, &&op_Jump, &&op_JumpIfFalse,
+                                  &&op_JumpIfTrue, &&op_NewObject, &&op_GetField, &&op_SetField, &&op_Call, &&op_CallNative, &&op_Return };
+  static_assert (sizeof (LABELS) / sizeof (LABELS[0]) == size_t (ScriptOp::Count));
+#define SCRIPT_CASE(name) case ScriptOp::name: op_##name:
+#define SCRIPT_NEXT() if constexpr (COMPUTED_GOTO) { instruction = *pc++; goto *LABELS[instruction & 0xff]; } else continue
+  if constexpr (COMPUTED_GOTO)
+  {
+    instruction = *pc++;
+    goto *LABELS[instruction & 0xff];
+  }
+#else
+#define SCRIPT_CASE(name) case ScriptOp::name:
+#define SCRIPT_NEXT() continue
+#endif
+
+  for (;;)
+  {
+    instruction = *pc++;
+    switch (ScriptOp (instruction & 0xff))
+    {
+
+#define SCRIPT_ARITHMETIC(name, op)                                                                           \
+  SCRIPT_CASE (name)                                                                                          \
+  {                                                                                                           \
+    const Value lhs = base[script_b (instruction)], rhs = base[script_c (instruction)];                       \
+    if (!lhs.is_number () || !rhs.is_number ()) return ScriptStatus::TypeError;                               \
+    base[script_a (instruction)] = Value::number (lhs.as_number () op rhs.as_number ());                      \
+    SCRIPT_NEXT ();                                                                                           \
+  }
+
+#define SCRIPT_COMPARE(name, op)                                                                              \
+  SCRIPT_CASE (name)                                                                                          \
+  {                                                                                                           \
+    const Value lhs = base[script_b (instruction)], rhs = base[script_c (instruction)];                       \
+    if (!lhs.is_number () || !rhs.is_number ()) return ScriptStatus::TypeError;                               \
+    base[script_a (instruction)] = Value::boolean (lhs.as_number () op rhs.as_number ());                     \
+    SCRIPT_NEXT ();                                                                                           \
+  }
+
+  SCRIPT_CASE (LoadConstant)
+  {
+    base[script_a (instruction)] = constants[script_bx (instruction)];
+    SCRIPT_NEXT ();
+  }
+
+  SCRIPT_CASE (LoadNil)
+  {
+    base[script_a (instruction)] = Value::nil ();
+    SCRIPT_NEXT ();
+  }
+
+  SCRIPT_CASE (LoadBool)
+  {
+    base[script_a (instruction)] = Value::boolean (script_b (instruction) != 0);
+    SCRIPT_NEXT ();
+  }
+
+  SCRIPT_CASE (Move)
+  {
+    base[script_a (instruction)] = base[script_b (instruction)];
+    SCRIPT_NEXT ();
+  }
+
+  SCRIPT_ARITHMETIC (Add, +)
+  SCRIPT_ARITHMETIC (Sub, -)
+  SCRIPT_ARITHMETIC (Mul, *)
+  SCRIPT_ARITHMETIC (Div, /)
+
+  SCRIPT_CASE (AddConstant)
+  {
+    const Value lhs = base[script_b (instruction)], rhs = constants[script_c (instruction)];
+    if (!lhs.is_number () || !rhs.is_number ()) return ScriptStatus::TypeError;
+    base[script_a (instruction)] = Value::number (lhs.as_number () + rhs.as_number ());
+    SCRIPT_NEXT ();
+  }
+
+  SCRIPT_COMPARE (Less, <)
+  SCRIPT_COMPARE (LessEqual, <=)
+
+  SCRIPT_CASE (Equal)
+  {
+    const Value lhs = base[script_b (instruction)], rhs = base[script_c (instruction)];
+    const bool equal = lhs.is_number () && rhs.is_number () ? lhs.as_number () == rhs.as_number () : lhs == rhs;
+    base[script_a (instruction)] = Value::boolean (equal);
+    SCRIPT_NEXT ();
+  }
+
+  SCRIPT_CASE (Not)
+  {
+    base[script_a (instruction)] = Value::boolean (!base[script_b (instruction)].truthy ());
+    SCRIPT_NEXT ();
+  }
+
+  SCRIPT_CASE (Jump)
+  {
+    pc += script_sbx (instruction);
+    SCRIPT_NEXT ();
+  }
+
+  SCRIPT_CASE (JumpIfFalse)
+  {
+    if (!base[script_a (instruction)].truthy ()) pc += script_sbx (instruction);
+    SCRIPT_NEXT ();
+  }
+
+  SCRIPT_CASE (JumpIfTrue)
+  {
+    if (base[script_a (instruction)].truthy ()) pc += script_sbx (instruction);
+    SCRIPT_NEXT ();
+  }
+
+  SCRIPT_CASE (NewObject)
+  {
+    ScriptObject *object = new_object ();
+    if (!object) return ScriptStatus::OutOfMemory;
+    base[script_a (instruction)] = Value::object (object);
+    SCRIPT_NEXT ();
+  }
+
+  SCRIPT_CASE (GetField)
+  {
+    const Value target = base[script_b (instruction)];
+    if (!target.is_object ()) return ScriptStatus::TypeError;
+    const ScriptObject *object = target.as_object ();
+    ScriptFieldSite &site = sites[script_c (instruction)];
+
+    if (object->shape == site.shape) base[script_a (instruction)] = object->slots[site.slot];
+    else
+    {
+      const int32_t slot = object->shape->find (site.symbol);
+      if (slot < 0) base[script_a (instruction)] = Value::nil ();
+      else
+      {
+        site.shape = object->shape;
+        site.next_shape = object->shape;
+        site.slot = uint32_t (slot);
+        base[script_a (instruction)] = object->slots[slot];
+      }
+    }
+    SCRIPT_NEXT ();
+  }
+
+  SCRIPT_CASE (SetField)
+  {
+    const Value target = base[script_a (instruction)];
+    if (!target.is_object ()) return ScriptStatus::TypeError;
+    ScriptObject *object = target.as_object ();
+    ScriptFieldSite &site = sites[script_c (instruction)];
+
+    if (object->shape != site.shape)
+    {
+      ScriptShape *shape = object->shape;
+      const int32_t slot = shape->find (site.symbol);
+      if (slot >= 0) site = { site.symbol, uint32_t (slot), shape, shape };
+      else
+      {
+        if (shape->field_count == SCRIPT_MAX_FIELDS) return ScriptStatus::TooManyFields;
+        ScriptShape *next = transition (shape, site.symbol);
+        if (!next) return ScriptStatus::OutOfMemory;
+        site = { site.symbol, shape->field_count, shape, next };
+      }
+    }
+    object->slots[site.slot] = base[script_b (instruction)];
+    object->shape = site.next_shape;
+    SCRIPT_NEXT ();
+  }
+
+  SCRIPT_CASE (Call)
+  {
+    const uint32_t index = script_b (instruction);
+    if (index >= function_count || functions[index].param_count != script_c (instruction)) return ScriptStatus::BadCall;
+    if (depth == max_depth) return ScriptStatus::StackOverflow;
+
+    const ScriptFunction *callee = &functions[index];
+    Value *callee_base = base + script_a (instruction) + 1;
+    const size_t end = size_t (callee_base - stack.data ()) + callee->register_count;
+    if (end > stack.capacity ()) return ScriptStatus::StackOverflow;
+    stack.reserve (end);
+    for (uint32_t i = callee->param_count; i < callee->register_count; ++i) callee_base[i] = Value::nil ();
+
+    frame_stack[depth++] = { function, pc, base };
+    function = callee;
+    pc = callee->code;
+    constants = callee->constants;
+    sites = callee->sites;
+    base = callee_base;
+    SCRIPT_NEXT ();
+  }
+
+  SCRIPT_CASE (CallNative)
+  {
+    const uint32_t index = script_b (instruction);
+    if (index >= native_count) return ScriptStatus::BadCall;
+
+    Value *args = base + script_a (instruction) + 1;
+    stack_top = base + function->register_count;
+    const uint32_t saved_frames = frame_count;
+    frame_count += depth;
+    Value value;
+    const bool ok = natives[index].func (natives[index].context, args, script_c (instruction), &value);
+    frame_count = saved_frames;
+    if (!ok) return ScriptStatus::NativeError;
+    base[script_a (instruction)] = value;
+    SCRIPT_NEXT ();
+  }
+
+  SCRIPT_CASE (Return)
+  {
+    const Value value = base[script_a (instruction)];
+    if (!depth)
+    {
+      *result = value;
+      return ScriptStatus::Ok;
+    }
+
+    /* 피호출자 창은 호출자의 R[A+1] 에서 시작하므로 결과 자리는 바로 앞 칸 */
+    base[-1] = value;
+    const Frame &frame = frame_stack[--depth];
+    function = frame.function;
+    pc = frame.pc;
+    base = frame.base;
+    constants = function->constants;
+    sites = function->sites;
+    SCRIPT_NEXT ();
+  }
+
+      default:
+        return ScriptStatus::BadCall;
+    }
+  }
+
+#undef SCRIPT_ARITHMETIC
+#undef SCRIPT_COMPARE
+#undef SCRIPT_CASE
+#undef SCRIPT_NEXT
+}
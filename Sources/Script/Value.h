@@ -0,0 +1,53 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+struct ScriptObject;
+
+/* NaN-boxing. double 는 비트 그대로 두고, 나머지 값은 quiet NaN 공간에 태그와 함께 넣음.
+   객체는 부호 비트 + quiet NaN + 48비트 포인터. 산술로 생기는 기본 NaN 은 x86 에서 0xfff8..., ARM 에서 0x7ff8... 이지만
+   호스트가 넘기는 NaN 은 페이로드가 태그 영역에 들어갈 수 있으므로 number 가 모든 NaN 을 0x7ff8... 하나로 바꿈 */
+class Value
+{
+public:
+  Value () : bits (TAG_NIL) {}
+
+  static Value number (double value)
+  {
+    /* -ffast-math 에서는 value != value 가 사라지므로 비트로 판별 */
+    const uint64_t bits = std::bit_cast <uint64_t> (value);
+    return Value ((bits & ~SIGN) > EXPONENT ? CANONICAL_NAN : bits);
+  }
+  static Value nil () { return Value (TAG_NIL); }
+  static Value boolean (bool value) { return Value (value ? TAG_TRUE : TAG_FALSE); }
+  static Value object (ScriptObject *object) { return Value (SIGN | QNAN | reinterpret_cast <uintptr_t> (object)); }
+
+  bool is_number () const { return (bits & QNAN) != QNAN; }
+  bool is_nil () const { return bits == TAG_NIL; }
+  bool is_boolean () const { return (bits | 1) == TAG_TRUE; }
+  bool is_object () const { return (bits & (SIGN | QNAN)) == (SIGN | QNAN); }
+
+  double as_number () const { return std::bit_cast <double> (bits); }
+  bool as_boolean () const { return bits == TAG_TRUE; }
+  ScriptObject *as_object () const { return reinterpret_cast <ScriptObject *> (uintptr_t (bits & ~(SIGN | QNAN))); }
+
+  /* nil 과 false 만 거짓 */
+  bool truthy () const { return bits != TAG_NIL && bits != TAG_FALSE; }
+
+  uint64_t raw () const { return bits; }
+  bool operator== (const Value &) const = default;
+
+private:
+  static constexpr uint64_t SIGN = 0x8000000000000000;
+  static constexpr uint64_t QNAN = 0x7ffc000000000000;
+  static constexpr uint64_t EXPONENT = 0x7ff0000000000000;
+  static constexpr uint64_t CANONICAL_NAN = 0x7ff8000000000000;
+  static constexpr uint64_t TAG_NIL = QNAN | 1;
+  static constexpr uint64_t TAG_FALSE = QNAN | 2;
+  static constexpr uint64_t TAG_TRUE = QNAN | 3;
+
+  explicit Value (uint64_t bits) : bits (bits) {}
+
+  uint64_t bits;
+};
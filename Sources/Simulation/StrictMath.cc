@@ -0,0 +1,53 @@
+#include "Simulation/StrictMath.h"
+
+#include <cmath>
+#include <cstring>
+
+#if defined (__FAST_MATH__)
+#error "Simulation sources must be compiled without fast-math"
+#endif
+
+namespace StrictMath
+{
+  float dot3 (const float *a, const float *b)
+  {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+  }
+
+  float length3 (const float *v)
+  {
+    return std::sqrt (dot3 (v, v));
+  }
+
+  void normalize3 (float *v)
+  {
+    const float length = length3 (v);
+    if (length == 0.0f) return;
+    v[0] /= length;
+    v[1] /= length;
+    v[2] /= length;
+  }
+
+  void integrate (float *position, const float *velocity, const float dt, const size_t count)
+  {
+    for (size_t i = 0; i < count; ++i) position[i] = position[i] + velocity[i] * dt;
+  }
+
+  uint64_t checksum (const void *data, const size_t size, const uint64_t seed)
+  {
+    const auto *bytes = static_cast <const uint8_t *> (data);
+    uint64_t hash = seed ^ 0x9e3779b97f4a7c15ull;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+      uint64_t word;
+      memcpy (&word, bytes + i, 8);
+      hash = (hash ^ word) * 0xff51afd7ed558ccdull;
+      hash ^= hash >> 32;
+    }
+    for (; i < size; ++i) hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    return hash ^ (hash >> 33);
+  }
+} /* namespace StrictMath */
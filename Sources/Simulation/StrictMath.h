@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/* 락스텝 시뮬레이션용 float 연산. StrictMath.cc 는 fast-math 없이(-ffp-contract=off, /fp:strict) 컴파일되며
+   인라인되지 않도록 헤더에는 선언만 둠. 결과는 IEEE 754 기본 연산과 sqrt 만으로 계산 */
+namespace StrictMath
+{
+  float dot3 (const float *a, const float *b);
+  float length3 (const float *v);
+  void normalize3 (float *v);
+
+  /* SoA 배열 적분: position += velocity * dt */
+  void integrate (float *position, const float *velocity, float dt, size_t count);
+
+  /* 동기화 검증용 상태 해시 */
+  uint64_t checksum (const void *data, size_t size, uint64_t seed = 0);
+} /* namespace StrictMath */
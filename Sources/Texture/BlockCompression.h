@@ -0,0 +1,1594 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if __SSE2__
+#include <emmintrin.h>
+#elif __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+/* 블록 압축 포맷의 블록 단위 해제와 압축. 픽셀은 RGBA8 (0xAABBGGRR), stride 는 픽셀 단위 행 간격.
+   BC 포맷은 4x4 블록이고 ASTC 는 포맷마다 블록 크기가 다름 (block_width / block_height).
+   BC4 는 (R, 0, 0, 255), BC5 는 (R, G, 0, 255) 로 풂. BC6H 는 decode_bc6h 로 RGBA16F 를 얻고
+   decode_block 은 [0, 1] 로 자른 RGBA8 을 냄. ASTC 는 LDR 프로필의 2D 블록만 풂 */
+enum class BlockFormat : uint8_t
+{
+  BC1,
+  BC2,
+  BC3,
+  BC4,
+  BC5,
+  BC6H_UF16,
+  BC6H_SF16,
+  BC7,
+  ASTC_4x4,
+  ASTC_5x4,
+  ASTC_5x5,
+  ASTC_6x5,
+  ASTC_6x6,
+  ASTC_8x5,
+  ASTC_8x6,
+  ASTC_8x8,
+  ASTC_10x5,
+  ASTC_10x6,
+  ASTC_10x8,
+  ASTC_10x10,
+  ASTC_12x10,
+  ASTC_12x12,
+};
+
+constexpr uint32_t block_bytes (BlockFormat format)
+{
+  return format == BlockFormat::BC1 || format == BlockFormat::BC4 ? 8 : 16;
+}
+
+constexpr uint32_t block_width (BlockFormat format)
+{
+  switch (format)
+  {
+    case BlockFormat::ASTC_5x4: case BlockFormat::ASTC_5x5: return 5;
+    case BlockFormat::ASTC_6x5: case BlockFormat::ASTC_6x6: return 6;
+    case BlockFormat::ASTC_8x5: case BlockFormat::ASTC_8x6: case BlockFormat::ASTC_8x8: return 8;
+    case BlockFormat::ASTC_10x5: case BlockFormat::ASTC_10x6: case BlockFormat::ASTC_10x8: case BlockFormat::ASTC_10x10: return 10;
+    case BlockFormat::ASTC_12x10: case BlockFormat::ASTC_12x12: return 12;
+    default: return 4;
+  }
+}
+
+constexpr uint32_t block_height (BlockFormat format)
+{
+  switch (format)
+  {
+    case BlockFormat::ASTC_5x5: case BlockFormat::ASTC_6x5: case BlockFormat::ASTC_8x5: case BlockFormat::ASTC_10x5: return 5;
+    case BlockFormat::ASTC_6x6: case BlockFormat::ASTC_8x6: case BlockFormat::ASTC_10x6: return 6;
+    case BlockFormat::ASTC_8x8: case BlockFormat::ASTC_10x8: return 8;
+    case BlockFormat::ASTC_10x10: case BlockFormat::ASTC_12x10: return 10;
+    case BlockFormat::ASTC_12x12: return 12;
+    default: return 4;
+  }
+}
+
+constexpr bool block_is_astc (BlockFormat format) { return format >= BlockFormat::ASTC_4x4; }
+
+void decode_bc1 (const uint8_t *block, uint32_t *out, size_t stride);
+void decode_bc2 (const uint8_t *block, uint32_t *out, size_t stride);
+void decode_bc3 (const uint8_t *block, uint32_t *out, size_t stride);
+void decode_bc4 (const uint8_t *block, uint32_t *out, size_t stride);
+void decode_bc5 (const uint8_t *block, uint32_t *out, size_t stride);
+/* 픽셀은 RGBA16F (R 이 낮은 16 비트, A 는 항상 1.0). is_signed 면 SF16, 아니면 UF16. 예약된 모드는 명세대로 검정 */
+void decode_bc6h (const uint8_t *block, uint64_t *out, size_t stride, bool is_signed);
+/* 잘못된 모드 (첫 바이트가 0) 는 명세대로 투명한 검정 */
+void decode_bc7 (const uint8_t *block, uint32_t *out, size_t stride);
+/* ASTC 명세의 오류 색 (불투명한 자홍) */
+inline constexpr uint32_t ASTC_ERROR_COLOR = 0xffff00ffu;
+/* block_width x block_height (각각 4, 5, 6, 8, 10, 12) 블록 하나. 8 비트 출력은 VK_EXT_astc_decode_mode 의 unorm8 방식으로
+   끝점을 e << 8 | 0x80 으로 넓혀 보간한 상위 8 비트 (sRGB 텍스처도 같은 바이트). HDR 끝점 모드, HDR 단색 블록과
+   잘못된 블록은 ASTC_ERROR_COLOR 로 풂 */
+void decode_astc (const uint8_t *block, uint32_t block_width, uint32_t block_height, uint32_t *out, size_t stride);
+/* out 은 block_width (format) x block_height (format) 픽셀 */
+void decode_block (BlockFormat format, const uint8_t *block, uint32_t *out, size_t stride);
+
+/* 주축 (PCA) 으로 끝점을 잡고 최소제곱으로 한 번 다듬음. 항상 불투명 4 색 모드 */
+void encode_bc1 (const uint32_t *pixels, size_t stride, uint8_t *block);
+/* 빠른 BC7: 모드 6 (부분집합 하나, RGBA 7+1 비트 끝점, 4 비트 색인) 만 씀 */
+void encode_bc7 (const uint32_t *pixels, size_t stride, uint8_t *block);
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  inline uint32_t block_rgba (const uint32_t r, const uint32_t g, const uint32_t b, const uint32_t a)
+  {
+    return r | g << 8 | b << 16 | a << 24;
+  }
+
+  inline uint16_t block_load16 (const uint8_t *p) { return uint16_t (p[0] | p[1] << 8); }
+
+  inline uint64_t block_load64 (const uint8_t *p)
+  {
+    uint64_t value;
+    memcpy (&value, p, sizeof (value));
+    return value;
+  }
+
+  /* 비트 순서를 뒤집음 (ASTC 가중치, BC6H 의 뒤집힌 필드) */
+  inline uint64_t block_reverse64 (uint64_t value)
+  {
+    value = (value >> 1 & 0x5555555555555555ull) | (value & 0x5555555555555555ull) << 1;
+    value = (value >> 2 & 0x3333333333333333ull) | (value & 0x3333333333333333ull) << 2;
+    value = (value >> 4 & 0x0f0f0f0f0f0f0f0full) | (value & 0x0f0f0f0f0f0f0f0full) << 4;
+    return __builtin_bswap64 (value);
+  }
+
+  /* 565 -> 888 */
+  inline void block_unpack565 (const uint16_t color, uint32_t *rgb)
+  {
+    const uint32_t r = color >> 11, g = (color >> 5) & 0x3f, b = color & 0x1f;
+    rgb[0] = r << 3 | r >> 2;
+    rgb[1] = g << 2 | g >> 4;
+    rgb[2] = b << 3 | b >> 2;
+  }
+
+  /* 색 부분 (BC1/2/3 공통). four_color 가 거짓이면 c0 <= c1 일 때 3 색 + 투명 모드 */
+  inline void block_decode_color (const uint8_t *block, uint32_t *out, const size_t stride, const bool allow_transparent)
+  {
+    const uint16_t c0 = block_load16 (block), c1 = block_load16 (block + 2);
+    uint32_t e0[3], e1[3];
+    block_unpack565 (c0, e0);
+    block_unpack565 (c1, e1);
+
+    uint32_t palette[4];
+    palette[0] = block_rgba (e0[0], e0[1], e0[2], 255);
+    palette[1] = block_rgba (e1[0], e1[1], e1[2], 255);
+    if (c0 > c1 || !allow_transparent)
+    {
+      palette[2] = block_rgba ((2 * e0[0] + e1[0]) / 3, (2 * e0[1] + e1[1]) / 3, (2 * e0[2] + e1[2]) / 3, 255);
+      palette[3] = block_rgba ((e0[0] + 2 * e1[0]) / 3, (e0[1] + 2 * e1[1]) / 3, (e0[2] + 2 * e1[2]) / 3, 255);
+    }
+    else
+    {
+      palette[2] = block_rgba ((e0[0] + e1[0]) / 2, (e0[1] + e1[1]) / 2, (e0[2] + e1[2]) / 2, 255);
+      palette[3] = 0;
+    }
+
+    uint32_t indices;
+    memcpy (&indices, block + 4, sizeof (indices));
+    for (uint32_t y = 0; y < 4; ++y)
+      for (uint32_t x = 0; x < 4; ++x) out[y * stride + x] = palette[(indices >> (2 * (y * 4 + x))) & 3];
+  }
+
+  /* BC4 한 채널 값 16 개 */
+  inline void block_decode_alpha (const uint8_t *block, uint8_t *values)
+  {
+    const uint32_t a0 = block[0], a1 = block[1];
+    uint8_t palette[8];
+    palette[0] = uint8_t (a0);
+    palette[1] = uint8_t (a1);
+    if (a0 > a1)
+      for (uint32_t i = 1; i < 7; ++i) palette[i + 1] = uint8_t (((7 - i) * a0 + i * a1) / 7);
+    else
+    {
+      for (uint32_t i = 1; i < 5; ++i) palette[i + 1] = uint8_t (((5 - i) * a0 + i * a1) / 5);
+      palette[6] = 0;
+      palette[7] = 255;
+    }
+
+    const uint64_t indices = block_load64 (block) >> 16;
+    for (uint32_t i = 0; i < 16; ++i) values[i] = palette[(indices >> (3 * i)) & 7];
+  }
+
+  /* 텍셀 count 개를 채널마다 ((64 - w) * e0 + w * e1 + 32) >> 6 으로 섞음. 끝점과 가중치 (0~64) 는 채널마다 한 바이트씩 묶은 값.
+     BC7 과 ASTC 해제의 마지막 단계라 SSE2 / NEON 으로 텍셀 넷씩 처리 */
+  inline void block_blend (const uint32_t *e0, const uint32_t *e1, const uint32_t *weights, uint32_t *out, const uint32_t count)
+  {
+    uint32_t i = 0;
+#if __SSE2__
+    const __m128i zero = _mm_setzero_si128 (), full = _mm_set1_epi16 (64), round = _mm_set1_epi16 (32);
+    for (; i + 4 <= count; i += 4)
+    {
+      const __m128i a = _mm_loadu_si128 (reinterpret_cast <const __m128i *> (e0 + i));
+      const __m128i b = _mm_loadu_si128 (reinterpret_cast <const __m128i *> (e1 + i));
+      const __m128i w = _mm_loadu_si128 (reinterpret_cast <const __m128i *> (weights + i));
+      const __m128i w_low = _mm_unpacklo_epi8 (w, zero), w_high = _mm_unpackhi_epi8 (w, zero);
+      __m128i low = _mm_add_epi16 (_mm_mullo_epi16 (_mm_unpacklo_epi8 (a, zero), _mm_sub_epi16 (full, w_low)),
+                                   _mm_mullo_epi16 (_mm_unpacklo_epi8 (b, zero), w_low));
+      __m128i high = _mm_add_epi16 (_mm_mullo_epi16 (_mm_unpackhi_epi8 (a, zero), _mm_sub_epi16 (full, w_high)),
+                                    _mm_mullo_epi16 (_mm_unpackhi_epi8 (b, zero), w_high));
+      low = _mm_srli_epi16 (_mm_add_epi16 (low, round), 6);
+      high = _mm_srli_epi16 (_mm_add_epi16 (high, round), 6);
+      _mm_storeu_si128 (reinterpret_cast <__m128i *> (out + i), _mm_packus_epi16 (low, high));
+    }
+#elif __ARM_NEON
+    for (; i + 4 <= count; i += 4)
+    {
+      const uint8x16_t a = vld1q_u8 (reinterpret_cast <const uint8_t *> (e0 + i));
+      const uint8x16_t b = vld1q_u8 (reinterpret_cast <const uint8_t *> (e1 + i));
+      const uint8x16_t w = vld1q_u8 (reinterpret_cast <const uint8_t *> (weights + i));
+      const uint8x16_t inverse = vsubq_u8 (vdupq_n_u8 (64), w);
+      const uint16x8_t low = vmlal_u8 (vmull_u8 (vget_low_u8 (a), vget_low_u8 (inverse)), vget_low_u8 (b), vget_low_u8 (w));
+      const uint16x8_t high = vmlal_u8 (vmull_u8 (vget_high_u8 (a), vget_high_u8 (inverse)), vget_high_u8 (b), vget_high_u8 (w));
+      vst1q_u8 (reinterpret_cast <uint8_t *> (out + i), vcombine_u8 (vrshrn_n_u16 (low, 6), vrshrn_n_u16 (high, 6)));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+      uint32_t pixel = 0;
+      for (uint32_t c = 0; c < 32; c += 8)
+      {
+        const uint32_t w = (weights[i] >> c) & 0xff;
+        pixel |= (((64 - w) * ((e0[i] >> c) & 0xff) + w * ((e1[i] >> c) & 0xff) + 32) >> 6) << c;
+      }
+      out[i] = pixel;
+    }
+  }
+
+  struct BC7Mode
+  {
+    uint8_t subsets;
+    uint8_t partition_bits;
+    uint8_t rotation_bits;
+    uint8_t selection_bits;
+    uint8_t color_bits;
+    uint8_t alpha_bits;
+    uint8_t endpoint_pbits;
+    uint8_t shared_pbits;
+    uint8_t index_bits;
+    uint8_t index_bits2;
+  };
+
+  inline constexpr BC7Mode BC7_MODES[8] = {
+    { 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+    { 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+    { 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+    { 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+    { 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+    { 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+    { 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+    { 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+  };
+
+  /* 픽셀 i 의 부분집합. 두 개짜리는 비트 i, 세 개짜리는 2 비트씩 */
+  inline constexpr uint16_t BC7_PARTITIONS2[64] = {
+    0xcccc, 0x8888, 0xeeee, 0xecc8, 0xc880, 0xfeec, 0xfec8, 0xec80,
+    0xc800, 0xffec, 0xfe80, 0xe800, 0xffe8, 0xff00, 0xfff0, 0xf000,
+    0xf710, 0x008e, 0x7100, 0x08ce, 0x008c, 0x7310, 0x3100, 0x8cce,
+    0x088c, 0x3110, 0x6666, 0x366c, 0x17e8, 0x0ff0, 0x718e, 0x399c,
+    0xaaaa, 0xf0f0, 0x5a5a, 0x33cc, 0x3c3c, 0x55aa, 0x9696, 0xa55a,
+    0x73ce, 0x13c8, 0x324c, 0x3bdc, 0x6996, 0xc33c, 0x9966, 0x0660,
+    0x0272, 0x04e4, 0x4e40, 0x2720, 0xc936, 0x936c, 0x39c6, 0x639c,
+    0x9336, 0x9cc6, 0x817e, 0xe718, 0xccf0, 0x0fcc, 0x7744, 0xee22,
+  };
+
+  inline constexpr uint32_t BC7_PARTITIONS3[64] = {
+    0xaa685050, 0x6a5a5040, 0x5a5a4200, 0x5450a0a8, 0xa5a50000, 0xa0a05050, 0x5555a0a0, 0x5a5a5050,
+    0xaa550000, 0xaa555500, 0xaaaa5500, 0x90909090, 0x94949494, 0xa4a4a4a4, 0xa9a59450, 0x2a0a4250,
+    0xa5945040, 0x0a425054, 0xa5a5a500, 0x55a0a0a0, 0xa8a85454, 0x6a6a4040, 0xa4a45000, 0x1a1a0500,
+    0x0050a4a4, 0xaaa59090, 0x14696914, 0x69691400, 0xa08585a0, 0xaa821414, 0x50a4a450, 0x6a5a0200,
+    0xa9a58000, 0x5090a0a8, 0xa8a09050, 0x24242424, 0x00aa5500, 0x24924924, 0x24499224, 0x50a50a50,
+    0x500aa550, 0xaaaa4444, 0x66660000, 0xa5a0a5a0, 0x50a050a0, 0x69286928, 0x44aaaa44, 0x66666600,
+    0xaa444444, 0x54a854a8, 0x95809580, 0x96969600, 0xa85454a8, 0x80959580, 0xaa141414, 0x96960000,
+    0xaaaa1414, 0xa05050a0, 0xa0a5a5a0, 0x96000000, 0x40804080, 0xa9a8a9a8, 0xaaaaaa44, 0x2a4a5254,
+  };
+
+  /* 각 부분집합의 기준 픽셀 (색인 최상위 비트를 생략). 첫 부분집합은 항상 0 */
+  inline constexpr uint8_t BC7_ANCHORS2[64] = {
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 2, 8, 2, 2, 8, 8, 15, 2, 8, 2, 2, 8, 8, 2, 2,
+    15, 15, 6, 8, 2, 8, 15, 15, 2, 8, 2, 2, 2, 15, 15, 6,
+    6, 2, 6, 8, 15, 15, 2, 2, 15, 15, 15, 15, 15, 2, 2, 15,
+  };
+
+  inline constexpr uint8_t BC7_ANCHORS3_SECOND[64] = {
+    3, 3, 15, 15, 8, 3, 15, 15, 8, 8, 6, 6, 6, 5, 3, 3,
+    3, 3, 8, 15, 3, 3, 6, 10, 5, 8, 8, 6, 8, 5, 15, 15,
+    8, 15, 3, 5, 6, 10, 8, 15, 15, 3, 15, 5, 15, 15, 15, 15,
+    3, 15, 5, 5, 5, 8, 5, 10, 5, 10, 8, 13, 15, 12, 3, 3,
+  };
+
+  inline constexpr uint8_t BC7_ANCHORS3_THIRD[64] = {
+    15, 8, 8, 3, 15, 15, 3, 8, 15, 15, 15, 15, 15, 15, 15, 8,
+    15, 8, 15, 3, 15, 8, 15, 8, 3, 15, 6, 10, 15, 15, 10, 8,
+    15, 3, 15, 10, 10, 8, 9, 10, 6, 15, 8, 15, 3, 6, 6, 8,
+    15, 3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 3, 15, 15, 8,
+  };
+
+  inline constexpr uint8_t BC7_WEIGHTS2[4] = { 0, 21, 43, 64 };
+  inline constexpr uint8_t BC7_WEIGHTS3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+  inline constexpr uint8_t BC7_WEIGHTS4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+  inline const uint8_t *bc7_weights (const uint32_t bits)
+  {
+    return bits == 2 ? BC7_WEIGHTS2 : bits == 3 ? BC7_WEIGHTS3 : BC7_WEIGHTS4;
+  }
+
+  /* 128 비트 블록을 낮은 비트부터 차례로 읽고 씀 */
+  struct BC7Bits
+  {
+    uint64_t low;
+    uint64_t high;
+    uint32_t position;
+
+    uint32_t read (const uint32_t count)
+    {
+      if (!count) return 0;
+      const uint64_t mask = (uint64_t (1) << count) - 1;
+      uint64_t value;
+      if (position >= 64) value = high >> (position - 64);
+      else if (position + count <= 64) value = low >> position;
+      else value = low >> position | high << (64 - position);
+      position += count;
+      return uint32_t (value & mask);
+    }
+
+    void write (const uint32_t value, const uint32_t count)
+    {
+      const uint64_t bits = value & ((uint64_t (1) << count) - 1);
+      if (position >= 64) high |= bits << (position - 64);
+      else
+      {
+        low |= bits << position;
+        if (position + count > 64) high |= bits >> (64 - position);
+      }
+      position += count;
+    }
+  };
+
+  /* BC6H 끝점 필드. w, x 는 첫 부분집합, y, z 는 둘째 부분집합의 두 끝점이고 D 는 분할 번호 */
+  enum BC6HField : uint8_t
+  {
+    BC6H_RW, BC6H_GW, BC6H_BW, BC6H_RX, BC6H_GX, BC6H_BX, BC6H_RY, BC6H_GY, BC6H_BY, BC6H_RZ, BC6H_GZ, BC6H_BZ, BC6H_D,
+  };
+
+  /* count 에 이 비트가 있으면 비트 순서가 뒤집힌 필드 (rw[10:15] 처럼 높은 비트가 먼저 나옴) */
+  inline constexpr uint8_t BC6H_REVERSED = 0x80;
+
+  /* 모드 비트 다음부터 블록에 놓인 순서대로 (필드, 필드 안 시작 비트, 비트 수). count 0 이 끝 */
+  struct BC6HBits
+  {
+    uint8_t field;
+    uint8_t shift;
+    uint8_t count;
+  };
+
+  inline constexpr BC6HBits BC6H_LAYOUTS[14][25] = {
+    { { BC6H_GY, 4, 1 }, { BC6H_BY, 4, 1 }, { BC6H_BZ, 4, 1 }, { BC6H_RW, 0, 10 }, { BC6H_GW, 0, 10 }, { BC6H_BW, 0, 10 },
+      { BC6H_RX, 0, 5 }, { BC6H_GZ, 4, 1 }, { BC6H_GY, 0, 4 }, { BC6H_GX, 0, 5 }, { BC6H_BZ, 0, 1 }, { BC6H_GZ, 0, 4 },
+      { BC6H_BX, 0, 5 }, { BC6H_BZ, 1, 1 }, { BC6H_BY, 0, 4 }, { BC6H_RY, 0, 5 }, { BC6H_BZ, 2, 1 }, { BC6H_RZ, 0, 5 },
+      { BC6H_BZ, 3, 1 }, { BC6H_D, 0, 5 } },
+    { { BC6H_GY, 5, 1 }, { BC6H_GZ, 4, 1 }, { BC6H_GZ, 5, 1 }, { BC6H_RW, 0, 7 }, { BC6H_BZ, 0, 1 }, { BC6H_BZ, 1, 1 },
+      { BC6H_BY, 4, 1 }, { BC6H_GW, 0, 7 }, { BC6H_BY, 5, 1 }, { BC6H_BZ, 2, 1 }, { BC6H_GY, 4, 1 }, { BC6H_BW, 0, 7 },
+      { BC6H_BZ, 3, 1 }, { BC6H_BZ, 5, 1 }, { BC6H_BZ, 4, 1 }, { BC6H_RX, 0, 6 }, { BC6H_GY, 0, 4 }, { BC6H_GX, 0, 6 },
+      { BC6H_GZ, 0, 4 }, { BC6H_BX, 0, 6 }, { BC6H_BY, 0, 4 }, { BC6H_RY, 0, 6 }, { BC6H_RZ, 0, 6 }, { BC6H_D, 0, 5 } },
+    { { BC6H_RW, 0, 10 }, { BC6H_GW, 0, 10 }, { BC6H_BW, 0, 10 }, { BC6H_RX, 0, 5 }, { BC6H_RW, 10, 1 }, { BC6H_GY, 0, 4 },
+      { BC6H_GX, 0, 4 }, { BC6H_GW, 10, 1 }, { BC6H_BZ, 0, 1 }, { BC6H_GZ, 0, 4 }, { BC6H_BX, 0, 4 }, { BC6H_BW, 10, 1 },
+      { BC6H_BZ, 1, 1 }, { BC6H_BY, 0, 4 }, { BC6H_RY, 0, 5 }, { BC6H_BZ, 2, 1 }, { BC6H_RZ, 0, 5 }, { BC6H_BZ, 3, 1 },
+      { BC6H_D, 0, 5 } },
+    { { BC6H_RW, 0, 10 }, { BC6H_GW, 0, 10 }, { BC6H_BW, 0, 10 }, { BC6H_RX, 0, 4 }, { BC6H_RW, 10, 1 }, { BC6H_GZ, 4, 1 },
+      { BC6H_GY, 0, 4 }, { BC6H_GX, 0, 5 }, { BC6H_GW, 10, 1 }, { BC6H_GZ, 0, 4 }, { BC6H_BX, 0, 4 }, { BC6H_BW, 10, 1 },
+      { BC6H_BZ, 1, 1 }, { BC6H_BY, 0, 4 }, { BC6H_RY, 0, 4 }, { BC6H_BZ, 0, 1 }, { BC6H_BZ, 2, 1 }, { BC6H_RZ, 0, 4 },
+      { BC6H_GY, 4, 1 }, { BC6H_BZ, 3, 1 }, { BC6H_D, 0, 5 } },
+    { { BC6H_RW, 0, 10 }, { BC6H_GW, 0, 10 }, { BC6H_BW, 0, 10 }, { BC6H_RX, 0, 4 }, { BC6H_RW, 10, 1 }, { BC6H_BY, 4, 1 },
+      { BC6H_GY, 0, 4 }, { BC6H_GX, 0, 4 }, { BC6H_GW, 10, 1 }, { BC6H_BZ, 0, 1 }, { BC6H_GZ, 0, 4 }, { BC6H_BX, 0, 5 },
+      { BC6H_BW, 10, 1 }, { BC6H_BY, 0, 4 }, { BC6H_RY, 0, 4 }, { BC6H_BZ, 1, 1 }, { BC6H_BZ, 2, 1 }, { BC6H_RZ, 0, 4 },
+      { BC6H_BZ, 4, 1 }, { BC6H_BZ, 3, 1 }, { BC6H_D, 0, 5 } },
+    { { BC6H_RW, 0, 9 }, { BC6H_BY, 4, 1 }, { BC6H_GW, 0, 9 }, { BC6H_GY, 4, 1 }, { BC6H_BW, 0, 9 }, { BC6H_BZ, 4, 1 },
+      { BC6H_RX, 0, 5 }, { BC6H_GZ, 4, 1 }, { BC6H_GY, 0, 4 }, { BC6H_GX, 0, 5 }, { BC6H_BZ, 0, 1 }, { BC6H_GZ, 0, 4 },
+      { BC6H_BX, 0, 5 }, { BC6H_BZ, 1, 1 }, { BC6H_BY, 0, 4 }, { BC6H_RY, 0, 5 }, { BC6H_BZ, 2, 1 }, { BC6H_RZ, 0, 5 },
+      { BC6H_BZ, 3, 1 }, { BC6H_D, 0, 5 } },
+    { { BC6H_RW, 0, 8 }, { BC6H_GZ, 4, 1 }, { BC6H_BY, 4, 1 }, { BC6H_GW, 0, 8 }, { BC6H_BZ, 2, 1 }, { BC6H_GY, 4, 1 },
+      { BC6H_BW, 0, 8 }, { BC6H_BZ, 3, 1 }, { BC6H_BZ, 4, 1 }, { BC6H_RX, 0, 6 }, { BC6H_GY, 0, 4 }, { BC6H_GX, 0, 5 },
+      { BC6H_BZ, 0, 1 }, { BC6H_GZ, 0, 4 }, { BC6H_BX, 0, 5 }, { BC6H_BZ, 1, 1 }, { BC6H_BY, 0, 4 }, { BC6H_RY, 0, 6 },
+      { BC6H_RZ, 0, 6 }, { BC6H_D, 0, 5 } },
+    { { BC6H_RW, 0, 8 }, { BC6H_BZ, 0, 1 }, { BC6H_BY, 4, 1 }, { BC6H_GW, 0, 8 }, { BC6H_GY, 5, 1 }, { BC6H_GY, 4, 1 },
+      { BC6H_BW, 0, 8 }, { BC6H_GZ, 5, 1 }, { BC6H_BZ, 4, 1 }, { BC6H_RX, 0, 5 }, { BC6H_GZ, 4, 1 }, { BC6H_GY, 0, 4 },
+      { BC6H_GX, 0, 6 }, { BC6H_GZ, 0, 4 }, { BC6H_BX, 0, 5 }, { BC6H_BZ, 1, 1 }, { BC6H_BY, 0, 4 }, { BC6H_RY, 0, 5 },
+      { BC6H_BZ, 2, 1 }, { BC6H_RZ, 0, 5 }, { BC6H_BZ, 3, 1 }, { BC6H_D, 0, 5 } },
+    { { BC6H_RW, 0, 8 }, { BC6H_BZ, 1, 1 }, { BC6H_BY, 4, 1 }, { BC6H_GW, 0, 8 }, { BC6H_BY, 5, 1 }, { BC6H_GY, 4, 1 },
+      { BC6H_BW, 0, 8 }, { BC6H_BZ, 5, 1 }, { BC6H_BZ, 4, 1 }, { BC6H_RX, 0, 5 }, { BC6H_GZ, 4, 1 }, { BC6H_GY, 0, 4 },
+      { BC6H_GX, 0, 5 }, { BC6H_BZ, 0, 1 }, { BC6H_GZ, 0, 4 }, { BC6H_BX, 0, 6 }, { BC6H_BY, 0, 4 }, { BC6H_RY, 0, 5 },
+      { BC6H_BZ, 2, 1 }, { BC6H_RZ, 0, 5 }, { BC6H_BZ, 3, 1 }, { BC6H_D, 0, 5 } },
+    { { BC6H_RW, 0, 6 }, { BC6H_GZ, 4, 1 }, { BC6H_BZ, 0, 1 }, { BC6H_BZ, 1, 1 }, { BC6H_BY, 4, 1 }, { BC6H_GW, 0, 6 },
+      { BC6H_GY, 5, 1 }, { BC6H_BY, 5, 1 }, { BC6H_BZ, 2, 1 }, { BC6H_GY, 4, 1 }, { BC6H_BW, 0, 6 }, { BC6H_GZ, 5, 1 },
+      { BC6H_BZ, 3, 1 }, { BC6H_BZ, 5, 1 }, { BC6H_BZ, 4, 1 }, { BC6H_RX, 0, 6 }, { BC6H_GY, 0, 4 }, { BC6H_GX, 0, 6 },
+      { BC6H_GZ, 0, 4 }, { BC6H_BX, 0, 6 }, { BC6H_BY, 0, 4 }, { BC6H_RY, 0, 6 }, { BC6H_RZ, 0, 6 }, { BC6H_D, 0, 5 } },
+    { { BC6H_RW, 0, 10 }, { BC6H_GW, 0, 10 }, { BC6H_BW, 0, 10 }, { BC6H_RX, 0, 10 }, { BC6H_GX, 0, 10 }, { BC6H_BX, 0, 10 } },
+    { { BC6H_RW, 0, 10 }, { BC6H_GW, 0, 10 }, { BC6H_BW, 0, 10 }, { BC6H_RX, 0, 9 }, { BC6H_RW, 10, 1 }, { BC6H_GX, 0, 9 },
+      { BC6H_GW, 10, 1 }, { BC6H_BX, 0, 9 }, { BC6H_BW, 10, 1 } },
+    { { BC6H_RW, 0, 10 }, { BC6H_GW, 0, 10 }, { BC6H_BW, 0, 10 }, { BC6H_RX, 0, 8 }, { BC6H_RW, 10, 2 | BC6H_REVERSED },
+      { BC6H_GX, 0, 8 }, { BC6H_GW, 10, 2 | BC6H_REVERSED }, { BC6H_BX, 0, 8 }, { BC6H_BW, 10, 2 | BC6H_REVERSED } },
+    { { BC6H_RW, 0, 10 }, { BC6H_GW, 0, 10 }, { BC6H_BW, 0, 10 }, { BC6H_RX, 0, 4 }, { BC6H_RW, 10, 6 | BC6H_REVERSED },
+      { BC6H_GX, 0, 4 }, { BC6H_GW, 10, 6 | BC6H_REVERSED }, { BC6H_BX, 0, 4 }, { BC6H_BW, 10, 6 | BC6H_REVERSED } },
+  };
+
+  struct BC6HMode
+  {
+    uint8_t subsets;
+    uint8_t transformed;
+    uint8_t endpoint_bits;
+    uint8_t delta_bits[3];
+  };
+
+  inline constexpr BC6HMode BC6H_MODES[14] = {
+    { 2, 1, 10, { 5, 5, 5 } },    { 2, 1, 7, { 6, 6, 6 } },     { 2, 1, 11, { 5, 4, 4 } },    { 2, 1, 11, { 4, 5, 4 } },
+    { 2, 1, 11, { 4, 4, 5 } },    { 2, 1, 9, { 5, 5, 5 } },     { 2, 1, 8, { 6, 5, 5 } },     { 2, 1, 8, { 5, 6, 5 } },
+    { 2, 1, 8, { 5, 5, 6 } },     { 2, 0, 6, { 6, 6, 6 } },     { 1, 0, 10, { 10, 10, 10 } }, { 1, 1, 11, { 9, 9, 9 } },
+    { 1, 1, 12, { 8, 8, 8 } },    { 1, 1, 16, { 4, 4, 4 } },
+  };
+
+  /* 다섯 비트 모드 값 -> 모드 번호. 0xff 는 예약된 모드. 낮은 두 비트가 00 / 01 이면 두 비트 모드 (0, 1) */
+  inline constexpr uint8_t BC6H_MODE_INDICES[32] = {
+    0, 1, 2, 10, 0, 1, 3, 11, 0, 1, 4, 12, 0, 1, 5, 13, 0, 1, 6, 0xff, 0, 1, 7, 0xff, 0, 1, 8, 0xff, 0, 1, 9, 0xff,
+  };
+
+  inline int32_t bc6h_sign_extend (const int32_t value, const uint32_t bits)
+  {
+    const int32_t shift = 32 - int32_t (bits);
+    return int32_t (uint32_t (value) << shift) >> shift;
+  }
+
+  /* 양자화된 끝점을 16 비트 (부호 있으면 부호 포함 15 비트) 로 넓힘 */
+  inline int32_t bc6h_unquantize (const int32_t value, const uint32_t bits, const bool is_signed)
+  {
+    if (!is_signed)
+    {
+      if (bits >= 15 || !value) return value;
+      if (value == (1 << bits) - 1) return 0xffff;
+      return ((value << 16) + 0x8000) >> bits;
+    }
+    if (bits >= 16) return value;
+    const int32_t magnitude = value < 0 ? -value : value;
+    int32_t result;
+    if (!magnitude) result = 0;
+    else if (magnitude >= (1 << (bits - 1)) - 1) result = 0x7fff;
+    else result = ((magnitude << 15) + 0x4000) >> (bits - 1);
+    return value < 0 ? -result : result;
+  }
+
+  /* 보간한 값 -> half 비트. 31/64 (부호 있으면 31/32) 배 해서 무한대와 NaN 이 나오지 않게 함 */
+  inline uint32_t bc6h_finish (const int32_t value, const bool is_signed)
+  {
+    if (!is_signed) return uint32_t (value * 31) >> 6;
+    return value < 0 ? 0x8000u | uint32_t ((-value * 31) >> 5) : uint32_t ((value * 31) >> 5);
+  }
+
+  inline uint32_t block_half_to_unorm8 (const uint32_t half)
+  {
+    if (half & 0x8000) return 0;
+    const uint32_t exponent = half >> 10, mantissa = half & 0x3ff;
+    const float value = exponent ? ldexpf (float (mantissa | 0x400), int32_t (exponent) - 25) : ldexpf (float (mantissa), -24);
+    return value >= 1.0f ? 255 : uint32_t (value * 255.0f + 0.5f);
+  }
+
+  /* ASTC 정수열 부호화 (ISE) 의 값 범위. 값 하나가 bits 비트에 3 진 (trit) 또는 5 진 (quint) 자리 하나를 더 가짐.
+     순서는 범위 2, 3, 4, 5, 6, 8, 10, 12, 16, 20, 24, 32, 40, 48, 64, 80, 96, 128, 160, 192, 256 */
+  struct AstcRange
+  {
+    uint8_t bits;
+    uint8_t trit;
+    uint8_t quint;
+  };
+
+  inline constexpr AstcRange ASTC_RANGES[21] = {
+    { 1, 0, 0 }, { 0, 1, 0 }, { 2, 0, 0 }, { 0, 0, 1 }, { 1, 1, 0 }, { 3, 0, 0 }, { 1, 0, 1 },
+    { 2, 1, 0 }, { 4, 0, 0 }, { 2, 0, 1 }, { 3, 1, 0 }, { 5, 0, 0 }, { 3, 0, 1 }, { 4, 1, 0 },
+    { 6, 0, 0 }, { 4, 0, 1 }, { 5, 1, 0 }, { 7, 0, 0 }, { 5, 0, 1 }, { 6, 1, 0 }, { 8, 0, 0 },
+  };
+
+  /* 끝점 색은 범위 6 부터 */
+  inline constexpr uint32_t ASTC_MIN_COLOR_RANGE = 4;
+  inline constexpr uint32_t ASTC_MAX_TEXELS = 144;
+  inline constexpr uint32_t ASTC_MAX_WEIGHTS = 64;
+
+  constexpr uint32_t astc_ise_bits (const AstcRange range, const uint32_t count)
+  {
+    return count * range.bits + (range.trit ? (8 * count + 4) / 5 : range.quint ? (7 * count + 2) / 3 : 0);
+  }
+
+  /* 8 비트 T 로 묶인 3 진 자리 다섯, 7 비트 Q 로 묶인 5 진 자리 셋 (명세의 비트 조작을 미리 표로) */
+  struct AstcDigits
+  {
+    uint8_t trits[256][5];
+    uint8_t quints[128][3];
+  };
+
+  constexpr AstcDigits astc_make_digits ()
+  {
+    AstcDigits digits = {};
+    for (uint32_t t = 0; t < 256; ++t)
+    {
+      auto bit = [t] (const uint32_t i) { return (t >> i) & 1; };
+      uint32_t c, t4, t3, t2, t1, t0;
+      if (((t >> 2) & 7) == 7)
+      {
+        c = (t >> 5 & 7) << 2 | (t & 3);
+        t4 = t3 = 2;
+      }
+      else
+      {
+        c = t & 0x1f;
+        if (((t >> 5) & 3) == 3)
+        {
+          t4 = 2;
+          t3 = bit (7);
+        }
+        else
+        {
+          t4 = bit (7);
+          t3 = t >> 5 & 3;
+        }
+      }
+      if ((c & 3) == 3)
+      {
+        t2 = 2;
+        t1 = c >> 4 & 1;
+        t0 = (c >> 3 & 1) << 1 | ((c >> 2) & ~(c >> 3) & 1);
+      }
+      else if (((c >> 2) & 3) == 3)
+      {
+        t2 = t1 = 2;
+        t0 = c & 3;
+      }
+      else
+      {
+        t2 = c >> 4 & 1;
+        t1 = c >> 2 & 3;
+        t0 = (c >> 1 & 1) << 1 | (c & ~(c >> 1) & 1);
+      }
+      const uint32_t values[5] = { t0, t1, t2, t3, t4 };
+      for (uint32_t i = 0; i < 5; ++i) digits.trits[t][i] = uint8_t (values[i]);
+    }
+    for (uint32_t q = 0; q < 128; ++q)
+    {
+      uint32_t q2, q1, q0;
+      if (((q >> 1) & 3) == 3 && !((q >> 5) & 3))
+      {
+        q2 = (q & 1) << 2 | ((q >> 4) & ~q & 1) << 1 | ((q >> 3) & ~q & 1);
+        q1 = q0 = 4;
+      }
+      else
+      {
+        uint32_t c;
+        if (((q >> 1) & 3) == 3)
+        {
+          q2 = 4;
+          c = (q >> 3 & 3) << 3 | (~q >> 5 & 3) << 1 | (q & 1);
+        }
+        else
+        {
+          q2 = q >> 5 & 3;
+          c = q & 0x1f;
+        }
+        if ((c & 7) == 5)
+        {
+          q1 = 4;
+          q0 = c >> 3 & 3;
+        }
+        else
+        {
+          q1 = c >> 3 & 3;
+          q0 = c & 7;
+        }
+      }
+      digits.quints[q][0] = uint8_t (q0);
+      digits.quints[q][1] = uint8_t (q1);
+      digits.quints[q][2] = uint8_t (q2);
+    }
+    return digits;
+  }
+
+  inline constexpr AstcDigits ASTC_DIGITS = astc_make_digits ();
+
+  /* ISE 값 -> 끝점 색 (0~255) 과 가중치 (0~64). 3 진 / 5 진 범위는 명세의 A, B, C 비트 섞기로 순서가 뒤섞임 */
+  struct AstcUnquantize
+  {
+    uint8_t colors[21][256];
+    uint8_t weights[12][32];
+  };
+
+  constexpr AstcUnquantize astc_make_unquantize ()
+  {
+    AstcUnquantize table = {};
+    for (uint32_t r = 0; r < 21; ++r)
+    {
+      const AstcRange range = ASTC_RANGES[r];
+      const uint32_t count = (1u << range.bits) * (range.trit ? 3 : range.quint ? 5 : 1);
+      for (uint32_t value = 0; value < count; ++value)
+      {
+        const uint32_t low = value & ((1u << range.bits) - 1), digit = value >> range.bits;
+        auto bit = [low] (const uint32_t i) { return (low >> i) & 1; };
+        const uint32_t a = bit (0), b = bit (1), c = bit (2), d = bit (3), e = bit (4), f = bit (5);
+
+        uint32_t color;
+        if (!range.trit && !range.quint)
+        {
+          color = 0;
+          for (int32_t shift = 8 - range.bits; shift > -int32_t (range.bits); shift -= range.bits)
+            color |= shift >= 0 ? low << shift : low >> -shift;
+        }
+        else
+        {
+          uint32_t scramble = 0, scale = 0;
+          if (range.trit)
+            switch (range.bits)
+            {
+              case 1: scale = 204; break;
+              case 2: scale = 93; scramble = b << 8 | b << 4 | b << 2 | b << 1; break;
+              case 3: scale = 44; scramble = c << 8 | b << 7 | c << 3 | b << 2 | c << 1 | b; break;
+              case 4: scale = 22; scramble = d << 8 | c << 7 | b << 6 | d << 2 | c << 1 | b; break;
+              case 5: scale = 11; scramble = e << 8 | d << 7 | c << 6 | b << 5 | e << 1 | d; break;
+              case 6: scale = 5; scramble = f << 8 | e << 7 | d << 6 | c << 5 | b << 4 | f; break;
+            }
+          else
+            switch (range.bits)
+            {
+              case 1: scale = 113; break;
+              case 2: scale = 54; scramble = b << 8 | b << 3 | b << 2; break;
+              case 3: scale = 26; scramble = c << 8 | b << 7 | c << 2 | b << 1 | c; break;
+              case 4: scale = 13; scramble = d << 8 | c << 7 | b << 6 | d << 1 | c; break;
+              case 5: scale = 6; scramble = e << 8 | d << 7 | c << 6 | b << 5 | e; break;
+            }
+          const uint32_t mask = a ? 0x1ff : 0;
+          color = scale ? (mask & 0x80) | ((digit * scale + scramble) ^ mask) >> 2 : 0;
+        }
+        table.colors[r][value] = uint8_t (color);
+
+        if (r >= 12) continue;
+        uint32_t weight;
+        if (!range.trit && !range.quint)
+        {
+          weight = 0;
+          for (int32_t shift = 6 - range.bits; shift > -int32_t (range.bits); shift -= range.bits)
+            weight |= shift >= 0 ? low << shift : low >> -shift;
+        }
+        else if (!range.bits) weight = digit * (range.trit ? 32 : 16);
+        else
+        {
+          uint32_t scramble = 0, scale;
+          if (range.trit)
+            scale = range.bits == 1 ? 50 : range.bits == 2 ? 23 : 11;
+          else
+            scale = range.bits == 1 ? 28 : 13;
+          if (range.trit && range.bits == 2) scramble = b << 6 | b << 2 | b;
+          if (range.trit && range.bits == 3) scramble = c << 6 | b << 5 | c << 1 | b;
+          if (range.quint && range.bits == 2) scramble = b << 6 | b << 1;
+          const uint32_t mask = a ? 0x7f : 0;
+          weight = (mask & 0x20) | ((digit * scale + scramble) ^ mask) >> 2;
+        }
+        if (range.bits && weight > 32) ++weight;
+        table.weights[r][value] = uint8_t (weight);
+      }
+    }
+    return table;
+  }
+
+  inline constexpr AstcUnquantize ASTC_UNQUANTIZE = astc_make_unquantize ();
+
+  /* 범위 range 의 값 count 개를 bits 의 현재 위치부터 풂. 마지막 묶음에서 빠진 값의 T / Q 비트는 블록에 없고 0 으로 침 */
+  inline void astc_decode_ise (BC7Bits &bits, const AstcRange range, const uint32_t count, uint8_t *values)
+  {
+    static constexpr uint8_t TRIT_BITS[5] = { 2, 2, 1, 2, 1 }, QUINT_BITS[3] = { 3, 2, 2 };
+    const uint32_t group = range.trit ? 5 : range.quint ? 3 : 1;
+    for (uint32_t first = 0; first < count; first += group)
+    {
+      if (group == 1)
+      {
+        values[first] = uint8_t (bits.read (range.bits));
+        continue;
+      }
+      uint32_t low[5], packed = 0, shift = 0;
+      const uint32_t present = count - first < group ? count - first : group;
+      for (uint32_t i = 0; i < present; ++i)
+      {
+        low[i] = bits.read (range.bits);
+        const uint32_t extra = range.trit ? TRIT_BITS[i] : QUINT_BITS[i];
+        packed |= bits.read (extra) << shift;
+        shift += extra;
+      }
+      for (uint32_t i = 0; i < present; ++i)
+      {
+        const uint32_t digit = range.trit ? ASTC_DIGITS.trits[packed][i] : ASTC_DIGITS.quints[packed][i];
+        values[first + i] = uint8_t (digit << range.bits | low[i]);
+      }
+    }
+  }
+
+  inline uint32_t astc_clamp (const int32_t value) { return value < 0 ? 0 : value > 255 ? 255 : uint32_t (value); }
+
+  /* 명세의 bit_transfer_signed: a 는 부호 있는 6 비트 차이, b 는 a 의 최상위 비트를 받은 기준값 */
+  inline void astc_bit_transfer (int32_t &a, int32_t &b)
+  {
+    b = (b >> 1) | (a & 0x80);
+    a = (a >> 1) & 0x3f;
+    if (a & 0x20) a -= 0x40;
+  }
+
+  inline uint32_t astc_blue_contract (const int32_t r, const int32_t g, const int32_t b, const int32_t a)
+  {
+    return block_rgba (astc_clamp ((r + b) >> 1), astc_clamp ((g + b) >> 1), astc_clamp (b), astc_clamp (a));
+  }
+
+  inline uint32_t astc_rgba (const int32_t r, const int32_t g, const int32_t b, const int32_t a)
+  {
+    return block_rgba (astc_clamp (r), astc_clamp (g), astc_clamp (b), astc_clamp (a));
+  }
+
+  /* LDR 끝점 모드 하나를 풀어 RGBA8 두 끝점으로. HDR 모드면 false */
+  inline bool astc_decode_endpoints (const uint32_t mode, const uint8_t *values, uint32_t &e0, uint32_t &e1)
+  {
+    int32_t v[8];
+    for (uint32_t i = 0; i < ((mode >> 2) + 1) * 2; ++i) v[i] = values[i];
+    switch (mode)
+    {
+      case 0:
+        e0 = astc_rgba (v[0], v[0], v[0], 255);
+        e1 = astc_rgba (v[1], v[1], v[1], 255);
+        return true;
+      case 1:
+      {
+        const int32_t l0 = (v[0] >> 2) | (v[1] & 0xc0), l1 = l0 + (v[1] & 0x3f);
+        e0 = astc_rgba (l0, l0, l0, 255);
+        e1 = astc_rgba (l1, l1, l1, 255);
+        return true;
+      }
+      case 4:
+        e0 = astc_rgba (v[0], v[0], v[0], v[2]);
+        e1 = astc_rgba (v[1], v[1], v[1], v[3]);
+        return true;
+      case 5:
+        astc_bit_transfer (v[1], v[0]);
+        astc_bit_transfer (v[3], v[2]);
+        e0 = astc_rgba (v[0], v[0], v[0], v[2]);
+        e1 = astc_rgba (v[0] + v[1], v[0] + v[1], v[0] + v[1], v[2] + v[3]);
+        return true;
+      case 6:
+      case 10:
+      {
+        const int32_t a0 = mode == 10 ? v[4] : 255, a1 = mode == 10 ? v[5] : 255;
+        e0 = astc_rgba ((v[0] * v[3]) >> 8, (v[1] * v[3]) >> 8, (v[2] * v[3]) >> 8, a0);
+        e1 = astc_rgba (v[0], v[1], v[2], a1);
+        return true;
+      }
+      case 8:
+      case 12:
+      {
+        const int32_t a0 = mode == 12 ? v[6] : 255, a1 = mode == 12 ? v[7] : 255;
+        if (v[1] + v[3] + v[5] >= v[0] + v[2] + v[4])
+        {
+          e0 = astc_rgba (v[0], v[2], v[4], a0);
+          e1 = astc_rgba (v[1], v[3], v[5], a1);
+        }
+        else
+        {
+          e0 = astc_blue_contract (v[1], v[3], v[5], a1);
+          e1 = astc_blue_contract (v[0], v[2], v[4], a0);
+        }
+        return true;
+      }
+      case 9:
+      case 13:
+      {
+        astc_bit_transfer (v[1], v[0]);
+        astc_bit_transfer (v[3], v[2]);
+        astc_bit_transfer (v[5], v[4]);
+        if (mode == 13) astc_bit_transfer (v[7], v[6]);
+        const int32_t a0 = mode == 13 ? v[6] : 255, a1 = mode == 13 ? v[6] + v[7] : 255;
+        if (v[1] + v[3] + v[5] >= 0)
+        {
+          e0 = astc_rgba (v[0], v[2], v[4], a0);
+          e1 = astc_rgba (v[0] + v[1], v[2] + v[3], v[4] + v[5], a1);
+        }
+        else
+        {
+          e0 = astc_blue_contract (v[0] + v[1], v[2] + v[3], v[4] + v[5], a1);
+          e1 = astc_blue_contract (v[0], v[2], v[4], a0);
+        }
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+
+  /* 명세의 select_partition (2D). 블록마다 같은 해시와 기울기를 먼저 구해 둠 */
+  struct AstcPartitioner
+  {
+    uint32_t slopes[8];
+    uint32_t random;
+    uint32_t count;
+    uint32_t scale;
+
+    AstcPartitioner (uint32_t seed, const uint32_t partition_count, const bool small_block)
+      : count (partition_count), scale (small_block ? 2 : 1)
+    {
+      seed += (partition_count - 1) * 1024;
+      uint32_t hash = seed;
+      hash ^= hash >> 15;
+      hash *= 0xeede0891u;
+      hash ^= hash >> 5;
+      hash += hash << 16;
+      hash ^= hash >> 7;
+      hash ^= hash >> 3;
+      hash ^= hash << 6;
+      hash ^= hash >> 17;
+      random = hash;
+
+      uint32_t shift_even, shift_odd;
+      if (seed & 1)
+      {
+        shift_even = seed & 2 ? 4 : 5;
+        shift_odd = partition_count == 3 ? 6 : 5;
+      }
+      else
+      {
+        shift_even = partition_count == 3 ? 6 : 5;
+        shift_odd = seed & 2 ? 4 : 5;
+      }
+      for (uint32_t i = 0; i < 8; ++i)
+      {
+        const uint32_t s = (hash >> (4 * i)) & 0xf;
+        slopes[i] = (s * s) >> (i & 1 ? shift_odd : shift_even);
+      }
+    }
+
+    uint32_t select (uint32_t x, uint32_t y) const
+    {
+      x *= scale;
+      y *= scale;
+      const uint32_t a = (slopes[0] * x + slopes[1] * y + (random >> 14)) & 0x3f;
+      const uint32_t b = (slopes[2] * x + slopes[3] * y + (random >> 10)) & 0x3f;
+      const uint32_t c = count < 3 ? 0 : (slopes[4] * x + slopes[5] * y + (random >> 6)) & 0x3f;
+      const uint32_t d = count < 4 ? 0 : (slopes[6] * x + slopes[7] * y + (random >> 2)) & 0x3f;
+      if (a >= b && a >= c && a >= d) return 0;
+      if (b >= c && b >= d) return 1;
+      return c >= d ? 2 : 3;
+    }
+  };
+
+  /* 블록 모드 11 비트 -> 가중치 격자와 범위. 예약된 모드나 제약을 어기면 false */
+  inline bool astc_block_mode (const uint32_t mode, uint32_t &grid_width, uint32_t &grid_height, uint32_t &range, bool &dual_plane)
+  {
+    uint32_t r = (mode >> 4) & 1, high = (mode >> 9) & 1, dual = (mode >> 10) & 1;
+    const uint32_t a = (mode >> 5) & 3;
+    if (mode & 3)
+    {
+      r |= (mode & 3) << 1;
+      const uint32_t b = (mode >> 7) & 3;
+      switch ((mode >> 2) & 3)
+      {
+        case 0: grid_width = b + 4; grid_height = a + 2; break;
+        case 1: grid_width = b + 8; grid_height = a + 2; break;
+        case 2: grid_width = a + 2; grid_height = b + 8; break;
+        default:
+          if (mode & 0x100)
+          {
+            grid_width = (b & 1) + 2;
+            grid_height = a + 2;
+          }
+          else
+          {
+            grid_width = a + 2;
+            grid_height = (b & 1) + 6;
+          }
+      }
+    }
+    else
+    {
+      r |= ((mode >> 2) & 3) << 1;
+      if (!((mode >> 2) & 3)) return false;
+      const uint32_t b = (mode >> 9) & 3;
+      switch ((mode >> 7) & 3)
+      {
+        case 0: grid_width = 12; grid_height = a + 2; break;
+        case 1: grid_width = a + 2; grid_height = 12; break;
+        case 2:
+          grid_width = a + 6;
+          grid_height = b + 6;
+          dual = high = 0;
+          break;
+        default:
+          if (a > 1) return false;
+          grid_width = a ? 10 : 6;
+          grid_height = a ? 6 : 10;
+      }
+    }
+    range = r - 2 + 6 * high;
+    dual_plane = dual;
+    const uint32_t count = grid_width * grid_height << dual;
+    const uint32_t bits = astc_ise_bits (ASTC_RANGES[range], count);
+    return count <= ASTC_MAX_WEIGHTS && bits >= 24 && bits <= 96;
+  }
+
+  inline void astc_fill (uint32_t *out, const size_t stride, const uint32_t width, const uint32_t height, const uint32_t color)
+  {
+    for (uint32_t y = 0; y < height; ++y)
+      for (uint32_t x = 0; x < width; ++x) out[y * stride + x] = color;
+  }
+
+  inline void bc1_endpoints_to_565 (const float *color, uint16_t &packed)
+  {
+    auto quantize = [] (const float value, const float scale)
+    {
+      const float q = value * scale / 255.0f + 0.5f;
+      return uint32_t (q < 0.0f ? 0.0f : q > scale ? scale : q);
+    };
+    packed = uint16_t (quantize (color[0], 31.0f) << 11 | quantize (color[1], 63.0f) << 5 | quantize (color[2], 31.0f));
+  }
+
+  /* 4 색 팔레트에서 가장 가까운 색인과 총 오차 */
+  inline uint32_t bc1_fit_indices (const float (*pixels)[4], const uint16_t c0, const uint16_t c1, uint32_t &indices)
+  {
+    uint32_t e0[3], e1[3];
+    block_unpack565 (c0, e0);
+    block_unpack565 (c1, e1);
+    int32_t palette[4][3];
+    for (int c = 0; c < 3; ++c)
+    {
+      palette[0][c] = int32_t (e0[c]);
+      palette[1][c] = int32_t (e1[c]);
+      palette[2][c] = int32_t ((2 * e0[c] + e1[c]) / 3);
+      palette[3][c] = int32_t ((e0[c] + 2 * e1[c]) / 3);
+    }
+
+    uint32_t error = 0;
+    indices = 0;
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+      uint32_t best = 0, best_error = ~0u;
+      for (uint32_t k = 0; k < 4; ++k)
+      {
+        uint32_t e = 0;
+        for (int c = 0; c < 3; ++c)
+        {
+          const int32_t d = int32_t (pixels[i][c]) - palette[k][c];
+          e += uint32_t (d * d);
+        }
+        if (e < best_error) { best_error = e; best = k; }
+      }
+      indices |= best << (2 * i);
+      error += best_error;
+    }
+    return error;
+  }
+
+  /* 분산 행렬의 주축을 거듭제곱법으로. channels 는 3 또는 4 */
+  inline void block_principal_axis (const float (*pixels)[4], const uint32_t channels, float *mean, float *axis)
+  {
+    for (uint32_t c = 0; c < 4; ++c) mean[c] = 0.0f;
+    for (uint32_t i = 0; i < 16; ++i)
+      for (uint32_t c = 0; c < channels; ++c) mean[c] += pixels[i][c] * (1.0f / 16.0f);
+
+    float covariance[4][4] = {};
+    float low[4] = { 255.0f, 255.0f, 255.0f, 255.0f }, high[4] = {};
+    for (uint32_t i = 0; i < 16; ++i)
+      for (uint32_t a = 0; a < channels; ++a)
+      {
+        const float da = pixels[i][a] - mean[a];
+        for (uint32_t b = 0; b < channels; ++b) covariance[a][b] += da * (pixels[i][b] - mean[b]);
+        low[a] = pixels[i][a] < low[a] ? pixels[i][a] : low[a];
+        high[a] = pixels[i][a] > high[a] ? pixels[i][a] : high[a];
+      }
+
+    for (uint32_t c = 0; c < 4; ++c) axis[c] = c < channels ? high[c] - low[c] : 0.0f;
+    for (int iteration = 0; iteration < 6; ++iteration)
+    {
+      float next[4] = {};
+      for (uint32_t a = 0; a < channels; ++a)
+        for (uint32_t b = 0; b < channels; ++b) next[a] += covariance[a][b] * axis[b];
+      float length = 0.0f;
+      for (uint32_t c = 0; c < channels; ++c) length += next[c] * next[c];
+      if (length <= 1e-12f) break;
+      length = 1.0f / sqrtf (length);
+      for (uint32_t c = 0; c < channels; ++c) axis[c] = next[c] * length;
+    }
+
+    float length = 0.0f;
+    for (uint32_t c = 0; c < channels; ++c) length += axis[c] * axis[c];
+    if (length > 1e-12f)
+    {
+      length = 1.0f / sqrtf (length);
+      for (uint32_t c = 0; c < channels; ++c) axis[c] *= length;
+    }
+  }
+
+  inline void block_load_pixels (const uint32_t *pixels, const size_t stride, float (*out)[4])
+  {
+    for (uint32_t y = 0; y < 4; ++y)
+      for (uint32_t x = 0; x < 4; ++x)
+      {
+        const uint32_t p = pixels[y * stride + x];
+        float *o = out[y * 4 + x];
+        o[0] = float (p & 0xff);
+        o[1] = float ((p >> 8) & 0xff);
+        o[2] = float ((p >> 16) & 0xff);
+        o[3] = float (p >> 24);
+      }
+  }
+}
+
+inline void decode_bc1 (const uint8_t *block, uint32_t *out, const size_t stride)
+{
+  Detail::block_decode_color (block, out, stride, true);
+}
+
+inline void decode_bc2 (const uint8_t *block, uint32_t *out, const size_t stride)
+{
+  Detail::block_decode_color (block + 8, out, stride, false);
+  const uint64_t alpha = Detail::block_load64 (block);
+  for (uint32_t i = 0; i < 16; ++i)
+  {
+    const uint32_t a = uint32_t (alpha >> (4 * i)) & 0xf;
+    uint32_t &pixel = out[(i >> 2) * stride + (i & 3)];
+    pixel = (pixel & 0x00ffffffu) | (a << 4 | a) << 24;
+  }
+}
+
+inline void decode_bc3 (const uint8_t *block, uint32_t *out, const size_t stride)
+{
+  Detail::block_decode_color (block + 8, out, stride, false);
+  uint8_t alpha[16];
+  Detail::block_decode_alpha (block, alpha);
+  for (uint32_t i = 0; i < 16; ++i)
+  {
+    uint32_t &pixel = out[(i >> 2) * stride + (i & 3)];
+    pixel = (pixel & 0x00ffffffu) | uint32_t (alpha[i]) << 24;
+  }
+}
+
+inline void decode_bc4 (const uint8_t *block, uint32_t *out, const size_t stride)
+{
+  uint8_t red[16];
+  Detail::block_decode_alpha (block, red);
+  for (uint32_t i = 0; i < 16; ++i) out[(i >> 2) * stride + (i & 3)] = Detail::block_rgba (red[i], 0, 0, 255);
+}
+
+inline void decode_bc5 (const uint8_t *block, uint32_t *out, const size_t stride)
+{
+  uint8_t red[16], green[16];
+  Detail::block_decode_alpha (block, red);
+  Detail::block_decode_alpha (block + 8, green);
+  for (uint32_t i = 0; i < 16; ++i) out[(i >> 2) * stride + (i & 3)] = Detail::block_rgba (red[i], green[i], 0, 255);
+}
+
+inline void decode_bc7 (const uint8_t *block, uint32_t *out, const size_t stride)
+{
+  using namespace Detail;
+
+  if (!block[0])
+  {
+    for (uint32_t y = 0; y < 4; ++y)
+      for (uint32_t x = 0; x < 4; ++x) out[y * stride + x] = 0;
+    return;
+  }
+
+  const uint32_t mode = uint32_t (__builtin_ctz (block[0]));
+  const BC7Mode &info = BC7_MODES[mode];
+  BC7Bits bits = { block_load64 (block), block_load64 (block + 8), mode + 1 };
+
+  const uint32_t partition = bits.read (info.partition_bits);
+  const uint32_t rotation = bits.read (info.rotation_bits);
+  const uint32_t selection = bits.read (info.selection_bits);
+
+  /* [부분집합 * 2 + 끝점][채널] */
+  uint32_t endpoints[6][4];
+  const uint32_t endpoint_count = info.subsets * 2u;
+  for (uint32_t c = 0; c < 3; ++c)
+    for (uint32_t e = 0; e < endpoint_count; ++e) endpoints[e][c] = bits.read (info.color_bits);
+  for (uint32_t e = 0; e < endpoint_count; ++e) endpoints[e][3] = info.alpha_bits ? bits.read (info.alpha_bits) : 255;
+
+  uint32_t pbits[6] = {};
+  if (info.endpoint_pbits)
+    for (uint32_t e = 0; e < endpoint_count; ++e) pbits[e] = bits.read (1);
+  if (info.shared_pbits)
+    for (uint32_t s = 0; s < info.subsets; ++s) pbits[s * 2] = pbits[s * 2 + 1] = bits.read (1);
+
+  const bool has_pbits = info.endpoint_pbits || info.shared_pbits;
+  for (uint32_t e = 0; e < endpoint_count; ++e)
+    for (uint32_t c = 0; c < 4; ++c)
+    {
+      if (c == 3 && !info.alpha_bits) continue;
+      uint32_t precision = c == 3 ? info.alpha_bits : info.color_bits;
+      uint32_t value = endpoints[e][c];
+      if (has_pbits)
+      {
+        value = value << 1 | pbits[e];
+        ++precision;
+      }
+      value <<= 8 - precision;
+      endpoints[e][c] = value | value >> precision;
+    }
+
+  uint32_t anchor2 = 16, anchor3 = 16;
+  if (info.subsets == 2) anchor2 = BC7_ANCHORS2[partition];
+  if (info.subsets == 3)
+  {
+    anchor2 = BC7_ANCHORS3_SECOND[partition];
+    anchor3 = BC7_ANCHORS3_THIRD[partition];
+  }
+
+  uint32_t indices[16], indices2[16];
+  for (uint32_t i = 0; i < 16; ++i)
+    indices[i] = bits.read (info.index_bits - (i == 0 || i == anchor2 || i == anchor3));
+  if (info.index_bits2)
+    for (uint32_t i = 0; i < 16; ++i) indices2[i] = bits.read (info.index_bits2 - (i == 0));
+
+  const uint8_t *color_weights = bc7_weights (info.index_bits), *alpha_weights = color_weights;
+  const uint32_t *color_indices = indices, *alpha_indices = indices;
+  if (info.index_bits2)
+  {
+    if (selection)
+    {
+      color_weights = bc7_weights (info.index_bits2);
+      color_indices = indices2;
+    }
+    else
+    {
+      alpha_weights = bc7_weights (info.index_bits2);
+      alpha_indices = indices2;
+    }
+  }
+
+  uint32_t packed[6];
+  for (uint32_t e = 0; e < endpoint_count; ++e) packed[e] = block_rgba (endpoints[e][0], endpoints[e][1], endpoints[e][2], endpoints[e][3]);
+
+  uint32_t low[16], high[16], weights[16], texels[16];
+  for (uint32_t i = 0; i < 16; ++i)
+  {
+    uint32_t subset = 0;
+    if (info.subsets == 2) subset = (BC7_PARTITIONS2[partition] >> i) & 1;
+    else if (info.subsets == 3) subset = (BC7_PARTITIONS3[partition] >> (2 * i)) & 3;
+
+    low[i] = packed[subset * 2];
+    high[i] = packed[subset * 2 + 1];
+    weights[i] = color_weights[color_indices[i]] * 0x010101u | uint32_t (alpha_weights[alpha_indices[i]]) << 24;
+  }
+  block_blend (low, high, weights, texels, 16);
+
+  for (uint32_t i = 0; i < 16; ++i)
+  {
+    uint32_t pixel = texels[i];
+    if (rotation)
+    {
+      const uint32_t shift = 8 * (rotation - 1), swap = (pixel >> shift) & 0xff;
+      pixel = (pixel & ~(0xffu << shift) & 0x00ffffffu) | (pixel >> 24) << shift | swap << 24;
+    }
+    out[(i >> 2) * stride + (i & 3)] = pixel;
+  }
+}
+
+inline void decode_bc6h (const uint8_t *block, uint64_t *out, const size_t stride, const bool is_signed)
+{
+  using namespace Detail;
+  constexpr uint64_t OPAQUE = uint64_t (0x3c00) << 48;
+
+  BC7Bits bits = { block_load64 (block), block_load64 (block + 8), 0 };
+  uint32_t mode_bits = bits.read (2);
+  if (mode_bits >= 2) mode_bits |= bits.read (3) << 2;
+  const uint32_t mode = BC6H_MODE_INDICES[mode_bits];
+  if (mode == 0xff)
+  {
+    for (uint32_t y = 0; y < 4; ++y)
+      for (uint32_t x = 0; x < 4; ++x) out[y * stride + x] = OPAQUE;
+    return;
+  }
+
+  int32_t fields[13] = {};
+  for (const BC6HBits *field = BC6H_LAYOUTS[mode]; field->count; ++field)
+  {
+    const uint32_t count = field->count & ~BC6H_REVERSED;
+    uint32_t value = bits.read (count);
+    if (field->count & BC6H_REVERSED) value = uint32_t (block_reverse64 (value) >> (64 - count));
+    fields[field->field] |= int32_t (value << field->shift);
+  }
+
+  /* [끝점][채널]. 변환 모드는 첫 끝점이 기준이고 나머지는 부호 있는 차이 */
+  const BC6HMode &info = BC6H_MODES[mode];
+  const uint32_t endpoint_count = info.subsets * 2u;
+  int32_t endpoints[4][3];
+  for (uint32_t e = 0; e < endpoint_count; ++e)
+    for (uint32_t c = 0; c < 3; ++c)
+    {
+      int32_t value = fields[e * 3 + c];
+      if (info.transformed && e)
+        value = (fields[c] + bc6h_sign_extend (value, info.delta_bits[c])) & ((1 << info.endpoint_bits) - 1);
+      if (is_signed) value = bc6h_sign_extend (value, info.endpoint_bits);
+      endpoints[e][c] = bc6h_unquantize (value, info.endpoint_bits, is_signed);
+    }
+
+  const uint32_t partition = uint32_t (fields[BC6H_D]);
+  const uint32_t anchor = info.subsets == 2 ? BC7_ANCHORS2[partition] : 16;
+  const uint32_t index_bits = info.subsets == 2 ? 3 : 4;
+  const uint8_t *weights = bc7_weights (index_bits);
+  for (uint32_t i = 0; i < 16; ++i)
+  {
+    const uint32_t weight = weights[bits.read (index_bits - (i == 0 || i == anchor))];
+    const uint32_t subset = info.subsets == 2 ? (BC7_PARTITIONS2[partition] >> i) & 1 : 0;
+    const int32_t *e0 = endpoints[subset * 2], *e1 = endpoints[subset * 2 + 1];
+
+    uint64_t pixel = OPAQUE;
+    for (uint32_t c = 0; c < 3; ++c)
+    {
+      const int32_t value = (e0[c] * int32_t (64 - weight) + e1[c] * int32_t (weight) + 32) >> 6;
+      pixel |= uint64_t (bc6h_finish (value, is_signed)) << (16 * c);
+    }
+    out[(i >> 2) * stride + (i & 3)] = pixel;
+  }
+}
+
+inline void decode_astc (const uint8_t *block, const uint32_t block_width, const uint32_t block_height, uint32_t *out, const size_t stride)
+{
+  using namespace Detail;
+  auto footprint = [] (const uint32_t size) { return (size >= 4 && size <= 6) || size == 8 || size == 10 || size == 12; };
+  if (!footprint (block_width) || !footprint (block_height)) abort ();
+
+  const uint64_t low = block_load64 (block), high = block_load64 (block + 8);
+  BC7Bits bits = { low, high, 0 };
+  const uint32_t mode = bits.read (11);
+
+  /* 단색 블록. 텍스처 좌표 범위는 최적화 힌트일 뿐이라 유효성만 봄 */
+  if ((mode & 0x1ff) == 0x1fc)
+  {
+    bits.position = 12;
+    const uint32_t min_s = bits.read (13), max_s = bits.read (13), min_t = bits.read (13), max_t = bits.read (13);
+    const bool all_ones = (min_s & max_s & min_t & max_t) == 0x1fff;
+    if ((mode & 0x200) || ((low >> 10) & 3) != 3 || (!all_ones && (min_s >= max_s || min_t >= max_t)))
+    {
+      astc_fill (out, stride, block_width, block_height, ASTC_ERROR_COLOR);
+      return;
+    }
+    astc_fill (out, stride, block_width, block_height,
+               block_rgba (uint32_t (high >> 8) & 0xff, uint32_t (high >> 24) & 0xff, uint32_t (high >> 40) & 0xff, uint32_t (high >> 56)));
+    return;
+  }
+
+  uint32_t grid_width, grid_height, weight_range;
+  bool dual_plane;
+  const uint32_t partition_count = bits.read (2) + 1;
+  if (!astc_block_mode (mode, grid_width, grid_height, weight_range, dual_plane) || grid_width > block_width ||
+      grid_height > block_height || (dual_plane && partition_count == 4))
+  {
+    astc_fill (out, stride, block_width, block_height, ASTC_ERROR_COLOR);
+    return;
+  }
+
+  const uint32_t weight_count = grid_width * grid_height << dual_plane;
+  uint32_t below_weights = 128 - astc_ise_bits (ASTC_RANGES[weight_range], weight_count);
+
+  /* 끝점 모드. 부분집합마다 다르면 모자란 비트가 가중치 바로 아래에 있음 */
+  uint32_t modes[4], partition_index = 0, color_start;
+  if (partition_count == 1)
+  {
+    modes[0] = bits.read (4);
+    color_start = 17;
+  }
+  else
+  {
+    partition_index = bits.read (10);
+    uint32_t encoded = bits.read (6);
+    color_start = 29;
+    if (!(encoded & 3))
+      for (uint32_t p = 0; p < partition_count; ++p) modes[p] = encoded >> 2;
+    else
+    {
+      const uint32_t extra = 3 * partition_count - 4;
+      below_weights -= extra;
+      bits.position = below_weights;
+      encoded |= bits.read (extra) << 6;
+      const uint32_t base = (encoded & 3) - 1;
+      for (uint32_t p = 0; p < partition_count; ++p)
+        modes[p] = (base + ((encoded >> (2 + p)) & 1)) << 2 | ((encoded >> (2 + partition_count + 2 * p)) & 3);
+    }
+  }
+  uint32_t plane_channel = 0;
+  if (dual_plane)
+  {
+    below_weights -= 2;
+    bits.position = below_weights;
+    plane_channel = bits.read (2);
+  }
+
+  uint32_t color_count = 0;
+  for (uint32_t p = 0; p < partition_count; ++p) color_count += ((modes[p] >> 2) + 1) * 2;
+  uint32_t color_range = 20;
+  const uint32_t color_bits = below_weights > color_start ? below_weights - color_start : 0;
+  while (color_range >= ASTC_MIN_COLOR_RANGE && astc_ise_bits (ASTC_RANGES[color_range], color_count) > color_bits) --color_range;
+  if (color_count > 18 || color_range < ASTC_MIN_COLOR_RANGE)
+  {
+    astc_fill (out, stride, block_width, block_height, ASTC_ERROR_COLOR);
+    return;
+  }
+
+  uint8_t colors[18];
+  bits.position = color_start;
+  astc_decode_ise (bits, ASTC_RANGES[color_range], color_count, colors);
+  for (uint32_t i = 0; i < color_count; ++i) colors[i] = ASTC_UNQUANTIZE.colors[color_range][colors[i]];
+
+  uint32_t endpoints[4][2];
+  for (uint32_t p = 0, offset = 0; p < partition_count; offset += ((modes[p] >> 2) + 1) * 2, ++p)
+    if (!astc_decode_endpoints (modes[p], colors + offset, endpoints[p][0], endpoints[p][1]))
+    {
+      astc_fill (out, stride, block_width, block_height, ASTC_ERROR_COLOR);
+      return;
+    }
+
+  /* 가중치는 블록 끝에서부터 비트를 뒤집어 놓임. 격자 밖을 읽는 보간 항은 가중치가 0 이라 여분을 0 으로 둠 */
+  uint8_t encoded_weights[ASTC_MAX_WEIGHTS], planes[2][ASTC_MAX_WEIGHTS + 16] = {};
+  BC7Bits reversed = { block_reverse64 (high), block_reverse64 (low), 0 };
+  astc_decode_ise (reversed, ASTC_RANGES[weight_range], weight_count, encoded_weights);
+  for (uint32_t i = 0; i < weight_count; ++i)
+    planes[i & dual_plane][i >> dual_plane] = ASTC_UNQUANTIZE.weights[weight_range][encoded_weights[i]];
+
+  const uint32_t texel_count = block_width * block_height;
+  const uint32_t plane_shift = 8 * plane_channel, plane_mask = dual_plane ? ~(0xffu << plane_shift) : ~0u;
+  uint32_t low_colors[ASTC_MAX_TEXELS], high_colors[ASTC_MAX_TEXELS], weights[ASTC_MAX_TEXELS], texels[ASTC_MAX_TEXELS];
+
+  /* 격자가 블록과 같으면 보간 없이 그대로. 아니면 명세의 고정소수점 쌍선형 보간 (열과 행 좌표는 미리 구함) */
+  if (grid_width == block_width && grid_height == block_height)
+    for (uint32_t i = 0; i < texel_count; ++i)
+      weights[i] = (planes[0][i] * 0x01010101u & plane_mask) | uint32_t (planes[1][i]) << plane_shift;
+  else
+  {
+    uint8_t column_base[12], column_fraction[12], row_base[12], row_fraction[12];
+    const uint32_t step_s = (1024 + block_width / 2) / (block_width - 1), step_t = (1024 + block_height / 2) / (block_height - 1);
+    for (uint32_t s = 0; s < block_width; ++s)
+    {
+      const uint32_t gs = (step_s * s * (grid_width - 1) + 32) >> 6;
+      column_base[s] = uint8_t (gs >> 4);
+      column_fraction[s] = uint8_t (gs & 15);
+    }
+    for (uint32_t t = 0; t < block_height; ++t)
+    {
+      const uint32_t gt = (step_t * t * (grid_height - 1) + 32) >> 6;
+      row_base[t] = uint8_t ((gt >> 4) * grid_width);
+      row_fraction[t] = uint8_t (gt & 15);
+    }
+    for (uint32_t t = 0, i = 0; t < block_height; ++t)
+      for (uint32_t s = 0; s < block_width; ++s, ++i)
+      {
+        const uint32_t fs = column_fraction[s], ft = row_fraction[t], base = column_base[s] + row_base[t];
+        const uint32_t w11 = (fs * ft + 8) >> 4, w10 = ft - w11, w01 = fs - w11, w00 = 16 - fs - ft + w11;
+        const uint8_t *plane0 = planes[0] + base, *plane1 = planes[1] + base;
+        const uint32_t w0 = (plane0[0] * w00 + plane0[1] * w01 + plane0[grid_width] * w10 + plane0[grid_width + 1] * w11 + 8) >> 4;
+        const uint32_t w1 = dual_plane ? (plane1[0] * w00 + plane1[1] * w01 + plane1[grid_width] * w10 + plane1[grid_width + 1] * w11 + 8) >> 4 : 0;
+        weights[i] = (w0 * 0x01010101u & plane_mask) | w1 << plane_shift;
+      }
+  }
+
+  if (partition_count == 1)
+    for (uint32_t i = 0; i < texel_count; ++i)
+    {
+      low_colors[i] = endpoints[0][0];
+      high_colors[i] = endpoints[0][1];
+    }
+  else
+  {
+    const AstcPartitioner partitioner (partition_index, partition_count, texel_count < 31);
+    for (uint32_t t = 0, i = 0; t < block_height; ++t)
+      for (uint32_t s = 0; s < block_width; ++s, ++i)
+      {
+        const uint32_t partition = partitioner.select (s, t);
+        low_colors[i] = endpoints[partition][0];
+        high_colors[i] = endpoints[partition][1];
+      }
+  }
+  block_blend (low_colors, high_colors, weights, texels, texel_count);
+
+  for (uint32_t t = 0; t < block_height; ++t) memcpy (out + t * stride, texels + t * block_width, sizeof (uint32_t) * block_width);
+}
+
+inline void decode_block (const BlockFormat format, const uint8_t *block, uint32_t *out, const size_t stride)
+{
+  switch (format)
+  {
+    case BlockFormat::BC1: decode_bc1 (block, out, stride); break;
+    case BlockFormat::BC2: decode_bc2 (block, out, stride); break;
+    case BlockFormat::BC3: decode_bc3 (block, out, stride); break;
+    case BlockFormat::BC4: decode_bc4 (block, out, stride); break;
+    case BlockFormat::BC5: decode_bc5 (block, out, stride); break;
+    case BlockFormat::BC6H_UF16:
+    case BlockFormat::BC6H_SF16:
+    {
+      uint64_t hdr[16];
+      decode_bc6h (block, hdr, 4, format == BlockFormat::BC6H_SF16);
+      for (uint32_t i = 0; i < 16; ++i)
+        out[(i >> 2) * stride + (i & 3)] = Detail::block_rgba (Detail::block_half_to_unorm8 (uint32_t (hdr[i]) & 0xffff),
+                                                               Detail::block_half_to_unorm8 (uint32_t (hdr[i] >> 16) & 0xffff),
+                                                               Detail::block_half_to_unorm8 (uint32_t (hdr[i] >> 32) & 0xffff), 255);
+      break;
+    }
+    case BlockFormat::BC7: decode_bc7 (block, out, stride); break;
+    default: decode_astc (block, block_width (format), block_height (format), out, stride); break;
+  }
+}
+
+inline void encode_bc1 (const uint32_t *pixels, const size_t stride, uint8_t *block)
+{
+  using namespace Detail;
+
+  float colors[16][4];
+  block_load_pixels (pixels, stride, colors);
+  float mean[4], axis[4];
+  block_principal_axis (colors, 3, mean, axis);
+
+  float low = 0.0f, high = 0.0f;
+  for (uint32_t i = 0; i < 16; ++i)
+  {
+    const float t = (colors[i][0] - mean[0]) * axis[0] + (colors[i][1] - mean[1]) * axis[1] + (colors[i][2] - mean[2]) * axis[2];
+    low = t < low ? t : low;
+    high = t > high ? t : high;
+  }
+  /* 양 끝을 범위의 1/16 만큼 안으로 */
+  const float inset = (high - low) / 16.0f;
+  float e0[3], e1[3];
+  for (int c = 0; c < 3; ++c)
+  {
+    e0[c] = mean[c] + axis[c] * (high - inset);
+    e1[c] = mean[c] + axis[c] * (low + inset);
+  }
+
+  uint16_t c0, c1;
+  bc1_endpoints_to_565 (e0, c0);
+  bc1_endpoints_to_565 (e1, c1);
+  uint32_t indices = 0;
+  uint32_t error = c0 == c1 ? ~0u : bc1_fit_indices (colors, c0 > c1 ? c0 : c1, c0 > c1 ? c1 : c0, indices);
+  if (c0 < c1)
+  {
+    const uint16_t swap = c0;
+    c0 = c1;
+    c1 = swap;
+  }
+
+  /* 고른 색인으로 끝점을 최소제곱 재계산 */
+  if (c0 != c1)
+  {
+    static constexpr float WEIGHTS[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+    float aa = 0.0f, bb = 0.0f, ab = 0.0f, ax[3] = {}, bx[3] = {};
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+      const float a = WEIGHTS[(indices >> (2 * i)) & 3], b = 1.0f - a;
+      aa += a * a;
+      bb += b * b;
+      ab += a * b;
+      for (int c = 0; c < 3; ++c)
+      {
+        ax[c] += a * colors[i][c];
+        bx[c] += b * colors[i][c];
+      }
+    }
+    const float determinant = aa * bb - ab * ab;
+    if (determinant > 1e-6f)
+    {
+      float r0[3], r1[3];
+      for (int c = 0; c < 3; ++c)
+      {
+        r0[c] = (ax[c] * bb - bx[c] * ab) / determinant;
+        r1[c] = (bx[c] * aa - ax[c] * ab) / determinant;
+      }
+      uint16_t n0, n1;
+      bc1_endpoints_to_565 (r0, n0);
+      bc1_endpoints_to_565 (r1, n1);
+      if (n0 < n1)
+      {
+        const uint16_t swap = n0;
+        n0 = n1;
+        n1 = swap;
+      }
+      uint32_t refined_indices;
+      if (n0 != n1)
+      {
+        const uint32_t refined = bc1_fit_indices (colors, n0, n1, refined_indices);
+        if (refined < error)
+        {
+          c0 = n0;
+          c1 = n1;
+          indices = refined_indices;
+        }
+      }
+    }
+  }
+  /* 끝점이 같으면 3 색 모드가 되지만 색인 0 은 c0 이므로 그대로 맞음 */
+  if (c0 == c1) indices = 0;
+
+  block[0] = uint8_t (c0);
+  block[1] = uint8_t (c0 >> 8);
+  block[2] = uint8_t (c1);
+  block[3] = uint8_t (c1 >> 8);
+  memcpy (block + 4, &indices, sizeof (indices));
+}
+
+inline void encode_bc7 (const uint32_t *pixels, const size_t stride, uint8_t *block)
+{
+  using namespace Detail;
+
+  float colors[16][4];
+  block_load_pixels (pixels, stride, colors);
+  float mean[4], axis[4];
+  block_principal_axis (colors, 4, mean, axis);
+
+  float low = 0.0f, high = 0.0f;
+  for (uint32_t i = 0; i < 16; ++i)
+  {
+    float t = 0.0f;
+    for (int c = 0; c < 4; ++c) t += (colors[i][c] - mean[c]) * axis[c];
+    low = t < low ? t : low;
+    high = t > high ? t : high;
+  }
+
+  /* 끝점마다 p 비트 둘 중 오차가 작은 쪽. 값은 2q + p 로 8 비트가 그대로 나옴 */
+  uint32_t quantized[2][4], pbits[2];
+  for (int e = 0; e < 2; ++e)
+  {
+    const float t = e == 0 ? low : high;
+    float best_error = 1e30f;
+    for (uint32_t p = 0; p < 2; ++p)
+    {
+      uint32_t q[4];
+      float error = 0.0f;
+      for (int c = 0; c < 4; ++c)
+      {
+        float target = mean[c] + axis[c] * t;
+        target = target < 0.0f ? 0.0f : target > 255.0f ? 255.0f : target;
+        const float level = (target - float (p)) * 0.5f + 0.5f;
+        q[c] = uint32_t (level < 0.0f ? 0.0f : level > 127.0f ? 127.0f : level);
+        const float d = float (q[c] * 2 + p) - target;
+        error += d * d;
+      }
+      if (error < best_error)
+      {
+        best_error = error;
+        pbits[e] = p;
+        for (int c = 0; c < 4; ++c) quantized[e][c] = q[c];
+      }
+    }
+  }
+
+  float e0[4], e1[4], direction[4], length = 0.0f;
+  for (int c = 0; c < 4; ++c)
+  {
+    e0[c] = float (quantized[0][c] * 2 + pbits[0]);
+    e1[c] = float (quantized[1][c] * 2 + pbits[1]);
+    direction[c] = e1[c] - e0[c];
+    length += direction[c] * direction[c];
+  }
+
+  uint32_t indices[16];
+  for (uint32_t i = 0; i < 16; ++i)
+  {
+    float t = 0.0f;
+    for (int c = 0; c < 4; ++c) t += (colors[i][c] - e0[c]) * direction[c];
+    t = length > 0.0f ? t / length * 15.0f + 0.5f : 0.0f;
+    indices[i] = uint32_t (t < 0.0f ? 0.0f : t > 15.0f ? 15.0f : t);
+  }
+
+  /* 0 번 픽셀의 색인 최상위 비트는 0 이어야 하므로 필요하면 끝점을 맞바꿈 */
+  if (indices[0] & 8)
+  {
+    for (int c = 0; c < 4; ++c)
+    {
+      const uint32_t swap = quantized[0][c];
+      quantized[0][c] = quantized[1][c];
+      quantized[1][c] = swap;
+    }
+    const uint32_t swap = pbits[0];
+    pbits[0] = pbits[1];
+    pbits[1] = swap;
+    for (uint32_t &index : indices) index = 15 - index;
+  }
+
+  BC7Bits bits = { 0, 0, 0 };
+  bits.write (1 << 6, 7);
+  for (int c = 0; c < 4; ++c)
+  {
+    bits.write (quantized[0][c], 7);
+    bits.write (quantized[1][c], 7);
+  }
+  bits.write (pbits[0], 1);
+  bits.write (pbits[1], 1);
+  for (uint32_t i = 0; i < 16; ++i) bits.write (indices[i], i == 0 ? 3 : 4);
+
+  memcpy (block, &bits.low, sizeof (bits.low));
+  memcpy (block + 8, &bits.high, sizeof (bits.high));
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Foundation/Thread/ParallelFor.h"
+#include "Foundation/Thread/ThreadPool.h"
+#include "Texture/BlockCompression.h"
+
+/* 블록 행 단위로 워커에 나눠 텍스처 전체를 풀고 압축. 블록은 행 우선으로 빽빽하게 놓이고
+   너비나 높이가 블록 크기의 배수가 아니면 가장자리 블록은 잘라서 쓰거나 (해제) 가장자리 픽셀을 되풀이 (압축) */
+inline uint32_t texture_block_columns (BlockFormat format, uint32_t width) { return (width + block_width (format) - 1) / block_width (format); }
+inline uint32_t texture_block_rows (BlockFormat format, uint32_t height) { return (height + block_height (format) - 1) / block_height (format); }
+inline size_t texture_compressed_size (BlockFormat format, uint32_t width, uint32_t height)
+{
+  return size_t (texture_block_columns (format, width)) * texture_block_rows (format, height) * block_bytes (format);
+}
+
+/* 블록 행 [first_block_row, first_block_row + block_row_count) 만 풀어 out 에 씀. out 의 첫 행은
+   first_block_row * block_height (format) 번째 픽셀 행에 해당하므로 전체 이미지 대신 스트리밍 버퍼 몇 행만 두고
+   조각조각 풀 수 있음. out_stride 는 픽셀 단위 */
+void decode_texture (ThreadPool &pool, const uint8_t *blocks, BlockFormat format, uint32_t width, uint32_t height,
+                     uint32_t *out, size_t out_stride, uint32_t first_block_row = 0, uint32_t block_row_count = ~0u);
+/* decode_texture 의 BC6H 판. 픽셀은 RGBA16F (decode_bc6h). format 이 BC6H 가 아니면 false */
+bool decode_texture_hdr (ThreadPool &pool, const uint8_t *blocks, BlockFormat format, uint32_t width, uint32_t height,
+                         uint64_t *out, size_t out_stride, uint32_t first_block_row = 0, uint32_t block_row_count = ~0u);
+
+/* format 은 BC1 또는 BC7. 다른 포맷이면 false */
+bool encode_texture (ThreadPool &pool, const uint32_t *pixels, size_t stride, uint32_t width, uint32_t height,
+                     BlockFormat format, uint8_t *blocks);
+
+/* ============ 구현 ============ */
+namespace Detail
+{
+  /* decode (block, out, stride) 로 블록 하나를 푸는 공통 루프 */
+  template <typename Pixel, typename Decode>
+  void texture_decode (ThreadPool &pool, const uint8_t *blocks, const BlockFormat format, const uint32_t width, const uint32_t height,
+                       Pixel *out, const size_t out_stride, const uint32_t first_block_row, uint32_t block_row_count, const Decode &decode)
+  {
+    const uint32_t columns = texture_block_columns (format, width), rows = texture_block_rows (format, height);
+    if (first_block_row >= rows) return;
+    if (block_row_count > rows - first_block_row) block_row_count = rows - first_block_row;
+
+    const uint32_t size_x = block_width (format), size_y = block_height (format);
+    const size_t row_bytes = size_t (columns) * block_bytes (format);
+    parallel_for (pool, block_row_count, 1, [&] (const size_t begin, const size_t end)
+    {
+      for (size_t local = begin; local < end; ++local)
+      {
+        const uint32_t row = first_block_row + uint32_t (local);
+        const uint8_t *block = blocks + row * row_bytes;
+        Pixel *line = out + local * size_y * out_stride;
+        const uint32_t visible_y = height - row * size_y < size_y ? height - row * size_y : size_y;
+
+        for (uint32_t column = 0; column < columns; ++column, block += block_bytes (format))
+        {
+          const uint32_t visible_x = width - column * size_x < size_x ? width - column * size_x : size_x;
+          if (visible_x == size_x && visible_y == size_y)
+          {
+            decode (block, line + column * size_x, out_stride);
+            continue;
+          }
+          Pixel temp[ASTC_MAX_TEXELS];
+          decode (block, temp, size_x);
+          for (uint32_t y = 0; y < visible_y; ++y)
+            for (uint32_t x = 0; x < visible_x; ++x) line[y * out_stride + column * size_x + x] = temp[y * size_x + x];
+        }
+      }
+    });
+  }
+}
+
+inline void decode_texture (ThreadPool &pool, const uint8_t *blocks, const BlockFormat format, const uint32_t width, const uint32_t height,
+                            uint32_t *out, const size_t out_stride, const uint32_t first_block_row, const uint32_t block_row_count)
+{
+  Detail::texture_decode (pool, blocks, format, width, height, out, out_stride, first_block_row, block_row_count,
+                          [format] (const uint8_t *block, uint32_t *pixels, const size_t stride) { decode_block (format, block, pixels, stride); });
+}
+
+inline bool decode_texture_hdr (ThreadPool &pool, const uint8_t *blocks, const BlockFormat format, const uint32_t width, const uint32_t height,
+                                uint64_t *out, const size_t out_stride, const uint32_t first_block_row, const uint32_t block_row_count)
+{
+  if (format != BlockFormat::BC6H_UF16 && format != BlockFormat::BC6H_SF16) return false;
+  const bool is_signed = format == BlockFormat::BC6H_SF16;
+  Detail::texture_decode (pool, blocks, format, width, height, out, out_stride, first_block_row, block_row_count,
+                          [is_signed] (const uint8_t *block, uint64_t *pixels, const size_t stride) { decode_bc6h (block, pixels, stride, is_signed); });
+  return true;
+}
+
+inline bool encode_texture (ThreadPool &pool, const uint32_t *pixels, const size_t stride, const uint32_t width, const uint32_t height,
+                            const BlockFormat format, uint8_t *blocks)
+{
+  if (format != BlockFormat::BC1 && format != BlockFormat::BC7) return false;
+
+  const uint32_t columns = texture_block_columns (format, width), rows = texture_block_rows (format, height);
+  const size_t row_bytes = size_t (columns) * block_bytes (format);
+  parallel_for (pool, rows, 1, [&] (const size_t begin, const size_t end)
+  {
+    for (size_t row = begin; row < end; ++row)
+    {
+      uint8_t *block = blocks + row * row_bytes;
+      const uint32_t *line = pixels + row * 4 * stride;
+      const uint32_t visible_y = height - uint32_t (row) * 4 < 4 ? height - uint32_t (row) * 4 : 4;
+
+      for (uint32_t column = 0; column < columns; ++column, block += block_bytes (format))
+      {
+        const uint32_t visible_x = width - column * 4 < 4 ? width - column * 4 : 4;
+        const uint32_t *source = line + column * 4;
+        size_t source_stride = stride;
+        uint32_t temp[16];
+        if (visible_x < 4 || visible_y < 4)
+        {
+          for (uint32_t y = 0; y < 4; ++y)
+            for (uint32_t x = 0; x < 4; ++x)
+              temp[y * 4 + x] = source[(y < visible_y ? y : visible_y - 1) * stride + (x < visible_x ? x : visible_x - 1)];
+          source = temp;
+          source_stride = 4;
+        }
+        if (format == BlockFormat::BC1) encode_bc1 (source, source_stride, block);
+        else encode_bc7 (source, source_stride, block);
+      }
+    }
+  });
+  return true;
+}
@@ -0,0 +1,352 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Foundation/Math/Random.h"
+#include "Foundation/Thread/ParallelFor.h"
+#include "Foundation/Thread/ThreadPool.h"
+#include "Mesh/MeshSimplify.h"
+#include "Mesh/Meshlet.h"
+#include "Mesh/VertexCache.h"
+
+/* 빌드 시점 메시 처리기. OBJ 를 읽어 정점 캐시/읽기 순서 최적화, LOD 사슬, 메시렛을 만들고 .mesh 로 씀.
+   메시 하나가 작업 하나이고 여러 메시를 워커에 나눠 처리함.
+
+   MeshTool [옵션] input.obj ...
+     -o DIR          출력 디렉터리 (기본: 입력 옆)
+     --lods N        LOD 최대 개수, LOD0 포함 (기본 4)
+     --ratio R       LOD 마다 남길 삼각형 비율 (기본 0.5)
+     --error E       LOD 허용 오차, 메시 크기 비율 (기본 0.02)
+     --demo N        입력 대신 울퉁불퉁한 구 N 개를 만들어 처리 (출력은 -o 가 있을 때만) */
+
+static constexpr uint32_t MESHLET_VERTICES = 64;
+static constexpr uint32_t MESHLET_TRIANGLES = 124;
+static constexpr uint32_t FILE_VERSION = 1;
+
+struct Vertex
+{
+  float position[3];
+  float normal[3];
+  float uv[2];
+};
+
+struct Lod
+{
+  uint32_t index_offset;
+  uint32_t index_count;
+  float error;
+};
+
+struct Settings
+{
+  std::string output_directory;
+  uint32_t max_lods = 4;
+  float ratio = 0.5f;
+  float error = 0.02f;
+};
+
+struct MeshJob
+{
+  std::string name;
+  std::string output_path;
+  bool loaded = false;
+
+  std::vector <Vertex> vertices;
+  std::vector <uint32_t> indices;   /* 처리 후에는 모든 LOD 를 이어 붙인 것 */
+  std::vector <Lod> lods;
+  std::vector <Meshlet> meshlets;
+  std::vector <uint32_t> meshlet_vertices;
+  std::vector <uint8_t> meshlet_triangles;
+
+  VertexCacheStats before = {}, after = {};
+  double milliseconds = 0.0;
+};
+
+/* 길이 제한 없이 한 줄을 읽음. 줄 끝 문자는 남겨 둠 */
+static bool read_line (FILE *file, std::string &line)
+{
+  char chunk[1024];
+  line.clear ();
+  while (fgets (chunk, sizeof (chunk), file))
+  {
+    line += chunk;
+    if (line.back () == '\n') break;
+  }
+  return !line.empty ();
+}
+
+/* v, vt, vn, f 만 읽음. 다각형은 꼭짓점 수와 상관없이 모두 부채꼴로 나누고 음수 번호 (뒤에서부터) 도 받음 */
+static bool load_obj (const std::string &path, MeshJob &job)
+{
+  FILE *file = fopen (path.c_str (), "rb");
+  if (!file) return false;
+
+  std::vector <float> positions, normals, uvs;
+  std::unordered_map <std::string, uint32_t> unique;
+  std::vector <uint32_t> polygon;
+  std::string text;
+
+  auto corner = [&] (const char *token) -> uint32_t
+  {
+    auto it = unique.find (token);
+    if (it != unique.end ()) return it->second;
+
+    long ids[3] = { 0, 0, 0 };
+    const char *p = token;
+    for (int slot = 0; slot < 3 && *p; ++slot)
+    {
+      char *end = const_cast <char *> (p);
+      if (*p != '/') ids[slot] = strtol (p, &end, 10);
+      p = end;
+      if (*p == '/') ++p;
+    }
+    auto resolve = [] (const long id, const size_t count) { return id < 0 ? long (count) + id : id - 1; };
+
+    Vertex vertex = {};
+    const long position = resolve (ids[0], positions.size () / 3);
+    const long uv = resolve (ids[1], uvs.size () / 2);
+    const long normal = resolve (ids[2], normals.size () / 3);
+    if (position >= 0 && size_t (position) < positions.size () / 3) memcpy (vertex.position, &positions[size_t (position) * 3], sizeof (vertex.position));
+    if (ids[1] && uv >= 0 && size_t (uv) < uvs.size () / 2) memcpy (vertex.uv, &uvs[size_t (uv) * 2], sizeof (vertex.uv));
+    if (ids[2] && normal >= 0 && size_t (normal) < normals.size () / 3) memcpy (vertex.normal, &normals[size_t (normal) * 3], sizeof (vertex.normal));
+
+    const uint32_t index = uint32_t (job.vertices.size ());
+    job.vertices.push_back (vertex);
+    unique.emplace (token, index);
+    return index;
+  };
+
+  while (read_line (file, text))
+  {
+    char *line = text.data ();
+    if (line[0] == 'v' && line[1] == ' ')
+    {
+      float x = 0, y = 0, z = 0;
+      sscanf (line + 2, "%f %f %f", &x, &y, &z);
+      positions.insert (positions.end (), { x, y, z });
+    }
+    else if (line[0] == 'v' && line[1] == 'n')
+    {
+      float x = 0, y = 0, z = 0;
+      sscanf (line + 3, "%f %f %f", &x, &y, &z);
+      normals.insert (normals.end (), { x, y, z });
+    }
+    else if (line[0] == 'v' && line[1] == 't')
+    {
+      float u = 0, v = 0;
+      sscanf (line + 3, "%f %f", &u, &v);
+      uvs.insert (uvs.end (), { u, v });
+    }
+    else if (line[0] == 'f' && line[1] == ' ')
+    {
+      polygon.clear ();
+      for (char *token = strtok (line + 2, " \t\r\n"); token; token = strtok (nullptr, " \t\r\n")) polygon.push_back (corner (token));
+      for (size_t i = 2; i < polygon.size (); ++i) job.indices.insert (job.indices.end (), { polygon[0], polygon[i - 1], polygon[i] });
+    }
+  }
+  fclose (file);
+  return !job.indices.empty ();
+}
+
+/* 경도 x 위도 격자 구에 잡음을 얹은 시험용 메시. 경도 0 에 UV 이음매가 있음 */
+static void make_demo_mesh (const uint32_t seed, MeshJob &job)
+{
+  Xoshiro256 random (seed + 1);
+  const uint32_t slices = 192 + uint32_t (random.next () % 128), stacks = slices / 2;
+  const float bumps[3] = { 3.0f + random.next_float () * 5.0f, 2.0f + random.next_float () * 4.0f, 0.05f + random.next_float () * 0.1f };
+
+  for (uint32_t j = 0; j <= stacks; ++j)
+    for (uint32_t i = 0; i <= slices; ++i)
+    {
+      const float theta = 3.14159265f * float (j) / float (stacks), phi = 6.2831853f * float (i % slices) / float (slices);
+      const float r = 1.0f + bumps[2] * sinf (theta * bumps[0]) * cosf (phi * bumps[1]);
+      Vertex vertex = {};
+      const float n[3] = { sinf (theta) * cosf (phi), cosf (theta), sinf (theta) * sinf (phi) };
+      for (int c = 0; c < 3; ++c)
+      {
+        vertex.position[c] = n[c] * r;
+        vertex.normal[c] = n[c];
+      }
+      vertex.uv[0] = float (i) / float (slices);
+      vertex.uv[1] = float (j) / float (stacks);
+      job.vertices.push_back (vertex);
+    }
+
+  /* 극점의 퇴화 삼각형은 빼고, 임포터가 흔히 내는 줄 단위 순서를 흉내 냄 */
+  for (uint32_t j = 0; j < stacks; ++j)
+    for (uint32_t i = 0; i < slices; ++i)
+    {
+      const uint32_t a = j * (slices + 1) + i, b = a + 1, c = a + slices + 1, d = c + 1;
+      if (j != 0) job.indices.insert (job.indices.end (), { a, b, d });
+      if (j != stacks - 1) job.indices.insert (job.indices.end (), { a, d, c });
+    }
+}
+
+static void process_mesh (MeshJob &job, const Settings &settings)
+{
+  const auto start = std::chrono::steady_clock::now ();
+  const size_t vertex_count = job.vertices.size ();
+  const float *positions = job.vertices[0].position;
+
+  job.before = analyze_vertex_cache (job.indices.data (), job.indices.size (), vertex_count);
+
+  /* LOD0 은 캐시 최적화만. 나머지 LOD 는 모두 LOD0 에서 바로 줄여 기록하는 오차가 원본 기준이 되게 함.
+     삼각형이 앞 LOD 보다 충분히 줄지 않거나 오차 한도에 걸리면 멈춤 */
+  std::vector <uint32_t> all = job.indices;
+  optimize_vertex_cache (all.data (), all.data (), all.size (), vertex_count);
+  const size_t source_count = all.size ();
+  job.lods.push_back ({ 0, uint32_t (source_count), 0.0f });
+
+  std::vector <uint32_t> lod (source_count);
+  while (job.lods.size () < settings.max_lods)
+  {
+    const Lod &previous = job.lods.back ();
+    const size_t target = size_t (float (previous.index_count / 3) * settings.ratio) * 3;
+    float error = 0.0f;
+    const size_t count = simplify_mesh (lod.data (), all.data (), source_count, positions, vertex_count, sizeof (Vertex), target, settings.error, &error);
+    if (count == 0 || count > size_t (float (previous.index_count) * 0.9f)) break;
+
+    optimize_vertex_cache (lod.data (), lod.data (), count, vertex_count);
+    const Lod next = { uint32_t (all.size ()), uint32_t (count), error };
+    all.insert (all.end (), lod.begin (), lod.begin () + ptrdiff_t (count));
+    job.lods.push_back (next);
+  }
+
+  /* LOD0 이 처음 쓰는 순서대로 정점을 놓음. 줄인 LOD 는 LOD0 정점의 부분집합이라 같은 표를 씀 */
+  std::vector <uint32_t> remap (vertex_count);
+  const size_t used = optimize_vertex_fetch_remap (remap.data (), all.data (), all.size (), vertex_count);
+  std::vector <Vertex> vertices (used);
+  remap_vertices (vertices.data (), job.vertices.data (), vertex_count, sizeof (Vertex), remap.data ());
+  remap_indices (all.data (), all.data (), all.size (), remap.data ());
+  job.vertices.swap (vertices);
+  job.indices.swap (all);
+
+  const size_t lod0 = job.lods[0].index_count;
+  job.after = analyze_vertex_cache (job.indices.data (), lod0, job.vertices.size ());
+
+  job.meshlets.resize (meshlet_bound (lod0, MESHLET_VERTICES, MESHLET_TRIANGLES));
+  job.meshlet_vertices.resize (lod0);
+  job.meshlet_triangles.resize (lod0);
+  const size_t meshlet_count = build_meshlets (job.meshlets.data (), job.meshlet_vertices.data (), job.meshlet_triangles.data (), job.indices.data (), lod0,
+                                               job.vertices[0].position, job.vertices.size (), sizeof (Vertex), MESHLET_VERTICES, MESHLET_TRIANGLES);
+  job.meshlets.resize (meshlet_count);
+  if (meshlet_count)
+  {
+    const Meshlet &last = job.meshlets.back ();
+    job.meshlet_vertices.resize (last.vertex_offset + last.vertex_count);
+    job.meshlet_triangles.resize (last.triangle_offset + last.triangle_count * 3);
+  }
+
+  job.milliseconds = std::chrono::duration <double, std::milli> (std::chrono::steady_clock::now () - start).count ();
+}
+
+/* 머리 뒤에 LOD 표, 정점, 인덱스, 메시렛, 메시렛 정점, 메시렛 삼각형이 차례로 옴 */
+static bool write_mesh (const MeshJob &job)
+{
+  FILE *file = fopen (job.output_path.c_str (), "wb");
+  if (!file) return false;
+
+  const uint32_t header[9] = { 0x534d4b49 /* "IKMS" */, FILE_VERSION, uint32_t (sizeof (Vertex)), uint32_t (job.vertices.size ()),
+                               uint32_t (job.indices.size ()), uint32_t (job.lods.size ()), uint32_t (job.meshlets.size ()),
+                               uint32_t (job.meshlet_vertices.size ()), uint32_t (job.meshlet_triangles.size ()) };
+  bool ok = fwrite (header, sizeof (header), 1, file) == 1;
+  auto write = [&] (const auto &array)
+  {
+    if (!array.empty ()) ok = ok && fwrite (array.data (), sizeof (array[0]), array.size (), file) == array.size ();
+  };
+  write (job.lods);
+  write (job.vertices);
+  write (job.indices);
+  write (job.meshlets);
+  write (job.meshlet_vertices);
+  write (job.meshlet_triangles);
+  return fclose (file) == 0 && ok;
+}
+
+static std::string output_path_for (const std::string &input, const Settings &settings)
+{
+  std::string name = input;
+  const size_t slash = name.find_last_of ("/\\");
+  const size_t dot = name.find_last_of ('.');
+  if (dot != std::string::npos && (slash == std::string::npos || dot > slash)) name.resize (dot);
+  if (settings.output_directory.empty ()) return name + ".mesh";
+  if (slash != std::string::npos) name = name.substr (slash + 1);
+  return settings.output_directory + "/" + name + ".mesh";
+}
+
+int main (int argc, char **argv)
+{
+  Settings settings;
+  std::vector <std::string> inputs;
+  uint32_t demo = 0;
+  for (int i = 1; i < argc; ++i)
+  {
+    const char *arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (!strcmp (arg, "-o") && has_value) settings.output_directory = argv[++i];
+    else if (!strcmp (arg, "--lods") && has_value) settings.max_lods = uint32_t (atoi (argv[++i]));
+    else if (!strcmp (arg, "--ratio") && has_value) settings.ratio = float (atof (argv[++i]));
+    else if (!strcmp (arg, "--error") && has_value) settings.error = float (atof (argv[++i]));
+    else if (!strcmp (arg, "--demo") && has_value) demo = uint32_t (atoi (argv[++i]));
+    else if (arg[0] == '-')
+    {
+      fprintf (stderr, "usage: %s [-o dir] [--lods n] [--ratio r] [--error e] [--demo n] input.obj ...\n", argv[0]);
+      return 2;
+    }
+    else inputs.push_back (arg);
+  }
+  if (settings.max_lods < 1) settings.max_lods = 1;
+
+  std::vector <MeshJob> jobs (demo ? demo : inputs.size ());
+  if (jobs.empty ())
+  {
+    fprintf (stderr, "no input\n");
+    return 2;
+  }
+  for (size_t i = 0; i < jobs.size (); ++i)
+  {
+    jobs[i].name = demo ? "demo" + std::to_string (i) : inputs[i];
+    if (!demo || !settings.output_directory.empty ()) jobs[i].output_path = output_path_for (jobs[i].name, settings);
+  }
+
+  ThreadPool pool;
+  const auto start = std::chrono::steady_clock::now ();
+  parallel_for (pool, jobs.size (), 1, [&] (const size_t begin, const size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+    {
+      MeshJob &job = jobs[i];
+      if (demo) make_demo_mesh (uint32_t (i), job);
+      else if (!load_obj (job.name, job)) continue;
+      job.loaded = true;
+      process_mesh (job, settings);
+      if (!job.output_path.empty () && !write_mesh (job)) job.output_path = "(write failed) " + job.output_path;
+    }
+  });
+  const double total = std::chrono::duration <double, std::milli> (std::chrono::steady_clock::now () - start).count ();
+
+  int failures = 0;
+  size_t triangles = 0;
+  for (const MeshJob &job : jobs)
+  {
+    if (!job.loaded)
+    {
+      fprintf (stderr, "%s: cannot read mesh\n", job.name.c_str ());
+      ++failures;
+      continue;
+    }
+    triangles += job.lods[0].index_count / 3;
+    printf ("%s: %zu vertices, ACMR %.3f -> %.3f, %zu meshlets, %.1f ms\n", job.name.c_str (), job.vertices.size (), job.before.acmr, job.after.acmr,
+            job.meshlets.size (), job.milliseconds);
+    for (size_t l = 0; l < job.lods.size (); ++l) printf ("  LOD%zu %u triangles, error %.4f\n", l, job.lods[l].index_count / 3, job.lods[l].error);
+    if (!job.output_path.empty ()) printf ("  -> %s\n", job.output_path.c_str ());
+    failures += job.output_path.rfind ("(write failed)", 0) == 0;
+  }
+  printf ("%zu meshes, %zu triangles, %.1f ms on %u threads\n", jobs.size (), triangles, total, pool.worker_count () + 1);
+  return failures ? 1 : 0;
+}